@@ -48,126 +48,1349 @@
 ////////////////////////////////////////////////////////////////////////////////
 size_t ZLibComputeDeflateCompressSize(size_t inSize)
 {
-    bool computed = false;
-    size_t outSize = 2;
+    // Largest container header : GZip header
+    size_t outSize = ZLIB_GZIP_HEADER_SIZE;
 
-    // Compute deflate data compressed size
-    while (!computed)
+    // Worst case : every block falls back to uncompressed blocks
+    outSize += inSize;
+
+    // Block infos and block size (per block and per uncompressed chunk)
+    outSize += (5*((inSize/ZLIB_DEFLATE_MAX_STORED) +
+        (inSize/(ZLIB_DEFLATE_BLOCK_SYMBOLS-2)) + 2));
+
+    // Partial blocks and sync flush per parallel segment
+    outSize += (15*(inSize/ZLIB_DEFLATE_SEGMENT_SIZE));
+
+    // Largest container trailer : GZip CRC32 and size
+    outSize += ZLIB_GZIP_TRAILER_SIZE;
+
+    // Compressed ZLib deflate data size successfully computed
+    return outSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Write ZLib header                                                         //
+////////////////////////////////////////////////////////////////////////////////
+inline void ZLibDeflateWriteHeader(unsigned char out[],
+    ZLibDeflateLevel level, bool dictionary)
+{
+    uint16_t zlibHeader = ((8 << 8) | (7 << 12));
+    zlibHeader |= (ZLibDeflateLevels[level].hint << 6);
+    if (dictionary) { zlibHeader |= (0x0001 << 5); }
+    zlibHeader |= (31 - (zlibHeader % 31));
+    out[0] = ((zlibHeader >> 8) & 0xFF);
+    out[1] = (zlibHeader & 0xFF);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compress ZLib deflate data                                                //
+//  return : True if the data is successfully compressed                      //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateCompress(unsigned char in[], size_t inSize,
+    unsigned char out[], size_t* outSize, ZLibDeflateLevel level)
+{
+    return ZLibDeflateCompressDictionary(
+        in, inSize, 0, 0, out, outSize, level
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compress ZLib deflate data with a preset dictionary                       //
+//  return : True if the data is successfully compressed                      //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateCompressDictionary(unsigned char in[], size_t inSize,
+    const unsigned char dict[], size_t dictSize,
+    unsigned char out[], size_t* outSize, ZLibDeflateLevel level)
+{
+    // Check data buffers
+    size_t headerSize = (dict && (dictSize > 0)) ? 6 : 2;
+    if (!in || !out || (inSize <= 0) || (*outSize < (headerSize + 4)))
+    {
+        // Invalid data buffers
+        return false;
+    }
+
+    // Check compression level
+    if ((level < ZLIB_DEFLATE_LEVEL_STORE) ||
+        (level >= ZLIB_DEFLATE_LEVEL_COUNT))
+    {
+        // Invalid compression level
+        return false;
+    }
+
+    // Write ZLib header
+    size_t outIndex = 0;
+    ZLibDeflateWriteHeader(out, level, (headerSize > 2));
+    outIndex += 2;
+    if (headerSize > 2)
+    {
+        // Write dictionary Adler32 CRC
+        uint32_t dictAdler32 = SysAdler32((unsigned char*)dict, dictSize);
+        out[outIndex++] = ((dictAdler32 >> 24) & 0xFF);
+        out[outIndex++] = ((dictAdler32 >> 16) & 0xFF);
+        out[outIndex++] = ((dictAdler32 >> 8) & 0xFF);
+        out[outIndex++] = (dictAdler32 & 0xFF);
+    }
+
+    // Compress deflate data
+    size_t deflateSize = (*outSize - headerSize - 4);
+    if (!ZLibDeflateCompressRaw(in, inSize,
+        &out[outIndex], &deflateSize, level, dict, dictSize))
+    {
+        // Could not compress deflate data
+        return false;
+    }
+    outIndex += deflateSize;
+
+    // Write Adler32 CRC
+    uint32_t zlibAdler32 = SysAdler32(in, inSize);
+    out[outIndex++] = ((zlibAdler32 >> 24) & 0xFF);
+    out[outIndex++] = ((zlibAdler32 >> 16) & 0xFF);
+    out[outIndex++] = ((zlibAdler32 >> 8) & 0xFF);
+    out[outIndex++] = (zlibAdler32 & 0xFF);
+
+    // Set output data size
+    if (outIndex > *outSize)
+    {
+        // Invalid output data size
+        return false;
+    }
+    *outSize = outIndex;
+
+    // Data is successfully compressed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compress raw deflate data                                                 //
+//  return : True if the data is successfully compressed                      //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateCompressRaw(unsigned char in[], size_t inSize,
+    unsigned char out[], size_t* outSize, ZLibDeflateLevel level,
+    const unsigned char dict[], size_t dictSize)
+{
+    // Check data buffers
+    if (!in || !out || (inSize <= 0) || (*outSize <= 0))
+    {
+        // Invalid data buffers
+        return false;
+    }
+
+    // Check compression level
+    if ((level < ZLIB_DEFLATE_LEVEL_STORE) ||
+        (level >= ZLIB_DEFLATE_LEVEL_COUNT))
+    {
+        // Invalid compression level
+        return false;
+    }
+
+    // Only the last 32KiB of the dictionary can be referenced
+    if (!dict) { dictSize = 0; }
+    if (dictSize > ZLIB_DEFLATE_WINDOW_SIZE)
+    {
+        dict += (dictSize - ZLIB_DEFLATE_WINDOW_SIZE);
+        dictSize = ZLIB_DEFLATE_WINDOW_SIZE;
+    }
+
+    // Prepend dictionary to the input data
+    unsigned char* data = in;
+    if (dictSize > 0)
+    {
+        data = new (std::nothrow) unsigned char[dictSize + inSize];
+        if (!data)
+        {
+            // Could not allocate dictionary data
+            return false;
+        }
+        memcpy(data, dict, dictSize);
+        memcpy(&data[dictSize], in, inSize);
+    }
+
+    // Allocate deflate encoder
+    ZLibDeflateEncoder* encoder = new (std::nothrow) ZLibDeflateEncoder;
+    if (!encoder)
+    {
+        // Could not allocate deflate encoder
+        if (data != in) { delete[] data; }
+        return false;
+    }
+    ZLibInitEncoder(*encoder, out, *outSize);
+
+    // Compress deflate data
+    bool compressed = ZLibDeflateEncode(
+        *encoder, data, dictSize, (dictSize + inSize), level, true
+    );
+    size_t outIndex = encoder->outIndex;
+    delete encoder;
+    if (data != in) { delete[] data; }
+    if (!compressed)
+    {
+        // Could not compress deflate data
+        return false;
+    }
+
+    // Set output data size
+    *outSize = outIndex;
+
+    // Data is successfully compressed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compress GZip data                                                        //
+//  return : True if the data is successfully compressed                      //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibGZipCompress(unsigned char in[], size_t inSize,
+    unsigned char out[], size_t* outSize, ZLibDeflateLevel level)
+{
+    // Check data buffers
+    if (!in || !out || (inSize <= 0) ||
+        (*outSize < (ZLIB_GZIP_HEADER_SIZE + ZLIB_GZIP_TRAILER_SIZE)))
+    {
+        // Invalid data buffers
+        return false;
+    }
+
+    // Check compression level
+    if ((level < ZLIB_DEFLATE_LEVEL_STORE) ||
+        (level >= ZLIB_DEFLATE_LEVEL_COUNT))
+    {
+        // Invalid compression level
+        return false;
+    }
+
+    // Write GZip header (no optional fields, no modification time)
+    size_t outIndex = 0;
+    out[outIndex++] = ZLIB_GZIP_ID1;
+    out[outIndex++] = ZLIB_GZIP_ID2;
+    out[outIndex++] = 0x08;
+    out[outIndex++] = 0x00;
+    out[outIndex++] = 0x00;
+    out[outIndex++] = 0x00;
+    out[outIndex++] = 0x00;
+    out[outIndex++] = 0x00;
+    out[outIndex++] = (level == ZLIB_DEFLATE_LEVEL_SMALLEST) ? 0x02 :
+        ((level == ZLIB_DEFLATE_LEVEL_FASTEST) ? 0x04 : 0x00);
+    out[outIndex++] = ZLIB_GZIP_OS_UNKNOWN;
+
+    // Compress deflate data
+    size_t deflateSize =
+        (*outSize - ZLIB_GZIP_HEADER_SIZE - ZLIB_GZIP_TRAILER_SIZE);
+    if (!ZLibDeflateCompressRaw(in, inSize,
+        &out[outIndex], &deflateSize, level))
+    {
+        // Could not compress deflate data
+        return false;
+    }
+    outIndex += deflateSize;
+
+    // Write CRC32 and input size (little endian)
+    uint32_t gzipCRC32 = SysCRC32(in, inSize);
+    uint32_t gzipSize = (uint32_t)(inSize & 0xFFFFFFFF);
+    out[outIndex++] = (gzipCRC32 & 0xFF);
+    out[outIndex++] = ((gzipCRC32 >> 8) & 0xFF);
+    out[outIndex++] = ((gzipCRC32 >> 16) & 0xFF);
+    out[outIndex++] = ((gzipCRC32 >> 24) & 0xFF);
+    out[outIndex++] = (gzipSize & 0xFF);
+    out[outIndex++] = ((gzipSize >> 8) & 0xFF);
+    out[outIndex++] = ((gzipSize >> 16) & 0xFF);
+    out[outIndex++] = ((gzipSize >> 24) & 0xFF);
+
+    // Set output data size
+    if (outIndex > *outSize)
+    {
+        // Invalid output data size
+        return false;
+    }
+    *outSize = outIndex;
+
+    // Data is successfully compressed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compress ZLib deflate parallel segments worker                            //
+////////////////////////////////////////////////////////////////////////////////
+void ZLibDeflateSegmentsWorker(ZLibDeflateSegment* segments,
+    uint32_t segmentsCount, std::atomic<uint32_t>* nextSegment,
+    ZLibDeflateLevel level)
+{
+    // Allocate deflate encoder
+    ZLibDeflateEncoder* encoder = new (std::nothrow) ZLibDeflateEncoder;
+    if (!encoder)
+    {
+        // Could not allocate deflate encoder
+        return;
+    }
+
+    // Compress segments until all segments are taken
+    uint32_t segment = nextSegment->fetch_add(1);
+    while (segment < segmentsCount)
+    {
+        ZLibDeflateCompressSegment(*encoder, segments[segment], level);
+        segment = nextSegment->fetch_add(1);
+    }
+    delete encoder;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compress ZLib deflate data with parallel segments                         //
+//  Each segment uses the previous 32KiB of input as its dictionary           //
+//  and ends on a sync flush boundary, the output is one ZLib stream          //
+//  return : True if the data is successfully compressed                      //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateCompressParallel(unsigned char in[], size_t inSize,
+    unsigned char out[], size_t* outSize, ZLibDeflateLevel level,
+    uint32_t threadsCount)
+{
+    // Check data buffers
+    if (!in || !out || (inSize <= 0) || (*outSize < 2))
+    {
+        // Invalid data buffers
+        return false;
+    }
+
+    // Check compression level
+    if ((level < ZLIB_DEFLATE_LEVEL_STORE) ||
+        (level >= ZLIB_DEFLATE_LEVEL_COUNT))
+    {
+        // Invalid compression level
+        return false;
+    }
+
+    // Compute segments and threads count
+    uint32_t segmentsCount = (uint32_t)(
+        (inSize + ZLIB_DEFLATE_SEGMENT_SIZE - 1) / ZLIB_DEFLATE_SEGMENT_SIZE
+    );
+    if (threadsCount == 0)
+    {
+        threadsCount = std::thread::hardware_concurrency();
+    }
+    if (threadsCount > ZLIB_DEFLATE_MAX_THREADS)
+    {
+        threadsCount = ZLIB_DEFLATE_MAX_THREADS;
+    }
+    if (threadsCount > segmentsCount) { threadsCount = segmentsCount; }
+    if ((threadsCount <= 1) || (level == ZLIB_DEFLATE_LEVEL_STORE))
+    {
+        // Single threaded compression
+        return ZLibDeflateCompress(in, inSize, out, outSize, level);
+    }
+
+    // Allocate segments
+    ZLibDeflateSegment* segments =
+        new (std::nothrow) ZLibDeflateSegment[segmentsCount];
+    if (!segments)
+    {
+        // Could not allocate segments
+        return false;
+    }
+
+    // Allocate segments output buffers
+    size_t segmentOutSize =
+        ZLibComputeDeflateCompressSize(ZLIB_DEFLATE_SEGMENT_SIZE);
+    unsigned char* segmentsOut = new (std::nothrow)
+        unsigned char[segmentOutSize*segmentsCount];
+    if (!segmentsOut)
+    {
+        // Could not allocate segments output buffers
+        delete[] segments;
+        return false;
+    }
+
+    // Set segments
+    for (uint32_t i = 0; i < segmentsCount; ++i)
+    {
+        segments[i].in = in;
+        segments[i].start = (i*(size_t)ZLIB_DEFLATE_SEGMENT_SIZE);
+        segments[i].end = (segments[i].start + ZLIB_DEFLATE_SEGMENT_SIZE);
+        if (segments[i].end > inSize) { segments[i].end = inSize; }
+        segments[i].out = &segmentsOut[i*segmentOutSize];
+        segments[i].outSize = segmentOutSize;
+        segments[i].adler32 = SysAdler32Default;
+        segments[i].finalBlock = (i == (segmentsCount-1));
+        segments[i].compressed = false;
+    }
+
+    // Start worker threads, the current thread is also a worker
+    std::atomic<uint32_t> nextSegment(0);
+    std::thread* threads[ZLIB_DEFLATE_MAX_THREADS] = {0};
+    for (uint32_t i = 1; i < threadsCount; ++i)
+    {
+        threads[i] = new (std::nothrow) std::thread(
+            ZLibDeflateSegmentsWorker, segments, segmentsCount,
+            &nextSegment, level
+        );
+    }
+    ZLibDeflateSegmentsWorker(segments, segmentsCount, &nextSegment, level);
+
+    // Wait for worker threads
+    for (uint32_t i = 1; i < threadsCount; ++i)
+    {
+        if (threads[i])
+        {
+            threads[i]->join();
+            delete threads[i];
+        }
+    }
+
+    // Write ZLib header
+    size_t outIndex = 0;
+    ZLibDeflateWriteHeader(out, level, false);
+    outIndex += 2;
+
+    // Join segments and combine Adler32 CRC
+    bool compressed = true;
+    uint32_t zlibAdler32 = SysAdler32Default;
+    for (uint32_t i = 0; i < segmentsCount; ++i)
+    {
+        if (!segments[i].compressed ||
+            ((outIndex + segments[i].outSize) > *outSize))
+        {
+            // Could not compress segment
+            compressed = false;
+            break;
+        }
+        memcpy(&out[outIndex], segments[i].out, segments[i].outSize);
+        outIndex += segments[i].outSize;
+        zlibAdler32 = SysAdler32Combine(zlibAdler32, segments[i].adler32,
+            (segments[i].end - segments[i].start));
+    }
+    delete[] segmentsOut;
+    delete[] segments;
+    if (!compressed) { return false; }
+
+    // Write Adler32 CRC
+    if ((outIndex + 4) > *outSize) return false;
+    out[outIndex++] = ((zlibAdler32 >> 24) & 0xFF);
+    out[outIndex++] = ((zlibAdler32 >> 16) & 0xFF);
+    out[outIndex++] = ((zlibAdler32 >> 8) & 0xFF);
+    out[outIndex++] = (zlibAdler32 & 0xFF);
+    *outSize = outIndex;
+
+    // Data is successfully compressed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compress ZLib deflate parallel segment                                    //
+//  return : True if the segment is successfully compressed                   //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateCompressSegment(ZLibDeflateEncoder& encoder,
+    ZLibDeflateSegment& segment, ZLibDeflateLevel level)
+{
+    segment.compressed = false;
+    ZLibInitEncoder(encoder, segment.out, segment.outSize);
+
+    // Compress segment with the previous input as dictionary
+    if (!ZLibDeflateEncode(encoder, segment.in, segment.start, segment.end,
+        level, segment.finalBlock))
+    {
+        // Could not compress segment
+        return false;
+    }
+
+    // Sync flush : empty uncompressed block to reach a byte boundary
+    if (!segment.finalBlock)
+    {
+        if (!ZLibDeflateWriteStored(encoder, segment.in, 0, false))
+        {
+            // Could not flush segment
+            return false;
+        }
+    }
+
+    // Compute segment Adler32 CRC
+    segment.adler32 = SysAdler32(
+        (unsigned char*)&segment.in[segment.start],
+        (segment.end - segment.start)
+    );
+    segment.outSize = encoder.outIndex;
+    segment.compressed = true;
+
+    // Segment is successfully compressed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Init ZLib deflate encoder                                                 //
+////////////////////////////////////////////////////////////////////////////////
+void ZLibInitEncoder(ZLibDeflateEncoder& encoder,
+    unsigned char out[], size_t outSize)
+{
+    // Reset hash chains
+    memset(encoder.head, 0xFF, sizeof(encoder.head));
+
+    // Reset block symbols
+    memset(encoder.litlenFreqs, 0, sizeof(encoder.litlenFreqs));
+    memset(encoder.offsetFreqs, 0, sizeof(encoder.offsetFreqs));
+    encoder.symbolsCount = 0;
+
+    // Reset output bit stream
+    encoder.out = out;
+    encoder.outIndex = 0;
+    encoder.outSize = outSize;
+    encoder.bits = 0;
+    encoder.bitsCount = 0;
+
+    // Build length symbols lookup table
+    for (uint32_t i = 0; i < 29; ++i)
+    {
+        uint32_t entry = ZLibDeflateLitlenTable[257+i];
+        uint32_t base = (entry >> 16);
+        uint32_t extra = ((entry >> 8) & 0xFF);
+        for (uint32_t j = 0; j < (0x00000001u << extra); ++j)
+        {
+            if ((base + j) <= ZLIB_DEFLATE_MAX_MATCH)
+            {
+                encoder.lengthSymbols[base + j] = (uint8_t)i;
+            }
+        }
+    }
+
+    // Build offset symbols lookup table (zlib distance code layout)
+    for (uint32_t i = 0; i < 30; ++i)
+    {
+        uint32_t entry = (ZLibDeflateOffsetTable[i] >> 8);
+        uint32_t base = ((entry & 0xFFFF) - 1);
+        uint32_t extra = (entry >> 16);
+        for (uint32_t j = 0; j < (0x00000001u << extra); ++j)
+        {
+            uint32_t offset = (base + j);
+            if (offset < 256)
+            {
+                encoder.offsetSymbols[offset] = (uint8_t)i;
+            }
+            else
+            {
+                encoder.offsetSymbols[256 + (offset >> 7)] = (uint8_t)i;
+            }
+        }
+    }
+
+    // Build static Huffman codes
+    uint32_t i = 0;
+    for (i = 0; i < 144; ++i) { encoder.staticLitlenLengths[i] = 8; }
+    for (; i < 256; ++i) { encoder.staticLitlenLengths[i] = 9; }
+    for (; i < 280; ++i) { encoder.staticLitlenLengths[i] = 7; }
+    for (; i < 288; ++i) { encoder.staticLitlenLengths[i] = 8; }
+    for (i = 0; i < ZLIB_DEFLATE_OFFSET_SYMBOLS; ++i)
+    {
+        encoder.staticOffsetLengths[i] = 5;
+    }
+    ZLibBuildHuffmanCodes(encoder.staticLitlenLengths,
+        encoder.staticLitlenCodes, ZLIB_DEFLATE_LITLEN_SYMBOLS);
+    ZLibBuildHuffmanCodes(encoder.staticOffsetLengths,
+        encoder.staticOffsetCodes, ZLIB_DEFLATE_OFFSET_SYMBOLS);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Write ZLib deflate encoder bits                                           //
+//  return : True if the bits are successfully written                        //
+////////////////////////////////////////////////////////////////////////////////
+inline bool ZLibDeflatePutBits(ZLibDeflateEncoder& encoder,
+    uint32_t bits, uint32_t count)
+{
+    encoder.bits |= ((uint64_t)bits << encoder.bitsCount);
+    encoder.bitsCount += count;
+    if (encoder.bitsCount >= 32)
+    {
+        // Flush 32 bits
+        if ((encoder.outIndex + 4) > encoder.outSize) { return false; }
+        encoder.out[encoder.outIndex++] = (uint8_t)(encoder.bits);
+        encoder.out[encoder.outIndex++] = (uint8_t)(encoder.bits >> 8);
+        encoder.out[encoder.outIndex++] = (uint8_t)(encoder.bits >> 16);
+        encoder.out[encoder.outIndex++] = (uint8_t)(encoder.bits >> 24);
+        encoder.bits >>= 32;
+        encoder.bitsCount -= 32;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Flush ZLib deflate encoder bits to the next byte boundary                 //
+//  return : True if the bits are successfully flushed                        //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateAlignBits(ZLibDeflateEncoder& encoder)
+{
+    while (encoder.bitsCount > 0)
+    {
+        if (encoder.outIndex >= encoder.outSize) { return false; }
+        encoder.out[encoder.outIndex++] = (uint8_t)(encoder.bits);
+        encoder.bits >>= 8;
+        encoder.bitsCount = (encoder.bitsCount > 8) ?
+            (encoder.bitsCount - 8) : 0;
+    }
+    encoder.bits = 0;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Insert position into ZLib deflate encoder hash chains                     //
+//  return : Previous position with the same hash                             //
+////////////////////////////////////////////////////////////////////////////////
+inline uint32_t ZLibDeflateInsertHash(ZLibDeflateEncoder& encoder,
+    const unsigned char in[], size_t pos)
+{
+    uint32_t hash = (in[pos] | (in[pos+1] << 8) | (in[pos+2] << 16));
+    hash = ((hash * 0x9E3779B1u) >> (32 - ZLIB_DEFLATE_HASH_BITS));
+    uint32_t candidate = encoder.head[hash];
+    encoder.head[hash] = (uint32_t)pos;
+    encoder.prev[pos & ZLIB_DEFLATE_WINDOW_MASK] = candidate;
+    return candidate;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Find ZLib deflate longest match along the hash chain                      //
+//  return : Length of a match longer than minLength, 0 otherwise             //
+////////////////////////////////////////////////////////////////////////////////
+inline uint32_t ZLibDeflateFindMatch(ZLibDeflateEncoder& encoder,
+    const unsigned char in[], size_t inSize, size_t pos, uint32_t candidate,
+    uint32_t minLength, const ZLibDeflateLevelSettings& settings,
+    uint32_t* offset)
+{
+    // Compute match limits
+    uint32_t maxLength = ZLIB_DEFLATE_MAX_MATCH;
+    if ((inSize - pos) < maxLength) { maxLength = (uint32_t)(inSize - pos); }
+    if (maxLength < ZLIB_DEFLATE_MIN_MATCH) { return 0; }
+    if (minLength >= maxLength) { return 0; }
+    size_t limit = 0;
+    if (pos > ZLIB_DEFLATE_WINDOW_SIZE)
+    {
+        limit = (pos - ZLIB_DEFLATE_WINDOW_SIZE);
+    }
+    uint32_t chainLength = settings.chainLength;
+    if (minLength >= settings.goodLength) { chainLength >>= 2; }
+
+    // Walk the hash chain
+    const unsigned char* current = &in[pos];
+    uint32_t bestLength = minLength;
+    while ((candidate != ZLIB_DEFLATE_HASH_NIL) &&
+        (candidate >= limit) && (chainLength-- > 0))
+    {
+        const unsigned char* match = &in[candidate];
+        if ((match[bestLength] == current[bestLength]) &&
+            (match[0] == current[0]) && (match[1] == current[1]))
+        {
+            // Compare 8 bytes at a time
+            uint32_t length = 0;
+            while ((length + 8) <= maxLength)
+            {
+                uint64_t word1 = 0;
+                uint64_t word2 = 0;
+                memcpy(&word1, &match[length], 8);
+                memcpy(&word2, &current[length], 8);
+                if (word1 != word2)
+                {
+                    length += (SysBitScanForward64(word1 ^ word2) >> 3);
+                    break;
+                }
+                length += 8;
+            }
+            if ((length + 8) > maxLength)
+            {
+                while ((length < maxLength) &&
+                    (match[length] == current[length])) { ++length; }
+            }
+
+            // Keep the longest match
+            if (length > bestLength)
+            {
+                bestLength = length;
+                *offset = (uint32_t)(pos - candidate);
+                if ((length >= settings.niceLength) ||
+                    (length >= maxLength)) { break; }
+            }
+        }
+
+        // Next position in the chain
+        uint32_t next = encoder.prev[candidate & ZLIB_DEFLATE_WINDOW_MASK];
+        if (next >= candidate) { break; }
+        candidate = next;
+    }
+
+    // Return the match length if it improves on minLength
+    if ((bestLength > minLength) && (bestLength >= ZLIB_DEFLATE_MIN_MATCH))
+    {
+        return bestLength;
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Encode raw deflate blocks with LZ77 and Huffman coding                    //
+//  Input bytes before start are only used as dictionary                      //
+//  return : True if the data is successfully encoded                         //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateEncode(ZLibDeflateEncoder& encoder,
+    const unsigned char in[], size_t start, size_t inSize,
+    ZLibDeflateLevel level, bool finalBlock)
+{
+    // Uncompressed blocks only
+    if (level == ZLIB_DEFLATE_LEVEL_STORE)
+    {
+        return ZLibDeflateWriteStored(
+            encoder, &in[start], (inSize-start), finalBlock
+        );
+    }
+    const ZLibDeflateLevelSettings& settings = ZLibDeflateLevels[level];
+
+    // Insert dictionary positions into the hash chains
+    size_t pos = 0;
+    if (start > ZLIB_DEFLATE_WINDOW_SIZE)
+    {
+        pos = (start - ZLIB_DEFLATE_WINDOW_SIZE);
+    }
+    for (; pos < start; ++pos)
+    {
+        if ((pos + ZLIB_DEFLATE_MIN_MATCH) <= inSize)
+        {
+            ZLibDeflateInsertHash(encoder, in, pos);
+        }
+    }
+
+    size_t blockStart = start;
+    size_t blockEnd = start;
+    uint32_t prevLength = 0;
+    uint32_t prevOffset = 0;
+    bool prevPending = false;
+    while (pos < inSize)
+    {
+        // Flush full block
+        if (encoder.symbolsCount >= (ZLIB_DEFLATE_BLOCK_SYMBOLS-2))
+        {
+            if (!ZLibDeflateFlushBlock(encoder,
+                &in[blockStart], (blockEnd-blockStart), false))
+            {
+                // Could not flush block
+                return false;
+            }
+            blockStart = blockEnd;
+        }
+
+        // Insert current position and find a match
+        uint32_t candidate = ZLIB_DEFLATE_HASH_NIL;
+        if ((pos + ZLIB_DEFLATE_MIN_MATCH) <= inSize)
+        {
+            candidate = ZLibDeflateInsertHash(encoder, in, pos);
+        }
+
+        if (settings.lazyLength == 0)
+        {
+            // Greedy matching
+            uint32_t offset = 0;
+            uint32_t length = ZLibDeflateFindMatch(encoder, in, inSize,
+                pos, candidate, ZLIB_DEFLATE_MIN_MATCH-1, settings, &offset);
+            if (length >= ZLIB_DEFLATE_MIN_MATCH)
+            {
+                // Record match
+                uint32_t symbol = encoder.symbolsCount++;
+                encoder.litlens[symbol] = (uint16_t)length;
+                encoder.offsets[symbol] = (uint16_t)offset;
+                ++encoder.litlenFreqs[257+encoder.lengthSymbols[length]];
+                --offset;
+                ++encoder.offsetFreqs[encoder.offsetSymbols[(offset < 256) ?
+                    offset : (256 + (offset >> 7))]];
+
+                // Insert matched positions
+                size_t matchEnd = (pos + length);
+                for (++pos; pos < matchEnd; ++pos)
+                {
+                    if ((pos + ZLIB_DEFLATE_MIN_MATCH) <= inSize)
+                    {
+                        ZLibDeflateInsertHash(encoder, in, pos);
+                    }
+                }
+            }
+            else
+            {
+                // Record literal
+                uint32_t symbol = encoder.symbolsCount++;
+                encoder.litlens[symbol] = in[pos];
+                encoder.offsets[symbol] = 0;
+                ++encoder.litlenFreqs[in[pos]];
+                ++pos;
+            }
+            blockEnd = pos;
+            continue;
+        }
+
+        // Lazy matching
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        if (prevLength < settings.lazyLength)
+        {
+            uint32_t minLength = ZLIB_DEFLATE_MIN_MATCH-1;
+            if (prevPending && (prevLength > minLength))
+            {
+                minLength = prevLength;
+            }
+            length = ZLibDeflateFindMatch(encoder, in, inSize,
+                pos, candidate, minLength, settings, &offset);
+        }
+
+        if (prevPending && (prevLength >= ZLIB_DEFLATE_MIN_MATCH) &&
+            (length <= prevLength))
+        {
+            // Record previous match
+            uint32_t symbol = encoder.symbolsCount++;
+            encoder.litlens[symbol] = (uint16_t)prevLength;
+            encoder.offsets[symbol] = (uint16_t)prevOffset;
+            ++encoder.litlenFreqs[257+encoder.lengthSymbols[prevLength]];
+            --prevOffset;
+            ++encoder.offsetFreqs[encoder.offsetSymbols[(prevOffset < 256) ?
+                prevOffset : (256 + (prevOffset >> 7))]];
+
+            // Insert matched positions
+            size_t matchEnd = (pos - 1 + prevLength);
+            for (++pos; pos < matchEnd; ++pos)
+            {
+                if ((pos + ZLIB_DEFLATE_MIN_MATCH) <= inSize)
+                {
+                    ZLibDeflateInsertHash(encoder, in, pos);
+                }
+            }
+            blockEnd = pos;
+            prevPending = false;
+            prevLength = 0;
+        }
+        else
+        {
+            if (prevPending)
+            {
+                // Record previous literal
+                uint32_t symbol = encoder.symbolsCount++;
+                encoder.litlens[symbol] = in[pos-1];
+                encoder.offsets[symbol] = 0;
+                ++encoder.litlenFreqs[in[pos-1]];
+                blockEnd = pos;
+            }
+
+            // Defer current position
+            prevPending = true;
+            prevLength = length;
+            prevOffset = offset;
+            ++pos;
+        }
+    }
+
+    // Record last pending symbol
+    if (prevPending)
+    {
+        uint32_t symbol = encoder.symbolsCount++;
+        if (prevLength >= ZLIB_DEFLATE_MIN_MATCH)
+        {
+            encoder.litlens[symbol] = (uint16_t)prevLength;
+            encoder.offsets[symbol] = (uint16_t)prevOffset;
+            ++encoder.litlenFreqs[257+encoder.lengthSymbols[prevLength]];
+            --prevOffset;
+            ++encoder.offsetFreqs[encoder.offsetSymbols[(prevOffset < 256) ?
+                prevOffset : (256 + (prevOffset >> 7))]];
+        }
+        else
+        {
+            encoder.litlens[symbol] = in[pos-1];
+            encoder.offsets[symbol] = 0;
+            ++encoder.litlenFreqs[in[pos-1]];
+        }
+        blockEnd = inSize;
+    }
+
+    // Flush last block
+    if ((encoder.symbolsCount > 0) || finalBlock)
+    {
+        if (!ZLibDeflateFlushBlock(encoder,
+            &in[blockStart], (blockEnd-blockStart), finalBlock))
+        {
+            // Could not flush last block
+            return false;
+        }
+    }
+
+    // Align final block
+    if (finalBlock)
+    {
+        if (!ZLibDeflateAlignBits(encoder))
+        {
+            // Could not align final block
+            return false;
+        }
+    }
+
+    // Data is successfully encoded
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compute ZLib deflate block data size in bits                              //
+//  return : Block symbols size in bits with the given codeword lengths       //
+////////////////////////////////////////////////////////////////////////////////
+inline size_t ZLibDeflateBlockBits(const ZLibDeflateEncoder& encoder,
+    const uint8_t litlenLengths[], const uint8_t offsetLengths[])
+{
+    size_t bits = 0;
+    for (uint32_t i = 0; i < 286; ++i)
+    {
+        bits += (encoder.litlenFreqs[i] * litlenLengths[i]);
+    }
+    for (uint32_t i = 257; i < 286; ++i)
+    {
+        bits += (encoder.litlenFreqs[i] *
+            ((ZLibDeflateLitlenTable[i] >> 8) & 0xFF));
+    }
+    for (uint32_t i = 0; i < 30; ++i)
+    {
+        bits += (encoder.offsetFreqs[i] *
+            (offsetLengths[i] + (ZLibDeflateOffsetTable[i] >> 24)));
+    }
+    return bits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Flush ZLib deflate encoder block                                          //
+//  return : True if the block is successfully written                        //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateFlushBlock(ZLibDeflateEncoder& encoder,
+    const unsigned char in[], size_t inSize, bool finalBlock)
+{
+    // End of block symbol
+    encoder.litlenFreqs[ZLIB_DEFLATE_END_OF_BLOCK] = 1;
+
+    // Build dynamic Huffman codes
+    ZLibBuildHuffmanLengths(encoder.litlenFreqs, encoder.litlenLengths,
+        286, ZLIB_DEFLATE_MAX_LITLEN_LEN);
+    ZLibBuildHuffmanLengths(encoder.offsetFreqs, encoder.offsetLengths,
+        30, ZLIB_DEFLATE_MAX_OFFSET_LEN);
+    uint32_t litlenSymbols = 286;
+    while ((litlenSymbols > 257) &&
+        (encoder.litlenLengths[litlenSymbols-1] == 0)) { --litlenSymbols; }
+    uint32_t offsetSymbols = 30;
+    while ((offsetSymbols > 1) &&
+        (encoder.offsetLengths[offsetSymbols-1] == 0)) { --offsetSymbols; }
+
+    // Run length encode codeword lengths with the precode
+    uint8_t lengths[286+30];
+    memcpy(lengths, encoder.litlenLengths, litlenSymbols);
+    memcpy(&lengths[litlenSymbols], encoder.offsetLengths, offsetSymbols);
+    uint32_t lengthsCount = (litlenSymbols + offsetSymbols);
+    uint32_t precodeFreqs[ZLIB_DEFLATE_PRECODE_SYMBOLS] = {0};
+    uint32_t itemsCount = 0;
+    for (uint32_t i = 0; i < lengthsCount; )
+    {
+        uint8_t length = lengths[i];
+        uint32_t run = 1;
+        while (((i + run) < lengthsCount) && (lengths[i+run] == length))
+        {
+            ++run;
+        }
+        i += run;
+
+        if (length == 0)
+        {
+            // Repeat zero 11 to 138 times
+            while (run >= 11)
+            {
+                uint32_t repeat = ((run < 138) ? run : 138);
+                encoder.precodeItems[itemsCount++] = ((repeat-11) << 5) | 18;
+                ++precodeFreqs[18];
+                run -= repeat;
+            }
+
+            // Repeat zero 3 to 10 times
+            if (run >= 3)
+            {
+                encoder.precodeItems[itemsCount++] = ((run-3) << 5) | 17;
+                ++precodeFreqs[17];
+                run = 0;
+            }
+        }
+        else
+        {
+            // Explicit codeword length
+            encoder.precodeItems[itemsCount++] = length;
+            ++precodeFreqs[length];
+            --run;
+
+            // Repeat previous length 3 to 6 times
+            while (run >= 3)
+            {
+                uint32_t repeat = ((run < 6) ? run : 6);
+                encoder.precodeItems[itemsCount++] = ((repeat-3) << 5) | 16;
+                ++precodeFreqs[16];
+                run -= repeat;
+            }
+        }
+
+        // Remaining explicit codeword lengths
+        while (run > 0)
+        {
+            encoder.precodeItems[itemsCount++] = length;
+            ++precodeFreqs[length];
+            --run;
+        }
+    }
+
+    // Build precode
+    uint8_t precodeLengths[ZLIB_DEFLATE_PRECODE_SYMBOLS];
+    uint16_t precodeCodes[ZLIB_DEFLATE_PRECODE_SYMBOLS];
+    ZLibBuildHuffmanLengths(precodeFreqs, precodeLengths,
+        ZLIB_DEFLATE_PRECODE_SYMBOLS, ZLIB_DEFLATE_MAX_PRECODE_LEN);
+    ZLibBuildHuffmanCodes(precodeLengths, precodeCodes,
+        ZLIB_DEFLATE_PRECODE_SYMBOLS);
+    uint32_t precodeSymbols = ZLIB_DEFLATE_PRECODE_SYMBOLS;
+    while ((precodeSymbols > 4) && (precodeLengths[
+        ZLibDeflatePrecodePermutations[precodeSymbols-1]] == 0))
     {
-        // Check remaining size
-        if (inSize <= 65535)
+        --precodeSymbols;
+    }
+
+    // Compute dynamic block size
+    size_t dynamicBits = (3 + 5 + 5 + 4 + (3*precodeSymbols));
+    for (uint32_t i = 0; i < ZLIB_DEFLATE_PRECODE_SYMBOLS; ++i)
+    {
+        dynamicBits += (precodeFreqs[i] * precodeLengths[i]);
+    }
+    dynamicBits += ((precodeFreqs[16]*2)+(precodeFreqs[17]*3)+
+        (precodeFreqs[18]*7));
+    dynamicBits += ZLibDeflateBlockBits(
+        encoder, encoder.litlenLengths, encoder.offsetLengths
+    );
+
+    // Compute static block size
+    size_t staticBits = (3 + ZLibDeflateBlockBits(
+        encoder, encoder.staticLitlenLengths, encoder.staticOffsetLengths
+    ));
+
+    // Compute uncompressed block size
+    size_t storedChunks = ((inSize + ZLIB_DEFLATE_MAX_STORED - 1) /
+        ZLIB_DEFLATE_MAX_STORED);
+    if (storedChunks == 0) { storedChunks = 1; }
+    size_t storedBits = (((encoder.bitsCount + 3 + 7) & ~7u) -
+        encoder.bitsCount + 32 + (inSize*8) + ((storedChunks-1)*(8+32)));
+
+    // Write the smallest block type
+    bool written = true;
+    if ((storedBits <= staticBits) && (storedBits <= dynamicBits))
+    {
+        // Uncompressed blocks
+        written = ZLibDeflateWriteStored(encoder, in, inSize, finalBlock);
+    }
+    else
+    {
+        const uint8_t* litlenLengths = encoder.staticLitlenLengths;
+        const uint16_t* litlenCodes = encoder.staticLitlenCodes;
+        const uint8_t* offsetLengths = encoder.staticOffsetLengths;
+        const uint16_t* offsetCodes = encoder.staticOffsetCodes;
+        if (dynamicBits < staticBits)
         {
-            outSize += inSize;
-            inSize = 0;
-            computed = true;
+            // Dynamic Huffman block header
+            ZLibBuildHuffmanCodes(encoder.litlenLengths,
+                encoder.litlenCodes, 286);
+            ZLibBuildHuffmanCodes(encoder.offsetLengths,
+                encoder.offsetCodes, 30);
+            litlenLengths = encoder.litlenLengths;
+            litlenCodes = encoder.litlenCodes;
+            offsetLengths = encoder.offsetLengths;
+            offsetCodes = encoder.offsetCodes;
+
+            written &= ZLibDeflatePutBits(encoder,
+                (finalBlock ? 1 : 0) |
+                (ZLIB_DEFLATE_BLOCK_DYNAMIC_HUFFMAN << 1), 3);
+            written &= ZLibDeflatePutBits(encoder, litlenSymbols-257, 5);
+            written &= ZLibDeflatePutBits(encoder, offsetSymbols-1, 5);
+            written &= ZLibDeflatePutBits(encoder, precodeSymbols-4, 4);
+            for (uint32_t i = 0; i < precodeSymbols; ++i)
+            {
+                written &= ZLibDeflatePutBits(encoder,
+                    precodeLengths[ZLibDeflatePrecodePermutations[i]], 3);
+            }
+            for (uint32_t i = 0; i < itemsCount; ++i)
+            {
+                uint32_t presym = (encoder.precodeItems[i] & 0x1F);
+                uint32_t extra = (encoder.precodeItems[i] >> 5);
+                written &= ZLibDeflatePutBits(encoder,
+                    precodeCodes[presym], precodeLengths[presym]);
+                if (presym == 16)
+                {
+                    written &= ZLibDeflatePutBits(encoder, extra, 2);
+                }
+                else if (presym == 17)
+                {
+                    written &= ZLibDeflatePutBits(encoder, extra, 3);
+                }
+                else if (presym == 18)
+                {
+                    written &= ZLibDeflatePutBits(encoder, extra, 7);
+                }
+            }
         }
         else
         {
-            outSize += 65535;
-            inSize -= 65535;
+            // Static Huffman block header
+            written &= ZLibDeflatePutBits(encoder,
+                (finalBlock ? 1 : 0) |
+                (ZLIB_DEFLATE_BLOCK_STATIC_HUFFMAN << 1), 3);
+        }
+
+        // Write block symbols
+        for (uint32_t i = 0; written && (i < encoder.symbolsCount); ++i)
+        {
+            uint32_t litlen = encoder.litlens[i];
+            uint32_t offset = encoder.offsets[i];
+            if (offset == 0)
+            {
+                // Literal
+                written &= ZLibDeflatePutBits(encoder,
+                    litlenCodes[litlen], litlenLengths[litlen]);
+                continue;
+            }
+
+            // Match length
+            uint32_t symbol = (257 + encoder.lengthSymbols[litlen]);
+            uint32_t entry = ZLibDeflateLitlenTable[symbol];
+            written &= ZLibDeflatePutBits(encoder,
+                litlenCodes[symbol], litlenLengths[symbol]);
+            written &= ZLibDeflatePutBits(encoder,
+                litlen - (entry >> 16), ((entry >> 8) & 0xFF));
+
+            // Match offset
+            --offset;
+            symbol = encoder.offsetSymbols[(offset < 256) ?
+                offset : (256 + (offset >> 7))];
+            entry = (ZLibDeflateOffsetTable[symbol] >> 8);
+            written &= ZLibDeflatePutBits(encoder,
+                offsetCodes[symbol], offsetLengths[symbol]);
+            written &= ZLibDeflatePutBits(encoder,
+                (offset + 1) - (entry & 0xFFFF), (entry >> 16));
         }
 
-        // Block infos
-        outSize += 1;
-        // Block size
-        outSize += 4;
+        // End of block
+        written &= ZLibDeflatePutBits(encoder,
+            litlenCodes[ZLIB_DEFLATE_END_OF_BLOCK],
+            litlenLengths[ZLIB_DEFLATE_END_OF_BLOCK]);
     }
 
-    // Adler32 CRC
-    outSize += 4;
+    // Reset block symbols
+    memset(encoder.litlenFreqs, 0, sizeof(encoder.litlenFreqs));
+    memset(encoder.offsetFreqs, 0, sizeof(encoder.offsetFreqs));
+    encoder.symbolsCount = 0;
 
-    // Compressed ZLib deflate data size successfully computed
-    return outSize;
+    // Block is successfully written
+    return written;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Compress ZLib deflate data                                                //
-//  return : True if the data is successfully compressed                      //
+//  Write ZLib deflate uncompressed blocks                                    //
+//  return : True if the blocks are successfully written                      //
 ////////////////////////////////////////////////////////////////////////////////
-bool ZLibDeflateCompress(unsigned char in[], size_t inSize,
-    unsigned char out[], size_t* outSize)
+bool ZLibDeflateWriteStored(ZLibDeflateEncoder& encoder,
+    const unsigned char in[], size_t inSize, bool finalBlock)
 {
-    bool compressed = false;
     size_t inIndex = 0;
-    size_t outIndex = 0;
-
-    // Check data buffers
-    if (!in || !out || (inSize <= 0) || (*outSize < 2))
-    {
-        // Invalid data buffers
-        return false;
-    }
-
-    // Write ZLib header
-    uint16_t zlibHeader = ((8 << 8) | (7 << 12));
-    zlibHeader |= (ZLIB_DEFLATE_FASTEST_COMPRESSION << 6);
-    zlibHeader |= (31 - (zlibHeader % 31));
-    out[outIndex++] = ((zlibHeader >> 8) & 0xFF);
-    out[outIndex++] = (zlibHeader & 0xFF);
-
-    // Compress deflate data
-    uint32_t bitsCount = 0;
-    while (!compressed)
+    bool lastChunk = false;
+    while (!lastChunk)
     {
         // Check remaining size
-        uint16_t blockSize = 65535;
-        if ((inSize-inIndex) <= 65535)
+        uint16_t blockSize = ZLIB_DEFLATE_MAX_STORED;
+        if ((inSize-inIndex) <= ZLIB_DEFLATE_MAX_STORED)
         {
             blockSize = (uint16_t)(inSize-inIndex);
-            compressed = true;
+            lastChunk = true;
         }
 
-        // Check output buffer size
-        if ((outIndex + 5) > *outSize) return false;
-
-        // Write final block state
-        out[outIndex] = 0;
-        out[outIndex] |= ((compressed ? 1 : 0) << bitsCount);
-        ++bitsCount;
+        // Write block header and align output
+        if (!ZLibDeflatePutBits(encoder, ((lastChunk && finalBlock) ? 1 : 0) |
+            (ZLIB_DEFLATE_BLOCK_UNCOMPRESSED << 1), 3)) { return false; }
+        if (!ZLibDeflateAlignBits(encoder)) { return false; }
 
-        // Write block type
-        out[outIndex] |= (ZLIB_DEFLATE_BLOCK_UNCOMPRESSED << bitsCount);
-        ++bitsCount;
-
-        // Align output
-        bitsCount = 0;
-        ++outIndex;
+        // Check output buffer size
+        if ((encoder.outIndex + 4 + blockSize) > encoder.outSize)
+        {
+            return false;
+        }
 
         // Write block size
-        out[outIndex++] = (blockSize & 0xFF);
-        out[outIndex++] = ((blockSize >> 8) & 0xFF);
         uint16_t nBlockSize = ((uint16_t)~blockSize);
-        out[outIndex++] = (nBlockSize & 0xFF);
-        out[outIndex++] = ((nBlockSize >> 8) & 0xFF);
-
-        // Check buffers sizes
-        if ((inIndex + blockSize) > inSize) return false;
-        if ((outIndex + blockSize) > *outSize) return false;
+        encoder.out[encoder.outIndex++] = (blockSize & 0xFF);
+        encoder.out[encoder.outIndex++] = ((blockSize >> 8) & 0xFF);
+        encoder.out[encoder.outIndex++] = (nBlockSize & 0xFF);
+        encoder.out[encoder.outIndex++] = ((nBlockSize >> 8) & 0xFF);
 
         // Copy uncompressed block
-        memcpy(&out[outIndex], &in[inIndex], blockSize);
+        if (blockSize > 0)
+        {
+            memcpy(&encoder.out[encoder.outIndex], &in[inIndex], blockSize);
+        }
         inIndex += blockSize;
-        outIndex += blockSize;
+        encoder.outIndex += blockSize;
     }
 
-    // Write Adler32 CRC
-    if ((outIndex + 4) > *outSize) return false;
-    uint32_t zlibAdler32 = SysAdler32(in, inSize);
-    out[outIndex++] = ((zlibAdler32 >> 24) & 0xFF);
-    out[outIndex++] = ((zlibAdler32 >> 16) & 0xFF);
-    out[outIndex++] = ((zlibAdler32 >> 8) & 0xFF);
-    out[outIndex++] = (zlibAdler32 & 0xFF);
+    // Uncompressed blocks are successfully written
+    return true;
+}
 
-    // Set output data size
-    if (outIndex > *outSize)
+////////////////////////////////////////////////////////////////////////////////
+//  Build length limited Huffman codeword lengths                             //
+////////////////////////////////////////////////////////////////////////////////
+void ZLibBuildHuffmanLengths(const uint32_t freqs[], uint8_t lengths[],
+    const uint32_t symbolsCount, const uint32_t codewordLen)
+{
+    uint32_t sorted[ZLIB_DEFLATE_MAX_SYMBOLS];
+    int32_t nodes[ZLIB_DEFLATE_MAX_SYMBOLS];
+    int32_t count = 0;
+
+    // Sort used symbols by ascending frequency
+    memset(lengths, 0, symbolsCount);
+    for (uint32_t i = 0; i < symbolsCount; ++i)
     {
-        // Invalid output data size
-        return false;
+        if (freqs[i] == 0) { continue; }
+        uint32_t key = ((freqs[i] << 9) | i);
+        int32_t j = count++;
+        while ((j > 0) && (sorted[j-1] > key))
+        {
+            sorted[j] = sorted[j-1];
+            --j;
+        }
+        sorted[j] = key;
     }
-    *outSize = outIndex;
 
-    // Data is successfully compressed
-    return true;
+    // At least two codewords are required
+    if (count < 2)
+    {
+        uint32_t symbol = ((count == 1) ? (sorted[0] & 0x1FF) : 0);
+        lengths[symbol] = 1;
+        lengths[(symbol == 0) ? 1 : 0] = 1;
+        return;
+    }
+
+    // Compute Huffman codeword lengths in place (Moffat-Katajainen)
+    for (int32_t i = 0; i < count; ++i)
+    {
+        nodes[i] = (int32_t)(sorted[i] >> 9);
+    }
+    int32_t root = 0;
+    int32_t leaf = 2;
+    nodes[0] += nodes[1];
+    for (int32_t next = 1; next < (count-1); ++next)
+    {
+        if ((leaf >= count) || (nodes[root] < nodes[leaf]))
+        {
+            nodes[next] = nodes[root];
+            nodes[root++] = next;
+        }
+        else
+        {
+            nodes[next] = nodes[leaf++];
+        }
+        if ((leaf >= count) ||
+            ((root < next) && (nodes[root] < nodes[leaf])))
+        {
+            nodes[next] += nodes[root];
+            nodes[root++] = next;
+        }
+        else
+        {
+            nodes[next] += nodes[leaf++];
+        }
+    }
+    nodes[count-2] = 0;
+    for (int32_t next = (count-3); next >= 0; --next)
+    {
+        nodes[next] = (nodes[nodes[next]] + 1);
+    }
+    int32_t available = 1;
+    int32_t used = 0;
+    int32_t depth = 0;
+    root = (count-2);
+    int32_t next = (count-1);
+    while (available > 0)
+    {
+        while ((root >= 0) && (nodes[root] == depth)) { ++used; --root; }
+        while (available > used) { nodes[next--] = depth; --available; }
+        available = (2*used);
+        ++depth;
+        used = 0;
+    }
+
+    // Count codeword lengths and limit them to codewordLen
+    uint32_t lenCounts[ZLIB_DEFLATE_MAX_CODEWORD_LEN+1] = {0};
+    for (int32_t i = 0; i < count; ++i)
+    {
+        uint32_t length = (uint32_t)nodes[i];
+        if (length > codewordLen) { length = codewordLen; }
+        ++lenCounts[length];
+    }
+    uint32_t codespace = 0;
+    for (uint32_t i = 1; i <= codewordLen; ++i)
+    {
+        codespace += (lenCounts[i] << (codewordLen - i));
+    }
+    while (codespace > (0x00000001u << codewordLen))
+    {
+        // Move a leaf down to restore a complete code
+        --lenCounts[codewordLen];
+        for (uint32_t i = (codewordLen-1); i > 0; --i)
+        {
+            if (lenCounts[i] > 0)
+            {
+                --lenCounts[i];
+                lenCounts[i+1] += 2;
+                break;
+            }
+        }
+        --codespace;
+    }
+
+    // Assign longest lengths to least frequent symbols
+    int32_t index = 0;
+    for (uint32_t i = codewordLen; i > 0; --i)
+    {
+        for (uint32_t j = 0; j < lenCounts[i]; ++j)
+        {
+            lengths[sorted[index++] & 0x1FF] = (uint8_t)i;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Build canonical Huffman codewords (bit reversed)                          //
+////////////////////////////////////////////////////////////////////////////////
+void ZLibBuildHuffmanCodes(const uint8_t lengths[], uint16_t codes[],
+    const uint32_t symbolsCount)
+{
+    uint32_t lenCounts[ZLIB_DEFLATE_MAX_CODEWORD_LEN+1] = {0};
+    uint32_t nextCodes[ZLIB_DEFLATE_MAX_CODEWORD_LEN+1] = {0};
+
+    // Count codewords for each length
+    for (uint32_t i = 0; i < symbolsCount; ++i)
+    {
+        ++lenCounts[lengths[i]];
+    }
+    lenCounts[0] = 0;
+
+    // Compute first codeword for each length
+    uint32_t code = 0;
+    for (uint32_t i = 1; i <= ZLIB_DEFLATE_MAX_CODEWORD_LEN; ++i)
+    {
+        code = ((code + lenCounts[i-1]) << 1);
+        nextCodes[i] = code;
+    }
+
+    // Assign bit reversed codewords
+    for (uint32_t i = 0; i < symbolsCount; ++i)
+    {
+        uint32_t length = lengths[i];
+        uint32_t reversed = 0;
+        if (length > 0)
+        {
+            code = nextCodes[length]++;
+            for (uint32_t j = 0; j < length; ++j)
+            {
+                reversed = ((reversed << 1) | ((code >> j) & 1));
+            }
+        }
+        codes[i] = (uint16_t)reversed;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -342,41 +1565,95 @@ bool ZLibBuildDecodeTable(uint32_t decodeTable[], uint8_t lengthsTable[],
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Decompress ZLib deflate data                                              //
-//  return : True if the data is successfully decompressed                    //
+//  Build ZLib multi-literal decode table                                     //
+//  Entries decode two consecutive literals within the litlen table bits      //
 ////////////////////////////////////////////////////////////////////////////////
-bool ZLibDeflateDecompress(unsigned char in[], size_t inSize,
-    unsigned char out[], size_t* outSize)
+void ZLibBuildMultiLiteralTable(uint32_t multiTable[],
+    const uint32_t litlenTable[])
+{
+    for (uint32_t i = 0; i < ZLIB_DEFLATE_MULTI_SIZE; ++i)
+    {
+        // First literal from the table index
+        multiTable[i] = 0;
+        uint32_t first = litlenTable[i];
+        if ((first & 0xC0000000) != 0x40000000) { continue; }
+        uint32_t firstLen = (first & 0xFF);
+
+        // Second literal from the remaining known bits
+        uint32_t second = litlenTable[i >> firstLen];
+        if ((second & 0xC0000000) != 0x40000000) { continue; }
+        uint32_t secondLen = (second & 0xFF);
+        if ((firstLen + secondLen) > ZLIB_DEFLATE_LITLEN_TABLEBITS)
+        {
+            continue;
+        }
+
+        // Two literals entry
+        multiTable[i] = ((((second >> 8) & 0xFF) << 16) |
+            (((first >> 8) & 0xFF) << 8) | (firstLen + secondLen));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Init ZLib deflate decode context                                          //
+////////////////////////////////////////////////////////////////////////////////
+void ZLibInitDecodeContext(ZLibDeflateContext& context)
+{
+    // Decode tables are built by the first Huffman block
+    context.staticTablesLoaded = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Copy ZLib deflate match starting in the preset dictionary                 //
+//  return : True if the match is successfully copied                         //
+////////////////////////////////////////////////////////////////////////////////
+inline bool ZLibDeflateCopyDictionary(unsigned char out[], size_t outIndex,
+    uint32_t offset, uint32_t len, const unsigned char dict[], size_t dictSize)
+{
+    // Check dictionary offset
+    size_t dictOffset = (offset - outIndex);
+    if (!dict || (dictOffset > dictSize))
+    {
+        // Invalid offset
+        return false;
+    }
+
+    // Copy from the dictionary end, then from the output start
+    const unsigned char* src = &dict[dictSize - dictOffset];
+    for (uint32_t i = 0; i < len; ++i)
+    {
+        if (i == dictOffset) { src = out; }
+        out[outIndex + i] = *src++;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Inflate raw deflate data                                                  //
+//  return : True if the data is successfully inflated                        //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateInflate(ZLibDeflateContext& context,
+    const unsigned char in[], size_t inSize, size_t* inRead,
+    unsigned char out[], size_t* outSize,
+    const unsigned char dict[], size_t dictSize)
 {
     bool decompressed = false;
-    bool staticTablesLoaded = false;
+    bool& staticTablesLoaded = context.staticTablesLoaded;
     size_t inIndex = 0;
     size_t outIndex = 0;
-    size_t endIndex = (inSize-4);
+    size_t endIndex = inSize;
     uint32_t bitsLeft = 0;
     uint64_t current = 0;
     size_t overrun = 0;
-    ZLibDeflateDecodeTables tables;
+    ZLibDeflateDecodeTables& tables = context.tables;
 
     // Check data buffers
-    if (!in || !out || (inSize < 4) || (*outSize <= 0))
+    if (!in || !out || (*outSize <= 0))
     {
         // Invalid data buffers
         return false;
     }
 
-    // Check ZLib header
-    uint16_t zlibHeader = (in[inIndex++] << 8);
-    zlibHeader |= in[inIndex++];
-    // FCHECK
-    if ((zlibHeader % 31) != 0) return false;
-    // CM
-    if (((zlibHeader >> 8) & 0x000F) != 0x0008) return false;
-    // CINFO
-    if ((zlibHeader >> 12) > 0x0007) return false;
-    // FDICT     
-    if ((zlibHeader >> 5) & 0x0001) return false;
-
     // Decompress deflate data
     while (!decompressed)
     {
@@ -615,44 +1892,197 @@ bool ZLibDeflateDecompress(unsigned char in[], size_t inSize,
                         i += repCount;
                     }
                 }
-            }
-            else
-            {
-                // Invalid block type
-                return false;
-            }
+            }
+            else
+            {
+                // Invalid block type
+                return false;
+            }
+
+            if (!staticTablesLoaded)
+            {
+                // Build offset table
+                if (!ZLibBuildDecodeTable(
+                    tables.offset, tables.u.l.lengths+litlenSymbols,
+                    tables.sorted, ZLibDeflateOffsetTable, offsetSymbols,
+                    ZLIB_DEFLATE_MAX_OFFSET_LEN, ZLIB_DEFLATE_OFFSET_TABLEBITS))
+                {
+                    // Could not build offset table
+                    return false;
+                }
+
+                // Build litlen table
+                if (!ZLibBuildDecodeTable(
+                    tables.u.litlen, tables.u.l.lengths,
+                    tables.sorted, ZLibDeflateLitlenTable, litlenSymbols,
+                    ZLIB_DEFLATE_MAX_LITLEN_LEN, ZLIB_DEFLATE_LITLEN_TABLEBITS))
+                {
+                    // Could not build litlen table
+                    return false;
+                }
+
+                // Build multi-literal table when enough output remains
+                if ((*outSize - outIndex) >= ZLIB_DEFLATE_MULTI_MINOUT)
+                {
+                    ZLibBuildMultiLiteralTable(tables.multi, tables.u.litlen);
+                }
+                else
+                {
+                    memset(tables.multi, 0, sizeof(tables.multi));
+                }
+
+                // Static decode tables are loaded
+                if (blockType == ZLIB_DEFLATE_BLOCK_STATIC_HUFFMAN)
+                {
+                    staticTablesLoaded = true;
+                }
+            }
+
+            // Decompress Huffman block fast loop
+            bool blockDone = false;
+            while (((inIndex + ZLIB_DEFLATE_FASTLOOP_INPUT) <= endIndex) &&
+                ((outIndex + ZLIB_DEFLATE_FASTLOOP_OUTPUT) <= *outSize))
+            {
+                // Refill 56 bits at least without per byte branches
+                uint64_t word = 0;
+                memcpy(&word, &in[inIndex], 8);
+                current |= (word << bitsLeft);
+                inIndex += ((63 - bitsLeft) >> 3);
+                bitsLeft |= 56;
+
+                // Decode two literals from the multi-literal table
+                uint32_t entry = tables.multi[((uint32_t)current &
+                    ((0x00000001u << ZLIB_DEFLATE_LITLEN_TABLEBITS) - 1))];
+                if (entry)
+                {
+                    out[outIndex++] = (uint8_t)(entry >> 8);
+                    out[outIndex++] = (uint8_t)(entry >> 16);
+                    current >>= (entry & 0xFF);
+                    bitsLeft -= (entry & 0xFF);
+                    continue;
+                }
+
+                // Decode litlen symbol
+                entry = tables.u.litlen[((uint32_t)current &
+                    ((0x00000001u << ZLIB_DEFLATE_LITLEN_TABLEBITS) - 1))];
+                if (entry & 0x80000000)
+                {
+                    // Litlen subtable required
+                    current >>= ZLIB_DEFLATE_LITLEN_TABLEBITS;
+                    bitsLeft -= ZLIB_DEFLATE_LITLEN_TABLEBITS;
+                    entry = tables.u.litlen[
+                        ((entry >> 8) & 0xFFFF) + ((uint32_t)current &
+                        ((0x00000001u << (entry & 0xFF)) - 1))
+                    ];
+                }
+                current >>= (entry & 0xFF);
+                bitsLeft -= (entry & 0xFF);
+                if (entry & 0x40000000)
+                {
+                    // Literal
+                    out[outIndex++] = (uint8_t)(entry >> 8);
+                    continue;
+                }
+                entry >>= 8;
 
-            if (!staticTablesLoaded)
-            {
-                // Build offset table
-                if (!ZLibBuildDecodeTable(
-                    tables.offset, tables.u.l.lengths+litlenSymbols,
-                    tables.sorted, ZLibDeflateOffsetTable, offsetSymbols,
-                    ZLIB_DEFLATE_MAX_OFFSET_LEN, ZLIB_DEFLATE_OFFSET_TABLEBITS))
+                // Compute full length
+                uint32_t len =
+                    ((uint32_t)current & ((0x00000001u << (entry & 0xFF))-1));
+                current >>= (entry & 0xFF);
+                bitsLeft -= (entry & 0xFF);
+                len += (entry >> 8);
+
+                // Block done
+                if (len == 0)
                 {
-                    // Could not build offset table
-                    return false;
+                    blockDone = true;
+                    break;
                 }
 
-                // Build litlen table
-                if (!ZLibBuildDecodeTable(
-                    tables.u.litlen, tables.u.l.lengths,
-                    tables.sorted, ZLibDeflateLitlenTable, litlenSymbols,
-                    ZLIB_DEFLATE_MAX_LITLEN_LEN, ZLIB_DEFLATE_LITLEN_TABLEBITS))
+                // Decode offset symbol
+                entry = tables.offset[((uint32_t)current &
+                    ((0x00000001u << ZLIB_DEFLATE_OFFSET_TABLEBITS) - 1))];
+                if (entry & 0x80000000)
                 {
-                    // Could not build litlen table
-                    return false;
+                    // Offset subtable required
+                    current >>= ZLIB_DEFLATE_OFFSET_TABLEBITS;
+                    bitsLeft -= ZLIB_DEFLATE_OFFSET_TABLEBITS;
+                    entry = tables.offset[
+                        ((entry >> 8) & 0xFFFF) + ((uint32_t)current &
+                        ((0x00000001u << (entry & 0xFF)) - 1))
+                    ];
                 }
+                current >>= (entry & 0xFF);
+                bitsLeft -= (entry & 0xFF);
+                entry >>= 8;
 
-                // Static decode tables are loaded
-                if (blockType == ZLIB_DEFLATE_BLOCK_STATIC_HUFFMAN)
+                // Compute extra offset
+                uint32_t offset =
+                    ((uint32_t)current & ((0x00000001u << (entry>>16))-1));
+                current >>= (entry >> 16);
+                bitsLeft -= (entry >> 16);
+                offset += (entry & 0xFFFF);
+                if (offset > outIndex)
                 {
-                    staticTablesLoaded = true;
+                    // Copy from the preset dictionary
+                    if (!ZLibDeflateCopyDictionary(
+                        out, outIndex, offset, len, dict, dictSize))
+                    {
+                        return false;
+                    }
+                    outIndex += len;
+                    continue;
+                }
+
+                // Copy to output buffer, up to 15 bytes past the match end
+                const uint8_t* src = &out[outIndex-offset];
+                uint8_t* dst = &out[outIndex];
+                const uint8_t* end = &out[outIndex+len];
+                outIndex += len;
+                if (offset >= 16)
+                {
+                    // Non overlapping 16 bytes words
+                    do
+                    {
+                        memcpy(dst, src, 16);
+                        dst += 16;
+                        src += 16;
+                    } while (dst < end);
+                }
+                else if (offset >= 8)
+                {
+                    // Non overlapping 8 bytes words
+                    do
+                    {
+                        memcpy(dst, src, 8);
+                        dst += 8;
+                        src += 8;
+                    } while (dst < end);
+                }
+                else if (offset == 1)
+                {
+                    // Repeated byte
+                    uint64_t pattern = (src[0] * 0x0101010101010101ull);
+                    do
+                    {
+                        memcpy(dst, &pattern, 8);
+                        dst += 8;
+                    } while (dst < end);
+                }
+                else
+                {
+                    // Short overlapping offset
+                    *dst++ = *src++;
+                    *dst++ = *src++;
+                    do
+                    {
+                        *dst++ = *src++;
+                    } while (dst < end);
                 }
             }
 
             // Decompress Huffman block
-            for (;;)
+            while (!blockDone)
             {
                 // Read next 15 bits
                 if (bitsLeft < 15)
@@ -766,7 +2196,17 @@ bool ZLibDeflateDecompress(unsigned char in[], size_t inSize,
                 current >>= (entry >> 16);
                 bitsLeft -= (entry >> 16);
                 offset += (entry & 0xFFFF);
-                if (offset > outIndex) { return false; }
+                if (offset > outIndex)
+                {
+                    // Copy from the preset dictionary
+                    if (!ZLibDeflateCopyDictionary(
+                        out, outIndex, offset, len, dict, dictSize))
+                    {
+                        return false;
+                    }
+                    outIndex += len;
+                    continue;
+                }
 
                 // Copy to output buffer
                 const uint8_t* src = &out[outIndex-offset];
@@ -784,13 +2224,218 @@ bool ZLibDeflateDecompress(unsigned char in[], size_t inSize,
 
     // Align input
     inIndex -= ((bitsLeft >> 3) - overrun);
+    if (inRead) { *inRead = inIndex; }
 
-    // Read Adler32 CRC
+    // Set output data size
+    if (outIndex > *outSize)
+    {
+        // Invalid output data size
+        return false;
+    }
+    *outSize = outIndex;
+
+    // Data is successfully inflated
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read ZLib stream header                                                   //
+//  return : True if the ZLib header is valid                                 //
+////////////////////////////////////////////////////////////////////////////////
+inline bool ZLibDeflateReadHeader(const unsigned char in[], size_t inSize,
+    size_t& inIndex, bool& presetDictionary, uint32_t& dictAdler32)
+{
+    // Check ZLib header
+    uint16_t zlibHeader = (in[inIndex++] << 8);
+    zlibHeader |= in[inIndex++];
+    // FCHECK
+    if ((zlibHeader % 31) != 0) return false;
+    // CM
+    if (((zlibHeader >> 8) & 0x000F) != 0x0008) return false;
+    // CINFO
+    if ((zlibHeader >> 12) > 0x0007) return false;
+    // FDICT
+    presetDictionary = ((zlibHeader >> 5) & 0x0001);
+    dictAdler32 = 0;
+    if (presetDictionary)
+    {
+        // Read preset dictionary Adler32
+        if ((inIndex + 8) > inSize) return false;
+        dictAdler32 = (in[inIndex++] << 24);
+        dictAdler32 |= (in[inIndex++] << 16);
+        dictAdler32 |= (in[inIndex++] << 8);
+        dictAdler32 |= in[inIndex++];
+    }
+
+    // ZLib header is valid
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read ZLib stream Adler32 trailer                                          //
+//  return : True if the Adler32 trailer is successfully read                 //
+////////////////////////////////////////////////////////////////////////////////
+inline bool ZLibDeflateReadAdler32(const unsigned char in[], size_t inSize,
+    size_t& inIndex, uint32_t& zlibAdler32)
+{
     if ((inIndex + 4) > inSize) { return false; }
-    uint32_t zlibAdler32 = (in[inIndex++] << 24);
+    zlibAdler32 = (in[inIndex++] << 24);
     zlibAdler32 |= (in[inIndex++] << 16);
     zlibAdler32 |= (in[inIndex++] << 8);
     zlibAdler32 |= in[inIndex++];
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decompress ZLib deflate data                                              //
+//  return : True if the data is successfully decompressed                    //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateDecompress(unsigned char in[], size_t inSize,
+    unsigned char out[], size_t* outSize)
+{
+    return ZLibDeflateDecompressDictionary(in, inSize, 0, 0, out, outSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decompress ZLib deflate data into a buffer of exact final size            //
+//  return : True if the stream decompresses to exactly outSize bytes         //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateDecompressExact(ZLibDeflateContext& context,
+    const unsigned char in[], size_t inSize, size_t* inRead,
+    unsigned char out[], size_t outSize, size_t* outWritten,
+    bool checkAdler32)
+{
+    size_t inIndex = 0;
+    if (inRead) { *inRead = 0; }
+    if (outWritten) { *outWritten = 0; }
+
+    // Check data buffers
+    if (!in || !out || (inSize < 6) || (outSize <= 0))
+    {
+        // Invalid data buffers
+        return false;
+    }
+
+    // Check ZLib header
+    bool presetDictionary = false;
+    uint32_t dictAdler32 = 0;
+    if (!ZLibDeflateReadHeader(
+        in, inSize, inIndex, presetDictionary, dictAdler32))
+    {
+        // Invalid ZLib header
+        return false;
+    }
+    if (presetDictionary)
+    {
+        // Preset dictionary is not supported
+        return false;
+    }
+    if ((inIndex + 4) > inSize) { return false; }
+
+    // Inflate deflate data
+    size_t inflateRead = 0;
+    size_t produced = outSize;
+    if (!ZLibDeflateInflate(context, &in[inIndex], (inSize - inIndex - 4),
+        &inflateRead, out, &produced, 0, 0))
+    {
+        // Could not inflate deflate data
+        return false;
+    }
+    inIndex += inflateRead;
+
+    // Read Adler32 CRC
+    uint32_t zlibAdler32 = 0;
+    if (!ZLibDeflateReadAdler32(in, inSize, inIndex, zlibAdler32))
+    {
+        // Truncated Adler32 CRC
+        return false;
+    }
+
+    // Report exact consumed and produced sizes
+    if (inRead) { *inRead = inIndex; }
+    if (outWritten) { *outWritten = produced; }
+
+    // Check output size
+    if (produced != outSize)
+    {
+        // Stream is shorter than the expected output size
+        return false;
+    }
+
+    // Check Adler32 CRC
+    if (checkAdler32 && (zlibAdler32 != SysAdler32(out, produced)))
+    {
+        // Invalid Adler32 CRC
+        return false;
+    }
+
+    // Data is successfully decompressed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decompress ZLib deflate data with a preset dictionary                     //
+//  return : True if the data is successfully decompressed                    //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateDecompressDictionary(unsigned char in[], size_t inSize,
+    const unsigned char dict[], size_t dictSize,
+    unsigned char out[], size_t* outSize)
+{
+    size_t inIndex = 0;
+
+    // Check data buffers
+    if (!in || !out || (inSize < 6) || (*outSize <= 0))
+    {
+        // Invalid data buffers
+        return false;
+    }
+
+    // Check ZLib header
+    bool presetDictionary = false;
+    uint32_t dictAdler32 = 0;
+    if (!ZLibDeflateReadHeader(
+        in, inSize, inIndex, presetDictionary, dictAdler32))
+    {
+        // Invalid ZLib header
+        return false;
+    }
+    if (presetDictionary)
+    {
+        // Check preset dictionary
+        if (!dict) return false;
+        if (dictAdler32 != SysAdler32((unsigned char*)dict, dictSize))
+        {
+            // Invalid preset dictionary
+            return false;
+        }
+    }
+    else
+    {
+        // No preset dictionary
+        dict = 0;
+        dictSize = 0;
+    }
+    if ((inIndex + 4) > inSize) { return false; }
+
+    // Inflate deflate data
+    ZLibDeflateContext context;
+    ZLibInitDecodeContext(context);
+    size_t inRead = 0;
+    if (!ZLibDeflateInflate(context, &in[inIndex], (inSize - inIndex - 4),
+        &inRead, out, outSize, dict, dictSize))
+    {
+        // Could not inflate deflate data
+        return false;
+    }
+    inIndex += inRead;
+
+    // Read Adler32 CRC
+    uint32_t zlibAdler32 = 0;
+    if (!ZLibDeflateReadAdler32(in, inSize, inIndex, zlibAdler32))
+    {
+        // Truncated Adler32 CRC
+        return false;
+    }
 
     // Check Adler32 CRC
     if (zlibAdler32 != SysAdler32(out, *outSize))
@@ -799,13 +2444,112 @@ bool ZLibDeflateDecompress(unsigned char in[], size_t inSize,
         return false;
     }
 
-    // Set output data size
-    if (outIndex > *outSize)
+    // Data is successfully decompressed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decompress raw deflate data                                               //
+//  return : True if the data is successfully decompressed                    //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibDeflateDecompressRaw(unsigned char in[], size_t inSize,
+    unsigned char out[], size_t* outSize,
+    const unsigned char dict[], size_t dictSize)
+{
+    // Check data buffers
+    if (!in || !out || (inSize <= 0) || (*outSize <= 0))
     {
-        // Invalid output data size
+        // Invalid data buffers
+        return false;
+    }
+
+    // Inflate deflate data
+    if (!dict) { dictSize = 0; }
+    ZLibDeflateContext context;
+    ZLibInitDecodeContext(context);
+    return ZLibDeflateInflate(
+        context, in, inSize, 0, out, outSize, dict, dictSize
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decompress GZip data                                                      //
+//  return : True if the data is successfully decompressed                    //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibGZipDecompress(unsigned char in[], size_t inSize,
+    unsigned char out[], size_t* outSize)
+{
+    size_t inIndex = 0;
+
+    // Check data buffers
+    if (!in || !out || (*outSize <= 0) ||
+        (inSize < (ZLIB_GZIP_HEADER_SIZE + ZLIB_GZIP_TRAILER_SIZE)))
+    {
+        // Invalid data buffers
+        return false;
+    }
+
+    // Check GZip header
+    if ((in[0] != ZLIB_GZIP_ID1) || (in[1] != ZLIB_GZIP_ID2)) return false;
+    if (in[2] != 0x08) return false;
+    uint8_t flags = in[3];
+    if (flags & 0xE0) return false;
+    inIndex = ZLIB_GZIP_HEADER_SIZE;
+
+    // Skip optional header fields
+    if (flags & ZLIB_GZIP_FLAG_EXTRA)
+    {
+        if ((inIndex + 2) > inSize) return false;
+        size_t extraSize = (in[inIndex] | (in[inIndex+1] << 8));
+        inIndex += (2 + extraSize);
+    }
+    if (flags & ZLIB_GZIP_FLAG_NAME)
+    {
+        while ((inIndex < inSize) && (in[inIndex] != 0)) { ++inIndex; }
+        ++inIndex;
+    }
+    if (flags & ZLIB_GZIP_FLAG_COMMENT)
+    {
+        while ((inIndex < inSize) && (in[inIndex] != 0)) { ++inIndex; }
+        ++inIndex;
+    }
+    if (flags & ZLIB_GZIP_FLAG_HCRC)
+    {
+        inIndex += 2;
+    }
+    if ((inIndex + ZLIB_GZIP_TRAILER_SIZE) > inSize) return false;
+
+    // Inflate deflate data
+    ZLibDeflateContext context;
+    ZLibInitDecodeContext(context);
+    size_t inRead = 0;
+    if (!ZLibDeflateInflate(context, &in[inIndex],
+        (inSize - inIndex - ZLIB_GZIP_TRAILER_SIZE),
+        &inRead, out, outSize, 0, 0))
+    {
+        // Could not inflate deflate data
+        return false;
+    }
+    inIndex += inRead;
+
+    // Read CRC32 and input size (little endian)
+    if ((inIndex + ZLIB_GZIP_TRAILER_SIZE) > inSize) { return false; }
+    uint32_t gzipCRC32 = in[inIndex++];
+    gzipCRC32 |= (in[inIndex++] << 8);
+    gzipCRC32 |= (in[inIndex++] << 16);
+    gzipCRC32 |= ((uint32_t)in[inIndex++] << 24);
+    uint32_t gzipSize = in[inIndex++];
+    gzipSize |= (in[inIndex++] << 8);
+    gzipSize |= (in[inIndex++] << 16);
+    gzipSize |= ((uint32_t)in[inIndex++] << 24);
+
+    // Check CRC32 and input size
+    if ((gzipSize != (uint32_t)(*outSize & 0xFFFFFFFF)) ||
+        (gzipCRC32 != SysCRC32(out, *outSize)))
+    {
+        // Invalid CRC32
         return false;
     }
-    *outSize = outIndex;
 
     // Data is successfully decompressed
     return true;
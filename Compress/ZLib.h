@@ -49,6 +49,9 @@
     #include <cstddef>
     #include <cstdint>
     #include <cstring>
+    #include <new>
+    #include <thread>
+    #include <atomic>
 
 
     ////////////////////////////////////////////////////////////////////////////
@@ -69,6 +72,44 @@
     #define ZLIB_DEFLATE_PRECODE_TABLEBITS 7
     #define ZLIB_DEFLATE_OFFSET_TABLEBITS 8
     #define ZLIB_DEFLATE_LITLEN_TABLEBITS 10
+    #define ZLIB_DEFLATE_MULTI_SIZE 1024
+    #define ZLIB_DEFLATE_MULTI_MINOUT 32768
+    #define ZLIB_DEFLATE_FASTLOOP_INPUT 8
+    #define ZLIB_DEFLATE_FASTLOOP_OUTPUT (258+16)
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib LZ77 deflate constants                                           //
+    ////////////////////////////////////////////////////////////////////////////
+    #define ZLIB_DEFLATE_WINDOW_SIZE 32768
+    #define ZLIB_DEFLATE_WINDOW_MASK 32767
+    #define ZLIB_DEFLATE_HASH_BITS 15
+    #define ZLIB_DEFLATE_HASH_SIZE 32768
+    #define ZLIB_DEFLATE_HASH_NIL 0xFFFFFFFFu
+    #define ZLIB_DEFLATE_MIN_MATCH 3
+    #define ZLIB_DEFLATE_MAX_MATCH 258
+    #define ZLIB_DEFLATE_MAX_STORED 65535
+    #define ZLIB_DEFLATE_BLOCK_SYMBOLS 16384
+    #define ZLIB_DEFLATE_PRECODE_ITEMS 320
+    #define ZLIB_DEFLATE_END_OF_BLOCK 256
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib GZip container constants                                         //
+    ////////////////////////////////////////////////////////////////////////////
+    #define ZLIB_GZIP_HEADER_SIZE 10
+    #define ZLIB_GZIP_TRAILER_SIZE 8
+    #define ZLIB_GZIP_ID1 0x1F
+    #define ZLIB_GZIP_ID2 0x8B
+    #define ZLIB_GZIP_OS_UNKNOWN 0xFF
+    #define ZLIB_GZIP_FLAG_HCRC 0x02
+    #define ZLIB_GZIP_FLAG_EXTRA 0x04
+    #define ZLIB_GZIP_FLAG_NAME 0x08
+    #define ZLIB_GZIP_FLAG_COMMENT 0x10
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib parallel deflate constants                                       //
+    ////////////////////////////////////////////////////////////////////////////
+    #define ZLIB_DEFLATE_SEGMENT_SIZE 524288
+    #define ZLIB_DEFLATE_MAX_THREADS 4
 
     ////////////////////////////////////////////////////////////////////////////
     //  ZLib deflate compression level hint enumeration                       //
@@ -81,6 +122,20 @@
         ZLIB_DEFLATE_SLOWEST_COMPRESSION = 3
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib deflate compression level enumeration                            //
+    ////////////////////////////////////////////////////////////////////////////
+    enum ZLibDeflateLevel
+    {
+        ZLIB_DEFLATE_LEVEL_STORE = 0,
+        ZLIB_DEFLATE_LEVEL_FASTEST = 1,
+        ZLIB_DEFLATE_LEVEL_FAST = 2,
+        ZLIB_DEFLATE_LEVEL_DEFAULT = 3,
+        ZLIB_DEFLATE_LEVEL_SMALLEST = 4,
+
+        ZLIB_DEFLATE_LEVEL_COUNT = 5
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     //  ZLib deflate block types enumeration                                  //
     ////////////////////////////////////////////////////////////////////////////
@@ -207,6 +262,75 @@
         0x00E30500u, 0x01020000u, 0x01020000u, 0x01020000u
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib deflate compression level settings structure                     //
+    ////////////////////////////////////////////////////////////////////////////
+    struct ZLibDeflateLevelSettings
+    {
+        uint32_t                    chainLength;    // Max hash chain length
+        uint32_t                    niceLength;     // Stop search length
+        uint32_t                    goodLength;     // Reduce search length
+        uint32_t                    lazyLength;     // Lazy match (0 : greedy)
+        ZLibCompressionLevelHint    hint;           // ZLib header level hint
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib deflate compression levels settings                              //
+    ////////////////////////////////////////////////////////////////////////////
+    const ZLibDeflateLevelSettings ZLibDeflateLevels[ZLIB_DEFLATE_LEVEL_COUNT] =
+    {
+        { 0, 0, 0, 0, ZLIB_DEFLATE_FASTEST_COMPRESSION },
+        { 4, 16, 4, 0, ZLIB_DEFLATE_FASTEST_COMPRESSION },
+        { 32, 64, 8, 0, ZLIB_DEFLATE_FAST_COMPRESSION },
+        { 128, 128, 8, 16, ZLIB_DEFLATE_DEFAULT_COMPRESSION },
+        { 4096, 258, 32, 258, ZLIB_DEFLATE_SLOWEST_COMPRESSION }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib deflate encoder                                                  //
+    ////////////////////////////////////////////////////////////////////////////
+    struct ZLibDeflateEncoder
+    {
+        uint32_t head[ZLIB_DEFLATE_HASH_SIZE];
+        uint32_t prev[ZLIB_DEFLATE_WINDOW_SIZE];
+        uint16_t litlens[ZLIB_DEFLATE_BLOCK_SYMBOLS];
+        uint16_t offsets[ZLIB_DEFLATE_BLOCK_SYMBOLS];
+        uint32_t litlenFreqs[ZLIB_DEFLATE_LITLEN_SYMBOLS];
+        uint32_t offsetFreqs[ZLIB_DEFLATE_OFFSET_SYMBOLS];
+        uint8_t litlenLengths[ZLIB_DEFLATE_LITLEN_SYMBOLS];
+        uint8_t offsetLengths[ZLIB_DEFLATE_OFFSET_SYMBOLS];
+        uint16_t litlenCodes[ZLIB_DEFLATE_LITLEN_SYMBOLS];
+        uint16_t offsetCodes[ZLIB_DEFLATE_OFFSET_SYMBOLS];
+        uint8_t staticLitlenLengths[ZLIB_DEFLATE_LITLEN_SYMBOLS];
+        uint8_t staticOffsetLengths[ZLIB_DEFLATE_OFFSET_SYMBOLS];
+        uint16_t staticLitlenCodes[ZLIB_DEFLATE_LITLEN_SYMBOLS];
+        uint16_t staticOffsetCodes[ZLIB_DEFLATE_OFFSET_SYMBOLS];
+        uint8_t lengthSymbols[ZLIB_DEFLATE_MAX_MATCH+1];
+        uint8_t offsetSymbols[512];
+        uint16_t precodeItems[ZLIB_DEFLATE_PRECODE_ITEMS];
+        uint32_t symbolsCount;
+        unsigned char* out;
+        size_t outIndex;
+        size_t outSize;
+        uint64_t bits;
+        uint32_t bitsCount;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib deflate parallel segment                                         //
+    ////////////////////////////////////////////////////////////////////////////
+    struct ZLibDeflateSegment
+    {
+        const unsigned char* in;
+        size_t start;
+        size_t end;
+        unsigned char* out;
+        size_t outSize;
+        uint32_t adler32;
+        bool finalBlock;
+        bool compressed;
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     //  ZLib deflate decode tables                                            //
     ////////////////////////////////////////////////////////////////////////////
@@ -223,9 +347,20 @@
             uint32_t litlen[ZLIB_DEFLATE_LITLEN_SIZE];
         } u;
         uint32_t offset[ZLIB_DEFLATE_OFFSET_SIZE];
+        uint32_t multi[ZLIB_DEFLATE_MULTI_SIZE];
         uint16_t sorted[ZLIB_DEFLATE_MAX_SYMBOLS];
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLib deflate decode context                                           //
+    //  Caller owned decode tables, reused across inflate calls               //
+    ////////////////////////////////////////////////////////////////////////////
+    struct ZLibDeflateContext
+    {
+        ZLibDeflateDecodeTables tables;
+        bool staticTablesLoaded;
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     //  Compute compressed ZLib deflate data size                             //
     //  return : Computed compressed ZLib deflate data size                   //
@@ -237,7 +372,99 @@
     //  return : True if the data is successfully compressed                  //
     ////////////////////////////////////////////////////////////////////////////
     bool ZLibDeflateCompress(unsigned char in[], size_t inSize,
-        unsigned char out[], size_t* outSize);
+        unsigned char out[], size_t* outSize,
+        ZLibDeflateLevel level = ZLIB_DEFLATE_LEVEL_DEFAULT);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compress ZLib deflate data with a preset dictionary                   //
+    //  return : True if the data is successfully compressed                  //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateCompressDictionary(unsigned char in[], size_t inSize,
+        const unsigned char dict[], size_t dictSize,
+        unsigned char out[], size_t* outSize,
+        ZLibDeflateLevel level = ZLIB_DEFLATE_LEVEL_DEFAULT);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compress raw deflate data                                             //
+    //  return : True if the data is successfully compressed                  //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateCompressRaw(unsigned char in[], size_t inSize,
+        unsigned char out[], size_t* outSize,
+        ZLibDeflateLevel level = ZLIB_DEFLATE_LEVEL_DEFAULT,
+        const unsigned char dict[] = 0, size_t dictSize = 0);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compress GZip data                                                    //
+    //  return : True if the data is successfully compressed                  //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibGZipCompress(unsigned char in[], size_t inSize,
+        unsigned char out[], size_t* outSize,
+        ZLibDeflateLevel level = ZLIB_DEFLATE_LEVEL_DEFAULT);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compress ZLib deflate data with parallel segments                     //
+    //  Each segment uses the previous 32KiB of input as its dictionary       //
+    //  and ends on a sync flush boundary, the output is one ZLib stream      //
+    //  return : True if the data is successfully compressed                  //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateCompressParallel(unsigned char in[], size_t inSize,
+        unsigned char out[], size_t* outSize,
+        ZLibDeflateLevel level = ZLIB_DEFLATE_LEVEL_DEFAULT,
+        uint32_t threadsCount = 0);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compress ZLib deflate parallel segment                                //
+    //  return : True if the segment is successfully compressed               //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateCompressSegment(ZLibDeflateEncoder& encoder,
+        ZLibDeflateSegment& segment, ZLibDeflateLevel level);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Init ZLib deflate encoder                                             //
+    ////////////////////////////////////////////////////////////////////////////
+    void ZLibInitEncoder(ZLibDeflateEncoder& encoder,
+        unsigned char out[], size_t outSize);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Encode raw deflate blocks with LZ77 and Huffman coding                //
+    //  Input bytes before start are only used as dictionary                  //
+    //  return : True if the data is successfully encoded                     //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateEncode(ZLibDeflateEncoder& encoder,
+        const unsigned char in[], size_t start, size_t inSize,
+        ZLibDeflateLevel level, bool finalBlock);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Flush ZLib deflate encoder block                                      //
+    //  return : True if the block is successfully written                    //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateFlushBlock(ZLibDeflateEncoder& encoder,
+        const unsigned char in[], size_t inSize, bool finalBlock);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Write ZLib deflate uncompressed blocks                                //
+    //  return : True if the blocks are successfully written                  //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateWriteStored(ZLibDeflateEncoder& encoder,
+        const unsigned char in[], size_t inSize, bool finalBlock);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Flush ZLib deflate encoder bits to the next byte boundary             //
+    //  return : True if the bits are successfully flushed                    //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateAlignBits(ZLibDeflateEncoder& encoder);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Build length limited Huffman codeword lengths                         //
+    ////////////////////////////////////////////////////////////////////////////
+    void ZLibBuildHuffmanLengths(const uint32_t freqs[], uint8_t lengths[],
+        const uint32_t symbolsCount, const uint32_t codewordLen);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Build canonical Huffman codewords (bit reversed)                      //
+    ////////////////////////////////////////////////////////////////////////////
+    void ZLibBuildHuffmanCodes(const uint8_t lengths[], uint16_t codes[],
+        const uint32_t symbolsCount);
 
     ////////////////////////////////////////////////////////////////////////////
     //  Build ZLib Huffman decode table                                       //
@@ -248,6 +475,27 @@
         const uint32_t symbolsCount, const uint32_t codewordLen,
         const uint32_t tableBits);
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  Build ZLib multi-literal decode table                                 //
+    //  Entries decode two consecutive literals within the litlen table bits  //
+    ////////////////////////////////////////////////////////////////////////////
+    void ZLibBuildMultiLiteralTable(uint32_t multiTable[],
+        const uint32_t litlenTable[]);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Init ZLib deflate decode context                                      //
+    ////////////////////////////////////////////////////////////////////////////
+    void ZLibInitDecodeContext(ZLibDeflateContext& context);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Inflate raw deflate data                                              //
+    //  return : True if the data is successfully inflated                    //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateInflate(ZLibDeflateContext& context,
+        const unsigned char in[], size_t inSize, size_t* inRead,
+        unsigned char out[], size_t* outSize,
+        const unsigned char dict[], size_t dictSize);
+
     ////////////////////////////////////////////////////////////////////////////
     //  Decompress ZLib deflate data                                          //
     //  return : True if the data is successfully decompressed                //
@@ -255,5 +503,40 @@
     bool ZLibDeflateDecompress(unsigned char in[], size_t inSize,
         unsigned char out[], size_t* outSize);
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decompress ZLib deflate data into a buffer of exact final size        //
+    //  Uses the caller decode context and never allocates memory,            //
+    //  inRead and outWritten receive the exact bytes consumed and produced   //
+    //  checkAdler32 can be disabled for pre-validated trusted data           //
+    //  return : True if the stream decompresses to exactly outSize bytes     //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateDecompressExact(ZLibDeflateContext& context,
+        const unsigned char in[], size_t inSize, size_t* inRead,
+        unsigned char out[], size_t outSize, size_t* outWritten,
+        bool checkAdler32 = true);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decompress ZLib deflate data with a preset dictionary                 //
+    //  return : True if the data is successfully decompressed                //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateDecompressDictionary(unsigned char in[], size_t inSize,
+        const unsigned char dict[], size_t dictSize,
+        unsigned char out[], size_t* outSize);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decompress raw deflate data                                           //
+    //  return : True if the data is successfully decompressed                //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibDeflateDecompressRaw(unsigned char in[], size_t inSize,
+        unsigned char out[], size_t* outSize,
+        const unsigned char dict[] = 0, size_t dictSize = 0);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decompress GZip data                                                  //
+    //  return : True if the data is successfully decompressed                //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ZLibGZipDecompress(unsigned char in[], size_t inSize,
+        unsigned char out[], size_t* outSize);
+
 
 #endif // WOS_COMPRESS_ZLIB_HEADER
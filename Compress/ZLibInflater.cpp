@@ -0,0 +1,682 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Compress/ZLibInflater.cpp : ZLib streaming inflate management          //
+////////////////////////////////////////////////////////////////////////////////
+#include "ZLibInflater.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  ZLibInflater default constructor                                          //
+////////////////////////////////////////////////////////////////////////////////
+ZLibInflater::ZLibInflater() :
+m_state(ZLIBINFLATER_STATE_ERROR),
+m_window(0),
+m_written(0),
+m_drained(0),
+m_bits(0),
+m_bitsCount(0),
+m_finalBlock(false),
+m_staticTables(false),
+m_blockType(0),
+m_litlenCount(0),
+m_offsetCount(0),
+m_precodeCount(0),
+m_index(0),
+m_storedSize(0),
+m_length(0),
+m_offset(0),
+m_extra(0),
+m_adler32(SysAdler32Default),
+m_checksum(0),
+m_checkAdler32(true)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  ZLibInflater destructor                                                   //
+////////////////////////////////////////////////////////////////////////////////
+ZLibInflater::~ZLibInflater()
+{
+    destroyInflater();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Init ZLib inflater for a new stream                                       //
+//  return : True if the inflater is ready                                    //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibInflater::init(bool checkAdler32)
+{
+    // Allocate output ring window
+    if (!m_window)
+    {
+        m_window = new (std::nothrow) unsigned char[ZLibInflaterWindowSize];
+        if (!m_window)
+        {
+            // Could not allocate output ring window
+            m_state = ZLIBINFLATER_STATE_ERROR;
+            return false;
+        }
+    }
+
+    // Reset inflater state
+    m_state = ZLIBINFLATER_STATE_HEADER;
+    m_written = 0;
+    m_drained = 0;
+    m_bits = 0;
+    m_bitsCount = 0;
+    m_finalBlock = false;
+    m_staticTables = false;
+    m_blockType = 0;
+    m_litlenCount = 0;
+    m_offsetCount = 0;
+    m_precodeCount = 0;
+    m_index = 0;
+    m_storedSize = 0;
+    m_length = 0;
+    m_offset = 0;
+    m_extra = 0;
+    m_adler32 = SysAdler32Default;
+    m_checksum = 0;
+    m_checkAdler32 = checkAdler32;
+
+    // Inflater is ready
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Feed compressed input chunk to the inflater                               //
+//  Decoding stops when the input is exhausted, when the window               //
+//  is full of undrained output, or at the end of the stream                  //
+//  return : False if the stream is invalid                                   //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibInflater::feed(const unsigned char* in, size_t inSize,
+    size_t* inRead)
+{
+    size_t inIndex = 0;
+    if (inRead) { *inRead = 0; }
+
+    // Check inflater state
+    if (!m_window || (m_state == ZLIBINFLATER_STATE_ERROR))
+    {
+        // Invalid inflater state
+        return false;
+    }
+    if (!in) { inSize = 0; }
+
+    // Decode input chunk
+    if (!decode(in, inSize, inIndex))
+    {
+        // Invalid stream
+        m_state = ZLIBINFLATER_STATE_ERROR;
+        if (inRead) { *inRead = inIndex; }
+        return false;
+    }
+
+    // Input chunk is successfully processed
+    if (inRead) { *inRead = inIndex; }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Drain decompressed output from the inflater                               //
+//  return : Number of bytes copied into the output buffer                    //
+////////////////////////////////////////////////////////////////////////////////
+size_t ZLibInflater::drain(unsigned char* out, size_t outSize)
+{
+    size_t drained = 0;
+    if (!m_window || !out) { return 0; }
+
+    // Copy pending output, up to two parts when the ring wraps
+    while ((drained < outSize) && (m_drained < m_written))
+    {
+        size_t start = (m_drained & ZLibInflaterWindowMask);
+        size_t size = (m_written - m_drained);
+        if (size > (ZLibInflaterWindowSize - start))
+        {
+            size = (ZLibInflaterWindowSize - start);
+        }
+        if (size > (outSize - drained))
+        {
+            size = (outSize - drained);
+        }
+
+        // Update Adler32 CRC with drained bytes
+        memcpy(&out[drained], &m_window[start], size);
+        if (m_checkAdler32)
+        {
+            m_adler32 = SysUpdateAdler32(m_adler32, &m_window[start], size);
+        }
+        m_drained += size;
+        drained += size;
+    }
+
+    return drained;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Finish ZLib inflater stream                                               //
+//  return : True if the stream is complete, fully drained and                //
+//           its Adler32 CRC is valid                                         //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibInflater::finish()
+{
+    // Check end of stream
+    if ((m_state != ZLIBINFLATER_STATE_DONE) || (m_drained != m_written))
+    {
+        // Stream is not complete
+        return false;
+    }
+
+    // Check Adler32 CRC
+    if (m_checkAdler32 && (m_adler32 != m_checksum))
+    {
+        // Invalid Adler32 CRC
+        m_state = ZLIBINFLATER_STATE_ERROR;
+        return false;
+    }
+
+    // Stream is successfully decompressed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Destroy ZLib inflater                                                     //
+////////////////////////////////////////////////////////////////////////////////
+void ZLibInflater::destroyInflater()
+{
+    if (m_window) { delete[] m_window; }
+    m_window = 0;
+    m_state = ZLIBINFLATER_STATE_ERROR;
+    m_written = 0;
+    m_drained = 0;
+    m_bits = 0;
+    m_bitsCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Peek Huffman decode table entry without consuming bits                    //
+//  return : True if a complete codeword is available                         //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibInflater::peekSymbol(const unsigned char* in, size_t inSize,
+    size_t& inIndex, const uint32_t table[], uint32_t tableBits,
+    uint32_t& entry, uint32_t& length)
+{
+    // Pull bits up to the maximum codeword length when available
+    pullBits(in, inSize, inIndex, ZLIB_DEFLATE_MAX_CODEWORD_LEN);
+
+    // Lookup decode table, missing bits are read as zeros
+    entry = table[((uint32_t)m_bits & ((0x00000001u << tableBits) - 1))];
+    if (entry & 0x80000000)
+    {
+        // Subtable required
+        entry = table[((entry >> 8) & 0xFFFF) +
+            ((uint32_t)(m_bits >> tableBits) &
+            ((0x00000001u << (entry & 0xFF)) - 1))
+        ];
+        length = (tableBits + (entry & 0xFF));
+    }
+    else
+    {
+        length = (entry & 0xFF);
+    }
+
+    // Check that the whole codeword was available
+    return (length <= m_bitsCount);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Build ZLib inflater Huffman decode tables                                 //
+//  return : True if the decode tables are successfully built                 //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibInflater::buildTables()
+{
+    // Build offset table
+    if (!ZLibBuildDecodeTable(
+        m_tables.offset, m_tables.u.l.lengths+m_litlenCount,
+        m_tables.sorted, ZLibDeflateOffsetTable, m_offsetCount,
+        ZLIB_DEFLATE_MAX_OFFSET_LEN, ZLIB_DEFLATE_OFFSET_TABLEBITS))
+    {
+        // Could not build offset table
+        return false;
+    }
+
+    // Build litlen table
+    if (!ZLibBuildDecodeTable(
+        m_tables.u.litlen, m_tables.u.l.lengths,
+        m_tables.sorted, ZLibDeflateLitlenTable, m_litlenCount,
+        ZLIB_DEFLATE_MAX_LITLEN_LEN, ZLIB_DEFLATE_LITLEN_TABLEBITS))
+    {
+        // Could not build litlen table
+        return false;
+    }
+
+    // Decode tables are successfully built
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode input into the inflater window                                     //
+//  return : False if the stream is invalid                                   //
+////////////////////////////////////////////////////////////////////////////////
+bool ZLibInflater::decode(const unsigned char* in, size_t inSize,
+    size_t& inIndex)
+{
+    uint32_t entry = 0;
+    uint32_t length = 0;
+
+    for (;;)
+    {
+        switch (m_state)
+        {
+            case ZLIBINFLATER_STATE_HEADER:
+            {
+                // Read ZLib header
+                if (!pullBits(in, inSize, inIndex, 16)) { return true; }
+                uint16_t zlibHeader = (uint16_t)(
+                    ((m_bits & 0xFF) << 8) | ((m_bits >> 8) & 0xFF)
+                );
+                dropBits(16);
+
+                // FCHECK
+                if ((zlibHeader % 31) != 0) return false;
+                // CM
+                if (((zlibHeader >> 8) & 0x000F) != 0x0008) return false;
+                // CINFO
+                if ((zlibHeader >> 12) > 0x0007) return false;
+                // FDICT
+                if ((zlibHeader >> 5) & 0x0001) return false;
+
+                m_state = ZLIBINFLATER_STATE_BLOCKHEADER;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_BLOCKHEADER:
+            {
+                // Read final block state and block type
+                if (!pullBits(in, inSize, inIndex, 3)) { return true; }
+                m_finalBlock = (m_bits & 0x01);
+                m_blockType = ((m_bits >> 1) & 0x03);
+                dropBits(3);
+
+                if (m_blockType == ZLIB_DEFLATE_BLOCK_UNCOMPRESSED)
+                {
+                    // Align input
+                    dropBits(m_bitsCount & 0x07);
+                    m_state = ZLIBINFLATER_STATE_STOREDSIZE;
+                }
+                else if (m_blockType == ZLIB_DEFLATE_BLOCK_STATIC_HUFFMAN)
+                {
+                    if (!m_staticTables)
+                    {
+                        // Build static tables
+                        uint32_t i = 0;
+                        for (i = 0; i < 144; ++i)
+                        {
+                            m_tables.u.l.lengths[i] = 8;
+                        }
+                        for (; i < 256; ++i)
+                        {
+                            m_tables.u.l.lengths[i] = 9;
+                        }
+                        for (; i < 280; ++i)
+                        {
+                            m_tables.u.l.lengths[i] = 7;
+                        }
+                        for (; i < 288; ++i)
+                        {
+                            m_tables.u.l.lengths[i] = 8;
+                        }
+                        for (; i < 320; ++i)
+                        {
+                            m_tables.u.l.lengths[i] = 5;
+                        }
+                        m_litlenCount = ZLIB_DEFLATE_LITLEN_SYMBOLS;
+                        m_offsetCount = ZLIB_DEFLATE_OFFSET_SYMBOLS;
+                        if (!buildTables()) { return false; }
+                        m_staticTables = true;
+                    }
+                    m_state = ZLIBINFLATER_STATE_LITLEN;
+                }
+                else if (m_blockType == ZLIB_DEFLATE_BLOCK_DYNAMIC_HUFFMAN)
+                {
+                    m_state = ZLIBINFLATER_STATE_TABLECOUNTS;
+                }
+                else
+                {
+                    // Invalid block type
+                    return false;
+                }
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_STOREDSIZE:
+            {
+                // Read block size
+                if (!pullBits(in, inSize, inIndex, 32)) { return true; }
+                uint16_t blockSize = (uint16_t)(m_bits & 0xFFFF);
+                uint16_t nBlockSize = (uint16_t)((m_bits >> 16) & 0xFFFF);
+                dropBits(32);
+
+                // Check block size
+                if (blockSize != ((uint16_t)~nBlockSize)) return false;
+                m_storedSize = blockSize;
+                m_state = ZLIBINFLATER_STATE_STOREDCOPY;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_STOREDCOPY:
+            {
+                // Copy uncompressed block
+                while (m_storedSize > 0)
+                {
+                    size_t available = (ZLibInflaterWindowSize -
+                        (m_written - m_drained));
+                    if (available == 0) { return true; }
+
+                    if (m_bitsCount >= 8)
+                    {
+                        // Bytes already pulled into the bits buffer
+                        m_window[m_written & ZLibInflaterWindowMask] =
+                            (unsigned char)(m_bits & 0xFF);
+                        dropBits(8);
+                        ++m_written;
+                        --m_storedSize;
+                        continue;
+                    }
+                    if (inIndex >= inSize) { return true; }
+
+                    // Copy contiguous input bytes into the window
+                    size_t start = (m_written & ZLibInflaterWindowMask);
+                    size_t size = m_storedSize;
+                    if (size > (inSize - inIndex)) { size = (inSize-inIndex); }
+                    if (size > available) { size = available; }
+                    if (size > (ZLibInflaterWindowSize - start))
+                    {
+                        size = (ZLibInflaterWindowSize - start);
+                    }
+                    memcpy(&m_window[start], &in[inIndex], size);
+                    inIndex += size;
+                    m_written += size;
+                    m_storedSize -= (uint32_t)size;
+                }
+
+                m_state = m_finalBlock ?
+                    ZLIBINFLATER_STATE_CHECKSUM :
+                    ZLIBINFLATER_STATE_BLOCKHEADER;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_TABLECOUNTS:
+            {
+                // Read codeword length counts
+                if (!pullBits(in, inSize, inIndex, 14)) { return true; }
+                m_litlenCount = (((uint32_t)m_bits & 0x1F) + 257);
+                m_offsetCount = (((uint32_t)(m_bits >> 5) & 0x1F) + 1);
+                m_precodeCount = (((uint32_t)(m_bits >> 10) & 0x0F) + 4);
+                dropBits(14);
+
+                m_staticTables = false;
+                m_index = 0;
+                m_state = ZLIBINFLATER_STATE_PRECODE;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_PRECODE:
+            {
+                // Read precode table entries
+                while (m_index < m_precodeCount)
+                {
+                    if (!pullBits(in, inSize, inIndex, 3)) { return true; }
+                    m_tables.u.precode[
+                        ZLibDeflatePrecodePermutations[m_index++]
+                    ] = (uint8_t)(m_bits & 0x07);
+                    dropBits(3);
+                }
+                for (; m_index < ZLIB_DEFLATE_PRECODE_SYMBOLS; ++m_index)
+                {
+                    // Fill unused precode symbols with zeros
+                    m_tables.u.precode[
+                        ZLibDeflatePrecodePermutations[m_index]
+                    ] = 0;
+                }
+
+                // Build decode table
+                if (!ZLibBuildDecodeTable(
+                    m_tables.u.l.decode, m_tables.u.precode,
+                    m_tables.sorted, ZLibDeflateDecodeTable,
+                    ZLIB_DEFLATE_PRECODE_SYMBOLS, ZLIB_DEFLATE_MAX_PRECODE_LEN,
+                    ZLIB_DEFLATE_PRECODE_TABLEBITS))
+                {
+                    // Could not build decode table
+                    return false;
+                }
+
+                m_index = 0;
+                m_state = ZLIBINFLATER_STATE_LENGTHS;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_LENGTHS:
+            {
+                // Expand litlen and offset codeword lengths
+                uint32_t symbols = (m_litlenCount + m_offsetCount);
+                while (m_index < symbols)
+                {
+                    if (!peekSymbol(in, inSize, inIndex, m_tables.u.l.decode,
+                        ZLIB_DEFLATE_PRECODE_TABLEBITS, entry, length))
+                    {
+                        return true;
+                    }
+                    uint32_t presym = (entry >> 8);
+
+                    // Handle explicit codeword lengths
+                    if (presym < 16)
+                    {
+                        dropBits(length);
+                        m_tables.u.l.lengths[m_index++] = (uint8_t)presym;
+                        continue;
+                    }
+
+                    // Precode symbol and its extra bits are read together
+                    uint32_t extraBits = 7;
+                    uint32_t repBase = 11;
+                    if (presym == 16) { extraBits = 2; repBase = 3; }
+                    else if (presym == 17) { extraBits = 3; repBase = 3; }
+                    if (!pullBits(in, inSize, inIndex, length + extraBits))
+                    {
+                        return true;
+                    }
+                    dropBits(length);
+                    uint32_t repCount = (((uint32_t)m_bits &
+                        ((0x00000001u << extraBits) - 1)) + repBase);
+                    dropBits(extraBits);
+                    if ((m_index + repCount) > symbols) { return false; }
+
+                    uint8_t repVal = 0;
+                    if (presym == 16)
+                    {
+                        // Repeat previous length
+                        if (m_index == 0) { return false; }
+                        repVal = m_tables.u.l.lengths[m_index-1];
+                    }
+                    memset(&m_tables.u.l.lengths[m_index], repVal, repCount);
+                    m_index += repCount;
+                }
+
+                // Build offset and litlen tables
+                if (!buildTables()) { return false; }
+                m_state = ZLIBINFLATER_STATE_LITLEN;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_LITLEN:
+            {
+                // Decode litlen symbols
+                for (;;)
+                {
+                    if ((m_written - m_drained) >= ZLibInflaterWindowSize)
+                    {
+                        // Output window is full
+                        return true;
+                    }
+                    if (!peekSymbol(in, inSize, inIndex, m_tables.u.litlen,
+                        ZLIB_DEFLATE_LITLEN_TABLEBITS, entry, length))
+                    {
+                        return true;
+                    }
+                    dropBits(length);
+                    if (entry & 0x40000000)
+                    {
+                        // Literal
+                        m_window[m_written & ZLibInflaterWindowMask] =
+                            (unsigned char)(entry >> 8);
+                        ++m_written;
+                        continue;
+                    }
+                    break;
+                }
+
+                m_extra = (entry >> 8);
+                if (m_extra == 0)
+                {
+                    // End of block
+                    m_state = m_finalBlock ?
+                        ZLIBINFLATER_STATE_CHECKSUM :
+                        ZLIBINFLATER_STATE_BLOCKHEADER;
+                    break;
+                }
+                m_state = ZLIBINFLATER_STATE_LENGTHEXTRA;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_LENGTHEXTRA:
+            {
+                // Compute full length
+                uint32_t extraBits = (m_extra & 0xFF);
+                if (!pullBits(in, inSize, inIndex, extraBits)) { return true; }
+                m_length = ((uint32_t)m_bits & ((0x00000001u << extraBits)-1));
+                m_length += (m_extra >> 8);
+                dropBits(extraBits);
+                m_state = ZLIBINFLATER_STATE_OFFSET;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_OFFSET:
+            {
+                // Decode offset symbol
+                if (!peekSymbol(in, inSize, inIndex, m_tables.offset,
+                    ZLIB_DEFLATE_OFFSET_TABLEBITS, entry, length))
+                {
+                    return true;
+                }
+                dropBits(length);
+                m_extra = (entry >> 8);
+                m_state = ZLIBINFLATER_STATE_OFFSETEXTRA;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_OFFSETEXTRA:
+            {
+                // Compute extra offset
+                uint32_t extraBits = (m_extra >> 16);
+                if (!pullBits(in, inSize, inIndex, extraBits)) { return true; }
+                m_offset = ((uint32_t)m_bits & ((0x00000001u << extraBits)-1));
+                m_offset += (m_extra & 0xFFFF);
+                dropBits(extraBits);
+
+                // Check offset
+                if ((m_offset > ZLibInflaterMaxOffset) ||
+                    (m_offset > m_written))
+                {
+                    // Invalid offset
+                    return false;
+                }
+                m_state = ZLIBINFLATER_STATE_COPY;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_COPY:
+            {
+                // Copy match into the window
+                size_t available = (ZLibInflaterWindowSize -
+                    (m_written - m_drained));
+                size_t size = m_length;
+                if (size > available) { size = available; }
+                for (size_t i = 0; i < size; ++i)
+                {
+                    m_window[m_written & ZLibInflaterWindowMask] =
+                        m_window[(m_written - m_offset) &
+                        ZLibInflaterWindowMask];
+                    ++m_written;
+                }
+                m_length -= (uint32_t)size;
+                if (m_length > 0) { return true; }
+
+                m_state = ZLIBINFLATER_STATE_LITLEN;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_CHECKSUM:
+            {
+                // Align input and read Adler32 CRC
+                dropBits(m_bitsCount & 0x07);
+                if (!pullBits(in, inSize, inIndex, 32)) { return true; }
+                m_checksum = ((uint32_t)(m_bits & 0xFF) << 24);
+                m_checksum |= ((uint32_t)((m_bits >> 8) & 0xFF) << 16);
+                m_checksum |= ((uint32_t)((m_bits >> 16) & 0xFF) << 8);
+                m_checksum |= ((uint32_t)((m_bits >> 24) & 0xFF));
+                dropBits(32);
+                m_state = ZLIBINFLATER_STATE_DONE;
+                break;
+            }
+
+            case ZLIBINFLATER_STATE_DONE:
+                // End of stream
+                return true;
+
+            default:
+                // Invalid inflater state
+                return false;
+        }
+    }
+}
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Compress/ZLibInflater.h : ZLib streaming inflate management            //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_COMPRESS_ZLIBINFLATER_HEADER
+#define WOS_COMPRESS_ZLIBINFLATER_HEADER
+
+    #include "../System/System.h"
+    #include "../System/SysCPU.h"
+    #include "../System/SysCRC.h"
+    #include "ZLib.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <new>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLibInflater settings                                                 //
+    ////////////////////////////////////////////////////////////////////////////
+    const size_t ZLibInflaterWindowSize = 65536;
+    const size_t ZLibInflaterWindowMask = (ZLibInflaterWindowSize-1);
+    const size_t ZLibInflaterMaxOffset = 32768;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLibInflaterState enumeration                                         //
+    ////////////////////////////////////////////////////////////////////////////
+    enum ZLibInflaterState
+    {
+        ZLIBINFLATER_STATE_HEADER = 0,
+        ZLIBINFLATER_STATE_BLOCKHEADER = 1,
+        ZLIBINFLATER_STATE_STOREDSIZE = 2,
+        ZLIBINFLATER_STATE_STOREDCOPY = 3,
+        ZLIBINFLATER_STATE_TABLECOUNTS = 4,
+        ZLIBINFLATER_STATE_PRECODE = 5,
+        ZLIBINFLATER_STATE_LENGTHS = 6,
+        ZLIBINFLATER_STATE_LITLEN = 7,
+        ZLIBINFLATER_STATE_LENGTHEXTRA = 8,
+        ZLIBINFLATER_STATE_OFFSET = 9,
+        ZLIBINFLATER_STATE_OFFSETEXTRA = 10,
+        ZLIBINFLATER_STATE_COPY = 11,
+        ZLIBINFLATER_STATE_CHECKSUM = 12,
+        ZLIBINFLATER_STATE_DONE = 13,
+
+        ZLIBINFLATER_STATE_ERROR = 14
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ZLibInflater class definition                                         //
+    ////////////////////////////////////////////////////////////////////////////
+    class ZLibInflater
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  ZLibInflater default constructor                              //
+            ////////////////////////////////////////////////////////////////////
+            ZLibInflater();
+
+            ////////////////////////////////////////////////////////////////////
+            //  ZLibInflater destructor                                       //
+            ////////////////////////////////////////////////////////////////////
+            ~ZLibInflater();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Init ZLib inflater for a new stream                           //
+            //  checkAdler32 can be disabled for pre-validated trusted data   //
+            //  return : True if the inflater is ready                        //
+            ////////////////////////////////////////////////////////////////////
+            bool init(bool checkAdler32 = true);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Feed compressed input chunk to the inflater                   //
+            //  Decoding stops when the input is exhausted, when the window   //
+            //  is full of undrained output, or at the end of the stream      //
+            //  return : False if the stream is invalid                       //
+            ////////////////////////////////////////////////////////////////////
+            bool feed(const unsigned char* in, size_t inSize, size_t* inRead);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Drain decompressed output from the inflater                   //
+            //  return : Number of bytes copied into the output buffer        //
+            ////////////////////////////////////////////////////////////////////
+            size_t drain(unsigned char* out, size_t outSize);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Finish ZLib inflater stream                                   //
+            //  return : True if the stream is complete, fully drained and    //
+            //           its Adler32 CRC is valid                             //
+            ////////////////////////////////////////////////////////////////////
+            bool finish();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Destroy ZLib inflater                                         //
+            ////////////////////////////////////////////////////////////////////
+            void destroyInflater();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get ZLib inflater end of stream state                         //
+            //  return : True if the end of the stream is reached             //
+            ////////////////////////////////////////////////////////////////////
+            inline bool isDone() const
+            {
+                return (m_state == ZLIBINFLATER_STATE_DONE);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get ZLib inflater error state                                 //
+            //  return : True if the stream is invalid                        //
+            ////////////////////////////////////////////////////////////////////
+            inline bool isError() const
+            {
+                return (m_state == ZLIBINFLATER_STATE_ERROR);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get ZLib inflater pending output size                         //
+            //  return : Number of decompressed bytes not yet drained         //
+            ////////////////////////////////////////////////////////////////////
+            inline size_t getPending() const
+            {
+                return (m_written - m_drained);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get ZLib inflater total output size                           //
+            //  return : Number of decompressed bytes drained so far          //
+            ////////////////////////////////////////////////////////////////////
+            inline size_t getTotalOut() const
+            {
+                return m_drained;
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  ZLibInflater private copy constructor : Not copyable          //
+            ////////////////////////////////////////////////////////////////////
+            ZLibInflater(const ZLibInflater&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  ZLibInflater private copy operator : Not copyable             //
+            ////////////////////////////////////////////////////////////////////
+            ZLibInflater& operator=(const ZLibInflater&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Pull input bytes until count bits are available               //
+            //  return : True if count bits are available                     //
+            ////////////////////////////////////////////////////////////////////
+            inline bool pullBits(const unsigned char* in, size_t inSize,
+                size_t& inIndex, uint32_t count)
+            {
+                while (m_bitsCount < count)
+                {
+                    if (inIndex >= inSize) { return false; }
+                    m_bits |= ((uint64_t)in[inIndex++] << m_bitsCount);
+                    m_bitsCount += 8;
+                }
+                return true;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Consume count bits                                            //
+            ////////////////////////////////////////////////////////////////////
+            inline void dropBits(uint32_t count)
+            {
+                m_bits >>= count;
+                m_bitsCount -= count;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Peek Huffman decode table entry without consuming bits        //
+            //  return : True if a complete codeword is available             //
+            ////////////////////////////////////////////////////////////////////
+            bool peekSymbol(const unsigned char* in, size_t inSize,
+                size_t& inIndex, const uint32_t table[], uint32_t tableBits,
+                uint32_t& entry, uint32_t& length);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Build ZLib inflater Huffman decode tables                     //
+            //  return : True if the decode tables are successfully built     //
+            ////////////////////////////////////////////////////////////////////
+            bool buildTables();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Decode input into the inflater window                         //
+            //  return : False if the stream is invalid                       //
+            ////////////////////////////////////////////////////////////////////
+            bool decode(const unsigned char* in, size_t inSize,
+                size_t& inIndex);
+
+
+        private:
+            ZLibInflaterState       m_state;        // Inflater state
+            ZLibDeflateDecodeTables m_tables;       // Huffman decode tables
+            unsigned char*          m_window;       // Output ring window
+            size_t                  m_written;      // Bytes written to window
+            size_t                  m_drained;      // Bytes drained from window
+
+            uint64_t                m_bits;         // Input bits buffer
+            uint32_t                m_bitsCount;    // Input bits count
+
+            bool                    m_finalBlock;   // Final block state
+            bool                    m_staticTables; // Static tables loaded
+            uint32_t                m_blockType;    // Current block type
+            uint32_t                m_litlenCount;  // Litlen symbols count
+            uint32_t                m_offsetCount;  // Offset symbols count
+            uint32_t                m_precodeCount; // Precode symbols count
+            uint32_t                m_index;        // Table entries index
+            uint32_t                m_storedSize;   // Stored bytes left
+            uint32_t                m_length;       // Match length
+            uint32_t                m_offset;       // Match offset
+            uint32_t                m_extra;        // Extra bits entry
+            uint32_t                m_adler32;      // Output Adler32 CRC
+            uint32_t                m_checksum;     // Stream Adler32 CRC
+            bool                    m_checkAdler32; // Adler32 check state
+    };
+
+
+#endif // WOS_COMPRESS_ZLIBINFLATER_HEADER
@@ -0,0 +1,528 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/BlockTranscoder.cpp : Compressed blocks CPU transcoder          //
+////////////////////////////////////////////////////////////////////////////////
+#include "BlockTranscoder.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Clamp block color channel                                                 //
+//  return : Channel value clamped to [0, 255]                                //
+////////////////////////////////////////////////////////////////////////////////
+inline unsigned char BlockClamp(int value)
+{
+    return static_cast<unsigned char>(
+        (value < 0) ? 0 : ((value > 255) ? 255 : value)
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get ETC block pixel index (pixels are stored column by column)            //
+//  return : Pixel index value (msb, lsb)                                     //
+////////////////////////////////////////////////////////////////////////////////
+inline uint32_t BlockETCIndex(uint32_t indices, uint32_t x, uint32_t y)
+{
+    uint32_t bit = (x*4 + y);
+    return ((((indices >> (bit+16)) & 1) << 1) | ((indices >> bit) & 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Set block pixel color                                                     //
+////////////////////////////////////////////////////////////////////////////////
+inline void BlockSetPixel(unsigned char* rgba, uint32_t x, uint32_t y,
+    const int color[3], unsigned char alpha)
+{
+    unsigned char* pixel = &rgba[(y*4 + x)*4];
+    pixel[0] = BlockClamp(color[0]);
+    pixel[1] = BlockClamp(color[1]);
+    pixel[2] = BlockClamp(color[2]);
+    pixel[3] = alpha;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode ETC2 T and H modes block from the paint colors                     //
+////////////////////////////////////////////////////////////////////////////////
+void BlockDecodeETC2Paint(uint32_t indices, const int paint[4][3],
+    unsigned char* rgba, bool opaque)
+{
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        for (uint32_t x = 0; x < 4; ++x)
+        {
+            uint32_t index = BlockETCIndex(indices, x, y);
+            if (!opaque && (index == 2))
+            {
+                // Punchthrough transparent pixel
+                const int black[3] = {0, 0, 0};
+                BlockSetPixel(rgba, x, y, black, 0);
+                continue;
+            }
+            BlockSetPixel(rgba, x, y, paint[index], 255);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode BC1 color block into 4x4 RGBA pixels                               //
+//  fourColors forces the 4 colors mode (BC3 color blocks)                    //
+////////////////////////////////////////////////////////////////////////////////
+void BlockDecodeBC1(const unsigned char* block, unsigned char* rgba,
+    bool alpha, bool fourColors)
+{
+    // Read endpoints (RGB565)
+    uint32_t color0 = (block[0] | (block[1] << 8));
+    uint32_t color1 = (block[2] | (block[3] << 8));
+    uint32_t indices = (block[4] | (block[5] << 8) |
+        (block[6] << 16) | ((uint32_t)block[7] << 24));
+
+    // Expand endpoints to 8 bits per channel
+    int palette[4][4];
+    const uint32_t endpoints[2] = {color0, color1};
+    for (int i = 0; i < 2; ++i)
+    {
+        int red = ((endpoints[i] >> 11) & 0x1F);
+        int green = ((endpoints[i] >> 5) & 0x3F);
+        int blue = (endpoints[i] & 0x1F);
+        palette[i][0] = ((red << 3) | (red >> 2));
+        palette[i][1] = ((green << 2) | (green >> 4));
+        palette[i][2] = ((blue << 3) | (blue >> 2));
+        palette[i][3] = 255;
+    }
+
+    // Interpolate palette colors
+    if (fourColors || (color0 > color1))
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = ((2*palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = ((palette[0][c] + 2*palette[1][c]) / 3);
+        }
+        palette[2][3] = 255;
+        palette[3][3] = 255;
+    }
+    else
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = ((palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        }
+        palette[2][3] = 255;
+        palette[3][3] = (alpha ? 0 : 255);
+    }
+
+    // Decode pixels (2 bits per pixel, row by row)
+    for (uint32_t i = 0; i < BlockTranscoderBlockPixels; ++i)
+    {
+        const int* color = palette[(indices >> (i*2)) & 3];
+        rgba[i*4] = static_cast<unsigned char>(color[0]);
+        rgba[i*4+1] = static_cast<unsigned char>(color[1]);
+        rgba[i*4+2] = static_cast<unsigned char>(color[2]);
+        rgba[i*4+3] = static_cast<unsigned char>(color[3]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode BC3 alpha block into the 4x4 RGBA pixels alpha channel             //
+////////////////////////////////////////////////////////////////////////////////
+void BlockDecodeBC3Alpha(const unsigned char* block, unsigned char* rgba)
+{
+    // Compute alpha palette
+    int palette[8];
+    palette[0] = block[0];
+    palette[1] = block[1];
+    if (palette[0] > palette[1])
+    {
+        for (int i = 2; i < 8; ++i)
+        {
+            palette[i] = (((8-i)*palette[0] + (i-1)*palette[1]) / 7);
+        }
+    }
+    else
+    {
+        for (int i = 2; i < 6; ++i)
+        {
+            palette[i] = (((6-i)*palette[0] + (i-1)*palette[1]) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    // Decode alpha (3 bits per pixel, row by row)
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i)
+    {
+        indices |= ((uint64_t)block[2+i] << (i*8));
+    }
+    for (uint32_t i = 0; i < BlockTranscoderBlockPixels; ++i)
+    {
+        rgba[i*4+3] =
+            static_cast<unsigned char>(palette[(indices >> (i*3)) & 7]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode ETC2 color block into 4x4 RGBA pixels                              //
+//  punchthrough selects the 1 bit alpha variant (RGB8A1)                     //
+////////////////////////////////////////////////////////////////////////////////
+void BlockDecodeETC2(const unsigned char* block, unsigned char* rgba,
+    bool punchthrough)
+{
+    // Read block (64 bits big endian : high word, then pixel indices)
+    uint32_t high = (((uint32_t)block[0] << 24) | (block[1] << 16) |
+        (block[2] << 8) | block[3]);
+    uint32_t indices = (((uint32_t)block[4] << 24) | (block[5] << 16) |
+        (block[6] << 8) | block[7]);
+    bool differential = ((high >> 1) & 1);
+    bool flip = (high & 1);
+    bool opaque = true;
+    if (punchthrough)
+    {
+        // Differential bit is the opaque bit (no individual mode)
+        opaque = differential;
+        differential = true;
+    }
+
+    // Get subblocks base colors
+    int base[2][3];
+    if (!differential)
+    {
+        // Individual mode (4 bits base colors)
+        for (int c = 0; c < 3; ++c)
+        {
+            int color1 = ((high >> (28 - c*8)) & 0xF);
+            int color2 = ((high >> (24 - c*8)) & 0xF);
+            base[0][c] = ((color1 << 4) | color1);
+            base[1][c] = ((color2 << 4) | color2);
+        }
+    }
+    else
+    {
+        // Differential mode (5 bits base color and 3 bits signed delta)
+        int color[3];
+        int delta[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            color[c] = ((high >> (27 - c*8)) & 0x1F);
+            delta[c] = ((high >> (24 - c*8)) & 0x7);
+            if (delta[c] >= 4) { delta[c] -= 8; }
+        }
+
+        if (((color[0] + delta[0]) < 0) || ((color[0] + delta[0]) > 31))
+        {
+            // T mode (red overflow)
+            int paint[4][3];
+            int color1[3];
+            int color2[3];
+            color1[0] = ((((high >> 27) & 0x3) << 2) | ((high >> 24) & 0x3));
+            color1[1] = ((high >> 20) & 0xF);
+            color1[2] = ((high >> 16) & 0xF);
+            color2[0] = ((high >> 12) & 0xF);
+            color2[1] = ((high >> 8) & 0xF);
+            color2[2] = ((high >> 4) & 0xF);
+            int distance = BlockETC2Distances[
+                (((high >> 2) & 0x3) << 1) | (high & 1)
+            ];
+            for (int c = 0; c < 3; ++c)
+            {
+                color1[c] = ((color1[c] << 4) | color1[c]);
+                color2[c] = ((color2[c] << 4) | color2[c]);
+                paint[0][c] = color1[c];
+                paint[1][c] = (color2[c] + distance);
+                paint[2][c] = color2[c];
+                paint[3][c] = (color2[c] - distance);
+            }
+            BlockDecodeETC2Paint(indices, paint, rgba, opaque);
+            return;
+        }
+
+        if (((color[1] + delta[1]) < 0) || ((color[1] + delta[1]) > 31))
+        {
+            // H mode (green overflow)
+            int paint[4][3];
+            int color1[3];
+            int color2[3];
+            color1[0] = ((high >> 27) & 0xF);
+            color1[1] = ((((high >> 24) & 0x7) << 1) | ((high >> 20) & 1));
+            color1[2] = ((((high >> 19) & 1) << 3) | ((high >> 15) & 0x7));
+            color2[0] = ((high >> 11) & 0xF);
+            color2[1] = ((high >> 7) & 0xF);
+            color2[2] = ((high >> 3) & 0xF);
+            int order = ((((color1[0] << 8) | (color1[1] << 4) | color1[2]) >=
+                ((color2[0] << 8) | (color2[1] << 4) | color2[2])) ? 1 : 0);
+            int distance = BlockETC2Distances[
+                (((high >> 2) & 1) << 2) | ((high & 1) << 1) | order
+            ];
+            for (int c = 0; c < 3; ++c)
+            {
+                color1[c] = ((color1[c] << 4) | color1[c]);
+                color2[c] = ((color2[c] << 4) | color2[c]);
+                paint[0][c] = (color1[c] + distance);
+                paint[1][c] = (color1[c] - distance);
+                paint[2][c] = (color2[c] + distance);
+                paint[3][c] = (color2[c] - distance);
+            }
+            BlockDecodeETC2Paint(indices, paint, rgba, opaque);
+            return;
+        }
+
+        if (((color[2] + delta[2]) < 0) || ((color[2] + delta[2]) > 31))
+        {
+            // Planar mode (blue overflow, always opaque)
+            int origin[3];
+            int horizontal[3];
+            int vertical[3];
+            origin[0] = ((high >> 25) & 0x3F);
+            origin[1] = ((((high >> 24) & 1) << 6) | ((high >> 17) & 0x3F));
+            origin[2] = ((((high >> 16) & 1) << 5) |
+                (((high >> 11) & 0x3) << 3) | ((high >> 7) & 0x7));
+            horizontal[0] = ((((high >> 2) & 0x1F) << 1) | (high & 1));
+            horizontal[1] = ((indices >> 25) & 0x7F);
+            horizontal[2] = ((indices >> 19) & 0x3F);
+            vertical[0] = ((indices >> 13) & 0x3F);
+            vertical[1] = ((indices >> 6) & 0x7F);
+            vertical[2] = (indices & 0x3F);
+            origin[0] = ((origin[0] << 2) | (origin[0] >> 4));
+            origin[1] = ((origin[1] << 1) | (origin[1] >> 6));
+            origin[2] = ((origin[2] << 2) | (origin[2] >> 4));
+            horizontal[0] = ((horizontal[0] << 2) | (horizontal[0] >> 4));
+            horizontal[1] = ((horizontal[1] << 1) | (horizontal[1] >> 6));
+            horizontal[2] = ((horizontal[2] << 2) | (horizontal[2] >> 4));
+            vertical[0] = ((vertical[0] << 2) | (vertical[0] >> 4));
+            vertical[1] = ((vertical[1] << 1) | (vertical[1] >> 6));
+            vertical[2] = ((vertical[2] << 2) | (vertical[2] >> 4));
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    int color[3];
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        color[c] = ((x*(horizontal[c] - origin[c]) +
+                            y*(vertical[c] - origin[c]) +
+                            4*origin[c] + 2) >> 2);
+                    }
+                    BlockSetPixel(rgba, x, y, color, 255);
+                }
+            }
+            return;
+        }
+
+        // Differential ETC1 mode
+        for (int c = 0; c < 3; ++c)
+        {
+            int color2 = (color[c] + delta[c]);
+            base[0][c] = ((color[c] << 3) | (color[c] >> 2));
+            base[1][c] = ((color2 << 3) | (color2 >> 2));
+        }
+    }
+
+    // Decode ETC1 subblocks (2x4 side by side, or 4x2 when flipped)
+    const int* modifiers[2] =
+    {
+        BlockETC1Modifiers[(high >> 5) & 0x7],
+        BlockETC1Modifiers[(high >> 2) & 0x7]
+    };
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        for (uint32_t x = 0; x < 4; ++x)
+        {
+            uint32_t subblock = (flip ? (y >> 1) : (x >> 1));
+            uint32_t index = BlockETCIndex(indices, x, y);
+            int modifier = modifiers[subblock][index];
+            if (!opaque)
+            {
+                // Punchthrough : index 2 is transparent, index 0 unmodified
+                if (index == 2)
+                {
+                    const int black[3] = {0, 0, 0};
+                    BlockSetPixel(rgba, x, y, black, 0);
+                    continue;
+                }
+                if (index == 0) { modifier = 0; }
+            }
+            int color[3] =
+            {
+                (base[subblock][0] + modifier),
+                (base[subblock][1] + modifier),
+                (base[subblock][2] + modifier)
+            };
+            BlockSetPixel(rgba, x, y, color, 255);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode EAC alpha block into the 4x4 RGBA pixels alpha channel             //
+////////////////////////////////////////////////////////////////////////////////
+void BlockDecodeEACAlpha(const unsigned char* block, unsigned char* rgba)
+{
+    // Read base codeword, multiplier and modifier table
+    int base = block[0];
+    int multiplier = (block[1] >> 4);
+    const int* modifiers = BlockEACModifiers[block[1] & 0xF];
+
+    // Decode alpha (3 bits per pixel big endian, column by column)
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i)
+    {
+        indices = ((indices << 8) | block[2+i]);
+    }
+    for (uint32_t i = 0; i < BlockTranscoderBlockPixels; ++i)
+    {
+        uint32_t x = (i >> 2);
+        uint32_t y = (i & 3);
+        uint32_t index = ((indices >> (45 - i*3)) & 7);
+        rgba[(y*4 + x)*4 + 3] =
+            BlockClamp(base + modifiers[index]*multiplier);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode compressed block into 4x4 RGBA pixels                              //
+//  return : True if the block format can be transcoded                       //
+////////////////////////////////////////////////////////////////////////////////
+bool BlockDecode(BlockFormat format, const unsigned char* block,
+    unsigned char* rgba)
+{
+    switch (format)
+    {
+        case BLOCKFORMAT_BC1:
+            BlockDecodeBC1(block, rgba, false);
+            return true;
+
+        case BLOCKFORMAT_BC1A:
+            BlockDecodeBC1(block, rgba, true);
+            return true;
+
+        case BLOCKFORMAT_BC3:
+            BlockDecodeBC1(&block[8], rgba, false, true);
+            BlockDecodeBC3Alpha(block, rgba);
+            return true;
+
+        case BLOCKFORMAT_ETC2:
+            BlockDecodeETC2(block, rgba, false);
+            return true;
+
+        case BLOCKFORMAT_ETC2A1:
+            BlockDecodeETC2(block, rgba, true);
+            return true;
+
+        case BLOCKFORMAT_ETC2A8:
+            BlockDecodeETC2(&block[8], rgba, false);
+            BlockDecodeEACAlpha(block, rgba);
+            return true;
+
+        default:
+            // Block format can not be transcoded
+            return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Transcode compressed image into RGBA8 or RGB565 pixels                    //
+//  return : True if the image is successfully transcoded                     //
+////////////////////////////////////////////////////////////////////////////////
+bool BlockTranscode(BlockFormat format, const unsigned char* data,
+    uint32_t width, uint32_t height, unsigned char* out,
+    BlockTarget target)
+{
+    // Check transcode parameters
+    if (!data || !out || (width <= 0) || (height <= 0) ||
+        !BlockFormatTranscodable(format))
+    {
+        // Invalid transcode parameters
+        return false;
+    }
+
+    // Transcode blocks row by row
+    size_t blockSize = BlockFormatSize(format);
+    size_t pixelSize = BlockTargetPixelSize(target);
+    unsigned char rgba[BlockTranscoderBlockPixels*4];
+    for (uint32_t blockY = 0; blockY < height;
+        blockY += BlockTranscoderBlockHeight)
+    {
+        for (uint32_t blockX = 0; blockX < width;
+            blockX += BlockTranscoderBlockWidth)
+        {
+            // Decode block
+            BlockDecode(format, data, rgba);
+            data += blockSize;
+
+            // Copy block pixels inside the image
+            uint32_t rows = (height - blockY);
+            uint32_t columns = (width - blockX);
+            if (rows > BlockTranscoderBlockHeight)
+            {
+                rows = BlockTranscoderBlockHeight;
+            }
+            if (columns > BlockTranscoderBlockWidth)
+            {
+                columns = BlockTranscoderBlockWidth;
+            }
+            for (uint32_t y = 0; y < rows; ++y)
+            {
+                const unsigned char* pixel = &rgba[y*16];
+                unsigned char* line =
+                    &out[((size_t)(blockY + y)*width + blockX)*pixelSize];
+                if (target == BLOCKTARGET_RGB565)
+                {
+                    for (uint32_t x = 0; x < columns; ++x)
+                    {
+                        uint16_t color = static_cast<uint16_t>(
+                            (((pixel[x*4]*31 + 127) / 255) << 11) |
+                            (((pixel[x*4+1]*63 + 127) / 255) << 5) |
+                            ((pixel[x*4+2]*31 + 127) / 255)
+                        );
+                        memcpy(&line[x*2], &color, sizeof(uint16_t));
+                    }
+                }
+                else
+                {
+                    memcpy(line, pixel, columns*4);
+                }
+            }
+        }
+    }
+
+    // Image successfully transcoded
+    return true;
+}
@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/BlockTranscoder.h : Compressed blocks CPU transcoder            //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_IMAGES_BLOCKTRANSCODER_HEADER
+#define WOS_IMAGES_BLOCKTRANSCODER_HEADER
+
+    #include "../System/System.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  BlockTranscoder settings                                              //
+    ////////////////////////////////////////////////////////////////////////////
+    const uint32_t BlockTranscoderBlockWidth = 4;
+    const uint32_t BlockTranscoderBlockHeight = 4;
+    const size_t BlockTranscoderBlockPixels = 16;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ETC1 intensity modifier tables                                        //
+    //  Indexed by pixel index value (msb, lsb) : +a, +b, -a, -b              //
+    ////////////////////////////////////////////////////////////////////////////
+    const int BlockETC1Modifiers[8][4] =
+    {
+        {2, 8, -2, -8},
+        {5, 17, -5, -17},
+        {9, 29, -9, -29},
+        {13, 42, -13, -42},
+        {18, 60, -18, -60},
+        {24, 80, -24, -80},
+        {33, 106, -33, -106},
+        {47, 183, -47, -183}
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ETC2 T and H modes distances                                          //
+    ////////////////////////////////////////////////////////////////////////////
+    const int BlockETC2Distances[8] =
+    {
+        3, 6, 11, 16, 23, 32, 41, 64
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  EAC alpha modifier tables                                             //
+    ////////////////////////////////////////////////////////////////////////////
+    const int BlockEACModifiers[16][8] =
+    {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  BlockFormat enumeration                                               //
+    //  Every format is made of 4x4 texels blocks                             //
+    ////////////////////////////////////////////////////////////////////////////
+    enum BlockFormat
+    {
+        BLOCKFORMAT_NONE = 0,
+        BLOCKFORMAT_BC1 = 1,
+        BLOCKFORMAT_BC1A = 2,
+        BLOCKFORMAT_BC3 = 3,
+        BLOCKFORMAT_ETC2 = 4,
+        BLOCKFORMAT_ETC2A1 = 5,
+        BLOCKFORMAT_ETC2A8 = 6,
+        BLOCKFORMAT_ASTC4X4 = 7,
+
+        BLOCKFORMAT_COUNT = 8
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  BlockTarget enumeration                                               //
+    //  RGBA8 : 4 bytes per pixel, RGB565 : 2 bytes per pixel (native endian) //
+    ////////////////////////////////////////////////////////////////////////////
+    enum BlockTarget
+    {
+        BLOCKTARGET_RGBA8 = 0,
+        BLOCKTARGET_RGB565 = 1
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Get block format bytes per block                                      //
+    //  return : Block size in bytes (0 for an invalid format)                //
+    ////////////////////////////////////////////////////////////////////////////
+    inline size_t BlockFormatSize(BlockFormat format)
+    {
+        switch (format)
+        {
+            case BLOCKFORMAT_BC1:
+            case BLOCKFORMAT_BC1A:
+            case BLOCKFORMAT_ETC2:
+            case BLOCKFORMAT_ETC2A1:
+                return 8;
+
+            case BLOCKFORMAT_BC3:
+            case BLOCKFORMAT_ETC2A8:
+            case BLOCKFORMAT_ASTC4X4:
+                return 16;
+
+            default:
+                return 0;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Get block format alpha channel                                        //
+    //  return : True if the block format holds alpha                         //
+    ////////////////////////////////////////////////////////////////////////////
+    inline bool BlockFormatAlpha(BlockFormat format)
+    {
+        return ((format != BLOCKFORMAT_BC1) && (format != BLOCKFORMAT_ETC2));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Get block format CPU transcoding support (ASTC is GPU only)           //
+    //  return : True if the block format can be transcoded                   //
+    ////////////////////////////////////////////////////////////////////////////
+    inline bool BlockFormatTranscodable(BlockFormat format)
+    {
+        return ((format > BLOCKFORMAT_NONE) &&
+            (format < BLOCKFORMAT_ASTC4X4));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Get compressed image size                                             //
+    //  return : Size in bytes of the blocks covering the image               //
+    ////////////////////////////////////////////////////////////////////////////
+    inline size_t BlockImageSize(BlockFormat format,
+        uint32_t width, uint32_t height)
+    {
+        size_t blocksX = ((width + BlockTranscoderBlockWidth-1) /
+            BlockTranscoderBlockWidth);
+        size_t blocksY = ((height + BlockTranscoderBlockHeight-1) /
+            BlockTranscoderBlockHeight);
+        return (blocksX*blocksY*BlockFormatSize(format));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Get transcoded pixel size                                             //
+    //  return : Bytes per pixel of the transcode target                      //
+    ////////////////////////////////////////////////////////////////////////////
+    inline size_t BlockTargetPixelSize(BlockTarget target)
+    {
+        return ((target == BLOCKTARGET_RGB565) ? 2 : 4);
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decode BC1 color block into 4x4 RGBA pixels                           //
+    //  fourColors forces the 4 colors mode (BC3 color blocks)                //
+    ////////////////////////////////////////////////////////////////////////////
+    void BlockDecodeBC1(const unsigned char* block, unsigned char* rgba,
+        bool alpha, bool fourColors = false);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decode BC3 alpha block into the 4x4 RGBA pixels alpha channel         //
+    ////////////////////////////////////////////////////////////////////////////
+    void BlockDecodeBC3Alpha(const unsigned char* block, unsigned char* rgba);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decode ETC2 color block into 4x4 RGBA pixels                          //
+    //  punchthrough selects the 1 bit alpha variant (RGB8A1)                 //
+    ////////////////////////////////////////////////////////////////////////////
+    void BlockDecodeETC2(const unsigned char* block, unsigned char* rgba,
+        bool punchthrough);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decode EAC alpha block into the 4x4 RGBA pixels alpha channel         //
+    ////////////////////////////////////////////////////////////////////////////
+    void BlockDecodeEACAlpha(const unsigned char* block, unsigned char* rgba);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Decode compressed block into 4x4 RGBA pixels                          //
+    //  return : True if the block format can be transcoded                   //
+    ////////////////////////////////////////////////////////////////////////////
+    bool BlockDecode(BlockFormat format, const unsigned char* block,
+        unsigned char* rgba);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Transcode compressed image into RGBA8 or RGB565 pixels                //
+    //  data must hold BlockImageSize bytes, out must hold                    //
+    //  width*height*BlockTargetPixelSize bytes                               //
+    //  return : True if the image is successfully transcoded                 //
+    ////////////////////////////////////////////////////////////////////////////
+    bool BlockTranscode(BlockFormat format, const unsigned char* data,
+        uint32_t width, uint32_t height, unsigned char* out,
+        BlockTarget target);
+
+
+#endif // WOS_IMAGES_BLOCKTRANSCODER_HEADER
@@ -0,0 +1,506 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/ImageDownscaler.cpp : Image downscaling and mip chain           //
+////////////////////////////////////////////////////////////////////////////////
+#include "ImageDownscaler.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Image gamma tables structure                                              //
+////////////////////////////////////////////////////////////////////////////////
+struct ImageGammaTables
+{
+    float           toLinear[256];
+    unsigned char   toSRGB[ImageDownscalerGammaTableSize];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compute image gamma tables                                                //
+//  return : sRGB to linear and linear to sRGB conversion tables              //
+////////////////////////////////////////////////////////////////////////////////
+ImageGammaTables ImageComputeGammaTables()
+{
+    ImageGammaTables tables;
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        double c = (i / 255.0);
+        c = (c <= 0.04045) ? (c / 12.92) : std::pow((c+0.055) / 1.055, 2.4);
+        tables.toLinear[i] = static_cast<float>(c);
+    }
+    for (uint32_t i = 0; i < ImageDownscalerGammaTableSize; ++i)
+    {
+        double l = (i / (double)(ImageDownscalerGammaTableSize-1));
+        l = (l <= 0.0031308) ?
+            (l*12.92) : ((1.055*std::pow(l, 1.0/2.4)) - 0.055);
+        tables.toSRGB[i] = static_cast<unsigned char>((l*255.0)+0.5);
+    }
+    return tables;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get image gamma tables (computed once)                                    //
+//  return : sRGB to linear and linear to sRGB conversion tables              //
+////////////////////////////////////////////////////////////////////////////////
+const ImageGammaTables& ImageGetGammaTables()
+{
+    static const ImageGammaTables tables = ImageComputeGammaTables();
+    return tables;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compute modified Bessel function of the first kind of order 0             //
+//  return : I0(x) power series                                               //
+////////////////////////////////////////////////////////////////////////////////
+double ImageBesselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    double halfX = (x*0.5);
+    for (uint32_t k = 1; k < 32; ++k)
+    {
+        term *= (halfX / k);
+        sum += (term*term);
+        if ((term*term) < (sum*1e-12)) { break; }
+    }
+    return sum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compute Kaiser windowed sinc filter                                       //
+//  return : Filter weight at distance t (in output pixels)                   //
+////////////////////////////////////////////////////////////////////////////////
+double ImageKaiserFilter(double t)
+{
+    double radius = ImageDownscalerKaiserRadius;
+    if ((t <= -radius) || (t >= radius)) { return 0.0; }
+
+    // Sinc
+    double sinc = 1.0;
+    if ((t < -1e-9) || (t > 1e-9))
+    {
+        sinc = (std::sin(Math::Pi*t) / (Math::Pi*t));
+    }
+
+    // Kaiser window
+    double x = (t / radius);
+    double alpha = ImageDownscalerKaiserAlpha;
+    return (sinc*(ImageBesselI0(alpha*std::sqrt(1.0-(x*x))) /
+        ImageBesselI0(alpha)));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Generate image mip chain                                                  //
+//  return : True if the mip chain is successfully generated                  //
+////////////////////////////////////////////////////////////////////////////////
+bool ImageGenerateMipmaps(unsigned char* chain,
+    uint32_t width, uint32_t height, uint32_t levels,
+    ImageDownscalerFilter filter, bool gammaCorrect)
+{
+    // Check mip chain
+    if (!chain || (width <= 0) || (height <= 0) ||
+        (levels > ImageMipLevels(width, height)))
+    {
+        // Invalid mip chain
+        return false;
+    }
+
+    // Each level is downscaled from the previous one
+    ImageDownscaler downscaler;
+    unsigned char* level = chain;
+    for (uint32_t i = 1; i < levels; ++i)
+    {
+        uint32_t outWidth = ImageDownscaledSize(width, 1);
+        uint32_t outHeight = ImageDownscaledSize(height, 1);
+        unsigned char* next = &level[(size_t)width*height*4];
+        if (!downscaler.init(width, height, outWidth, outHeight,
+            filter, gammaCorrect, next, (size_t)outWidth*4))
+        {
+            // Could not init mip level downscaler
+            return false;
+        }
+        for (uint32_t j = 0; j < height; ++j)
+        {
+            if (!downscaler.pushRow(&level[(size_t)j*width*4]))
+            {
+                // Could not downscale mip level
+                return false;
+            }
+        }
+        if (!downscaler.finish())
+        {
+            // Could not downscale mip level
+            return false;
+        }
+
+        // Next mip level
+        level = next;
+        width = outWidth;
+        height = outHeight;
+    }
+
+    // Image mip chain is successfully generated
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  ImageDownscaler default constructor                                       //
+////////////////////////////////////////////////////////////////////////////////
+ImageDownscaler::ImageDownscaler() :
+m_width(0),
+m_height(0),
+m_outWidth(0),
+m_outHeight(0),
+m_filter(IMAGEDOWNSCALER_FILTER_BOX),
+m_gamma(true),
+m_out(0),
+m_stride(0),
+m_xStarts(0),
+m_xCounts(0),
+m_xWeights(0),
+m_xTaps(0),
+m_yStarts(0),
+m_yCounts(0),
+m_yWeights(0),
+m_yTaps(0),
+m_linear(0),
+m_ring(0),
+m_rowsIn(0),
+m_rowsOut(0)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  ImageDownscaler destructor                                                //
+////////////////////////////////////////////////////////////////////////////////
+ImageDownscaler::~ImageDownscaler()
+{
+    destroyDownscaler();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Init image downscaler                                                     //
+//  return : True if the image downscaler is ready                            //
+////////////////////////////////////////////////////////////////////////////////
+bool ImageDownscaler::init(uint32_t width, uint32_t height,
+    uint32_t outWidth, uint32_t outHeight,
+    ImageDownscalerFilter filter, bool gammaCorrect,
+    unsigned char* out, size_t stride)
+{
+    // Reset image downscaler
+    destroyDownscaler();
+
+    // Check images sizes
+    if (!out || (width <= 0) || (height <= 0) ||
+        (outWidth <= 0) || (outWidth > width) ||
+        (outHeight <= 0) || (outHeight > height) ||
+        (stride < ((size_t)outWidth*4)))
+    {
+        // Invalid images sizes
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+    m_outWidth = outWidth;
+    m_outHeight = outHeight;
+    m_filter = filter;
+    m_gamma = gammaCorrect;
+    m_out = out;
+    m_stride = stride;
+
+    // Filter support radius in output pixels
+    double radius = (m_filter == IMAGEDOWNSCALER_FILTER_KAISER) ?
+        ImageDownscalerKaiserRadius : 0.5;
+    uint32_t xMaxTaps = static_cast<uint32_t>(
+        std::ceil(radius*2.0*width / outWidth)
+    ) + 2;
+    uint32_t yMaxTaps = static_cast<uint32_t>(
+        std::ceil(radius*2.0*height / outHeight)
+    ) + 2;
+
+    // Allocate filter taps
+    m_xStarts = new (std::nothrow) uint32_t[outWidth];
+    m_xCounts = new (std::nothrow) uint32_t[outWidth];
+    m_xWeights = new (std::nothrow) float[(size_t)outWidth*xMaxTaps];
+    m_yStarts = new (std::nothrow) uint32_t[outHeight];
+    m_yCounts = new (std::nothrow) uint32_t[outHeight];
+    m_yWeights = new (std::nothrow) float[(size_t)outHeight*yMaxTaps];
+    if (!m_xStarts || !m_xCounts || !m_xWeights ||
+        !m_yStarts || !m_yCounts || !m_yWeights)
+    {
+        // Could not allocate filter taps
+        destroyDownscaler();
+        return false;
+    }
+
+    // Compute filter taps
+    m_xTaps = xMaxTaps;
+    m_yTaps = yMaxTaps;
+    computeTaps(width, outWidth, m_xStarts, m_xCounts, m_xWeights, m_xTaps);
+    computeTaps(height, outHeight, m_yStarts, m_yCounts, m_yWeights, m_yTaps);
+
+    // Allocate linear source row and filtered rows ring
+    m_linear = new (std::nothrow) float[(size_t)width*4];
+    m_ring = new (std::nothrow) float[(size_t)outWidth*4*m_yTaps];
+    if (!m_linear || !m_ring)
+    {
+        // Could not allocate filtered rows
+        destroyDownscaler();
+        return false;
+    }
+
+    // Image downscaler is ready
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Push next source RGBA row                                                 //
+//  return : True if the row is successfully filtered                         //
+////////////////////////////////////////////////////////////////////////////////
+bool ImageDownscaler::pushRow(const unsigned char* row)
+{
+    // Check source row
+    if (!m_ring || !row || (m_rowsIn >= m_height))
+    {
+        // Invalid source row
+        return false;
+    }
+
+    // Convert source row to alpha weighted linear colors
+    const ImageGammaTables& tables = ImageGetGammaTables();
+    for (uint32_t i = 0; i < m_width; ++i)
+    {
+        const unsigned char* in = &row[i*4];
+        float* linear = &m_linear[i*4];
+        float alpha = ((in[3]*(1.0f/255.0f)) + ImageDownscalerAlphaBias);
+        if (m_gamma)
+        {
+            linear[0] = (tables.toLinear[in[0]]*alpha);
+            linear[1] = (tables.toLinear[in[1]]*alpha);
+            linear[2] = (tables.toLinear[in[2]]*alpha);
+        }
+        else
+        {
+            linear[0] = (in[0]*(1.0f/255.0f)*alpha);
+            linear[1] = (in[1]*(1.0f/255.0f)*alpha);
+            linear[2] = (in[2]*(1.0f/255.0f)*alpha);
+        }
+        linear[3] = alpha;
+    }
+
+    // Filter source row horizontally into the rows ring
+    float* filtered = &m_ring[(size_t)(m_rowsIn % m_yTaps)*m_outWidth*4];
+    for (uint32_t i = 0; i < m_outWidth; ++i)
+    {
+        const float* weights = &m_xWeights[(size_t)i*m_xTaps];
+        const float* linear = &m_linear[(size_t)m_xStarts[i]*4];
+        float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t k = 0; k < m_xCounts[i]; ++k)
+        {
+            sum[0] += (linear[0]*weights[k]);
+            sum[1] += (linear[1]*weights[k]);
+            sum[2] += (linear[2]*weights[k]);
+            sum[3] += (linear[3]*weights[k]);
+            linear += 4;
+        }
+        memcpy(&filtered[i*4], sum, sizeof(sum));
+    }
+    ++m_rowsIn;
+
+    // Write output rows whose vertical taps are all available
+    while ((m_rowsOut < m_outHeight) &&
+        ((m_yStarts[m_rowsOut] + m_yCounts[m_rowsOut]) <= m_rowsIn))
+    {
+        writeRow(m_rowsOut++);
+    }
+
+    // Source row is successfully filtered
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Finish image downscaler                                                   //
+//  return : True if every source row was pushed                              //
+////////////////////////////////////////////////////////////////////////////////
+bool ImageDownscaler::finish()
+{
+    return (m_ring && (m_rowsIn == m_height) && (m_rowsOut == m_outHeight));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Destroy image downscaler                                                  //
+////////////////////////////////////////////////////////////////////////////////
+void ImageDownscaler::destroyDownscaler()
+{
+    if (m_ring) { delete[] m_ring; }
+    if (m_linear) { delete[] m_linear; }
+    if (m_yWeights) { delete[] m_yWeights; }
+    if (m_yCounts) { delete[] m_yCounts; }
+    if (m_yStarts) { delete[] m_yStarts; }
+    if (m_xWeights) { delete[] m_xWeights; }
+    if (m_xCounts) { delete[] m_xCounts; }
+    if (m_xStarts) { delete[] m_xStarts; }
+    m_rowsOut = 0;
+    m_rowsIn = 0;
+    m_ring = 0;
+    m_linear = 0;
+    m_yTaps = 0;
+    m_yWeights = 0;
+    m_yCounts = 0;
+    m_yStarts = 0;
+    m_xTaps = 0;
+    m_xWeights = 0;
+    m_xCounts = 0;
+    m_xStarts = 0;
+    m_stride = 0;
+    m_out = 0;
+    m_gamma = true;
+    m_filter = IMAGEDOWNSCALER_FILTER_BOX;
+    m_outHeight = 0;
+    m_outWidth = 0;
+    m_height = 0;
+    m_width = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compute filter taps of one axis                                           //
+//  Taps outside of the image are dropped and the weights renormalized        //
+////////////////////////////////////////////////////////////////////////////////
+void ImageDownscaler::computeTaps(uint32_t size, uint32_t outSize,
+    uint32_t* starts, uint32_t* counts, float* weights, uint32_t maxTaps)
+{
+    double scale = (size / (double)outSize);
+    bool kaiser = (m_filter == IMAGEDOWNSCALER_FILTER_KAISER);
+    double radius = (kaiser ? ImageDownscalerKaiserRadius : 0.5)*scale;
+
+    for (uint32_t i = 0; i < outSize; ++i)
+    {
+        // Source pixels covered by the filter
+        double center = ((i+0.5)*scale);
+        int64_t first = static_cast<int64_t>(std::floor(center-radius));
+        int64_t last = static_cast<int64_t>(std::ceil(center+radius));
+        if (first < 0) { first = 0; }
+        if (last > size) { last = size; }
+        if ((last-first) > maxTaps) { last = (first+maxTaps); }
+
+        // Compute taps weights
+        float* tapWeights = &weights[(size_t)i*maxTaps];
+        double sum = 0.0;
+        for (int64_t j = first; j < last; ++j)
+        {
+            double weight = 0.0;
+            if (kaiser)
+            {
+                weight = ImageKaiserFilter((j+0.5-center) / scale);
+            }
+            else
+            {
+                // Box filter weight is the covered part of the pixel
+                double start = (center-radius);
+                double end = (center+radius);
+                if (start < j) { start = static_cast<double>(j); }
+                if (end > (j+1)) { end = static_cast<double>(j+1); }
+                weight = (end > start) ? (end-start) : 0.0;
+            }
+            tapWeights[j-first] = static_cast<float>(weight);
+            sum += weight;
+        }
+
+        // Normalize taps weights
+        uint32_t count = static_cast<uint32_t>(last-first);
+        for (uint32_t k = 0; k < count; ++k)
+        {
+            tapWeights[k] = static_cast<float>(tapWeights[k] / sum);
+        }
+        starts[i] = static_cast<uint32_t>(first);
+        counts[i] = count;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Write output row from the filtered rows ring                              //
+////////////////////////////////////////////////////////////////////////////////
+void ImageDownscaler::writeRow(uint32_t y)
+{
+    const ImageGammaTables& tables = ImageGetGammaTables();
+    const float* weights = &m_yWeights[(size_t)y*m_yTaps];
+    unsigned char* out = &m_out[(size_t)y*m_stride];
+    size_t rowSize = ((size_t)m_outWidth*4);
+
+    for (uint32_t i = 0; i < m_outWidth; ++i)
+    {
+        // Filter rows ring vertically
+        float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t k = 0; k < m_yCounts[y]; ++k)
+        {
+            uint32_t row = ((m_yStarts[y]+k) % m_yTaps);
+            const float* filtered = &m_ring[(row*rowSize)+(i*4)];
+            sum[0] += (filtered[0]*weights[k]);
+            sum[1] += (filtered[1]*weights[k]);
+            sum[2] += (filtered[2]*weights[k]);
+            sum[3] += (filtered[3]*weights[k]);
+        }
+
+        // Unweight colors by alpha
+        float alpha = (sum[3] - ImageDownscalerAlphaBias);
+        float invAlpha = (sum[3] > 0.0f) ? (1.0f/sum[3]) : 0.0f;
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            float value = (c < 3) ? (sum[c]*invAlpha) : alpha;
+            if (value < 0.0f) { value = 0.0f; }
+            if (value > 1.0f) { value = 1.0f; }
+            if (m_gamma && (c < 3))
+            {
+                out[c] = tables.toSRGB[static_cast<uint32_t>(
+                    (value*(ImageDownscalerGammaTableSize-1))+0.5f
+                )];
+            }
+            else
+            {
+                out[c] = static_cast<unsigned char>((value*255.0f)+0.5f);
+            }
+        }
+        out += 4;
+    }
+}
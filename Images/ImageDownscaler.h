@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/ImageDownscaler.h : Image downscaling and mip chain             //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_IMAGES_IMAGEDOWNSCALER_HEADER
+#define WOS_IMAGES_IMAGEDOWNSCALER_HEADER
+
+    #include "../System/System.h"
+    #include "../Math/Math.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <cmath>
+    #include <new>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ImageDownscaler settings                                              //
+    ////////////////////////////////////////////////////////////////////////////
+    const uint32_t ImageDownscalerMaxShift = 3;
+    const float ImageDownscalerKaiserRadius = 2.0f;
+    const float ImageDownscalerKaiserAlpha = 4.0f;
+    const float ImageDownscalerAlphaBias = 0.0001f;
+    const uint32_t ImageDownscalerGammaTableSize = 16384;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ImageDownscaler filter enumeration                                    //
+    //  BOX averages the source pixels covered by each output pixel           //
+    //  KAISER is a Kaiser windowed sinc, sharper but slower                  //
+    ////////////////////////////////////////////////////////////////////////////
+    enum ImageDownscalerFilter
+    {
+        IMAGEDOWNSCALER_FILTER_BOX = 0,
+        IMAGEDOWNSCALER_FILTER_KAISER = 1
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Get downscaled image size                                             //
+    //  return : Image size divided by 2^shift (at least 1 pixel)             //
+    ////////////////////////////////////////////////////////////////////////////
+    inline uint32_t ImageDownscaledSize(uint32_t size, uint32_t shift)
+    {
+        size >>= shift;
+        return ((size > 0) ? size : 1);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Get image full mip chain levels count                                 //
+    //  return : Mip levels count down to 1x1 (including the image)           //
+    ////////////////////////////////////////////////////////////////////////////
+    inline uint32_t ImageMipLevels(uint32_t width, uint32_t height)
+    {
+        uint32_t size = ((width > height) ? width : height);
+        uint32_t levels = 1;
+        while (size > 1) { size >>= 1; ++levels; }
+        return levels;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Get image mip chain size                                              //
+    //  Mip levels are tightly packed RGBA images, one after the other        //
+    //  return : Size in bytes of the first levels of the mip chain           //
+    ////////////////////////////////////////////////////////////////////////////
+    inline size_t ImageMipChainSize(uint32_t width, uint32_t height,
+        uint32_t levels)
+    {
+        size_t size = 0;
+        for (uint32_t i = 0; i < levels; ++i)
+        {
+            size += ((size_t)ImageDownscaledSize(width, i)*
+                ImageDownscaledSize(height, i)*4);
+        }
+        return size;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Generate image mip chain                                              //
+    //  chain holds the RGBA image, followed by room for the other levels     //
+    //  return : True if the mip chain is successfully generated              //
+    ////////////////////////////////////////////////////////////////////////////
+    bool ImageGenerateMipmaps(unsigned char* chain,
+        uint32_t width, uint32_t height, uint32_t levels,
+        ImageDownscalerFilter filter, bool gammaCorrect);
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  ImageDownscaler class definition                                      //
+    //  Source RGBA rows are pushed one by one, each row is filtered          //
+    //  horizontally into a ring of rows, and output rows are written as soon //
+    //  as their vertical taps are available, so the source image is never    //
+    //  needed as a whole                                                     //
+    //  Gamma correct filtering converts sRGB colors to linear light, colors  //
+    //  are weighted by alpha so that transparent pixels do not bleed         //
+    ////////////////////////////////////////////////////////////////////////////
+    class ImageDownscaler
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  ImageDownscaler default constructor                           //
+            ////////////////////////////////////////////////////////////////////
+            ImageDownscaler();
+
+            ////////////////////////////////////////////////////////////////////
+            //  ImageDownscaler destructor                                    //
+            ////////////////////////////////////////////////////////////////////
+            ~ImageDownscaler();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Init image downscaler                                         //
+            //  Output rows are written stride bytes apart into out           //
+            //  return : True if the image downscaler is ready                //
+            ////////////////////////////////////////////////////////////////////
+            bool init(uint32_t width, uint32_t height,
+                uint32_t outWidth, uint32_t outHeight,
+                ImageDownscalerFilter filter, bool gammaCorrect,
+                unsigned char* out, size_t stride);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Push next source RGBA row                                     //
+            //  return : True if the row is successfully filtered             //
+            ////////////////////////////////////////////////////////////////////
+            bool pushRow(const unsigned char* row);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Finish image downscaler                                       //
+            //  return : True if every source row was pushed                  //
+            ////////////////////////////////////////////////////////////////////
+            bool finish();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Destroy image downscaler                                      //
+            ////////////////////////////////////////////////////////////////////
+            void destroyDownscaler();
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  ImageDownscaler private copy constructor : Not copyable       //
+            ////////////////////////////////////////////////////////////////////
+            ImageDownscaler(const ImageDownscaler&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  ImageDownscaler private copy operator : Not copyable          //
+            ////////////////////////////////////////////////////////////////////
+            ImageDownscaler& operator=(const ImageDownscaler&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Compute filter taps of one axis                               //
+            ////////////////////////////////////////////////////////////////////
+            void computeTaps(uint32_t size, uint32_t outSize,
+                uint32_t* starts, uint32_t* counts, float* weights,
+                uint32_t maxTaps);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Write output row from the filtered rows ring                  //
+            ////////////////////////////////////////////////////////////////////
+            void writeRow(uint32_t y);
+
+
+        private:
+            uint32_t            m_width;        // Source width
+            uint32_t            m_height;       // Source height
+            uint32_t            m_outWidth;     // Output width
+            uint32_t            m_outHeight;    // Output height
+            ImageDownscalerFilter m_filter;     // Filter type
+            bool                m_gamma;        // Gamma correct filtering
+            unsigned char*      m_out;          // Output image
+            size_t              m_stride;       // Output rows stride
+
+            uint32_t*           m_xStarts;      // Horizontal first taps
+            uint32_t*           m_xCounts;      // Horizontal taps counts
+            float*              m_xWeights;     // Horizontal taps weights
+            uint32_t            m_xTaps;        // Horizontal max taps
+            uint32_t*           m_yStarts;      // Vertical first taps
+            uint32_t*           m_yCounts;      // Vertical taps counts
+            float*              m_yWeights;     // Vertical taps weights
+            uint32_t            m_yTaps;        // Vertical max taps
+
+            float*              m_linear;       // Linear source row
+            float*              m_ring;         // Filtered rows ring
+            uint32_t            m_rowsIn;       // Pushed source rows
+            uint32_t            m_rowsOut;      // Written output rows
+    };
+
+
+#endif // WOS_IMAGES_IMAGEDOWNSCALER_HEADER
@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/KTXFile.cpp : KTX2 compressed texture file                      //
+////////////////////////////////////////////////////////////////////////////////
+#include "KTXFile.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  KTXFile default constructor                                               //
+////////////////////////////////////////////////////////////////////////////////
+KTXFile::KTXFile() :
+m_format(BLOCKFORMAT_NONE),
+m_width(0),
+m_height(0),
+m_levels(0)
+{
+    for (uint32_t i = 0; i < KTXFileMaxLevels; ++i)
+    {
+        m_levelData[i] = 0;
+        m_levelSize[i] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  KTXFile destructor                                                        //
+////////////////////////////////////////////////////////////////////////////////
+KTXFile::~KTXFile()
+{
+    destroyFile();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check KTX2 file identifier                                                //
+//  return : True if the data start with the KTX2 identifier                  //
+////////////////////////////////////////////////////////////////////////////////
+bool KTXFile::probe(const unsigned char* data, size_t size)
+{
+    return (data && (size >= sizeof(KTXFileIdentifier)) &&
+        (memcmp(data, KTXFileIdentifier, sizeof(KTXFileIdentifier)) == 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Open KTX2 file from memory (data must outlive the file)                   //
+//  return : True if the KTX2 file is valid                                   //
+////////////////////////////////////////////////////////////////////////////////
+bool KTXFile::open(const unsigned char* data, size_t size)
+{
+    // Reset KTX2 file
+    destroyFile();
+
+    // Check KTX2 header
+    if (!probe(data, size) || (size < KTXFileHeaderSize))
+    {
+        // Invalid KTX2 header
+        return false;
+    }
+    uint32_t header[9] = {0};
+    memcpy(header, &data[12], sizeof(uint32_t)*9);
+
+    // Check KTX2 format
+    BlockFormat format = BLOCKFORMAT_NONE;
+    switch (header[0])
+    {
+        case KTXFileVkFormatBC1: format = BLOCKFORMAT_BC1; break;
+        case KTXFileVkFormatBC1A: format = BLOCKFORMAT_BC1A; break;
+        case KTXFileVkFormatBC3: format = BLOCKFORMAT_BC3; break;
+        case KTXFileVkFormatETC2: format = BLOCKFORMAT_ETC2; break;
+        case KTXFileVkFormatETC2A1: format = BLOCKFORMAT_ETC2A1; break;
+        case KTXFileVkFormatETC2A8: format = BLOCKFORMAT_ETC2A8; break;
+        case KTXFileVkFormatASTC4x4: format = BLOCKFORMAT_ASTC4X4; break;
+        default:
+            // Unsupported KTX2 format
+            return false;
+    }
+
+    // Check KTX2 texture type (2D, without supercompression)
+    uint32_t width = header[2];
+    uint32_t height = header[3];
+    uint32_t levels = ((header[7] > 0) ? header[7] : 1);
+    if ((header[1] != 1) || (header[4] != 0) || (header[5] > 1) ||
+        (header[6] != 1) || (header[8] != 0))
+    {
+        // Unsupported KTX2 texture type
+        return false;
+    }
+    if ((width <= 0) || (width > KTXFileMaxImageWidth) ||
+        (height <= 0) || (height > KTXFileMaxImageHeight) ||
+        (levels > ImageMipLevels(width, height)))
+    {
+        // Invalid KTX2 texture size
+        return false;
+    }
+    if ((KTXFileHeaderSize + levels*KTXFileLevelIndexSize) > size)
+    {
+        // Invalid KTX2 levels index
+        return false;
+    }
+
+    // Read KTX2 levels index (level 0 is the base level)
+    for (uint32_t i = 0; i < levels; ++i)
+    {
+        uint64_t level[3] = {0};
+        memcpy(level,
+            &data[KTXFileHeaderSize + i*KTXFileLevelIndexSize],
+            sizeof(uint64_t)*3
+        );
+        size_t levelSize = BlockImageSize(format,
+            ImageDownscaledSize(width, i), ImageDownscaledSize(height, i)
+        );
+        if ((level[1] != levelSize) || (level[2] != levelSize) ||
+            (level[0] > size) || (level[1] > (size - level[0])))
+        {
+            // Invalid KTX2 level
+            destroyFile();
+            return false;
+        }
+        m_levelData[i] = &data[level[0]];
+        m_levelSize[i] = levelSize;
+    }
+
+    // KTX2 file is valid
+    m_format = format;
+    m_width = width;
+    m_height = height;
+    m_levels = levels;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get transcoded mip chain size                                             //
+//  return : Size in bytes of levels mip levels from first level              //
+////////////////////////////////////////////////////////////////////////////////
+size_t KTXFile::getTranscodedSize(BlockTarget target,
+    uint32_t first, uint32_t levels) const
+{
+    if (first >= m_levels) { return 0; }
+    if (levels > (m_levels - first)) { levels = (m_levels - first); }
+    return ((ImageMipChainSize(ImageDownscaledSize(m_width, first),
+        ImageDownscaledSize(m_height, first), levels)/4)*
+        BlockTargetPixelSize(target));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Transcode mip levels into a packed mip chain                              //
+//  return : True if the mip levels are successfully transcoded               //
+////////////////////////////////////////////////////////////////////////////////
+bool KTXFile::transcode(unsigned char* out, BlockTarget target,
+    uint32_t first, uint32_t levels) const
+{
+    if (first >= m_levels) { return false; }
+    if (levels > (m_levels - first)) { levels = (m_levels - first); }
+    for (uint32_t i = 0; i < levels; ++i)
+    {
+        if (!BlockTranscode(m_format, m_levelData[first+i],
+            ImageDownscaledSize(m_width, first+i),
+            ImageDownscaledSize(m_height, first+i),
+            &out[getTranscodedSize(target, first, i)], target))
+        {
+            // Could not transcode mip level
+            return false;
+        }
+    }
+    return (levels > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reset KTX2 file                                                           //
+////////////////////////////////////////////////////////////////////////////////
+void KTXFile::destroyFile()
+{
+    for (uint32_t i = 0; i < KTXFileMaxLevels; ++i)
+    {
+        m_levelData[i] = 0;
+        m_levelSize[i] = 0;
+    }
+    m_levels = 0;
+    m_height = 0;
+    m_width = 0;
+    m_format = BLOCKFORMAT_NONE;
+}
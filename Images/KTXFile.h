@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/KTXFile.h : KTX2 compressed texture file                        //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_IMAGES_KTXFILE_HEADER
+#define WOS_IMAGES_KTXFILE_HEADER
+
+    #include "../System/System.h"
+    #include "BlockTranscoder.h"
+    #include "ImageDownscaler.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  KTXFile settings                                                      //
+    ////////////////////////////////////////////////////////////////////////////
+    const unsigned char KTXFileIdentifier[12] =
+    {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+    const uint32_t KTXFileMaxImageWidth = 4096;
+    const uint32_t KTXFileMaxImageHeight = 4096;
+    const uint32_t KTXFileMaxLevels = 13;
+    const size_t KTXFileHeaderSize = 80;
+    const size_t KTXFileLevelIndexSize = 24;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  KTXFile Vulkan formats (linear formats only)                          //
+    ////////////////////////////////////////////////////////////////////////////
+    const uint32_t KTXFileVkFormatBC1 = 131;
+    const uint32_t KTXFileVkFormatBC1A = 133;
+    const uint32_t KTXFileVkFormatBC3 = 137;
+    const uint32_t KTXFileVkFormatETC2 = 147;
+    const uint32_t KTXFileVkFormatETC2A1 = 149;
+    const uint32_t KTXFileVkFormatETC2A8 = 151;
+    const uint32_t KTXFileVkFormatASTC4x4 = 157;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  KTXFile class definition                                              //
+    //  KTX2 subset : 2D textures (no array, no cubemap) with BC1, BC3,       //
+    //  ETC2 or ASTC 4x4 blocks, and without supercompression                 //
+    //  Mip levels are viewed in place in the file data                       //
+    ////////////////////////////////////////////////////////////////////////////
+    class KTXFile
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  KTXFile default constructor                                   //
+            ////////////////////////////////////////////////////////////////////
+            KTXFile();
+
+            ////////////////////////////////////////////////////////////////////
+            //  KTXFile destructor                                            //
+            ////////////////////////////////////////////////////////////////////
+            ~KTXFile();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Check KTX2 file identifier                                    //
+            //  return : True if the data start with the KTX2 identifier      //
+            ////////////////////////////////////////////////////////////////////
+            static bool probe(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Open KTX2 file from memory (data must outlive the file)       //
+            //  return : True if the KTX2 file is valid                       //
+            ////////////////////////////////////////////////////////////////////
+            bool open(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get transcoded mip chain size                                 //
+            //  return : Size in bytes of levels mip levels from first level  //
+            ////////////////////////////////////////////////////////////////////
+            size_t getTranscodedSize(BlockTarget target,
+                uint32_t first, uint32_t levels) const;
+
+            ////////////////////////////////////////////////////////////////////
+            //  Transcode mip levels into a packed mip chain                  //
+            //  out must hold getTranscodedSize bytes                         //
+            //  return : True if the mip levels are successfully transcoded   //
+            ////////////////////////////////////////////////////////////////////
+            bool transcode(unsigned char* out, BlockTarget target,
+                uint32_t first, uint32_t levels) const;
+
+            ////////////////////////////////////////////////////////////////////
+            //  Reset KTX2 file                                               //
+            ////////////////////////////////////////////////////////////////////
+            void destroyFile();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Check if the KTX2 file is opened                              //
+            //  return : True if the KTX2 file is valid                       //
+            ////////////////////////////////////////////////////////////////////
+            inline bool isValid() const
+            {
+                return (m_format != BLOCKFORMAT_NONE);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get KTX2 file block format                                    //
+            //  return : Block format                                         //
+            ////////////////////////////////////////////////////////////////////
+            inline BlockFormat getFormat() const
+            {
+                return m_format;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get KTX2 file width                                           //
+            //  return : Base level width in pixels                           //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getWidth() const
+            {
+                return m_width;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get KTX2 file height                                          //
+            //  return : Base level height in pixels                          //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getHeight() const
+            {
+                return m_height;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get KTX2 file mip levels count                                //
+            //  return : Number of stored mip levels                          //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getLevels() const
+            {
+                return m_levels;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get KTX2 file mip level data                                  //
+            //  return : Mip level blocks                                     //
+            ////////////////////////////////////////////////////////////////////
+            inline const unsigned char* getLevelData(uint32_t level) const
+            {
+                return m_levelData[level];
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get KTX2 file mip level size                                  //
+            //  return : Mip level blocks size in bytes                       //
+            ////////////////////////////////////////////////////////////////////
+            inline size_t getLevelSize(uint32_t level) const
+            {
+                return m_levelSize[level];
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  KTXFile private copy constructor : Not copyable               //
+            ////////////////////////////////////////////////////////////////////
+            KTXFile(const KTXFile&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  KTXFile private copy operator : Not copyable                  //
+            ////////////////////////////////////////////////////////////////////
+            KTXFile& operator=(const KTXFile&) = delete;
+
+
+        private:
+            BlockFormat             m_format;       // Block format
+            uint32_t                m_width;        // Base level width
+            uint32_t                m_height;       // Base level height
+            uint32_t                m_levels;       // Mip levels count
+
+            const unsigned char*    m_levelData[KTXFileMaxLevels];
+            size_t                  m_levelSize[KTXFileMaxLevels];
+    };
+
+
+#endif // WOS_IMAGES_KTXFILE_HEADER
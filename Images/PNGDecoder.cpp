@@ -0,0 +1,1485 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/PNGDecoder.cpp : PNG streaming decoder                          //
+////////////////////////////////////////////////////////////////////////////////
+#include "PNGDecoder.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check PNG chunk type                                                      //
+//  return : True if the chunk type matches the expected type                 //
+////////////////////////////////////////////////////////////////////////////////
+inline bool PNGDecoderIsChunk(const unsigned char* type,
+    const unsigned char* expected)
+{
+    return ((type[0] == expected[0]) && (type[1] == expected[1]) &&
+        (type[2] == expected[2]) && (type[3] == expected[3]));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read PNG big endian 32 bits value                                         //
+//  return : Native 32 bits value                                             //
+////////////////////////////////////////////////////////////////////////////////
+inline uint32_t PNGDecoderRead32(const unsigned char* data)
+{
+    return (((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+        ((uint32_t)data[2] << 8) | (uint32_t)data[3]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read PNG big endian 16 bits value                                         //
+//  return : Native 16 bits value                                             //
+////////////////////////////////////////////////////////////////////////////////
+inline uint16_t PNGDecoderRead16(const unsigned char* data)
+{
+    return (uint16_t)(((uint32_t)data[0] << 8) | (uint32_t)data[1]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read PNG packed sample (1, 2, 4 or 8 bits, most significant bits first)   //
+//  return : Sample value at index in the scanline                            //
+////////////////////////////////////////////////////////////////////////////////
+inline uint32_t PNGDecoderSample(const unsigned char* data, uint32_t index,
+    uint32_t depth)
+{
+    size_t bit = ((size_t)index*depth);
+    return ((data[bit >> 3] >> (8 - depth - (bit & 7))) & ((1u << depth)-1));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  PNGDecoder default constructor                                            //
+////////////////////////////////////////////////////////////////////////////////
+PNGDecoder::PNGDecoder() :
+m_state(PNGDECODER_STATE_ERROR),
+m_verify(PNGFILE_VERIFY_FULL),
+m_inflater(),
+m_context(),
+m_deferData(false),
+m_data(0),
+m_dataCapacity(0),
+m_raw(0),
+m_rawCapacity(0),
+m_bufferSize(0),
+m_chunkLength(0),
+m_chunkLeft(0),
+m_chunkCRC(0),
+m_checkCRC(false),
+m_chunksCount(0),
+m_dataStarted(false),
+m_dataEnded(false),
+m_image(0),
+m_stride(0),
+m_ownedImage(0),
+m_ownedSize(0),
+m_destination(0),
+m_destSize(0),
+m_destStride(0),
+m_width(0),
+m_height(0),
+m_imageWidth(0),
+m_imageHeight(0),
+m_mipLevels(1),
+m_colorType(PNGFILE_COLOR_RGBA),
+m_bitDepth(0),
+m_pixelDepth(0),
+m_pixelBits(0),
+m_paletteSize(0),
+m_hasColorKey(false),
+m_rows(0),
+m_rowsCapacity(0),
+m_row(0),
+m_prevRow(0),
+m_rowSize(0),
+m_rowFill(0),
+m_rowIndex(0),
+m_pass(0),
+m_lastPass(0),
+m_passWidth(0),
+m_passHeight(0),
+m_passRow(0),
+m_passCapacity(0),
+m_callback(0),
+m_userData(0),
+m_bandRows(PNGFileStreamBandRows),
+m_bandStart(0),
+m_tileSize(0),
+m_tilesCount(0),
+m_tileCallback(0),
+m_tileUserData(0),
+m_downscale(0),
+m_shift(0),
+m_filter(IMAGEDOWNSCALER_FILTER_BOX),
+m_gamma(true),
+m_mipmaps(false),
+m_downscaler()
+{
+    memset(m_buffer, 0, sizeof(m_buffer));
+    memset(m_chunkType, 0, sizeof(m_chunkType));
+    memset(m_chunkData, 0, sizeof(m_chunkData));
+    memset(m_palette, 0, sizeof(m_palette));
+    memset(m_colorKey, 0, sizeof(m_colorKey));
+    ZLibInitDecodeContext(m_context);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  PNGDecoder destructor                                                     //
+////////////////////////////////////////////////////////////////////////////////
+PNGDecoder::~PNGDecoder()
+{
+    destroyDecoder();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Init PNG decoder for a new stream                                         //
+//  return : True if the decoder is ready                                     //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::init(const PNGFileLoadOptions& options)
+{
+    // Reset decoder, scratch buffers are reused
+    resetDecoder();
+
+    // Skip checksums only for manifest validated assets
+    m_verify = options.verify;
+    if ((m_verify == PNGFILE_VERIFY_SKIP) && !options.manifestValidated)
+    {
+        m_verify = PNGFILE_VERIFY_FULL;
+    }
+
+    // Downscale and mip chain settings
+    m_downscale = options.downscale;
+    if (m_downscale > ImageDownscalerMaxShift)
+    {
+        m_downscale = ImageDownscalerMaxShift;
+    }
+    m_filter = options.filter;
+    m_gamma = options.gammaCorrect;
+    m_mipmaps = options.mipmaps;
+
+    // PNG decoder is ready
+    m_state = PNGDECODER_STATE_SIGNATURE;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Set PNG decoder rows callback                                             //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::setRowsCallback(PNGFileRowsCallback callback, void* userData,
+    uint32_t bandRows)
+{
+    m_callback = callback;
+    m_userData = userData;
+    m_bandRows = (bandRows > 0) ? bandRows : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Set PNG decoder destination image (before the header)                     //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::setDestination(unsigned char* image, size_t size,
+    size_t stride)
+{
+    m_destination = image;
+    m_destSize = image ? size : 0;
+    m_destStride = image ? stride : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Set PNG decoder tiled mode (before the header)                            //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::setTiles(uint32_t tileSize, PNGFileTileCallback callback,
+    void* userData)
+{
+    m_tileSize = tileSize;
+    m_tileCallback = (tileSize > 0) ? callback : 0;
+    m_tileUserData = (tileSize > 0) ? userData : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Feed PNG data chunk to the decoder                                        //
+//  return : False if the stream is invalid                                   //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::feed(const unsigned char* data, size_t size)
+{
+    // Check decoder state
+    if ((m_state == PNGDECODER_STATE_ERROR) || (!data && (size > 0)))
+    {
+        // Invalid decoder state
+        m_state = PNGDECODER_STATE_ERROR;
+        return false;
+    }
+
+    while (size > 0)
+    {
+        switch (m_state)
+        {
+            case PNGDECODER_STATE_SIGNATURE:
+            case PNGDECODER_STATE_CHUNKHEADER:
+            case PNGDECODER_STATE_CHUNKCRC:
+            {
+                // Buffer signature, chunk header or chunk CRC
+                uint32_t expected = (m_state == PNGDECODER_STATE_CHUNKCRC) ?
+                    PNGFileChunkCRCSize : PNGFileChunkHeaderSize;
+                size_t count = (expected - m_bufferSize);
+                if (count > size) { count = size; }
+                memcpy(&m_buffer[m_bufferSize], data, count);
+                m_bufferSize += static_cast<uint32_t>(count);
+                data += count;
+                size -= count;
+                if (m_bufferSize < expected) { break; }
+                m_bufferSize = 0;
+
+                if (m_state == PNGDECODER_STATE_SIGNATURE)
+                {
+                    // Check PNG file signature
+                    if (memcmp(m_buffer, PNGFileSignature, 8) != 0)
+                    {
+                        // Invalid PNG file signature
+                        m_state = PNGDECODER_STATE_ERROR;
+                        return false;
+                    }
+                    m_state = PNGDECODER_STATE_CHUNKHEADER;
+                }
+                else if (m_state == PNGDECODER_STATE_CHUNKHEADER)
+                {
+                    if (!startChunk())
+                    {
+                        // Invalid PNG chunk header
+                        m_state = PNGDECODER_STATE_ERROR;
+                        return false;
+                    }
+                }
+                else
+                {
+                    if (!endChunk())
+                    {
+                        // Invalid PNG chunk
+                        m_state = PNGDECODER_STATE_ERROR;
+                        return false;
+                    }
+                }
+                break;
+            }
+
+            case PNGDECODER_STATE_CHUNKDATA:
+            {
+                // Read chunk data
+                size_t count = m_chunkLeft;
+                if (count > size) { count = size; }
+                if (!readChunkData(data, count))
+                {
+                    // Invalid PNG chunk data
+                    m_state = PNGDECODER_STATE_ERROR;
+                    return false;
+                }
+                m_chunkLeft -= static_cast<uint32_t>(count);
+                data += count;
+                size -= count;
+                if (m_chunkLeft <= 0)
+                {
+                    m_state = PNGDECODER_STATE_CHUNKCRC;
+                }
+                break;
+            }
+
+            case PNGDECODER_STATE_DONE:
+                // Ignore data after the IEND chunk
+                return true;
+
+            default:
+                // Invalid decoder state
+                m_state = PNGDECODER_STATE_ERROR;
+                return false;
+        }
+    }
+
+    // PNG data chunk is successfully fed
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode complete PNG data in one shot (call finish after)                  //
+//  return : False if the PNG data are invalid                                //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::decode(const unsigned char* data, size_t size)
+{
+    // Check decoder state
+    if ((m_state != PNGDECODER_STATE_SIGNATURE) || !data)
+    {
+        // Invalid decoder state
+        m_state = PNGDECODER_STATE_ERROR;
+        return false;
+    }
+
+    // Tiled images and incomplete image data are streamed
+    const unsigned char* imageData = 0;
+    size_t imageSize = 0;
+    if ((m_tileSize > 0) || !gatherData(data, size, imageData, imageSize))
+    {
+        return feed(data, size);
+    }
+
+    // Decode chunks, IDAT chunks are only checked
+    m_deferData = true;
+    if (!feed(data, size))
+    {
+        // Invalid PNG data
+        return false;
+    }
+
+    // Inflate image data
+    if (!inflateImage(imageData, imageSize))
+    {
+        // Invalid PNG image data
+        m_state = PNGDECODER_STATE_ERROR;
+        return false;
+    }
+
+    // PNG data are successfully decoded
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Finish PNG decoder stream                                                 //
+//  return : True if the image is completely decoded                          //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::finish()
+{
+    // Check decoder state
+    if ((m_state == PNGDECODER_STATE_ERROR) || !m_image)
+    {
+        // Invalid decoder state
+        return false;
+    }
+
+    // Check image passes
+    if (m_pass <= m_lastPass)
+    {
+        // Incomplete PNG image data
+        m_state = PNGDECODER_STATE_ERROR;
+        return false;
+    }
+
+    // Check image data stream (one shot data are checked by the inflate)
+    if (!m_deferData && !m_inflater.finish())
+    {
+        // Invalid PNG image data stream
+        m_state = PNGDECODER_STATE_ERROR;
+        return false;
+    }
+
+    // Check downscaled image
+    if ((m_shift > 0) && !m_downscaler.finish())
+    {
+        // Incomplete downscaled image
+        m_state = PNGDECODER_STATE_ERROR;
+        return false;
+    }
+    m_downscaler.destroyDownscaler();
+
+    // Generate image mip chain
+    if ((m_mipLevels > 1) && !ImageGenerateMipmaps(m_image,
+        m_imageWidth, m_imageHeight, m_mipLevels, m_filter, m_gamma))
+    {
+        // Could not generate image mip chain
+        m_state = PNGDECODER_STATE_ERROR;
+        return false;
+    }
+
+    // PNG image is completely decoded
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Release PNG decoder image ownership                                       //
+//  return : Decoded RGBA image (to delete[] by the caller)                   //
+////////////////////////////////////////////////////////////////////////////////
+unsigned char* PNGDecoder::releaseImage()
+{
+    // Destination images are owned by the caller
+    if (!m_image || (m_image != m_ownedImage)) { return 0; }
+
+    unsigned char* image = m_ownedImage;
+    m_ownedImage = 0;
+    m_ownedSize = 0;
+    m_image = 0;
+    return image;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Destroy PNG decoder                                                       //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::destroyDecoder()
+{
+    m_inflater.destroyInflater();
+    m_downscaler.destroyDownscaler();
+    if (m_passRow) { delete[] m_passRow; }
+    if (m_rows) { delete[] m_rows; }
+    if (m_ownedImage) { delete[] m_ownedImage; }
+    if (m_raw) { delete[] m_raw; }
+    if (m_data) { delete[] m_data; }
+    m_passCapacity = 0;
+    m_passRow = 0;
+    m_rowsCapacity = 0;
+    m_rows = 0;
+    m_ownedSize = 0;
+    m_ownedImage = 0;
+    m_rawCapacity = 0;
+    m_raw = 0;
+    m_dataCapacity = 0;
+    m_data = 0;
+    resetDecoder();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reset PNG decoder stream state, keep the scratch buffers                  //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::resetDecoder()
+{
+    m_mipmaps = false;
+    m_gamma = true;
+    m_filter = IMAGEDOWNSCALER_FILTER_BOX;
+    m_shift = 0;
+    m_downscale = 0;
+    m_tileUserData = 0;
+    m_tileCallback = 0;
+    m_tilesCount = 0;
+    m_tileSize = 0;
+    m_bandStart = 0;
+    m_passHeight = 0;
+    m_passWidth = 0;
+    m_lastPass = 0;
+    m_pass = 0;
+    m_rowIndex = 0;
+    m_rowFill = 0;
+    m_rowSize = 0;
+    m_prevRow = 0;
+    m_row = 0;
+    m_hasColorKey = false;
+    m_paletteSize = 0;
+    m_pixelBits = 0;
+    m_pixelDepth = 0;
+    m_bitDepth = 0;
+    m_colorType = PNGFILE_COLOR_RGBA;
+    m_mipLevels = 1;
+    m_imageHeight = 0;
+    m_imageWidth = 0;
+    m_height = 0;
+    m_width = 0;
+    m_destStride = 0;
+    m_destSize = 0;
+    m_destination = 0;
+    m_stride = 0;
+    m_image = 0;
+    m_dataEnded = false;
+    m_dataStarted = false;
+    m_chunksCount = 0;
+    m_checkCRC = false;
+    m_chunkCRC = 0;
+    m_chunkLeft = 0;
+    m_chunkLength = 0;
+    m_bufferSize = 0;
+    m_deferData = false;
+    m_verify = PNGFILE_VERIFY_FULL;
+    m_state = PNGDECODER_STATE_ERROR;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Start PNG decoder chunk                                                   //
+//  return : True if the chunk header is valid                                //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::startChunk()
+{
+    // Read chunk header
+    m_chunkLength = PNGDecoderRead32(m_buffer);
+    memcpy(m_chunkType, &m_buffer[4], PNGFileChunkHeaderTypeSize);
+    if (m_chunkLength > 0x7FFFFFFF)
+    {
+        // Invalid PNG chunk length
+        return false;
+    }
+
+    // Check chunk order
+    bool isHeader = PNGDecoderIsChunk(m_chunkType, PNGFileIHDRChunkType);
+    if ((m_chunksCount <= 0) != isHeader)
+    {
+        // IHDR must be the first and only header chunk
+        return false;
+    }
+    if (isHeader && (m_chunkLength != PNGFileIHDRChunkSize))
+    {
+        // Invalid PNG file IHDR chunk length
+        return false;
+    }
+
+    // Check PLTE chunk
+    if (PNGDecoderIsChunk(m_chunkType, PNGFilePLTEChunkType))
+    {
+        if (m_dataStarted || (m_paletteSize > 0) ||
+            (m_chunkLength <= 0) || ((m_chunkLength % 3) != 0) ||
+            (m_chunkLength > PNGFilePLTEChunkMaxSize))
+        {
+            // Invalid PNG file PLTE chunk
+            return false;
+        }
+    }
+
+    // Check tRNS chunk
+    if (PNGDecoderIsChunk(m_chunkType, PNGFileTRNSChunkType))
+    {
+        if (m_dataStarted || (m_chunkLength > PNGFileTRNSChunkMaxSize))
+        {
+            // Invalid PNG file tRNS chunk
+            return false;
+        }
+    }
+
+    // Track IDAT chunks sequence
+    if (PNGDecoderIsChunk(m_chunkType, PNGFileIDATChunkType))
+    {
+        if (m_dataEnded)
+        {
+            // IDAT chunks must be consecutive
+            return false;
+        }
+        if ((m_colorType == PNGFILE_COLOR_PALETTE) && (m_paletteSize <= 0))
+        {
+            // Palette images require a PLTE chunk before image data
+            return false;
+        }
+        m_dataStarted = true;
+    }
+    else if (m_dataStarted)
+    {
+        m_dataEnded = true;
+    }
+
+    // FULL checks every chunk, HEADER checks the IHDR chunk only
+    m_checkCRC = (m_verify == PNGFILE_VERIFY_FULL) ||
+        (isHeader && (m_verify == PNGFILE_VERIFY_HEADER));
+    if (m_checkCRC)
+    {
+        m_chunkCRC = SysUpdateCRC32(
+            SysCRC32Default, m_chunkType, PNGFileChunkHeaderTypeSize
+        );
+    }
+
+    m_chunkLeft = m_chunkLength;
+    m_state = (m_chunkLength > 0) ?
+        PNGDECODER_STATE_CHUNKDATA : PNGDECODER_STATE_CHUNKCRC;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read PNG decoder chunk data                                               //
+//  return : True if the chunk data are valid                                 //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::readChunkData(const unsigned char* data, size_t size)
+{
+    // Update chunk CRC
+    if (m_checkCRC)
+    {
+        m_chunkCRC = SysUpdateCRC32(m_chunkCRC, data, size);
+    }
+
+    // Buffer IHDR, PLTE and tRNS chunks until their CRC is checked
+    if (PNGDecoderIsChunk(m_chunkType, PNGFileIHDRChunkType) ||
+        PNGDecoderIsChunk(m_chunkType, PNGFilePLTEChunkType) ||
+        PNGDecoderIsChunk(m_chunkType, PNGFileTRNSChunkType))
+    {
+        memcpy(&m_chunkData[m_chunkLength-m_chunkLeft], data, size);
+        return true;
+    }
+
+    // Inflate IDAT chunk, one shot data are inflated after the chunks
+    if (PNGDecoderIsChunk(m_chunkType, PNGFileIDATChunkType))
+    {
+        if (m_deferData) { return (m_image != 0); }
+        return inflateData(data, size);
+    }
+
+    // Skip other chunks
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  End PNG decoder chunk                                                     //
+//  return : True if the chunk CRC is valid                                   //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::endChunk()
+{
+    // Check chunk CRC
+    if (m_checkCRC)
+    {
+        if ((m_chunkCRC^SysCRC32Final) != PNGDecoderRead32(m_buffer))
+        {
+            // Invalid PNG chunk CRC
+            return false;
+        }
+    }
+    ++m_chunksCount;
+    m_state = PNGDECODER_STATE_CHUNKHEADER;
+
+    // Decode IHDR chunk
+    if (PNGDecoderIsChunk(m_chunkType, PNGFileIHDRChunkType))
+    {
+        return decodeHeader();
+    }
+
+    // Decode PLTE chunk
+    if (PNGDecoderIsChunk(m_chunkType, PNGFilePLTEChunkType))
+    {
+        return decodePalette();
+    }
+
+    // Decode tRNS chunk
+    if (PNGDecoderIsChunk(m_chunkType, PNGFileTRNSChunkType))
+    {
+        return decodeTransparency();
+    }
+
+    // End of PNG stream
+    if (PNGDecoderIsChunk(m_chunkType, PNGFileIENDChunkType))
+    {
+        m_state = PNGDECODER_STATE_DONE;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode PNG IHDR chunk and allocate the image                              //
+//  return : True if the image header is supported                            //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::decodeHeader()
+{
+    // Read PNG file IHDR chunk
+    PNGFileIHDRChunk pngIHDRChunk = {0, 0, 0, 0, 0, 0, 0};
+    pngIHDRChunk.width = PNGDecoderRead32(&m_chunkData[0]);
+    pngIHDRChunk.height = PNGDecoderRead32(&m_chunkData[4]);
+    pngIHDRChunk.bitDepth = m_chunkData[8];
+    pngIHDRChunk.colorType = m_chunkData[9];
+    pngIHDRChunk.compression = m_chunkData[10];
+    pngIHDRChunk.filter = m_chunkData[11];
+    pngIHDRChunk.interlace = m_chunkData[12];
+
+    // Check PNG file image size (tiled images can be larger)
+    uint32_t maxWidth = (m_tileSize > 0) ?
+        PNGFileMaxTiledImageWidth : PNGFileMaxImageWidth;
+    uint32_t maxHeight = (m_tileSize > 0) ?
+        PNGFileMaxTiledImageHeight : PNGFileMaxImageHeight;
+    if ((pngIHDRChunk.width <= 0) || (pngIHDRChunk.height <= 0) ||
+        (pngIHDRChunk.width > maxWidth) || (pngIHDRChunk.height > maxHeight))
+    {
+        // Invalid PNG file image size
+        return false;
+    }
+
+    // Check PNG file compression
+    if (pngIHDRChunk.compression != 0)
+    {
+        // Unsupported PNG file compression
+        return false;
+    }
+
+    // Check PNG file filter
+    if (pngIHDRChunk.filter != 0)
+    {
+        // Unsupported PNG file filter
+        return false;
+    }
+
+    // Check PNG file interlace (none or Adam7)
+    if (pngIHDRChunk.interlace > 1)
+    {
+        // Unsupported PNG file interlace
+        return false;
+    }
+
+    // Adam7 passes span the whole image, tiles need sequential rows
+    if ((pngIHDRChunk.interlace != 0) && (m_tileSize > 0))
+    {
+        // Interlaced PNG file cannot be tiled
+        return false;
+    }
+
+    // Check PNG file color type and bit depth
+    uint32_t channels = 0;
+    bool validDepth = false;
+    uint32_t depth = pngIHDRChunk.bitDepth;
+    switch (pngIHDRChunk.colorType)
+    {
+        case PNGFILE_COLOR_GREYSCALE:
+            channels = 1;
+            validDepth = ((depth == 1) || (depth == 2) || (depth == 4) ||
+                (depth == 8) || (depth == 16));
+            break;
+        case PNGFILE_COLOR_RGB:
+            channels = 3;
+            validDepth = ((depth == 8) || (depth == 16));
+            break;
+        case PNGFILE_COLOR_PALETTE:
+            channels = 1;
+            validDepth = ((depth == 1) || (depth == 2) || (depth == 4) ||
+                (depth == 8));
+            break;
+        case PNGFILE_COLOR_GREYSCALE_ALPHA:
+            channels = 2;
+            validDepth = ((depth == 8) || (depth == 16));
+            break;
+        case PNGFILE_COLOR_RGBA:
+            channels = 4;
+            validDepth = ((depth == 8) || (depth == 16));
+            break;
+        default:
+            // Unsupported PNG file color type
+            return false;
+    }
+    if (!validDepth)
+    {
+        // Unsupported PNG file bit depth
+        return false;
+    }
+    m_colorType = static_cast<PNGFileColorType>(pngIHDRChunk.colorType);
+    m_bitDepth = depth;
+    m_width = pngIHDRChunk.width;
+    m_height = pngIHDRChunk.height;
+
+    // Adam7 passes and tiles need the full size rows
+    m_shift = 0;
+    if ((pngIHDRChunk.interlace == 0) && (m_tileSize <= 0))
+    {
+        m_shift = m_downscale;
+    }
+    m_imageWidth = ImageDownscaledSize(m_width, m_shift);
+    m_imageHeight = ImageDownscaledSize(m_height, m_shift);
+    m_mipLevels = 1;
+    if (m_mipmaps && (m_tileSize <= 0) && !m_destination)
+    {
+        m_mipLevels = ImageMipLevels(m_imageWidth, m_imageHeight);
+    }
+
+    // Filters work on whole bytes (at least one byte per pixel)
+    m_pixelBits = (channels*depth);
+    m_pixelDepth = (m_pixelBits >> 3);
+    if (m_pixelDepth <= 0) { m_pixelDepth = 1; }
+
+    // Allocate current and previous scanlines (full width for all passes)
+    size_t rowSize = ((((size_t)m_width*m_pixelBits)+7) >> 3)+1;
+    if ((rowSize*2) > m_rowsCapacity)
+    {
+        if (m_rows) { delete[] m_rows; }
+        m_rowsCapacity = 0;
+        m_rows = new (std::nothrow) unsigned char[rowSize*2];
+        if (!m_rows)
+        {
+            // Could not allocate scanlines
+            return false;
+        }
+        m_rowsCapacity = (rowSize*2);
+    }
+    memset(m_rows, 0, rowSize*2);
+    m_row = m_rows;
+    m_prevRow = &m_rows[rowSize];
+
+    // Allocate Adam7, tiled or downscaled expanded scanline
+    size_t imageRowSize = ((size_t)m_width*4);
+    if (((pngIHDRChunk.interlace != 0) || (m_tileSize > 0) ||
+        (m_shift > 0)) && (imageRowSize > m_passCapacity))
+    {
+        if (m_passRow) { delete[] m_passRow; }
+        m_passCapacity = 0;
+        m_passRow = new (std::nothrow) unsigned char[imageRowSize];
+        if (!m_passRow)
+        {
+            // Could not allocate pass scanline
+            return false;
+        }
+        m_passCapacity = imageRowSize;
+    }
+
+    if (m_tileSize > 0)
+    {
+        // Allocate one band of packed tiles
+        uint32_t tileRows = (m_height < m_tileSize) ? m_height : m_tileSize;
+        m_tilesCount = ((m_width+m_tileSize-1) / m_tileSize);
+        size_t bandSize = ((size_t)m_tilesCount*m_tileSize*tileRows*4);
+        if (bandSize > m_ownedSize)
+        {
+            if (m_ownedImage) { delete[] m_ownedImage; }
+            m_ownedSize = 0;
+            m_ownedImage = new (std::nothrow) unsigned char[bandSize];
+            if (!m_ownedImage)
+            {
+                // Could not allocate tiles band
+                return false;
+            }
+            m_ownedSize = bandSize;
+        }
+        m_image = m_ownedImage;
+        m_stride = imageRowSize;
+    }
+    else if (m_destination)
+    {
+        // Check caller destination image
+        imageRowSize = ((size_t)m_imageWidth*4);
+        size_t stride = (m_destStride > 0) ? m_destStride : imageRowSize;
+        if ((stride < imageRowSize) ||
+            (m_destSize < ((stride*(m_imageHeight-1))+imageRowSize)))
+        {
+            // Destination image is too small
+            return false;
+        }
+        m_image = m_destination;
+        m_stride = stride;
+    }
+    else
+    {
+        // Allocate 32bits RGBA image data and its mip chain
+        imageRowSize = ((size_t)m_imageWidth*4);
+        size_t imageSize = ImageMipChainSize(
+            m_imageWidth, m_imageHeight, m_mipLevels
+        );
+        if (imageSize > m_ownedSize)
+        {
+            if (m_ownedImage) { delete[] m_ownedImage; }
+            m_ownedSize = 0;
+            m_ownedImage = new (std::nothrow) unsigned char[imageSize];
+            if (!m_ownedImage)
+            {
+                // Could not allocate image data
+                return false;
+            }
+            m_ownedSize = imageSize;
+        }
+        m_image = m_ownedImage;
+        m_stride = imageRowSize;
+    }
+
+    // Init rows downscaler
+    if ((m_shift > 0) && !m_downscaler.init(m_width, m_height,
+        m_imageWidth, m_imageHeight, m_filter, m_gamma, m_image, m_stride))
+    {
+        // Could not init rows downscaler
+        return false;
+    }
+
+    // Init image data inflater
+    if (!m_deferData && !m_inflater.init(m_verify == PNGFILE_VERIFY_FULL))
+    {
+        // Could not init image data inflater
+        return false;
+    }
+
+    // Start first pass
+    m_pass = (pngIHDRChunk.interlace != 0) ? 1 : 0;
+    m_lastPass = (pngIHDRChunk.interlace != 0) ? PNGFileAdam7Passes : 0;
+    startPass();
+
+    // PNG image header is successfully decoded
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode PNG PLTE chunk into the RGBA palette                               //
+//  return : True if the palette is valid                                     //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::decodePalette()
+{
+    // Opaque palette, missing entries are opaque black
+    m_paletteSize = (m_chunkLength / 3);
+    for (uint32_t i = 0; i < PNGFilePaletteMaxSize; ++i)
+    {
+        bool entry = (i < m_paletteSize);
+        m_palette[(i*4)+0] = entry ? m_chunkData[(i*3)+0] : 0;
+        m_palette[(i*4)+1] = entry ? m_chunkData[(i*3)+1] : 0;
+        m_palette[(i*4)+2] = entry ? m_chunkData[(i*3)+2] : 0;
+        m_palette[(i*4)+3] = 255;
+    }
+
+    // PNG palette is successfully decoded
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode PNG tRNS chunk into palette alphas or color key                    //
+//  return : True if the transparency is valid                                //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::decodeTransparency()
+{
+    switch (m_colorType)
+    {
+        case PNGFILE_COLOR_PALETTE:
+        {
+            if (m_paletteSize <= 0)
+            {
+                // tRNS chunk before PLTE chunk
+                return false;
+            }
+
+            // Palette entries alphas
+            uint32_t count = m_chunkLength;
+            if (count > m_paletteSize) { count = m_paletteSize; }
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                m_palette[(i*4)+3] = m_chunkData[i];
+            }
+            return true;
+        }
+
+        case PNGFILE_COLOR_GREYSCALE:
+            if (m_chunkLength != 2)
+            {
+                // Invalid greyscale color key
+                return false;
+            }
+            m_colorKey[0] = PNGDecoderRead16(&m_chunkData[0]);
+            m_hasColorKey = true;
+            return true;
+
+        case PNGFILE_COLOR_RGB:
+            if (m_chunkLength != 6)
+            {
+                // Invalid RGB color key
+                return false;
+            }
+            m_colorKey[0] = PNGDecoderRead16(&m_chunkData[0]);
+            m_colorKey[1] = PNGDecoderRead16(&m_chunkData[2]);
+            m_colorKey[2] = PNGDecoderRead16(&m_chunkData[4]);
+            m_hasColorKey = true;
+            return true;
+
+        default:
+            // Images with an alpha channel ignore tRNS
+            return true;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Inflate PNG IDAT chunk data into scanlines                                //
+//  return : True if the image data are valid                                 //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::inflateData(const unsigned char* data, size_t size)
+{
+    // Check image header
+    if (!m_image)
+    {
+        // IDAT chunk before IHDR chunk
+        return false;
+    }
+
+    while (size > 0)
+    {
+        // Ignore data after the end of the deflate stream
+        if (m_inflater.isDone()) { return true; }
+
+        // Inflate data
+        size_t inRead = 0;
+        if (!m_inflater.feed(data, size, &inRead))
+        {
+            // Invalid image data stream
+            return false;
+        }
+        data += inRead;
+        size -= inRead;
+
+        // Drain inflated data into scanlines
+        while (m_inflater.getPending() > 0)
+        {
+            if (m_pass > m_lastPass)
+            {
+                // Too much image data
+                return false;
+            }
+            m_rowFill += m_inflater.drain(
+                &m_row[m_rowFill], m_rowSize-m_rowFill
+            );
+            if (m_rowFill >= m_rowSize)
+            {
+                if (!decodeRow())
+                {
+                    // Could not decode scanline
+                    return false;
+                }
+            }
+        }
+
+        // Window is drained, the inflater must progress
+        if ((inRead <= 0) && !m_inflater.isDone())
+        {
+            // Invalid image data stream
+            return false;
+        }
+    }
+
+    // PNG IDAT chunk data are successfully inflated
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Locate PNG IDAT chunks data in complete PNG data                          //
+//  return : True if the IDAT chunks are complete                             //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::gatherData(const unsigned char* data, size_t size,
+    const unsigned char*& imageData, size_t& imageSize)
+{
+    // Locate consecutive IDAT chunks, chunks are checked by the stream
+    size_t first = 0;
+    size_t chunks = 0;
+    size_t dataSize = 0;
+    size_t offset = sizeof(PNGFileSignature);
+    while ((offset + PNGFileChunkHeaderSize) <= size)
+    {
+        size_t length = PNGDecoderRead32(&data[offset]);
+        const unsigned char* type = &data[offset+4];
+        size_t chunkSize = (
+            PNGFileChunkHeaderSize + length + PNGFileChunkCRCSize
+        );
+        if (!PNGDecoderIsChunk(type, PNGFileIDATChunkType))
+        {
+            if (chunks > 0) { break; }
+            if (length > (size - offset)) { return false; }
+            offset += chunkSize;
+            continue;
+        }
+        if (length > (size - offset - PNGFileChunkHeaderSize))
+        {
+            // Truncated IDAT chunk
+            return false;
+        }
+        if (chunks <= 0) { first = offset; }
+        dataSize += length;
+        ++chunks;
+        offset += chunkSize;
+    }
+    if ((chunks <= 0) || (dataSize <= 0))
+    {
+        // No complete IDAT chunks
+        return false;
+    }
+
+    // Single IDAT chunk is inflated in place
+    if (chunks == 1)
+    {
+        imageData = &data[first+PNGFileChunkHeaderSize];
+        imageSize = dataSize;
+        return true;
+    }
+
+    // Gather split IDAT chunks data
+    if (dataSize > m_dataCapacity)
+    {
+        if (m_data) { delete[] m_data; }
+        m_dataCapacity = 0;
+        m_data = new (std::nothrow) unsigned char[dataSize];
+        if (!m_data)
+        {
+            // Could not allocate image data buffer
+            return false;
+        }
+        m_dataCapacity = dataSize;
+    }
+    offset = first;
+    for (size_t i = 0, gathered = 0; i < chunks; ++i)
+    {
+        size_t length = PNGDecoderRead32(&data[offset]);
+        memcpy(&m_data[gathered], &data[offset+PNGFileChunkHeaderSize], length);
+        gathered += length;
+        offset += (PNGFileChunkHeaderSize + length + PNGFileChunkCRCSize);
+    }
+    imageData = m_data;
+    imageSize = dataSize;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Inflate gathered PNG IDAT data in one shot into scanlines                 //
+//  return : True if the image data are valid                                 //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::inflateImage(const unsigned char* data, size_t size)
+{
+    // Check image header
+    if (!m_image)
+    {
+        // Missing IHDR chunk
+        return false;
+    }
+
+    // Compute exact scanlines size of the remaining passes
+    size_t rawSize = 0;
+    for (uint32_t i = m_pass; i <= m_lastPass; ++i)
+    {
+        const PNGDecoderPass& pass = PNGDecoderPasses[i];
+        size_t passWidth = (m_width > pass.xStart) ?
+            ((m_width-pass.xStart+pass.xStep-1) / pass.xStep) : 0;
+        size_t passHeight = (m_height > pass.yStart) ?
+            ((m_height-pass.yStart+pass.yStep-1) / pass.yStep) : 0;
+        if ((passWidth > 0) && (passHeight > 0))
+        {
+            rawSize += (((((passWidth*m_pixelBits)+7) >> 3)+1)*passHeight);
+        }
+    }
+
+    // Allocate scanlines data
+    if (rawSize > m_rawCapacity)
+    {
+        if (m_raw) { delete[] m_raw; }
+        m_rawCapacity = 0;
+        m_raw = new (std::nothrow) unsigned char[rawSize];
+        if (!m_raw)
+        {
+            // Could not allocate scanlines data
+            return false;
+        }
+        m_rawCapacity = rawSize;
+    }
+
+    // Inflate image data
+    if (!ZLibDeflateDecompressExact(m_context, data, size, 0,
+        m_raw, rawSize, 0, (m_verify == PNGFILE_VERIFY_FULL)))
+    {
+        // Invalid image data stream
+        return false;
+    }
+
+    // Decode scanlines (the row size changes with the passes)
+    size_t offset = 0;
+    while (m_pass <= m_lastPass)
+    {
+        memcpy(m_row, &m_raw[offset], m_rowSize);
+        offset += m_rowSize;
+        if (!decodeRow())
+        {
+            // Could not decode scanline
+            return false;
+        }
+    }
+
+    // PNG image data are successfully inflated
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Start next non empty PNG decoder pass                                     //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::startPass()
+{
+    while (m_pass <= m_lastPass)
+    {
+        // Compute pass size
+        const PNGDecoderPass& pass = PNGDecoderPasses[m_pass];
+        m_passWidth = (m_width > pass.xStart) ?
+            ((m_width-pass.xStart+pass.xStep-1) / pass.xStep) : 0;
+        m_passHeight = (m_height > pass.yStart) ?
+            ((m_height-pass.yStart+pass.yStep-1) / pass.yStep) : 0;
+
+        if ((m_passWidth > 0) && (m_passHeight > 0))
+        {
+            // Each pass is filtered from a zero previous scanline
+            m_rowSize = ((((size_t)m_passWidth*m_pixelBits)+7) >> 3)+1;
+            memset(m_prevRow, 0, m_rowSize);
+            m_rowFill = 0;
+            m_rowIndex = 0;
+            m_bandStart = 0;
+            return;
+        }
+
+        // Empty passes have no scanlines
+        ++m_pass;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode completed PNG scanline into the image                              //
+//  return : True if the scanline is successfully decoded                     //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGDecoder::decodeRow()
+{
+    // Unfilter scanline
+    if (!PNGUnfilterRow(
+        m_row[0], &m_row[1], &m_prevRow[1], m_rowSize-1, m_pixelDepth))
+    {
+        // Invalid scanline filter
+        return false;
+    }
+
+    // Expand scanline to 32bits RGBA
+    const PNGDecoderPass& pass = PNGDecoderPasses[m_pass];
+    uint32_t y = pass.yStart + (m_rowIndex*pass.yStep);
+    if (m_tileSize > 0)
+    {
+        expandRow(&m_row[1], m_passRow, m_passWidth);
+        storeTileRow(y);
+    }
+    else if (m_shift > 0)
+    {
+        expandRow(&m_row[1], m_passRow, m_passWidth);
+        if (!m_downscaler.pushRow(m_passRow))
+        {
+            // Could not downscale scanline
+            return false;
+        }
+    }
+    else if (pass.xStep <= 1)
+    {
+        expandRow(&m_row[1], &m_image[(size_t)y*m_stride], m_passWidth);
+    }
+    else
+    {
+        expandRow(&m_row[1], m_passRow, m_passWidth);
+        fillPassRow(y);
+    }
+
+    // Swap current and previous scanlines
+    unsigned char* prevRow = m_prevRow;
+    m_prevRow = m_row;
+    m_row = prevRow;
+    m_rowFill = 0;
+    ++m_rowIndex;
+
+    // Call rows callback
+    if (((m_rowIndex-m_bandStart) >= m_bandRows) ||
+        (m_rowIndex >= m_passHeight))
+    {
+        if (m_callback && (m_tileSize <= 0) && (m_shift <= 0))
+        {
+            // Band rows span the blocks filled by the pass scanlines
+            uint32_t firstRow = pass.yStart + (m_bandStart*pass.yStep);
+            uint32_t endRow = y + pass.blockHeight;
+            if (endRow > m_height) { endRow = m_height; }
+            m_callback(m_userData, &m_image[(size_t)firstRow*m_stride],
+                m_stride, firstRow, endRow-firstRow, m_pass
+            );
+        }
+        m_bandStart = m_rowIndex;
+    }
+
+    // Start next pass
+    if (m_rowIndex >= m_passHeight)
+    {
+        ++m_pass;
+        startPass();
+    }
+
+    // PNG scanline is successfully decoded
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Fill expanded Adam7 pass scanline blocks into the image                   //
+//  Blocks are clipped to the image, the last pass fills single pixels        //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::fillPassRow(uint32_t y)
+{
+    const PNGDecoderPass& pass = PNGDecoderPasses[m_pass];
+    uint32_t blockHeight = pass.blockHeight;
+    if (blockHeight > (m_height-y)) { blockHeight = (m_height-y); }
+
+    for (uint32_t j = 0; j < blockHeight; ++j)
+    {
+        unsigned char* out = &m_image[(size_t)(y+j)*m_stride];
+        const unsigned char* in = m_passRow;
+        for (uint32_t i = 0; i < m_passWidth; ++i)
+        {
+            uint32_t x = pass.xStart + (i*pass.xStep);
+            uint32_t blockWidth = pass.blockWidth;
+            if (blockWidth > (m_width-x)) { blockWidth = (m_width-x); }
+            for (uint32_t k = 0; k < blockWidth; ++k)
+            {
+                memcpy(&out[(x+k)*4], in, 4);
+            }
+            in += 4;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Store expanded scanline into the band tiles                               //
+//  Tiles are emitted when their last row is stored                           //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::storeTileRow(uint32_t y)
+{
+    uint32_t tileRows = (m_height < m_tileSize) ? m_height : m_tileSize;
+    size_t tileSize = ((size_t)m_tileSize*tileRows*4);
+    uint32_t tileY = ((y / m_tileSize)*m_tileSize);
+    uint32_t row = (y - tileY);
+    bool lastRow = (((row+1) >= m_tileSize) || ((y+1) >= m_height));
+
+    for (uint32_t i = 0; i < m_tilesCount; ++i)
+    {
+        // Copy scanline segment into its tile
+        uint32_t tileX = (i*m_tileSize);
+        uint32_t tileWidth = (m_width-tileX);
+        if (tileWidth > m_tileSize) { tileWidth = m_tileSize; }
+        unsigned char* tile = &m_image[i*tileSize];
+        memcpy(&tile[(size_t)row*tileWidth*4],
+            &m_passRow[(size_t)tileX*4], (size_t)tileWidth*4
+        );
+
+        // Emit completed tile
+        if (lastRow && m_tileCallback)
+        {
+            m_tileCallback(
+                m_tileUserData, tile, tileX, tileY, tileWidth, row+1
+            );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Expand unfiltered PNG scanline to 32bits RGBA                             //
+//  16 bits samples keep their most significant byte                          //
+////////////////////////////////////////////////////////////////////////////////
+void PNGDecoder::expandRow(const unsigned char* in, unsigned char* out,
+    uint32_t width)
+{
+    switch (m_colorType)
+    {
+        case PNGFILE_COLOR_GREYSCALE:
+            if (m_bitDepth == 16)
+            {
+                for (uint32_t i = 0; i < width; ++i)
+                {
+                    bool key = (m_hasColorKey &&
+                        (PNGDecoderRead16(in) == m_colorKey[0]));
+                    out[0] = in[0];
+                    out[1] = in[0];
+                    out[2] = in[0];
+                    out[3] = key ? 0 : 255;
+                    in += 2;
+                    out += 4;
+                }
+            }
+            else
+            {
+                // Scale 1, 2 and 4 bits samples to the full 8 bits range
+                uint32_t scale = (255 / ((1u << m_bitDepth)-1));
+                for (uint32_t i = 0; i < width; ++i)
+                {
+                    uint32_t sample = PNGDecoderSample(in, i, m_bitDepth);
+                    bool key = (m_hasColorKey && (sample == m_colorKey[0]));
+                    unsigned char grey = (unsigned char)(sample*scale);
+                    out[0] = grey;
+                    out[1] = grey;
+                    out[2] = grey;
+                    out[3] = key ? 0 : 255;
+                    out += 4;
+                }
+            }
+            break;
+
+        case PNGFILE_COLOR_RGB:
+            if (m_bitDepth == 16)
+            {
+                for (uint32_t i = 0; i < width; ++i)
+                {
+                    bool key = (m_hasColorKey &&
+                        (PNGDecoderRead16(&in[0]) == m_colorKey[0]) &&
+                        (PNGDecoderRead16(&in[2]) == m_colorKey[1]) &&
+                        (PNGDecoderRead16(&in[4]) == m_colorKey[2]));
+                    out[0] = in[0];
+                    out[1] = in[2];
+                    out[2] = in[4];
+                    out[3] = key ? 0 : 255;
+                    in += 6;
+                    out += 4;
+                }
+            }
+            else
+            {
+                for (uint32_t i = 0; i < width; ++i)
+                {
+                    bool key = (m_hasColorKey && (in[0] == m_colorKey[0]) &&
+                        (in[1] == m_colorKey[1]) && (in[2] == m_colorKey[2]));
+                    out[0] = in[0];
+                    out[1] = in[1];
+                    out[2] = in[2];
+                    out[3] = key ? 0 : 255;
+                    in += 3;
+                    out += 4;
+                }
+            }
+            break;
+
+        case PNGFILE_COLOR_PALETTE:
+            for (uint32_t i = 0; i < width; ++i)
+            {
+                uint32_t index = PNGDecoderSample(in, i, m_bitDepth);
+                memcpy(out, &m_palette[index*4], 4);
+                out += 4;
+            }
+            break;
+
+        case PNGFILE_COLOR_GREYSCALE_ALPHA:
+        {
+            uint32_t sampleSize = (m_bitDepth >> 3);
+            for (uint32_t i = 0; i < width; ++i)
+            {
+                out[0] = in[0];
+                out[1] = in[0];
+                out[2] = in[0];
+                out[3] = in[sampleSize];
+                in += (sampleSize*2);
+                out += 4;
+            }
+            break;
+        }
+
+        default:
+            if (m_bitDepth == 16)
+            {
+                for (uint32_t i = 0; i < width; ++i)
+                {
+                    out[0] = in[0];
+                    out[1] = in[2];
+                    out[2] = in[4];
+                    out[3] = in[6];
+                    in += 8;
+                    out += 4;
+                }
+            }
+            else
+            {
+                memcpy(out, in, (size_t)width*4);
+            }
+            break;
+    }
+}
@@ -0,0 +1,476 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/PNGDecoder.h : PNG streaming decoder                            //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_IMAGES_PNGDECODER_HEADER
+#define WOS_IMAGES_PNGDECODER_HEADER
+
+    #include "../System/System.h"
+    #include "../System/SysCPU.h"
+    #include "../System/SysCRC.h"
+    #include "../Compress/ZLib.h"
+    #include "../Compress/ZLibInflater.h"
+    #include "PNGFile.h"
+    #include "PNGFilter.h"
+    #include "ImageDownscaler.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <new>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGDecoderState enumeration                                           //
+    ////////////////////////////////////////////////////////////////////////////
+    enum PNGDecoderState
+    {
+        PNGDECODER_STATE_SIGNATURE = 0,
+        PNGDECODER_STATE_CHUNKHEADER = 1,
+        PNGDECODER_STATE_CHUNKDATA = 2,
+        PNGDECODER_STATE_CHUNKCRC = 3,
+        PNGDECODER_STATE_DONE = 4,
+
+        PNGDECODER_STATE_ERROR = 5
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGDecoderPass structure                                              //
+    //  Pass 0 is the whole non interlaced image, passes 1 to 7 are the       //
+    //  Adam7 passes, each pixel of a pass fills its block of the image       //
+    //  until the next passes refine it                                       //
+    ////////////////////////////////////////////////////////////////////////////
+    struct PNGDecoderPass
+    {
+        uint32_t    xStart;
+        uint32_t    yStart;
+        uint32_t    xStep;
+        uint32_t    yStep;
+        uint32_t    blockWidth;
+        uint32_t    blockHeight;
+    };
+    const PNGDecoderPass PNGDecoderPasses[PNGFileAdam7Passes+1] = {
+        {0, 0, 1, 1, 1, 1},
+        {0, 0, 8, 8, 8, 8},
+        {4, 0, 8, 8, 4, 8},
+        {0, 4, 4, 8, 4, 4},
+        {2, 0, 4, 4, 2, 4},
+        {0, 2, 2, 4, 2, 2},
+        {1, 0, 2, 2, 1, 2},
+        {0, 1, 1, 2, 1, 1}
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGDecoder class definition                                           //
+    //  Chunks are parsed as the input arrives, IDAT data is inflated and     //
+    //  each scanline is unfiltered as soon as it is complete, so only two    //
+    //  scanlines are kept besides the RGBA output image                      //
+    //  Every color type and bit depth is expanded to 8 bits RGBA             //
+    //  Adam7 interlaced images are decoded pass by pass, so the image is a   //
+    //  complete low resolution preview after each pass                       //
+    //  Complete PNG buffers skip the streaming inflater, their IDAT data are //
+    //  inflated in one shot into the exact scanlines size                    //
+    //  Scanlines, inflate window and owned image are kept across streams,    //
+    //  so a reused decoder only allocates when an image is larger            //
+    //  In tiled mode the owned image only holds one band of packed tiles     //
+    //  Downscaled images are filtered row by row, so only the downscaled     //
+    //  image and its mip chain are allocated                                 //
+    ////////////////////////////////////////////////////////////////////////////
+    class PNGDecoder
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  PNGDecoder default constructor                                //
+            ////////////////////////////////////////////////////////////////////
+            PNGDecoder();
+
+            ////////////////////////////////////////////////////////////////////
+            //  PNGDecoder destructor                                         //
+            ////////////////////////////////////////////////////////////////////
+            ~PNGDecoder();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Init PNG decoder for a new stream                             //
+            //  return : True if the decoder is ready                         //
+            ////////////////////////////////////////////////////////////////////
+            bool init(
+                const PNGFileLoadOptions& options = PNGFileDefaultLoadOptions);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Set PNG decoder rows callback                                 //
+            //  callback is called each time bandRows rows are decoded        //
+            ////////////////////////////////////////////////////////////////////
+            void setRowsCallback(PNGFileRowsCallback callback, void* userData,
+                uint32_t bandRows = PNGFileStreamBandRows);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Set PNG decoder destination image (before the header)         //
+            //  Rows are decoded stride bytes apart (0 for width*4) into the  //
+            //  caller owned image, the header fails if size is too small     //
+            //  image 0 decodes into the decoder owned image                  //
+            ////////////////////////////////////////////////////////////////////
+            void setDestination(unsigned char* image, size_t size,
+                size_t stride = 0);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Set PNG decoder tiled mode (before the header)                //
+            //  Tiles are emitted instead of the rows and the full image,     //
+            //  tileSize 0 disables the tiled mode                            //
+            ////////////////////////////////////////////////////////////////////
+            void setTiles(uint32_t tileSize, PNGFileTileCallback callback,
+                void* userData);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Feed PNG data chunk to the decoder                            //
+            //  return : False if the stream is invalid                       //
+            ////////////////////////////////////////////////////////////////////
+            bool feed(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Decode complete PNG data in one shot (call finish after)      //
+            //  IDAT data are inflated at once instead of through the         //
+            //  streaming inflater window                                     //
+            //  return : False if the PNG data are invalid                    //
+            ////////////////////////////////////////////////////////////////////
+            bool decode(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Finish PNG decoder stream                                     //
+            //  return : True if the image is completely decoded              //
+            ////////////////////////////////////////////////////////////////////
+            bool finish();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Release PNG decoder image ownership                           //
+            //  return : Decoded RGBA image (to delete[] by the caller),      //
+            //           or 0 if the image was decoded into a destination     //
+            ////////////////////////////////////////////////////////////////////
+            unsigned char* releaseImage();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Destroy PNG decoder                                           //
+            ////////////////////////////////////////////////////////////////////
+            void destroyDecoder();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder header state                                  //
+            //  return : True if the image header is decoded                  //
+            ////////////////////////////////////////////////////////////////////
+            inline bool isHeaderReady() const
+            {
+                return (m_image != 0);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder end of stream state                           //
+            //  return : True if the IEND chunk is reached                    //
+            ////////////////////////////////////////////////////////////////////
+            inline bool isDone() const
+            {
+                return (m_state == PNGDECODER_STATE_DONE);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder error state                                   //
+            //  return : True if the stream is invalid                        //
+            ////////////////////////////////////////////////////////////////////
+            inline bool isError() const
+            {
+                return (m_state == PNGDECODER_STATE_ERROR);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder tiled mode state                              //
+            //  return : True if the decoder emits tiles                      //
+            ////////////////////////////////////////////////////////////////////
+            inline bool isTiled() const
+            {
+                return (m_tileSize > 0);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder image width                                   //
+            //  return : Decoded image width in pixels (after downscale)      //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getWidth() const
+            {
+                return m_imageWidth;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder image height                                  //
+            //  return : Decoded image height in pixels (after downscale)     //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getHeight() const
+            {
+                return m_imageHeight;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder mip levels count                              //
+            //  return : Mip levels packed after the image (1 if no mipmaps)  //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getMipLevels() const
+            {
+                return m_mipLevels;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder image data                                    //
+            //  return : Partially decoded RGBA image (0 in tiled mode)       //
+            ////////////////////////////////////////////////////////////////////
+            inline const unsigned char* getImage() const
+            {
+                return ((m_tileSize > 0) ? 0 : m_image);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder image stride                                  //
+            //  return : Size in bytes between two image rows                 //
+            ////////////////////////////////////////////////////////////////////
+            inline size_t getStride() const
+            {
+                return m_stride;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder decoded rows count                            //
+            //  return : Number of rows already decoded in the current pass   //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getRowsDecoded() const
+            {
+                return m_rowIndex;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG decoder completed passes count                        //
+            //  return : Completed Adam7 passes (0 if not interlaced)         //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getPassesDecoded() const
+            {
+                return ((m_lastPass > 0) ? (m_pass-1) : 0);
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  PNGDecoder private copy constructor : Not copyable            //
+            ////////////////////////////////////////////////////////////////////
+            PNGDecoder(const PNGDecoder&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  PNGDecoder private copy operator : Not copyable               //
+            ////////////////////////////////////////////////////////////////////
+            PNGDecoder& operator=(const PNGDecoder&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Reset PNG decoder stream state, keep the scratch buffers      //
+            ////////////////////////////////////////////////////////////////////
+            void resetDecoder();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Start PNG decoder chunk                                       //
+            //  return : True if the chunk header is valid                    //
+            ////////////////////////////////////////////////////////////////////
+            bool startChunk();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Read PNG decoder chunk data                                   //
+            //  return : True if the chunk data are valid                     //
+            ////////////////////////////////////////////////////////////////////
+            bool readChunkData(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  End PNG decoder chunk                                         //
+            //  return : True if the chunk CRC is valid                       //
+            ////////////////////////////////////////////////////////////////////
+            bool endChunk();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Decode PNG IHDR chunk and allocate the image                  //
+            //  return : True if the image header is supported                //
+            ////////////////////////////////////////////////////////////////////
+            bool decodeHeader();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Decode PNG PLTE chunk into the RGBA palette                   //
+            //  return : True if the palette is valid                         //
+            ////////////////////////////////////////////////////////////////////
+            bool decodePalette();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Decode PNG tRNS chunk into palette alphas or color key        //
+            //  return : True if the transparency is valid                    //
+            ////////////////////////////////////////////////////////////////////
+            bool decodeTransparency();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Inflate PNG IDAT chunk data into scanlines                    //
+            //  return : True if the image data are valid                     //
+            ////////////////////////////////////////////////////////////////////
+            bool inflateData(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Locate PNG IDAT chunks data in complete PNG data              //
+            //  Split IDAT chunks data are gathered into the data buffer      //
+            //  return : True if the IDAT chunks are complete                 //
+            ////////////////////////////////////////////////////////////////////
+            bool gatherData(const unsigned char* data, size_t size,
+                const unsigned char*& imageData, size_t& imageSize);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Inflate gathered PNG IDAT data in one shot into scanlines     //
+            //  return : True if the image data are valid                     //
+            ////////////////////////////////////////////////////////////////////
+            bool inflateImage(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Start next non empty PNG decoder pass                         //
+            ////////////////////////////////////////////////////////////////////
+            void startPass();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Decode completed PNG scanline into the image                  //
+            //  return : True if the scanline is successfully decoded         //
+            ////////////////////////////////////////////////////////////////////
+            bool decodeRow();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Expand unfiltered PNG scanline to 32bits RGBA                 //
+            ////////////////////////////////////////////////////////////////////
+            void expandRow(const unsigned char* in, unsigned char* out,
+                uint32_t width);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Fill expanded Adam7 pass scanline blocks into the image       //
+            ////////////////////////////////////////////////////////////////////
+            void fillPassRow(uint32_t y);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Store expanded scanline into the band tiles                   //
+            //  Tiles are emitted when their last row is stored               //
+            ////////////////////////////////////////////////////////////////////
+            void storeTileRow(uint32_t y);
+
+
+        private:
+            PNGDecoderState     m_state;        // Decoder state
+            PNGFileVerifyPolicy m_verify;       // Checksum verification policy
+            ZLibInflater        m_inflater;     // IDAT stream inflater
+            ZLibDeflateContext  m_context;      // IDAT one shot inflate context
+            bool                m_deferData;    // IDAT inflated after chunks
+            unsigned char*      m_data;         // Gathered IDAT data
+            size_t              m_dataCapacity; // Gathered IDAT capacity
+            unsigned char*      m_raw;          // One shot scanlines data
+            size_t              m_rawCapacity;  // One shot scanlines capacity
+
+            unsigned char       m_buffer[PNGFileChunkHeaderSize];
+            uint32_t            m_bufferSize;   // Buffered bytes count
+            uint32_t            m_chunkLength;  // Current chunk length
+            uint32_t            m_chunkLeft;    // Current chunk bytes left
+            unsigned char       m_chunkType[4]; // Current chunk type
+            uint32_t            m_chunkCRC;     // Current chunk CRC
+            bool                m_checkCRC;     // Current chunk CRC check
+            unsigned char       m_chunkData[PNGFilePLTEChunkMaxSize];
+            uint32_t            m_chunksCount;  // Decoded chunks count
+            bool                m_dataStarted;  // IDAT chunks started
+            bool                m_dataEnded;    // IDAT chunks ended
+
+            unsigned char*      m_image;        // RGBA image data
+            size_t              m_stride;       // Image rows stride
+            unsigned char*      m_ownedImage;   // Owned image buffer
+            size_t              m_ownedSize;    // Owned image buffer size
+            unsigned char*      m_destination;  // Caller destination image
+            size_t              m_destSize;     // Destination size
+            size_t              m_destStride;   // Destination rows stride
+            uint32_t            m_width;        // Image width
+            uint32_t            m_height;       // Image height
+            uint32_t            m_imageWidth;   // Decoded image width
+            uint32_t            m_imageHeight;  // Decoded image height
+            uint32_t            m_mipLevels;    // Decoded mip levels count
+            PNGFileColorType    m_colorType;    // Image color type
+            uint32_t            m_bitDepth;     // Bits per sample
+            uint32_t            m_pixelDepth;   // Filter bytes per pixel
+            uint32_t            m_pixelBits;    // Bits per pixel
+            unsigned char       m_palette[PNGFilePaletteMaxSize*4];
+            uint32_t            m_paletteSize;  // Palette entries count
+            uint16_t            m_colorKey[3];  // Transparent color key
+            bool                m_hasColorKey;  // Color key state
+
+            unsigned char*      m_rows;         // Scanlines buffer
+            size_t              m_rowsCapacity; // Scanlines buffer capacity
+            unsigned char*      m_row;          // Current scanline
+            unsigned char*      m_prevRow;      // Previous scanline
+            size_t              m_rowSize;      // Scanline size with filter
+            size_t              m_rowFill;      // Current scanline bytes
+            uint32_t            m_rowIndex;     // Pass decoded rows count
+
+            uint32_t            m_pass;         // Current pass
+            uint32_t            m_lastPass;     // Last pass (7 if interlaced)
+            uint32_t            m_passWidth;    // Current pass width
+            uint32_t            m_passHeight;   // Current pass height
+            unsigned char*      m_passRow;      // Expanded pass scanline
+            size_t              m_passCapacity; // Pass scanline capacity
+
+            PNGFileRowsCallback m_callback;     // Rows band callback
+            void*               m_userData;     // Rows callback user data
+            uint32_t            m_bandRows;     // Rows per callback band
+            uint32_t            m_bandStart;    // Current band first row
+
+            uint32_t            m_tileSize;     // Tiles size (0 if not tiled)
+            uint32_t            m_tilesCount;   // Tiles count per band
+            PNGFileTileCallback m_tileCallback; // Tile callback
+            void*               m_tileUserData; // Tile callback user data
+
+            uint32_t            m_downscale;    // Requested downscale shift
+            uint32_t            m_shift;        // Applied downscale shift
+            ImageDownscalerFilter m_filter;     // Downscale filter
+            bool                m_gamma;        // Gamma correct filtering
+            bool                m_mipmaps;      // Mip chain generation
+            ImageDownscaler     m_downscaler;   // Rows downscaler
+    };
+
+
+#endif // WOS_IMAGES_PNGDECODER_HEADER
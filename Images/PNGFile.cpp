@@ -40,6 +40,8 @@
 //     Images/PNGFile.cpp : PNGFile image management                          //
 ////////////////////////////////////////////////////////////////////////////////
 #include "PNGFile.h"
+#include "PNGDecoder.h"
+#include "PNGFilter.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,8 +50,15 @@
 PNGFile::PNGFile() :
 m_loaded(false),
 m_image(0),
+m_ownsImage(false),
 m_width(0),
-m_height(0)
+m_height(0),
+m_stride(0),
+m_mipLevels(1),
+m_decoder(0),
+m_destination(0),
+m_destSize(0),
+m_destStride(0)
 {
 
 }
@@ -59,13 +68,24 @@ m_height(0)
 ////////////////////////////////////////////////////////////////////////////////
 PNGFile::~PNGFile()
 {
-    if (m_image)
+    if (m_decoder)
+    {
+        delete m_decoder;
+    }
+    m_decoder = 0;
+    if (m_image && m_ownsImage)
     {
         delete[] m_image;
     }
-    m_image = 0;
+    m_destStride = 0;
+    m_destSize = 0;
+    m_destination = 0;
+    m_mipLevels = 1;
+    m_stride = 0;
     m_height = 0;
     m_width = 0;
+    m_ownsImage = false;
+    m_image = 0;
     m_loaded = false;
 }
 
@@ -105,381 +125,515 @@ bool PNGFile::setImage(uint32_t width, uint32_t height,
     m_image = new (std::nothrow) unsigned char[imageSize];
     if (!m_image) return false;
 
+    m_ownsImage = true;
+
     // Copy image data
     memcpy(m_image, image, imageSize);
 
     // Set image size
     m_width = width;
     m_height = height;
+    m_stride = (width*4);
+    m_mipLevels = 1;
 
     // PNG file image is successfully set
     m_loaded = true;
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//  Set PNG file destination image for the next loads                         //
+////////////////////////////////////////////////////////////////////////////////
+void PNGFile::setDestination(unsigned char* image, size_t size, size_t stride)
+{
+    m_destination = image;
+    m_destSize = image ? size : 0;
+    m_destStride = image ? stride : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Load PNG file                                                             //
 //  return : True if PNG file is successfully loaded                          //
 ////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::loadImage(const std::string& filepath)
+bool PNGFile::loadImage(const std::string& filepath,
+    const PNGFileLoadOptions& options)
 {
-    // Check image loaded state
-    if (m_loaded)
-    {
-        // Destroy current image
-        destroyImage();
-    }
-
-    // Load PNG file
-    std::ifstream pngFile;
-    pngFile.open(filepath.c_str(), std::ios::in | std::ios::binary);
-    if (!pngFile.is_open())
+    // Start PNG decode stream
+    if (!startStream(options))
     {
-        // Could not load PNG file
+        // Could not start PNG decode stream
         return false;
     }
 
-    // Read PNG file signature
-    unsigned char pngSignature[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-    pngFile.read((char*)pngSignature, 8);
-    if (!pngFile)
+    // Decode PNG file
+    return streamFile(filepath);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load PNG buffer                                                           //
+//  return : True if PNG buffer is successfully loaded                        //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::loadImage(const unsigned char* buffer, size_t size,
+    const PNGFileLoadOptions& options)
+{
+    // Check image data
+    if (!buffer || (size <= 0))
     {
-        // Could not read PNG file signature
+        // Invalid image data
         return false;
     }
 
-    // Check PNG file signature
-    if ((pngSignature[0] != PNGFileSignature[0]) ||
-        (pngSignature[1] != PNGFileSignature[1]) ||
-        (pngSignature[2] != PNGFileSignature[2]) ||
-        (pngSignature[3] != PNGFileSignature[3]) ||
-        (pngSignature[4] != PNGFileSignature[4]) ||
-        (pngSignature[5] != PNGFileSignature[5]) ||
-        (pngSignature[6] != PNGFileSignature[6]) ||
-        (pngSignature[7] != PNGFileSignature[7]))
+    // Decode PNG buffer
+    if (!startStream(options))
     {
-        // Invalid PNG file signature
+        // Could not start PNG decode stream
         return false;
     }
 
-    // Read PNG file IHDR chunk header
-    PNGFileChunkHeader pngIHDRChunkHeader = {0, {0, 0, 0, 0}};
-    pngFile.read((char*)&pngIHDRChunkHeader, PNGFileChunkHeaderSize);
-    if (!pngFile)
+    // Complete buffer image data are inflated in one shot
+    if (!m_decoder->decode(buffer, size))
     {
-        // Could not read PNG file IHDR chunk header
+        // Invalid PNG buffer data
+        resetImage();
         return false;
     }
-    pngIHDRChunkHeader.length = SysByteSwap32(pngIHDRChunkHeader.length);
+    return finishStream();
+}
 
-    // Check PNG file IHDR chunk type
-    if ((pngIHDRChunkHeader.type[0] != PNGFileIHDRChunkType[0]) ||
-        (pngIHDRChunkHeader.type[1] != PNGFileIHDRChunkType[1]) ||
-        (pngIHDRChunkHeader.type[2] != PNGFileIHDRChunkType[2]) ||
-        (pngIHDRChunkHeader.type[3] != PNGFileIHDRChunkType[3]))
+////////////////////////////////////////////////////////////////////////////////
+//  Load PNG file as tiles                                                    //
+//  return : True if PNG file tiles are successfully decoded                  //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::loadTiles(const std::string& filepath, uint32_t tileSize,
+    PNGFileTileCallback callback, void* userData,
+    const PNGFileLoadOptions& options)
+{
+    // Start PNG tiled decode stream
+    if (!startTiledStream(tileSize, callback, userData, options))
     {
-        // Invalid PNG file IHDR chunk type
+        // Could not start PNG tiled decode stream
         return false;
     }
 
-    // Check PNG file IHDR chunk length
-    if (pngIHDRChunkHeader.length != PNGFileIHDRChunkSize)
+    // Decode PNG file
+    return streamFile(filepath);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Start PNG progressive decode stream                                       //
+//  return : True if PNG stream is successfully started                       //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::startStream(const PNGFileLoadOptions& options,
+    PNGFileRowsCallback callback, void* userData, uint32_t bandRows)
+{
+    // Reset current image or stream
+    resetImage();
+
+    // Create PNG decoder (reused by the next streams)
+    if (!m_decoder)
     {
-        // Invalid PNG file IHDR chunk length
-        return false;
+        m_decoder = new (std::nothrow) PNGDecoder();
+        if (!m_decoder)
+        {
+            // Could not create PNG decoder
+            return false;
+        }
     }
 
-    // Read PNG file IHDR chunk
-    PNGFileIHDRChunk pngIHDRChunk = {0, 0, 0, 0, 0, 0, 0};
-    pngFile.read((char*)&pngIHDRChunk, PNGFileIHDRChunkSize);
-    if (!pngFile)
+    // Init PNG decoder
+    if (!m_decoder->init(options))
     {
-        // Could not read PNG file IHDR chunk
+        // Could not init PNG decoder
+        destroyImage();
         return false;
     }
+    m_decoder->setDestination(m_destination, m_destSize, m_destStride);
+    m_decoder->setRowsCallback(callback, userData, bandRows);
 
-    // Read PNG file IHDR chunk CRC
-    uint32_t pngIHDRChunkCRC = 0;
-    pngFile.read((char*)&pngIHDRChunkCRC, PNGFileChunkCRCSize);
-    if (!pngFile)
+    // PNG stream is successfully started
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Start PNG tiled decode stream                                             //
+//  return : True if PNG tiled stream is successfully started                 //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::startTiledStream(uint32_t tileSize,
+    PNGFileTileCallback callback, void* userData,
+    const PNGFileLoadOptions& options)
+{
+    // Check tiles size and callback
+    if ((tileSize <= 0) || (tileSize > PNGFileMaxImageWidth) || !callback)
     {
-        // Could not read PNG file IHDR chunk CRC
+        // Invalid tiles size or callback
         return false;
     }
-    pngIHDRChunkCRC = SysByteSwap32(pngIHDRChunkCRC);
 
-    // Check PNG file IHDR chunk CRC
-    uint32_t checkIHDRChunkCRC = SysCRC32Default;
-    checkIHDRChunkCRC = SysUpdateCRC32(
-        checkIHDRChunkCRC, pngIHDRChunkHeader.type, PNGFileChunkHeaderTypeSize
-    );
-    checkIHDRChunkCRC = SysUpdateCRC32(
-        checkIHDRChunkCRC, (unsigned char*)&pngIHDRChunk, PNGFileIHDRChunkSize
-    );
-    if ((checkIHDRChunkCRC^SysCRC32Final) != pngIHDRChunkCRC)
+    // Start PNG decode stream
+    if (!startStream(options))
     {
-        // Invalid PNG file IHDR chunk CRC
+        // Could not start PNG decode stream
         return false;
     }
+    m_decoder->setTiles(tileSize, callback, userData);
 
-    // Swap PNG file IHDR chunk byte endianness
-    pngIHDRChunk.width = SysByteSwap32(pngIHDRChunk.width);
-    pngIHDRChunk.height = SysByteSwap32(pngIHDRChunk.height);
+    // PNG tiled stream is successfully started
+    return true;
+}
 
-    // Check PNG file image size
-    if ((pngIHDRChunk.width <= 0) || (pngIHDRChunk.height <= 0) ||
-        (pngIHDRChunk.width > PNGFileMaxImageWidth) ||
-        (pngIHDRChunk.height > PNGFileMaxImageHeight))
+////////////////////////////////////////////////////////////////////////////////
+//  Feed PNG progressive decode stream                                        //
+//  return : True if PNG stream data are valid                                //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::feedStream(const unsigned char* data, size_t size)
+{
+    // Check PNG decoder
+    if (!m_decoder)
     {
-        // Invalid PNG file image size
+        // PNG stream is not started
         return false;
     }
 
-    // Check PNG file bit depth
-    if (pngIHDRChunk.bitDepth != 8)
+    // Decode PNG stream data
+    if (!m_decoder->feed(data, size))
     {
-        // Unsupported PNG file bit depth
+        // Invalid PNG stream data
+        resetImage();
         return false;
     }
 
-    // Check PNG file compression
-    if (pngIHDRChunk.compression != 0)
+    // Image size is known as soon as the header is decoded
+    if (m_decoder->isHeaderReady())
     {
-        // Unsupported PNG file compression
-        return false;
+        m_width = m_decoder->getWidth();
+        m_height = m_decoder->getHeight();
     }
 
-    // Check PNG file filter
-    if (pngIHDRChunk.filter != 0)
+    // PNG stream data are valid
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Finish PNG progressive decode stream                                      //
+//  return : True if PNG stream is successfully loaded                        //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::finishStream()
+{
+    // Check PNG decoder
+    if (!m_decoder)
     {
-        // Unsupported PNG file filter
+        // PNG stream is not started
         return false;
     }
 
-    // Check PNG file interlace
-    if (pngIHDRChunk.interlace != 0)
+    // Finish PNG stream
+    if (!m_decoder->finish())
     {
-        // Unsupported PNG file interlace
+        // Incomplete or invalid PNG stream
+        resetImage();
         return false;
     }
 
-    // Load PNG file image data
-    if (!loadPNGData(pngFile, pngIHDRChunk))
+    // Tiled streams emitted their tiles, no image is kept
+    m_width = m_decoder->getWidth();
+    m_height = m_decoder->getHeight();
+    if (m_decoder->isTiled())
     {
-        // Could not load PNG image data
-        return false;
+        return true;
     }
 
-    // Close PNG file
-    pngFile.close();
+    // Decoded image stays in the pooled buffer or in the destination
+    m_stride = m_decoder->getStride();
+    m_mipLevels = m_decoder->getMipLevels();
+    m_image = const_cast<unsigned char*>(m_decoder->getImage());
+    m_ownsImage = false;
 
-    // PNG file is successfully loaded
+    // PNG stream is successfully loaded
     m_loaded = true;
     return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Load PNG buffer                                                           //
-//  return : True if PNG buffer is successfully loaded                        //
+//  Get PNG progressive decode stream completed passes                        //
+//  return : Completed Adam7 passes count (0 if not interlaced)               //
 ////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::loadImage(unsigned char* buffer, size_t size)
+uint32_t PNGFile::getStreamPasses() const
 {
-    // Check image loaded state
-    if (m_loaded)
-    {
-        // Destroy current image
-        destroyImage();
-    }
-
-    // Check image data
-    if (!buffer || (size <= 0))
-    {
-        // Invalid image data
-        return false;
-    }
+    if (!m_decoder) { return 0; }
+    return m_decoder->getPassesDecoded();
+}
 
-    // Set buffer end pointer
-    unsigned char* bufferEnd = (buffer+size);
+////////////////////////////////////////////////////////////////////////////////
+//  Get PNG progressive decode stream image                                   //
+//  return : Partially decoded RGBA image, or 0 before the header             //
+////////////////////////////////////////////////////////////////////////////////
+const unsigned char* PNGFile::getStreamImage() const
+{
+    if (!m_decoder) { return 0; }
+    return m_decoder->getImage();
+}
 
-    // Read PNG file signature
-    unsigned char pngSignature[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-    if ((buffer+8) >= bufferEnd)
+////////////////////////////////////////////////////////////////////////////////
+//  Save PNG file                                                             //
+//  return : True if PNG file is successfully saved                           //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::saveImage(const std::string& filepath,
+    PNGFileColorType colorType, const PNGFileSaveOptions& options)
+{
+    // Check image loaded state
+    if (!m_loaded)
     {
-        // Could not read PNG file signature
+        // No current image to save
         return false;
     }
-    memcpy((char*)&pngSignature, buffer, 8);
-    buffer += 8;
 
-    // Check PNG file signature
-    if ((pngSignature[0] != PNGFileSignature[0]) ||
-        (pngSignature[1] != PNGFileSignature[1]) ||
-        (pngSignature[2] != PNGFileSignature[2]) ||
-        (pngSignature[3] != PNGFileSignature[3]) ||
-        (pngSignature[4] != PNGFileSignature[4]) ||
-        (pngSignature[5] != PNGFileSignature[5]) ||
-        (pngSignature[6] != PNGFileSignature[6]) ||
-        (pngSignature[7] != PNGFileSignature[7]))
+    // Pack strided destination image rows
+    const unsigned char* image = m_image;
+    unsigned char* packed = 0;
+    size_t rowSize = (m_width*4);
+    if (m_stride != rowSize)
     {
-        // Invalid PNG file signature
-        return false;
+        packed = new (std::nothrow) unsigned char[rowSize*m_height];
+        if (!packed)
+        {
+            // Could not allocate packed image
+            return false;
+        }
+        for (uint32_t j = 0; j < m_height; ++j)
+        {
+            memcpy(&packed[j*rowSize], &m_image[j*m_stride], rowSize);
+        }
+        image = packed;
     }
 
-    // Read PNG file IHDR chunk header
-    PNGFileChunkHeader pngIHDRChunkHeader = {0, {0, 0, 0, 0}};
-    if ((buffer+PNGFileChunkHeaderSize) >= bufferEnd)
+    // Save PNG file
+    bool saved = savePNGImage(
+        filepath, m_width, m_height, image, colorType, options
+    );
+    if (packed) { delete[] packed; }
+    if (!saved)
     {
-        // Could not read PNG file IHDR chunk header
+        // Could not save PNG file
         return false;
     }
-    memcpy((char*)&pngIHDRChunkHeader, buffer, PNGFileChunkHeaderSize);
-    buffer += PNGFileChunkHeaderSize;
-    pngIHDRChunkHeader.length = SysByteSwap32(pngIHDRChunkHeader.length);
 
-    // Check PNG file IHDR chunk type
-    if ((pngIHDRChunkHeader.type[0] != PNGFileIHDRChunkType[0]) ||
-        (pngIHDRChunkHeader.type[1] != PNGFileIHDRChunkType[1]) ||
-        (pngIHDRChunkHeader.type[2] != PNGFileIHDRChunkType[2]) ||
-        (pngIHDRChunkHeader.type[3] != PNGFileIHDRChunkType[3]))
+    // PNG file is successfully saved
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Destroy PNG image                                                         //
+////////////////////////////////////////////////////////////////////////////////
+void PNGFile::destroyImage()
+{
+    resetImage();
+    if (m_decoder)
     {
-        // Invalid PNG file IHDR chunk type
-        return false;
+        delete m_decoder;
     }
+    m_decoder = 0;
+}
 
-    // Check PNG file IHDR chunk length
-    if (pngIHDRChunkHeader.length != PNGFileIHDRChunkSize)
+////////////////////////////////////////////////////////////////////////////////
+//  Reset PNG image, keep the decoder and its scratch buffers                 //
+////////////////////////////////////////////////////////////////////////////////
+void PNGFile::resetImage()
+{
+    if (m_image && m_ownsImage)
     {
-        // Invalid PNG file IHDR chunk length
-        return false;
+        delete[] m_image;
     }
+    m_image = 0;
+    m_ownsImage = false;
+    m_mipLevels = 1;
+    m_stride = 0;
+    m_height = 0;
+    m_width = 0;
+    m_loaded = false;
+}
 
-    // Read PNG file IHDR chunk
-    PNGFileIHDRChunk pngIHDRChunk = {0, 0, 0, 0, 0, 0, 0};
-    if ((buffer+PNGFileIHDRChunkSize) >= bufferEnd)
+////////////////////////////////////////////////////////////////////////////////
+//  Feed PNG file into the started decode stream                              //
+//  return : True if PNG file is successfully decoded                         //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::streamFile(const std::string& filepath)
+{
+    // Load PNG file
+    std::ifstream pngFile;
+    pngFile.open(filepath.c_str(), std::ios::in | std::ios::binary);
+    if (!pngFile.is_open())
     {
-        // Could not read PNG file IHDR chunk
+        // Could not load PNG file
+        resetImage();
         return false;
     }
-    memcpy((char*)&pngIHDRChunk, buffer, PNGFileIHDRChunkSize);
-    buffer += PNGFileIHDRChunkSize;
 
-    // Read PNG file IHDR chunk CRC
-    uint32_t pngIHDRChunkCRC = 0;
-    if ((buffer+PNGFileChunkCRCSize) >= bufferEnd)
+    // Allocate PNG file read block
+    unsigned char* block = new (std::nothrow)
+        unsigned char[PNGFileReadBlockSize];
+    if (!block)
     {
-        // Could not read PNG file IHDR chunk CRC
+        // Could not allocate PNG file read block
+        resetImage();
         return false;
     }
-    memcpy((char*)&pngIHDRChunkCRC, buffer, PNGFileChunkCRCSize);
-    buffer += PNGFileChunkCRCSize;
-    pngIHDRChunkCRC = SysByteSwap32(pngIHDRChunkCRC);
 
-    // Check PNG file IHDR chunk CRC
-    uint32_t checkIHDRChunkCRC = SysCRC32Default;
-    checkIHDRChunkCRC = SysUpdateCRC32(
-        checkIHDRChunkCRC, pngIHDRChunkHeader.type, PNGFileChunkHeaderTypeSize
-    );
-    checkIHDRChunkCRC = SysUpdateCRC32(
-        checkIHDRChunkCRC, (unsigned char*)&pngIHDRChunk, PNGFileIHDRChunkSize
-    );
-    if ((checkIHDRChunkCRC^SysCRC32Final) != pngIHDRChunkCRC)
+    // Decode PNG file blocks as they are read
+    while (pngFile)
     {
-        // Invalid PNG file IHDR chunk CRC
-        return false;
+        pngFile.read((char*)block, PNGFileReadBlockSize);
+        size_t blockSize = static_cast<size_t>(pngFile.gcount());
+        if (blockSize <= 0) { break; }
+        if (!feedStream(block, blockSize))
+        {
+            // Invalid PNG file data
+            delete[] block;
+            return false;
+        }
     }
+    delete[] block;
 
-    // Swap PNG file IHDR chunk byte endianness
-    pngIHDRChunk.width = SysByteSwap32(pngIHDRChunk.width);
-    pngIHDRChunk.height = SysByteSwap32(pngIHDRChunk.height);
+    // Close PNG file
+    pngFile.close();
+
+    // Finish PNG decode stream
+    return finishStream();
+}
 
-    // Check PNG file image size
-    if ((pngIHDRChunk.width <= 0) || (pngIHDRChunk.height <= 0) ||
-        (pngIHDRChunk.width > PNGFileMaxImageWidth) ||
-        (pngIHDRChunk.height > PNGFileMaxImageHeight))
-    {
-        // Invalid PNG file image size
-        return false;
-    }
 
-    // Check PNG file bit depth
-    if (pngIHDRChunk.bitDepth != 8)
+////////////////////////////////////////////////////////////////////////////////
+//  Probe PNG buffer header and chunks without inflating data                 //
+//  return : True if PNG buffer header is valid                               //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFile::probe(const unsigned char* buffer, size_t size,
+    PNGFileInfo& info)
+{
+    // Reset PNG file info
+    info.width = 0;
+    info.height = 0;
+    info.colorType = PNGFILE_COLOR_RGBA;
+    info.bitDepth = 0;
+    info.interlace = 0;
+    info.dataSize = 0;
+    info.complete = false;
+
+    // Check PNG file signature and IHDR chunk
+    size_t headerSize = (8 + PNGFileChunkHeaderSize +
+        PNGFileIHDRChunkSize + PNGFileChunkCRCSize);
+    if (!buffer || (size < headerSize) ||
+        (memcmp(buffer, PNGFileSignature, 8) != 0))
     {
-        // Unsupported PNG file bit depth
+        // Invalid PNG file signature
         return false;
     }
 
-    // Check PNG file compression
-    if (pngIHDRChunk.compression != 0)
+    // Read PNG file IHDR chunk header
+    PNGFileChunkHeader pngIHDRChunkHeader;
+    memcpy(&pngIHDRChunkHeader.length, &buffer[8], 4);
+    memcpy(pngIHDRChunkHeader.type, &buffer[12], PNGFileChunkHeaderTypeSize);
+    pngIHDRChunkHeader.length = SysByteSwap32(pngIHDRChunkHeader.length);
+    if ((pngIHDRChunkHeader.length != PNGFileIHDRChunkSize) ||
+        (memcmp(pngIHDRChunkHeader.type, PNGFileIHDRChunkType, 4) != 0))
     {
-        // Unsupported PNG file compression
+        // Invalid PNG file IHDR chunk
         return false;
     }
 
-    // Check PNG file filter
-    if (pngIHDRChunk.filter != 0)
+    // Check PNG file IHDR chunk CRC
+    uint32_t pngIHDRChunkCRC = 0;
+    memcpy(&pngIHDRChunkCRC, &buffer[headerSize-PNGFileChunkCRCSize], 4);
+    if (SysCRC32(&buffer[12], PNGFileChunkHeaderTypeSize +
+        PNGFileIHDRChunkSize) != SysByteSwap32(pngIHDRChunkCRC))
     {
-        // Unsupported PNG file filter
+        // Invalid PNG file IHDR chunk CRC
         return false;
     }
 
-    // Check PNG file interlace
-    if (pngIHDRChunk.interlace != 0)
+    // Read PNG file IHDR chunk
+    const unsigned char* pngIHDRChunk = &buffer[16];
+    uint32_t width = 0;
+    uint32_t height = 0;
+    memcpy(&width, &pngIHDRChunk[0], 4);
+    memcpy(&height, &pngIHDRChunk[4], 4);
+    width = SysByteSwap32(width);
+    height = SysByteSwap32(height);
+    uint32_t bitDepth = pngIHDRChunk[8];
+    uint32_t colorType = pngIHDRChunk[9];
+    if ((width <= 0) || (height <= 0) || (width > 0x7FFFFFFF) ||
+        (height > 0x7FFFFFFF) || (pngIHDRChunk[10] != 0) ||
+        (pngIHDRChunk[11] != 0) || (pngIHDRChunk[12] > 1))
     {
-        // Unsupported PNG file interlace
+        // Invalid PNG file IHDR chunk
         return false;
     }
 
-    // Load PNG buffer image data
-    if (!loadPNGData(buffer, bufferEnd, pngIHDRChunk))
+    // Check PNG file color type and bit depth
+    bool validDepth = false;
+    switch (colorType)
     {
-        // Could not load PNG image data
-        return false;
+        case PNGFILE_COLOR_GREYSCALE:
+            validDepth = ((bitDepth == 1) || (bitDepth == 2) ||
+                (bitDepth == 4) || (bitDepth == 8) || (bitDepth == 16));
+            break;
+        case PNGFILE_COLOR_PALETTE:
+            validDepth = ((bitDepth == 1) || (bitDepth == 2) ||
+                (bitDepth == 4) || (bitDepth == 8));
+            break;
+        case PNGFILE_COLOR_RGB:
+        case PNGFILE_COLOR_GREYSCALE_ALPHA:
+        case PNGFILE_COLOR_RGBA:
+            validDepth = ((bitDepth == 8) || (bitDepth == 16));
+            break;
+        default:
+            break;
     }
-
-    // PNG buffer is successfully loaded
-    m_loaded = true;
-    return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//  Save PNG file                                                             //
-//  return : True if PNG file is successfully saved                           //
-////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::saveImage(const std::string& filepath, PNGFileColorType colorType)
-{
-    // Check image loaded state
-    if (!m_loaded)
+    if (!validDepth)
     {
-        // No current image to save
+        // Unsupported PNG file color type or bit depth
         return false;
     }
+    info.width = width;
+    info.height = height;
+    info.colorType = static_cast<PNGFileColorType>(colorType);
+    info.bitDepth = bitDepth;
+    info.interlace = pngIHDRChunk[12];
 
-    // Save PNG file
-    if (!savePNGImage(filepath, m_width, m_height, m_image, colorType))
+    // Sum IDAT chunks sizes until IEND or the end of the buffer
+    size_t offset = headerSize;
+    while ((size - offset) >= PNGFileChunkHeaderSize)
     {
-        // Could not save PNG file
-        return false;
-    }
+        PNGFileChunkHeader pngChunkHeader;
+        memcpy(&pngChunkHeader.length, &buffer[offset], 4);
+        memcpy(pngChunkHeader.type, &buffer[offset+4],
+            PNGFileChunkHeaderTypeSize
+        );
+        pngChunkHeader.length = SysByteSwap32(pngChunkHeader.length);
+        if (pngChunkHeader.length > 0x7FFFFFFF)
+        {
+            // Invalid PNG chunk length
+            return false;
+        }
 
-    // PNG file is successfully saved
-    return true;
-}
+        if (memcmp(pngChunkHeader.type, PNGFileIDATChunkType, 4) == 0)
+        {
+            info.dataSize += pngChunkHeader.length;
+        }
+        else if (memcmp(pngChunkHeader.type, PNGFileIENDChunkType, 4) == 0)
+        {
+            info.complete = true;
+            break;
+        }
 
-////////////////////////////////////////////////////////////////////////////////
-//  Destroy PNG image                                                         //
-////////////////////////////////////////////////////////////////////////////////
-void PNGFile::destroyImage()
-{
-    if (m_image)
-    {
-        delete[] m_image;
+        // Next chunk
+        size_t chunkSize = (PNGFileChunkHeaderSize +
+            (size_t)pngChunkHeader.length + PNGFileChunkCRCSize);
+        if (chunkSize > (size - offset)) { break; }
+        offset += chunkSize;
     }
-    m_image = 0;
-    m_height = 0;
-    m_width = 0;
-    m_loaded = false;
-}
 
+    // PNG buffer header is valid
+    return true;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 //  Save PNG image                                                            //
@@ -487,7 +641,7 @@ void PNGFile::destroyImage()
 ////////////////////////////////////////////////////////////////////////////////
 bool PNGFile::savePNGImage(const std::string& filepath,
     uint32_t width, uint32_t height, const unsigned char* image,
-    PNGFileColorType colorType)
+    PNGFileColorType colorType, const PNGFileSaveOptions& options)
 {
     // Check image data
     if (!image)
@@ -577,7 +731,7 @@ bool PNGFile::savePNGImage(const std::string& filepath,
     pngIHDRChunk.height = SysByteSwap32(pngIHDRChunk.height);
 
     // Save PNG file image data
-    if (!savePNGData(pngFile, pngIHDRChunk, image))
+    if (!savePNGData(pngFile, pngIHDRChunk, image, options))
     {
         // Could not save PNG image data
         return false;
@@ -621,12 +775,20 @@ bool PNGFile::savePNGImage(const std::string& filepath,
 
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Load PNG file image data                                                  //
-//  return : True if PNG file image data is successfully loaded               //
+//  Save PNG file image data                                                  //
+//  return : True if PNG file image data is successfully saved                //
 ////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::loadPNGData(std::ifstream& pngFile,
-    PNGFileIHDRChunk& pngIHDRChunk)
+bool PNGFile::savePNGData(std::ofstream& pngFile,
+    PNGFileIHDRChunk& pngIHDRChunk, const unsigned char* image,
+    const PNGFileSaveOptions& options)
 {
+    // Check image data
+    if (!image)
+    {
+        // Invalid image data
+        return false;
+    }
+
     // Set pixel depth
     uint32_t pixelDepth = 0;
     switch (pngIHDRChunk.colorType)
@@ -651,548 +813,11 @@ bool PNGFile::loadPNGData(std::ifstream& pngFile,
             return false;
     }
 
-    // Read PNG file IDAT chunks headers
-    std::streampos pngIDATstart = pngFile.tellg();
-    size_t pngIDATChunksLength = 0;
-    unsigned int pngIDATChunksCount = 0;
-    PNGFileChunkHeader pngIDATChunkHeader;
-    while (pngFile)
-    {
-        pngIDATChunkHeader = {0, {0, 0, 0, 0}};
-        pngFile.read((char*)&pngIDATChunkHeader, PNGFileChunkHeaderSize);
-        if (!pngFile)
-        {
-            // Could not read PNG file chunk header
-            break;
-        }
-        pngIDATChunkHeader.length = SysByteSwap32(pngIDATChunkHeader.length);
-        if ((pngIDATChunkHeader.type[0] == PNGFileIDATChunkType[0]) &&
-            (pngIDATChunkHeader.type[1] == PNGFileIDATChunkType[1]) &&
-            (pngIDATChunkHeader.type[2] == PNGFileIDATChunkType[2]) &&
-            (pngIDATChunkHeader.type[3] == PNGFileIDATChunkType[3]))
-        {
-            // PNG file IDAT chunk header found
-            pngIDATChunksLength += pngIDATChunkHeader.length;
-            ++pngIDATChunksCount;
-        }
-
-        // Skip current chunk
-        pngFile.ignore(pngIDATChunkHeader.length + PNGFileChunkCRCSize);
-    }
-    if (pngIDATChunksCount <= 0)
-    {
-        // Could not find any PNG file IDAT chunk header
-        return false;
-    }
-
-    // Allocate raw image data
-    unsigned char* rawData = new (std::nothrow)
-        unsigned char[pngIDATChunksLength];
-    if (!rawData)
-    {
-        // Could not allocate raw image data
-        return false;
-    }
-
-    // Reset input file stream
-    pngFile.clear();
-    pngFile.seekg(pngIDATstart, std::ios::beg);
-
-    // Read all IDAT chunks
-    size_t rawDataOffset = 0;
-    for (unsigned int i = 0; i < pngIDATChunksCount;)
-    {
-        pngIDATChunkHeader = {0, {0, 0, 0, 0}};
-        pngFile.read((char*)&pngIDATChunkHeader, PNGFileChunkHeaderSize);
-        if (!pngFile)
-        {
-            // Could not read PNG file chunk header
-            if (rawData) { delete[] rawData; }
-            return false;
-        }
-        pngIDATChunkHeader.length = SysByteSwap32(pngIDATChunkHeader.length);
-        if ((pngIDATChunkHeader.type[0] != PNGFileIDATChunkType[0]) ||
-            (pngIDATChunkHeader.type[1] != PNGFileIDATChunkType[1]) ||
-            (pngIDATChunkHeader.type[2] != PNGFileIDATChunkType[2]) ||
-            (pngIDATChunkHeader.type[3] != PNGFileIDATChunkType[3]))
-        {
-            // Skip current chunk
-            pngFile.ignore(pngIDATChunkHeader.length + PNGFileChunkCRCSize);
-        }
-        else
-        {
-            // Read PNG file raw image data
-            pngFile.read(
-                (char*)&rawData[rawDataOffset], pngIDATChunkHeader.length
-            );
-            if (!pngFile)
-            {
-                // Could not read PNG raw image data
-                if (rawData) { delete[] rawData; }
-                return false;
-            }
-
-            // Read PNG file IDAT chunk CRC
-            uint32_t pngIDATChunkCRC = 0;
-            pngFile.read((char*)&pngIDATChunkCRC, PNGFileChunkCRCSize);
-            if (!pngFile)
-            {
-                // Could not read PNG file IDAT chunk CRC
-                if (rawData) { delete[] rawData; }
-                return false;
-            }
-            pngIDATChunkCRC = SysByteSwap32(pngIDATChunkCRC);
-
-            // Check PNG file IDAT chunk CRC
-            uint32_t checkIDATChunkCRC = SysCRC32Default;
-            checkIDATChunkCRC = SysUpdateCRC32(
-                checkIDATChunkCRC, pngIDATChunkHeader.type,
-                PNGFileChunkHeaderTypeSize
-            );
-            checkIDATChunkCRC = SysUpdateCRC32(
-                checkIDATChunkCRC, &rawData[rawDataOffset],
-                pngIDATChunkHeader.length
-            );
-            if ((checkIDATChunkCRC^SysCRC32Final) != pngIDATChunkCRC)
-            {
-                // Invalid PNG file IDAT chunk CRC
-                if (rawData) { delete[] rawData; }
-                return false;
-            }
-
-            // Increment raw data offset
-            rawDataOffset += pngIDATChunkHeader.length;
-            ++i;
-        }
-    }
-
-    // Allocate decompressed data
-    size_t pngDataSize =
-        (pngIHDRChunk.width*pngIHDRChunk.height*pixelDepth)+pngIHDRChunk.height;
-    unsigned char* pngData = new (std::nothrow) unsigned char[pngDataSize];
-    if (!pngData)
-    {
-        // Could not allocate decompressed data
-        if (rawData) { delete[] rawData; }
-        return false;
-    }
-
-    // Decompress deflate data
-    if (!ZLibDeflateDecompress(
-        rawData, pngIDATChunksLength, pngData, &pngDataSize))
-    {
-        // Could not decompress deflate data
-        if (pngData) { delete[] pngData; }
-        if (rawData) { delete[] rawData; }
-        return false;
-    }
-
-    // Allocate 32bits RGBA internal image data
-    size_t imageSize = (pngIHDRChunk.width*pngIHDRChunk.height*4);
-    m_image = new (std::nothrow) unsigned char[imageSize];
-    if (!m_image)
-    {
-        // Could not allocate internal image data
-        if (pngData) { delete[] pngData; }
-        if (rawData) { delete[] rawData; }
-        return false;
-    }
-
-    // Decode PNG image data
-    switch (pngIHDRChunk.colorType)
-    {
-        case PNGFILE_COLOR_GREYSCALE:
-            // Decode 8 bits greyscale PNG
-            if (!decodePNG8bits(
-                pngData, pngIHDRChunk.width, pngIHDRChunk.height))
-            {
-                // Could not decode 8 bits greyscale PNG
-                if (pngData) { delete[] pngData; }
-                if (rawData) { delete[] rawData; }
-                if (m_image) { delete[] m_image; m_image = 0; }
-                return false;
-            }
-            break;
-        case PNGFILE_COLOR_RGB:
-            // Decode 24 bits RGB PNG
-            if (!decodePNG24bits(
-                pngData, pngIHDRChunk.width, pngIHDRChunk.height))
-            {
-                // Could not decode 24 bits RGB PNG
-                if (pngData) { delete[] pngData; }
-                if (rawData) { delete[] rawData; }
-                if (m_image) { delete[] m_image; m_image = 0; }
-                return false;
-            }
-            break;
-        case PNGFILE_COLOR_PALETTE:
-            // Unsupported PNG file color type
-            return false;
-        case PNGFILE_COLOR_GREYSCALE_ALPHA:
-            // Decode 16 bits greyscale-alpha PNG
-            if (!decodePNG16bits(
-                pngData, pngIHDRChunk.width, pngIHDRChunk.height))
-            {
-                // Could not decode 16 bits greyscale-alpha PNG
-                if (pngData) { delete[] pngData; }
-                if (rawData) { delete[] rawData; }
-                if (m_image) { delete[] m_image; m_image = 0; }
-                return false;
-            }
-            break;
-        case PNGFILE_COLOR_RGBA:
-            // Decode 32 bits RGBA PNG
-            if (!decodePNG32bits(
-                pngData, pngIHDRChunk.width, pngIHDRChunk.height))
-            {
-                // Could not decode 32 bits RGBA PNG
-                if (pngData) { delete[] pngData; }
-                if (rawData) { delete[] rawData; }
-                if (m_image) { delete[] m_image; m_image = 0; }
-                return false;
-            }
-            break;
-        default:
-            // Unsupported PNG file color type
-            if (pngData) { delete[] pngData; }
-            if (rawData) { delete[] rawData; }
-            if (m_image) { delete[] m_image; m_image = 0; }
-            return false;
-    }
-
-    // Destroy decompressed data
-    if (pngData)
-    {
-        delete[] pngData;
-    }
-
-    // Destroy raw image data
-    if (rawData)
-    {
-        delete[] rawData;
-    }
-
-    // Set image size
-    m_width = pngIHDRChunk.width;
-    m_height = pngIHDRChunk.height;
-
-    // PNG file image data is successfully loaded
-    return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//  Load PNG buffer image data                                                //
-//  return : True if PNG buffer image data is successfully loaded             //
-////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::loadPNGData(unsigned char* buffer, unsigned char* bufferEnd,
-    PNGFileIHDRChunk& pngIHDRChunk)
-{
-    // Set pixel depth
-    uint32_t pixelDepth = 0;
-    switch (pngIHDRChunk.colorType)
-    {
-        case PNGFILE_COLOR_GREYSCALE:
-            pixelDepth = 1;
-            break;
-        case PNGFILE_COLOR_RGB:
-            pixelDepth = 3;
-            break;
-        case PNGFILE_COLOR_PALETTE:
-            // Unsupported PNG file color type
-            return false;
-        case PNGFILE_COLOR_GREYSCALE_ALPHA:
-            pixelDepth = 2;
-            break;
-        case PNGFILE_COLOR_RGBA:
-            pixelDepth = 4;
-            break;
-        default:
-            // Unsupported PNG file color type
-            return false;
-    }
-
-    // Read PNG file IDAT chunks headers
-    unsigned char* pngIDATstart = buffer;
-    size_t pngIDATChunksLength = 0;
-    unsigned int pngIDATChunksCount = 0;
-    PNGFileChunkHeader pngIDATChunkHeader;
-    while (buffer < bufferEnd)
-    {
-        pngIDATChunkHeader = {0, {0, 0, 0, 0}};
-        if ((buffer+PNGFileChunkHeaderSize) >= bufferEnd)
-        {
-            // Could not read PNG file chunk header
-            break;
-        }
-        memcpy((char*)&pngIDATChunkHeader, buffer, PNGFileChunkHeaderSize);
-        buffer += PNGFileChunkHeaderSize;
-
-        pngIDATChunkHeader.length = SysByteSwap32(
-            pngIDATChunkHeader.length
-        );
-        if ((pngIDATChunkHeader.type[0] == PNGFileIDATChunkType[0]) &&
-            (pngIDATChunkHeader.type[1] == PNGFileIDATChunkType[1]) &&
-            (pngIDATChunkHeader.type[2] == PNGFileIDATChunkType[2]) &&
-            (pngIDATChunkHeader.type[3] == PNGFileIDATChunkType[3]))
-        {
-            // PNG file IDAT chunk header found
-            pngIDATChunksLength += pngIDATChunkHeader.length;
-            ++pngIDATChunksCount;
-        }
-
-        // Skip current chunk
-        buffer += (pngIDATChunkHeader.length + PNGFileChunkCRCSize);
-    }
-    if (pngIDATChunksCount <= 0)
-    {
-        // Could not find any PNG file IDAT chunk header
-        return false;
-    }
-
-    // Allocate raw image data
-    unsigned char* rawData = new (std::nothrow)
-        unsigned char[pngIDATChunksLength];
-    if (!rawData)
-    {
-        // Could not allocate raw image data
-        return false;
-    }
-
-    // Reset input file stream
-    buffer = pngIDATstart;
-
-    // Read all IDAT chunks
-    size_t rawDataOffset = 0;
-    for (unsigned int i = 0; i < pngIDATChunksCount;)
-    {
-        pngIDATChunkHeader = {0, {0, 0, 0, 0}};
-        if ((buffer+PNGFileChunkHeaderSize) >= bufferEnd)
-        {
-            // Could not read PNG file chunk header
-            if (rawData) { delete[] rawData; }
-            return false;
-        }
-        memcpy((char*)&pngIDATChunkHeader, buffer, PNGFileChunkHeaderSize);
-        buffer += PNGFileChunkHeaderSize;
-        
-        pngIDATChunkHeader.length = SysByteSwap32(
-            pngIDATChunkHeader.length
-        );
-        if ((pngIDATChunkHeader.type[0] != PNGFileIDATChunkType[0]) ||
-            (pngIDATChunkHeader.type[1] != PNGFileIDATChunkType[1]) ||
-            (pngIDATChunkHeader.type[2] != PNGFileIDATChunkType[2]) ||
-            (pngIDATChunkHeader.type[3] != PNGFileIDATChunkType[3]))
-        {
-            // Skip current chunk
-            buffer += (pngIDATChunkHeader.length + PNGFileChunkCRCSize);
-        }
-        else
-        {
-            // Read PNG file raw image data
-            if ((buffer+pngIDATChunkHeader.length) >= bufferEnd)
-            {
-                // Could not read PNG raw image data
-                if (rawData) { delete[] rawData; }
-                return false;
-            }
-            memcpy(
-                (char*)&rawData[rawDataOffset],
-                buffer, pngIDATChunkHeader.length
-            );
-            buffer += pngIDATChunkHeader.length;
-
-            // Read PNG file IDAT chunk CRC
-            uint32_t pngIDATChunkCRC = 0;
-            if ((buffer+PNGFileChunkCRCSize) >= bufferEnd)
-            {
-                // Could not read PNG file IDAT chunk CRC
-                if (rawData) { delete[] rawData; }
-                return false;
-            }
-            memcpy((char*)&pngIDATChunkCRC, buffer, PNGFileChunkCRCSize);
-            buffer += PNGFileChunkCRCSize;
-            pngIDATChunkCRC = SysByteSwap32(pngIDATChunkCRC);
-
-            // Check PNG file IDAT chunk CRC
-            uint32_t checkIDATChunkCRC = SysCRC32Default;
-            checkIDATChunkCRC = SysUpdateCRC32(
-                checkIDATChunkCRC, pngIDATChunkHeader.type,
-                PNGFileChunkHeaderTypeSize
-            );
-            checkIDATChunkCRC = SysUpdateCRC32(
-                checkIDATChunkCRC, &rawData[rawDataOffset],
-                pngIDATChunkHeader.length
-            );
-            if ((checkIDATChunkCRC^SysCRC32Final) != pngIDATChunkCRC)
-            {
-                // Invalid PNG file IDAT chunk CRC
-                if (rawData) { delete[] rawData; }
-                return false;
-            }
-
-            // Increment raw data offset
-            rawDataOffset += pngIDATChunkHeader.length;
-            ++i;
-        }
-    }
-
-    // Allocate decompressed data
-    size_t pngDataSize =
-        (pngIHDRChunk.width*pngIHDRChunk.height*pixelDepth)+pngIHDRChunk.height;
-    unsigned char* pngData = new (std::nothrow) unsigned char[pngDataSize];
-    if (!pngData)
-    {
-        // Could not allocate decompressed data
-        if (rawData) { delete[] rawData; }
-        return false;
-    }
-
-    // Decompress deflate data
-    if (!ZLibDeflateDecompress(
-        rawData, pngIDATChunksLength, pngData, &pngDataSize))
-    {
-        // Could not decompress deflate data
-        if (pngData) { delete[] pngData; }
-        if (rawData) { delete[] rawData; }
-        return false;
-    }
-
-    // Allocate 32bits RGBA internal image data
-    size_t imageSize = (pngIHDRChunk.width*pngIHDRChunk.height*4);
-    m_image = new (std::nothrow) unsigned char[imageSize];
-    if (!m_image)
-    {
-        // Could not allocate internal image data
-        if (pngData) { delete[] pngData; }
-        if (rawData) { delete[] rawData; }
-        return false;
-    }
-
-    // Decode PNG image data
-    switch (pngIHDRChunk.colorType)
-    {
-        case PNGFILE_COLOR_GREYSCALE:
-            // Decode 8 bits greyscale PNG
-            if (!decodePNG8bits(
-                pngData, pngIHDRChunk.width, pngIHDRChunk.height))
-            {
-                // Could not decode 8 bits greyscale PNG
-                if (pngData) { delete[] pngData; }
-                if (rawData) { delete[] rawData; }
-                if (m_image) { delete[] m_image; m_image = 0; }
-                return false;
-            }
-            break;
-        case PNGFILE_COLOR_RGB:
-            // Decode 24 bits RGB PNG
-            if (!decodePNG24bits(
-                pngData, pngIHDRChunk.width, pngIHDRChunk.height))
-            {
-                // Could not decode 24 bits RGB PNG
-                if (pngData) { delete[] pngData; }
-                if (rawData) { delete[] rawData; }
-                if (m_image) { delete[] m_image; m_image = 0; }
-                return false;
-            }
-            break;
-        case PNGFILE_COLOR_PALETTE:
-            // Unsupported PNG file color type
-            return false;
-        case PNGFILE_COLOR_GREYSCALE_ALPHA:
-            // Decode 16 bits greyscale-alpha PNG
-            if (!decodePNG16bits(
-                pngData, pngIHDRChunk.width, pngIHDRChunk.height))
-            {
-                // Could not decode 16 bits greyscale-alpha PNG
-                if (pngData) { delete[] pngData; }
-                if (rawData) { delete[] rawData; }
-                if (m_image) { delete[] m_image; m_image = 0; }
-                return false;
-            }
-            break;
-        case PNGFILE_COLOR_RGBA:
-            // Decode 32 bits RGBA PNG
-            if (!decodePNG32bits(
-                pngData, pngIHDRChunk.width, pngIHDRChunk.height))
-            {
-                // Could not decode 32 bits RGBA PNG
-                if (pngData) { delete[] pngData; }
-                if (rawData) { delete[] rawData; }
-                if (m_image) { delete[] m_image; m_image = 0; }
-                return false;
-            }
-            break;
-        default:
-            // Unsupported PNG file color type
-            if (pngData) { delete[] pngData; }
-            if (rawData) { delete[] rawData; }
-            if (m_image) { delete[] m_image; m_image = 0; }
-            return false;
-    }
-
-    // Destroy decompressed data
-    if (pngData)
-    {
-        delete[] pngData;
-    }
-
-    // Destroy raw image data
-    if (rawData)
-    {
-        delete[] rawData;
-    }
-
-    // Set image size
-    m_width = pngIHDRChunk.width;
-    m_height = pngIHDRChunk.height;
-
-    // PNG buffer image data is successfully loaded
-    return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//  Save PNG file image data                                                  //
-//  return : True if PNG file image data is successfully saved                //
-////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::savePNGData(std::ofstream& pngFile,
-    PNGFileIHDRChunk& pngIHDRChunk, const unsigned char* image)
-{
-    // Check image data
-    if (!image)
-    {
-        // Invalid image data
-        return false;
-    }
-
-    // Set pixel depth
-    uint32_t pixelDepth = 0;
-    switch (pngIHDRChunk.colorType)
-    {
-        case PNGFILE_COLOR_GREYSCALE:
-            pixelDepth = 1;
-            break;
-        case PNGFILE_COLOR_RGB:
-            pixelDepth = 3;
-            break;
-        case PNGFILE_COLOR_PALETTE:
-            // Unsupported PNG file color type
-            return false;
-        case PNGFILE_COLOR_GREYSCALE_ALPHA:
-            pixelDepth = 2;
-            break;
-        case PNGFILE_COLOR_RGBA:
-            pixelDepth = 4;
-            break;
-        default:
-            // Unsupported PNG file color type
-            return false;
-    }
-
-    // Allocate PNG data
-    size_t pngDataSize =
-        (pngIHDRChunk.width*pngIHDRChunk.height*pixelDepth)+pngIHDRChunk.height;
-    unsigned char* pngData = new (std::nothrow) unsigned char[pngDataSize];
-    if (!pngData)
+    // Allocate PNG data
+    size_t pngDataSize =
+        (pngIHDRChunk.width*pngIHDRChunk.height*pixelDepth)+pngIHDRChunk.height;
+    unsigned char* pngData = new (std::nothrow) unsigned char[pngDataSize];
+    if (!pngData)
     {
         // Could not allocate PNG data
         return false;
@@ -1250,6 +875,30 @@ bool PNGFile::savePNGData(std::ofstream& pngFile,
             return false;
     }
 
+    // Filter PNG scanlines
+    if (options.filters != PNGFILE_FILTERS_NONE)
+    {
+        unsigned char* filteredData = new (std::nothrow)
+            unsigned char[pngDataSize];
+        if (!filteredData)
+        {
+            // Could not allocate filtered data
+            if (pngData) { delete[] pngData; }
+            return false;
+        }
+        if (!filterPNGData(pngData, filteredData, pngIHDRChunk.height,
+            (size_t)pngIHDRChunk.width*pixelDepth, pixelDepth,
+            options.filters))
+        {
+            // Could not filter PNG scanlines
+            if (filteredData) { delete[] filteredData; }
+            if (pngData) { delete[] pngData; }
+            return false;
+        }
+        delete[] pngData;
+        pngData = filteredData;
+    }
+
     // Compute ZLib compressed data size
     size_t compressedDataSize = ZLibComputeDeflateCompressSize(pngDataSize);
 
@@ -1264,8 +913,22 @@ bool PNGFile::savePNGData(std::ofstream& pngFile,
     }
 
     // Compress deflate data
-    if (!ZLibDeflateCompress(
-        pngData, pngDataSize, compressedData, &compressedDataSize))
+    bool compressed = false;
+    if (options.parallel)
+    {
+        compressed = ZLibDeflateCompressParallel(pngData, pngDataSize,
+            compressedData, &compressedDataSize,
+            static_cast<ZLibDeflateLevel>(options.level)
+        );
+    }
+    else
+    {
+        compressed = ZLibDeflateCompress(pngData, pngDataSize,
+            compressedData, &compressedDataSize,
+            static_cast<ZLibDeflateLevel>(options.level)
+        );
+    }
+    if (!compressed)
     {
         // Could not compress deflate data
         if (compressedData) { delete[] compressedData; }
@@ -1334,128 +997,113 @@ bool PNGFile::savePNGData(std::ofstream& pngFile,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Decode PNG 32 bits data                                                   //
-//  return : True if PNG 32 bits data are successfully decoded                //
+//  Filter PNG scanlines                                                      //
+//  return : True if PNG scanlines are successfully filtered                  //
 ////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::decodePNG32bits(unsigned char* data,
-    uint32_t width, uint32_t height)
+bool PNGFile::filterPNGData(const unsigned char* data,
+    unsigned char* filtered, uint32_t height,
+    size_t scanlineSize, uint32_t pixelDepth,
+    PNGFileFilterStrategy filters)
 {
-    size_t inIndex = 0;
-    size_t outIndex = 0;
-    size_t scanlineSize = (width*4);
-    for (uint32_t j = 0; j < height; ++j)
+    // Check PNG data
+    if (!data || !filtered || (scanlineSize <= 0) || (pixelDepth <= 0))
+    {
+        // Invalid PNG data
+        return false;
+    }
+
+    // Allocate candidate scanlines and zero first previous scanline
+    size_t rowSize = (scanlineSize+1);
+    unsigned char* candidates = new (std::nothrow)
+        unsigned char[rowSize*(PNGFILE_FILTER_PAETH+2)];
+    if (!candidates)
     {
-        // Check scanline filter type
-        switch (data[inIndex++])
+        // Could not allocate candidate scanlines
+        return false;
+    }
+    unsigned char* zeroRow = &candidates[rowSize*(PNGFILE_FILTER_PAETH+1)];
+    memset(zeroRow, 0, rowSize);
+
+    // Allocate brute force deflate encoder
+    ZLibDeflateEncoder* encoder = 0;
+    unsigned char* trialData = 0;
+    size_t trialSize = ZLibComputeDeflateCompressSize(rowSize);
+    if (filters == PNGFILE_FILTERS_BRUTEFORCE)
+    {
+        encoder = new (std::nothrow) ZLibDeflateEncoder;
+        trialData = new (std::nothrow) unsigned char[trialSize];
+        if (!encoder || !trialData)
         {
-            case PNGFILE_FILTER_NONE:
-            {
-                // No filter
-                memcpy(&m_image[outIndex], &data[inIndex], scanlineSize);
-                outIndex += scanlineSize;
-                inIndex += scanlineSize;
-                break;
-            }
-            case PNGFILE_FILTER_SUB:
-            {
-                // Sub filter
-                size_t prevIndex = inIndex;
+            // Could not allocate brute force deflate encoder
+            if (trialData) { delete[] trialData; }
+            if (encoder) { delete encoder; }
+            delete[] candidates;
+            return false;
+        }
+    }
 
-                // Copy first pixel
-                memcpy(&m_image[outIndex], &data[inIndex], 4);
-                inIndex += 4;
-                outIndex += 4;
+    const unsigned char* prevRow = &zeroRow[1];
+    for (uint32_t j = 0; j < height; ++j)
+    {
+        const unsigned char* row = &data[(j*rowSize)+1];
+        size_t start = (j*rowSize);
+        size_t window = (start < PNGFileBruteForceWindow) ?
+            start : PNGFileBruteForceWindow;
 
-                // Decode sub filtered scanline
-                for (size_t i = 4; i < scanlineSize; ++i)
-                {
-                    m_image[outIndex++] =
-                        (data[inIndex++] += data[prevIndex++]);
-                }
-                break;
-            }
-            case PNGFILE_FILTER_UP:
-            {
-                // Up filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                unsigned char prevData = 0;
+        // Evaluate every filter type
+        uint64_t bestCost = 0;
+        unsigned char bestFilter = PNGFILE_FILTER_NONE;
+        for (unsigned char filter = PNGFILE_FILTER_NONE;
+            filter <= PNGFILE_FILTER_PAETH; ++filter)
+        {
+            unsigned char* candidate = &candidates[filter*rowSize];
+            candidate[0] = filter;
+            PNGFilterRow(filter, &candidate[1], row, prevRow,
+                scanlineSize, pixelDepth
+            );
 
-                // Decode up filtered scanline
-                for (size_t i = 0; i < scanlineSize; ++i)
+            uint64_t cost = 0;
+            if (encoder)
+            {
+                // Deflate candidate after the previous filtered scanlines
+                memcpy(&filtered[start], candidate, rowSize);
+                ZLibInitEncoder(*encoder, trialData, trialSize);
+                if (!ZLibDeflateEncode(*encoder, &filtered[start-window],
+                    window, window+rowSize,
+                    static_cast<ZLibDeflateLevel>(PNGFileBruteForceLevel),
+                    true))
                 {
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    m_image[outIndex++] = (data[inIndex++] += prevData);
-                    ++prevIndex;
+                    // Could not deflate candidate scanline
+                    delete[] trialData;
+                    delete encoder;
+                    delete[] candidates;
+                    return false;
                 }
-                break;
+                cost = encoder->outIndex;
             }
-            case PNGFILE_FILTER_AVERAGE:
+            else
             {
-                // Average filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                size_t prevIndex2 = inIndex;
-                unsigned char prevData = 0;
-
-                // Decode first pixel (up filtered)
-                for (size_t i = 0; i < 4; ++i)
-                {
-                    if (j > 0) { prevData = (data[prevIndex]/2); }
-                    m_image[outIndex++] = (data[inIndex++] += prevData);
-                    ++prevIndex;
-                }
-
-                // Decode avarage filtered scanline
-                for (size_t i = 4; i < scanlineSize; ++i)
-                {
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    m_image[outIndex++] = (data[inIndex++] +=
-                        ((prevData + data[prevIndex2++])/2));
-                    ++prevIndex;
-                }
-                break;
+                // Minimum sum of absolute values heuristic
+                cost = PNGFilterRowCost(&candidate[1], scanlineSize);
             }
-            case PNGFILE_FILTER_PAETH:
+            if ((filter == PNGFILE_FILTER_NONE) || (cost < bestCost))
             {
-                // Paeth multibyte filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                size_t prevIndex2 = prevIndex;
-                size_t prevIndex3 = inIndex;
-                unsigned char prevData = 0;
-                unsigned char prevData2 = 0;
-
-                // Decode first pixel
-                for (size_t i = 0; i < 4; ++i)
-                {
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    m_image[outIndex++] = (data[inIndex++] += prevData);
-                    ++prevIndex;
-                }
-
-                // Decode paeth filtered scanline
-                for (size_t i = 4; i < scanlineSize; ++i)
-                {
-                    unsigned char currentData = data[prevIndex3++];
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    if (j > 0) { prevData2 = data[prevIndex2++]; }
-                    int p = prevData - prevData2;
-                    int pc = currentData - prevData2;
-                    int pa = (p < 0) ? -p : p;
-                    int pb = (pc < 0) ? -pc : pc;
-                    pc = ((p + pc) < 0) ? -(p + pc) : (p + pc);
-                    if (pb < pa) { pa = pb; currentData = prevData; }
-                    if (pc < pa) { currentData = prevData2; }
-                    m_image[outIndex++] = (data[inIndex++] += currentData);
-                    ++prevIndex;
-                }
-                break;
+                bestCost = cost;
+                bestFilter = filter;
             }
-            default:
-                // Invalid filter type
-                return false;
         }
+
+        // Keep the best filtered scanline
+        memcpy(&filtered[start], &candidates[bestFilter*rowSize], rowSize);
+        prevRow = row;
     }
 
-    // PNG 32 bits data are successfully decoded
+    // Destroy candidate scanlines and brute force encoder
+    if (trialData) { delete[] trialData; }
+    if (encoder) { delete encoder; }
+    delete[] candidates;
+
+    // PNG scanlines are successfully filtered
     return true;
 }
 
@@ -1491,154 +1139,6 @@ bool PNGFile::encodePNG32bits(unsigned char* data,
     return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-//  Decode PNG 24 bits data                                                   //
-//  return : True if PNG 24 bits data are successfully decoded                //
-////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::decodePNG24bits(unsigned char* data,
-    uint32_t width, uint32_t height)
-{
-    size_t inIndex = 0;
-    size_t outIndex = 0;
-    size_t scanlineSize = (width*3);
-    for (uint32_t j = 0; j < height; ++j)
-    {
-        // Check scanline filter type
-        switch (data[inIndex++])
-        {
-            case PNGFILE_FILTER_NONE:
-            {
-                // No filter
-                for (size_t i = 0; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    m_image[outIndex++] = data[inIndex++];
-                    // Alpha channel
-                    if ((i % 3) == 2) { m_image[outIndex++] = 255; }
-                }
-                break;
-            }
-            case PNGFILE_FILTER_SUB:
-            {
-                // Sub filter
-                size_t prevIndex = inIndex;
-
-                // Copy first pixel
-                memcpy(&m_image[outIndex], &data[inIndex], 3);
-                inIndex += 3;
-                outIndex += 3;
-                // Add first pixel alpha channel
-                m_image[outIndex++] = 255;
-
-                // Decode sub filtered scanline
-                for (size_t i = 3; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    m_image[outIndex++] =
-                        (data[inIndex++] += data[prevIndex++]);
-                    // Alpha channel
-                    if ((i % 3) == 2) { m_image[outIndex++] = 255; }
-                }
-                break;
-            }
-            case PNGFILE_FILTER_UP:
-            {
-                // Up filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                unsigned char prevData = 0;
-
-                // Decode up filtered scanline
-                for (size_t i = 0; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    m_image[outIndex++] = (data[inIndex++] += prevData);
-                    ++prevIndex;
-                    // Alpha channel
-                    if ((i % 3) == 2) { m_image[outIndex++] = 255; }
-                }
-                break;
-            }
-            case PNGFILE_FILTER_AVERAGE:
-            {
-                // Average filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                size_t prevIndex2 = inIndex;
-                unsigned char prevData = 0;
-
-                // Decode first pixel (up filtered)
-                for (size_t i = 0; i < 3; ++i)
-                {
-                    if (j > 0) { prevData = (data[prevIndex]/2); }
-                    m_image[outIndex++] = (data[inIndex++] += prevData);
-                    ++prevIndex;
-                }
-                // Add first pixel alpha channel
-                m_image[outIndex++] = 255;
-
-                // Decode average filtered scanline
-                for (size_t i = 3; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    m_image[outIndex++] = (data[inIndex++] +=
-                        ((prevData + data[prevIndex2++])/2));
-                    ++prevIndex;
-                    // Alpha channel
-                    if ((i % 3) == 2) { m_image[outIndex++] = 255; }
-                }
-                break;
-            }
-            case PNGFILE_FILTER_PAETH:
-            {
-                // Paeth multibyte filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                size_t prevIndex2 = prevIndex;
-                size_t prevIndex3 = inIndex;
-                unsigned char prevData = 0;
-                unsigned char prevData2 = 0;
-
-                // Decode first pixel
-                for (size_t i = 0; i < 3; ++i)
-                {
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    m_image[outIndex++] = (data[inIndex++] += prevData);
-                    ++prevIndex;
-                }
-                // Add first pixel alpha channel
-                m_image[outIndex++] = 255;
-
-                // Decode paeth filtered scanline
-                for (size_t i = 3; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    unsigned char currentData = data[prevIndex3++];
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    if (j > 0) { prevData2 = data[prevIndex2++]; }
-                    int p = prevData - prevData2;
-                    int pc = currentData - prevData2;
-                    int pa = (p < 0) ? -p : p;
-                    int pb = (pc < 0) ? -pc : pc;
-                    pc = ((p + pc) < 0) ? -(p + pc) : (p + pc);
-                    if (pb < pa) { pa = pb; currentData = prevData; }
-                    if (pc < pa) { currentData = prevData2; }
-                    m_image[outIndex++] = (data[inIndex++] += currentData);
-                    ++prevIndex;
-                    // Alpha channel
-                    if ((i % 3) == 2) { m_image[outIndex++] = 255; }
-                }
-                break;
-            }
-            default:
-                // Invalid filter type
-                return false;
-        }
-    }
-
-    // PNG 24 bits data are successfully decoded
-    return true;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 //  Encode PNG 24 bits data                                                   //
 //  return : True if PNG 24 bits data are successfully encoded                //
@@ -1675,189 +1175,6 @@ bool PNGFile::encodePNG24bits(unsigned char* data,
     return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-//  Decode PNG 16 bits data                                                   //
-//  return : True if PNG 16 bits data are successfully decoded                //
-////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::decodePNG16bits(unsigned char* data,
-    uint32_t width, uint32_t height)
-{
-    size_t inIndex = 0;
-    size_t outIndex = 0;
-    size_t scanlineSize = (width*2);
-    for (uint32_t j = 0; j < height; ++j)
-    {
-        // Check scanline filter type
-        switch (data[inIndex++])
-        {
-            case PNGFILE_FILTER_NONE:
-            {
-                // No filter
-                for (size_t i = 0; i < scanlineSize; i+=2)
-                {
-                    // RGB channels
-                    m_image[outIndex++] = data[inIndex];
-                    m_image[outIndex++] = data[inIndex];
-                    m_image[outIndex++] = data[inIndex++];
-                    // Alpha channel
-                    m_image[outIndex++] = data[inIndex++];
-                }
-                break;
-            }
-            case PNGFILE_FILTER_SUB:
-            {
-                // Sub filter
-                size_t prevIndex = inIndex;
-
-                // Copy first pixel
-                m_image[outIndex++] = data[inIndex];
-                m_image[outIndex++] = data[inIndex];
-                m_image[outIndex++] = data[inIndex++];
-                // Alpha channel
-                m_image[outIndex++] = data[inIndex++];
-
-                // Decode sub filtered scanline
-                for (size_t i = 2; i < scanlineSize; i+=2)
-                {
-                    // RGB channels
-                    unsigned char greyscale =
-                        (data[inIndex++] += data[prevIndex++]);
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    // Alpha channel
-                    m_image[outIndex++] =
-                        (data[inIndex++] += data[prevIndex++]);
-                }
-                break;
-            }
-            case PNGFILE_FILTER_UP:
-            {
-                // Up filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                unsigned char prevData = 0;
-
-                // Decode up filtered scanline
-                for (size_t i = 0; i < scanlineSize; i+=2)
-                {
-                    // RGB channels
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    unsigned char greyscale = (data[inIndex++] += prevData);
-                    ++prevIndex;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    // Alpha channel
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    m_image[outIndex++] = (data[inIndex++] += prevData);
-                    ++prevIndex;
-                }
-                break;
-            }
-            case PNGFILE_FILTER_AVERAGE:
-            {
-                // Average filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                size_t prevIndex2 = inIndex;
-                unsigned char prevData = 0;
-
-                // Decode first pixel (up filtered)
-                if (j > 0) { prevData = (data[prevIndex]/2); }
-                unsigned char greyscale = (data[inIndex++] += prevData);
-                ++prevIndex;
-                m_image[outIndex++] = greyscale;
-                m_image[outIndex++] = greyscale;
-                m_image[outIndex++] = greyscale;
-                // Alpha channel
-                if (j > 0) { prevData = (data[prevIndex]/2); }
-                m_image[outIndex++] = (data[inIndex++] += prevData);
-                ++prevIndex;
-
-                // Decode avarage filtered scanline
-                for (size_t i = 2; i < scanlineSize; i+=2)
-                {
-                    // RGB channels
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    greyscale = (data[inIndex++] +=
-                        ((prevData + data[prevIndex2++])/2));
-                    ++prevIndex;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    // Alpha channel
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    m_image[outIndex++] = (data[inIndex++] +=
-                        ((prevData + data[prevIndex2++])/2));
-                    ++prevIndex;
-                }
-                break;
-            }
-            case PNGFILE_FILTER_PAETH:
-            {
-                // Paeth multibyte filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                size_t prevIndex2 = prevIndex;
-                size_t prevIndex3 = inIndex;
-                unsigned char prevData = 0;
-                unsigned char prevData2 = 0;
-
-                // Decode first pixel
-                if (j > 0) { prevData = data[prevIndex]; }
-                unsigned char greyscale = (data[inIndex++] += prevData);
-                ++prevIndex;
-                m_image[outIndex++] = greyscale;
-                m_image[outIndex++] = greyscale;
-                m_image[outIndex++] = greyscale;
-                // Alpha channel
-                if (j > 0) { prevData = data[prevIndex]; }
-                m_image[outIndex++] = (data[inIndex++] += prevData);
-                ++prevIndex;
-
-                // Decode paeth filtered scanline
-                for (size_t i = 2; i < scanlineSize; i+=2)
-                {
-                    // RGB channels
-                    unsigned char currentData = data[prevIndex3++];
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    if (j > 0) { prevData2 = data[prevIndex2++]; }
-                    int p = prevData - prevData2;
-                    int pc = currentData - prevData2;
-                    int pa = (p < 0) ? -p : p;
-                    int pb = (pc < 0) ? -pc : pc;
-                    pc = ((p + pc) < 0) ? -(p + pc) : (p + pc);
-                    if (pb < pa) { pa = pb; currentData = prevData; }
-                    if (pc < pa) { currentData = prevData2; }
-                    greyscale = (data[inIndex++] += currentData);
-                    ++prevIndex;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    // Alpha channel
-                    currentData = data[prevIndex3++];
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    if (j > 0) { prevData2 = data[prevIndex2++]; }
-                    p = prevData - prevData2;
-                    pc = currentData - prevData2;
-                    pa = (p < 0) ? -p : p;
-                    pb = (pc < 0) ? -pc : pc;
-                    pc = ((p + pc) < 0) ? -(p + pc) : (p + pc);
-                    if (pb < pa) { pa = pb; currentData = prevData; }
-                    if (pc < pa) { currentData = prevData2; }
-                    m_image[outIndex++] = (data[inIndex++] += currentData);
-                    ++prevIndex;
-                }
-                break;
-            }
-            default:
-                // Invalid filter type
-                return false;
-        }
-    }
-
-    // PNG 16 bits data are successfully decoded
-    return true;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 //  Encode PNG 16 bits data                                                   //
 //  return : True if PNG 16 bits data are successfully encoded                //
@@ -1900,168 +1217,6 @@ bool PNGFile::encodePNG16bits(unsigned char* data,
     return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-//  Decode PNG 8 bits data                                                    //
-//  return : True if PNG 8 bits data are successfully decoded                 //
-////////////////////////////////////////////////////////////////////////////////
-bool PNGFile::decodePNG8bits(unsigned char* data,
-    uint32_t width, uint32_t height)
-{
-    size_t inIndex = 0;
-    size_t outIndex = 0;
-    size_t scanlineSize = (width*1);
-    for (uint32_t j = 0; j < height; ++j)
-    {
-        // Check scanline filter type
-        switch (data[inIndex++])
-        {
-            case PNGFILE_FILTER_NONE:
-            {
-                // No filter
-                for (size_t i = 0; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    m_image[outIndex++] = data[inIndex];
-                    m_image[outIndex++] = data[inIndex];
-                    m_image[outIndex++] = data[inIndex++];
-                    // Alpha channel
-                    m_image[outIndex++] = 255;
-                }
-                break;
-            }
-            case PNGFILE_FILTER_SUB:
-            {
-                // Sub filter
-                size_t prevIndex = inIndex;
-
-                // Copy first pixel
-                m_image[outIndex++] = data[inIndex];
-                m_image[outIndex++] = data[inIndex];
-                m_image[outIndex++] = data[inIndex++];
-                // Add first pixel alpha channel
-                m_image[outIndex++] = 255;
-
-                // Decode sub filtered scanline
-                for (size_t i = 1; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    unsigned char greyscale = 
-                        (data[inIndex++] += data[prevIndex++]);
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    // Alpha channel
-                    m_image[outIndex++] = 255;
-                }
-                break;
-            }
-            case PNGFILE_FILTER_UP:
-            {
-                // Up filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                unsigned char prevData = 0;
-
-                // Decode up filtered scanline
-                for (size_t i = 0; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    unsigned char greyscale = (data[inIndex++] += prevData);
-                    ++prevIndex;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    // Alpha channel
-                    m_image[outIndex++] = 255;
-                }
-                break;
-            }
-            case PNGFILE_FILTER_AVERAGE:
-            {
-                // Average filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                size_t prevIndex2 = inIndex;
-                unsigned char prevData = 0;
-
-                // Decode first pixel (up filtered)
-                if (j > 0) { prevData = (data[prevIndex]/2); }
-                unsigned char greyscale = (data[inIndex++] += prevData);
-                ++prevIndex;
-                m_image[outIndex++] = greyscale;
-                m_image[outIndex++] = greyscale;
-                m_image[outIndex++] = greyscale;
-                // Add first pixel alpha channel
-                m_image[outIndex++] = 255;
-
-                // Decode average filtered scanline
-                for (size_t i = 1; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    greyscale = (data[inIndex++] +=
-                        ((prevData + data[prevIndex2++])/2));
-                    ++prevIndex;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    // Alpha channel
-                    m_image[outIndex++] = 255;
-                }
-                break;
-            }
-            case PNGFILE_FILTER_PAETH:
-            {
-                // Paeth multibyte filter
-                size_t prevIndex = (inIndex-scanlineSize-1);
-                size_t prevIndex2 = prevIndex;
-                size_t prevIndex3 = inIndex;
-                unsigned char prevData = 0;
-                unsigned char prevData2 = 0;
-
-                // Decode first pixel
-                if (j > 0) { prevData = data[prevIndex]; }
-                unsigned char greyscale = (data[inIndex++] += prevData);
-                ++prevIndex;
-                m_image[outIndex++] = greyscale;
-                m_image[outIndex++] = greyscale;
-                m_image[outIndex++] = greyscale;
-                // Add first pixel alpha channel
-                m_image[outIndex++] = 255;
-
-                // Decode paeth filtered scanline
-                for (size_t i = 1; i < scanlineSize; ++i)
-                {
-                    // RGB channels
-                    unsigned char currentData = data[prevIndex3++];
-                    if (j > 0) { prevData = data[prevIndex]; }
-                    if (j > 0) { prevData2 = data[prevIndex2++]; }
-                    int p = prevData - prevData2;
-                    int pc = currentData - prevData2;
-                    int pa = (p < 0) ? -p : p;
-                    int pb = (pc < 0) ? -pc : pc;
-                    pc = ((p + pc) < 0) ? -(p + pc) : (p + pc);
-                    if (pb < pa) { pa = pb; currentData = prevData; }
-                    if (pc < pa) { currentData = prevData2; }
-                    greyscale = (data[inIndex++] += currentData);
-                    ++prevIndex;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    m_image[outIndex++] = greyscale;
-                    // Alpha channel
-                    m_image[outIndex++] = 255;
-                }
-                break;
-            }
-            default:
-                // Invalid filter type
-                return false;
-        }
-    }
-
-    // PNG 8 bits data are successfully decoded
-    return true;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 //  Encode PNG 8 bits data                                                    //
 //  return : True if PNG 8 bits data are successfully encoded                 //
@@ -46,6 +46,7 @@
     #include "../System/SysCPU.h"
     #include "../System/SysCRC.h"
     #include "../Compress/ZLib.h"
+    #include "ImageDownscaler.h"
 
     #include <cstddef>
     #include <cstdint>
@@ -62,6 +63,13 @@
         {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
     const uint32_t PNGFileMaxImageWidth = 4096;
     const uint32_t PNGFileMaxImageHeight = 4096;
+    const uint32_t PNGFileMaxTiledImageWidth = 32768;
+    const uint32_t PNGFileMaxTiledImageHeight = 32768;
+    const uint32_t PNGFileTileSize = 1024;
+    const uint32_t PNGFileStreamBandRows = 16;
+    const uint32_t PNGFileAdam7Passes = 7;
+    const size_t PNGFileReadBlockSize = 65536;
+    const size_t PNGFileBruteForceWindow = 16384;
 
 
     ////////////////////////////////////////////////////////////////////////////
@@ -92,6 +100,19 @@
     };
     const uint32_t PNGFileIHDRChunkSize = 13;
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile PLTE chunk type                                               //
+    ////////////////////////////////////////////////////////////////////////////
+    const unsigned char PNGFilePLTEChunkType[4] = {0x50, 0x4C, 0x54, 0x45};
+    const uint32_t PNGFilePLTEChunkMaxSize = 768;
+    const uint32_t PNGFilePaletteMaxSize = 256;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile tRNS chunk type                                               //
+    ////////////////////////////////////////////////////////////////////////////
+    const unsigned char PNGFileTRNSChunkType[4] = {0x74, 0x52, 0x4E, 0x53};
+    const uint32_t PNGFileTRNSChunkMaxSize = 256;
+
     ////////////////////////////////////////////////////////////////////////////
     //  PNGFile IDAT chunk type                                               //
     ////////////////////////////////////////////////////////////////////////////
@@ -128,8 +149,132 @@
     };
 
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile checksum verification policy enumeration                      //
+    ////////////////////////////////////////////////////////////////////////////
+    enum PNGFileVerifyPolicy
+    {
+        PNGFILE_VERIFY_FULL = 0,
+        PNGFILE_VERIFY_HEADER = 1,
+        PNGFILE_VERIFY_SKIP = 2
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile load options structure                                        //
+    //  FULL checks every chunk CRC and the zlib Adler32                      //
+    //  HEADER checks the IHDR chunk CRC only                                 //
+    //  SKIP checks no checksum, and is only honored when the asset content   //
+    //  was already validated against a manifest hash (else FULL is used)     //
+    //  downscale decodes at 1/2^downscale size (up to 1/8), Adam7 and tiled  //
+    //  images are always decoded at full size                                //
+    //  mipmaps packs the full mip chain after the image                      //
+    ////////////////////////////////////////////////////////////////////////////
+    struct PNGFileLoadOptions
+    {
+        PNGFileVerifyPolicy verify;     // Checksum verification policy
+        bool manifestValidated;         // Content validated by manifest hash
+        uint32_t downscale;             // Downscale shift (0 to 3)
+        ImageDownscalerFilter filter;   // Downscale and mipmaps filter
+        bool mipmaps;                   // Generate mip chain
+        bool gammaCorrect;              // Filter in linear color space
+    };
+    const PNGFileLoadOptions PNGFileDefaultLoadOptions =
+        {PNGFILE_VERIFY_FULL, false,
+        0, IMAGEDOWNSCALER_FILTER_BOX, false, true};
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile filter strategy enumeration                                   //
+    ////////////////////////////////////////////////////////////////////////////
+    enum PNGFileFilterStrategy
+    {
+        PNGFILE_FILTERS_NONE = 0,
+        PNGFILE_FILTERS_ADAPTIVE = 1,
+        PNGFILE_FILTERS_BRUTEFORCE = 2
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile compression level enumeration (matches ZLib deflate levels)   //
+    ////////////////////////////////////////////////////////////////////////////
+    enum PNGFileCompressionLevel
+    {
+        PNGFILE_COMPRESSION_STORE = 0,
+        PNGFILE_COMPRESSION_FASTEST = 1,
+        PNGFILE_COMPRESSION_FAST = 2,
+        PNGFILE_COMPRESSION_DEFAULT = 3,
+        PNGFILE_COMPRESSION_SMALLEST = 4
+    };
+    const PNGFileCompressionLevel PNGFileBruteForceLevel =
+        PNGFILE_COMPRESSION_FAST;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile save options structure                                        //
+    //  NONE stores every scanline unfiltered                                 //
+    //  ADAPTIVE picks the filter with the minimum sum of absolute values     //
+    //  BRUTEFORCE deflates each filtered candidate after the previous        //
+    //  scanlines and keeps the smallest one                                  //
+    ////////////////////////////////////////////////////////////////////////////
+    struct PNGFileSaveOptions
+    {
+        PNGFileFilterStrategy filters;  // Scanlines filter strategy
+        PNGFileCompressionLevel level;  // Deflate compression level
+        bool parallel;                  // Parallel deflate segments
+    };
+    const PNGFileSaveOptions PNGFileFastSaveOptions =
+        {PNGFILE_FILTERS_ADAPTIVE, PNGFILE_COMPRESSION_FASTEST, true};
+    const PNGFileSaveOptions PNGFileSmallSaveOptions =
+        {PNGFILE_FILTERS_BRUTEFORCE, PNGFILE_COMPRESSION_SMALLEST, false};
+    const PNGFileSaveOptions PNGFileDefaultSaveOptions =
+        {PNGFILE_FILTERS_NONE, PNGFILE_COMPRESSION_DEFAULT, true};
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile info structure                                                //
+    //  dataSize sums the lengths of the IDAT chunks whose header is in the   //
+    //  buffer, complete is true when the IEND chunk is inside the buffer     //
+    ////////////////////////////////////////////////////////////////////////////
+    struct PNGFileInfo
+    {
+        uint32_t width;                 // Image width
+        uint32_t height;                // Image height
+        PNGFileColorType colorType;     // Image color type
+        uint32_t bitDepth;              // Bits per sample
+        uint32_t interlace;             // Interlace method (1 for Adam7)
+        size_t dataSize;                // Total IDAT chunks size
+        bool complete;                  // IEND chunk reached
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile rows callback                                                 //
+    //  rows points to the first decoded RGBA row of the band, stride is the  //
+    //  size in bytes of one row, rows stay valid until the stream finishes   //
+    //  pass is 0 for non interlaced images, or the Adam7 pass (1 to 7) that  //
+    //  refined the band rows (earlier passes fill the rows of later ones)    //
+    ////////////////////////////////////////////////////////////////////////////
+    typedef void (*PNGFileRowsCallback)(void* userData,
+        const unsigned char* rows, size_t stride,
+        uint32_t firstRow, uint32_t rowsCount, uint32_t pass);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFile tile callback                                                 //
+    //  tile points to the tightly packed RGBA tile (width*4 bytes per row)   //
+    //  at pixel x, y of the image, and is only valid during the callback     //
+    //  Tiles on the right and bottom edges are clipped to the image size     //
+    ////////////////////////////////////////////////////////////////////////////
+    typedef void (*PNGFileTileCallback)(void* userData,
+        const unsigned char* tile, uint32_t x, uint32_t y,
+        uint32_t width, uint32_t height);
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGDecoder class declaration                                          //
+    ////////////////////////////////////////////////////////////////////////////
+    class PNGDecoder;
+
+
     ////////////////////////////////////////////////////////////////////////////
     //  PNGFile class definition                                              //
+    //  The decoder and its scratch buffers are kept between loads, decoded   //
+    //  images live in a pooled buffer owned by the decoder, or in the caller //
+    //  destination image                                                     //
     ////////////////////////////////////////////////////////////////////////////
     class PNGFile
     {
@@ -152,27 +297,96 @@
             bool setImage(uint32_t width, uint32_t height,
                 const unsigned char* image);
 
+            ////////////////////////////////////////////////////////////////////
+            //  Set PNG file destination image for the next loads             //
+            //  Rows are decoded stride bytes apart (0 for width*4) into the  //
+            //  caller owned image, loads fail if size is too small           //
+            //  image 0 decodes into the pooled image buffer                  //
+            ////////////////////////////////////////////////////////////////////
+            void setDestination(unsigned char* image, size_t size,
+                size_t stride = 0);
+
             ////////////////////////////////////////////////////////////////////
             //  Load PNG file                                                 //
             //  return : True if PNG file is successfully loaded              //
             ////////////////////////////////////////////////////////////////////
-            bool loadImage(const std::string& filepath);
+            bool loadImage(const std::string& filepath,
+                const PNGFileLoadOptions& options = PNGFileDefaultLoadOptions);
 
             ////////////////////////////////////////////////////////////////////
             //  Load PNG buffer                                               //
+            //  Complete buffers inflate their image data in one shot         //
             //  return : True if PNG buffer is successfully loaded            //
             ////////////////////////////////////////////////////////////////////
-            bool loadImage(unsigned char* buffer, size_t size);
+            bool loadImage(const unsigned char* buffer, size_t size,
+                const PNGFileLoadOptions& options = PNGFileDefaultLoadOptions);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Load PNG file as tiles                                        //
+            //  Images up to PNGFileMaxTiledImageWidth/Height are decoded one //
+            //  band of tiles at a time (width*tileSize*4 bytes), the whole   //
+            //  image is never held in memory (Adam7 images are rejected)     //
+            //  return : True if PNG file tiles are successfully decoded      //
+            ////////////////////////////////////////////////////////////////////
+            bool loadTiles(const std::string& filepath, uint32_t tileSize,
+                PNGFileTileCallback callback, void* userData,
+                const PNGFileLoadOptions& options = PNGFileDefaultLoadOptions);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Start PNG progressive decode stream                           //
+            //  callback is called each time bandRows rows are decoded        //
+            //  return : True if PNG stream is successfully started           //
+            ////////////////////////////////////////////////////////////////////
+            bool startStream(
+                const PNGFileLoadOptions& options = PNGFileDefaultLoadOptions,
+                PNGFileRowsCallback callback = 0, void* userData = 0,
+                uint32_t bandRows = PNGFileStreamBandRows);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Start PNG tiled decode stream                                 //
+            //  callback is called with each tile once its rows are decoded   //
+            //  return : True if PNG tiled stream is successfully started     //
+            ////////////////////////////////////////////////////////////////////
+            bool startTiledStream(uint32_t tileSize,
+                PNGFileTileCallback callback, void* userData,
+                const PNGFileLoadOptions& options = PNGFileDefaultLoadOptions);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Feed PNG progressive decode stream                            //
+            //  return : True if PNG stream data are valid                    //
+            ////////////////////////////////////////////////////////////////////
+            bool feedStream(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Finish PNG progressive decode stream                          //
+            //  Tiled streams keep no image, only the image size is set       //
+            //  return : True if PNG stream is successfully loaded            //
+            ////////////////////////////////////////////////////////////////////
+            bool finishStream();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG progressive decode stream completed passes            //
+            //  return : Completed Adam7 passes count (0 if not interlaced)   //
+            ////////////////////////////////////////////////////////////////////
+            uint32_t getStreamPasses() const;
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG progressive decode stream image                       //
+            //  Width and height are set as soon as the header is decoded     //
+            //  return : Partially decoded RGBA image, or 0 before the header //
+            ////////////////////////////////////////////////////////////////////
+            const unsigned char* getStreamImage() const;
 
             ////////////////////////////////////////////////////////////////////
             //  Save PNG file                                                 //
             //  return : True if PNG file is successfully saved               //
             ////////////////////////////////////////////////////////////////////
             bool saveImage(const std::string& filepath,
-                PNGFileColorType colorType = PNGFILE_COLOR_RGBA);
+                PNGFileColorType colorType = PNGFILE_COLOR_RGBA,
+                const PNGFileSaveOptions& options = PNGFileDefaultSaveOptions);
 
             ////////////////////////////////////////////////////////////////////
-            //  Destroy PNG image                                             //
+            //  Destroy PNG image, pooled image and decoder scratch buffers   //
             ////////////////////////////////////////////////////////////////////
             void destroyImage();
 
@@ -213,6 +427,42 @@
                 return m_height;
             }
 
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG file image stride                                     //
+            //  return : PNG file image size in bytes between two rows        //
+            ////////////////////////////////////////////////////////////////////
+            inline size_t getStride() const
+            {
+                return m_stride;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG file mip levels count                                 //
+            //  return : Mip levels packed after the image (1 if no mipmaps)  //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getMipLevels() const
+            {
+                return m_mipLevels;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get PNG file mip level image data                             //
+            //  return : Packed RGBA mip level (0 if the level is missing)    //
+            ////////////////////////////////////////////////////////////////////
+            inline unsigned char* getMipmap(uint32_t level)
+            {
+                if (!m_image || (level >= m_mipLevels)) { return 0; }
+                return &m_image[ImageMipChainSize(m_width, m_height, level)];
+            }
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Probe PNG buffer header and chunks without inflating data     //
+            //  The image size is not checked against the maximum size        //
+            //  return : True if PNG buffer header is valid                   //
+            ////////////////////////////////////////////////////////////////////
+            static bool probe(const unsigned char* buffer, size_t size,
+                PNGFileInfo& info);
 
             ////////////////////////////////////////////////////////////////////
             //  Save PNG image                                                //
@@ -220,7 +470,8 @@
             ////////////////////////////////////////////////////////////////////
             static bool savePNGImage(const std::string& filepath,
                 uint32_t width, uint32_t height, const unsigned char* image,
-                PNGFileColorType colorType = PNGFILE_COLOR_RGBA);
+                PNGFileColorType colorType = PNGFILE_COLOR_RGBA,
+                const PNGFileSaveOptions& options = PNGFileDefaultSaveOptions);
 
 
         private:
@@ -236,32 +487,33 @@
 
 
             ////////////////////////////////////////////////////////////////////
-            //  Load PNG file image data                                      //
-            //  return : True if PNG file image data is successfully loaded   //
+            //  Reset PNG image, keep the decoder and its scratch buffers     //
             ////////////////////////////////////////////////////////////////////
-            bool loadPNGData(std::ifstream& pngFile,
-                PNGFileIHDRChunk& pngIHDRChunk);
+            void resetImage();
 
             ////////////////////////////////////////////////////////////////////
-            //  Load PNG buffer image data                                    //
-            //  return : True if PNG buffer image data is successfully loaded //
+            //  Feed PNG file into the started decode stream                  //
+            //  return : True if PNG file is successfully decoded             //
             ////////////////////////////////////////////////////////////////////
-            bool loadPNGData(unsigned char* buffer, unsigned char* bufferEnd,
-                PNGFileIHDRChunk& pngIHDRChunk);
+            bool streamFile(const std::string& filepath);
 
             ////////////////////////////////////////////////////////////////////
             //  Save PNG file image data                                      //
             //  return : True if PNG file image data is successfully saved    //
             ////////////////////////////////////////////////////////////////////
             static bool savePNGData(std::ofstream& pngFile,
-                PNGFileIHDRChunk& pngIHDRChunk, const unsigned char* image);
+                PNGFileIHDRChunk& pngIHDRChunk, const unsigned char* image,
+                const PNGFileSaveOptions& options);
 
             ////////////////////////////////////////////////////////////////////
-            //  Decode PNG 32 bits data                                       //
-            //  return : True if PNG 32 bits data are successfully decoded    //
+            //  Filter PNG scanlines                                          //
+            //  data holds unfiltered scanlines, each after a filter byte     //
+            //  return : True if PNG scanlines are successfully filtered      //
             ////////////////////////////////////////////////////////////////////
-            bool decodePNG32bits(unsigned char* data,
-                uint32_t width, uint32_t height);
+            static bool filterPNGData(const unsigned char* data,
+                unsigned char* filtered, uint32_t height,
+                size_t scanlineSize, uint32_t pixelDepth,
+                PNGFileFilterStrategy filters);
 
             ////////////////////////////////////////////////////////////////////
             //  Encode PNG 32 bits data                                       //
@@ -270,13 +522,6 @@
             static bool encodePNG32bits(unsigned char* data,
                 uint32_t width, uint32_t height, const unsigned char* image);
 
-            ////////////////////////////////////////////////////////////////////
-            //  Decode PNG 24 bits data                                       //
-            //  return : True if PNG 24 bits data are successfully decoded    //
-            ////////////////////////////////////////////////////////////////////
-            bool decodePNG24bits(unsigned char* data,
-                uint32_t width, uint32_t height);
-
             ////////////////////////////////////////////////////////////////////
             //  Encode PNG 24 bits data                                       //
             //  return : True if PNG 24 bits data are successfully encoded    //
@@ -284,13 +529,6 @@
             static bool encodePNG24bits(unsigned char* data,
                 uint32_t width, uint32_t height, const unsigned char* image);
 
-            ////////////////////////////////////////////////////////////////////
-            //  Decode PNG 16 bits data                                       //
-            //  return : True if PNG 16 bits data are successfully decoded    //
-            ////////////////////////////////////////////////////////////////////
-            bool decodePNG16bits(unsigned char* data,
-                uint32_t width, uint32_t height);
-
             ////////////////////////////////////////////////////////////////////
             //  Encode PNG 16 bits data                                       //
             //  return : True if PNG 16 bits data are successfully encoded    //
@@ -298,13 +536,6 @@
             static bool encodePNG16bits(unsigned char* data,
                 uint32_t width, uint32_t height, const unsigned char* image);
 
-            ////////////////////////////////////////////////////////////////////
-            //  Decode PNG 8 bits data                                        //
-            //  return : True if PNG 8 bits data are successfully decoded     //
-            ////////////////////////////////////////////////////////////////////
-            bool decodePNG8bits(unsigned char* data,
-                uint32_t width, uint32_t height);
-
             ////////////////////////////////////////////////////////////////////
             //  Encode PNG 8 bits data                                        //
             //  return : True if PNG 8 bits data are successfully encoded     //
@@ -316,8 +547,16 @@
         private:
             bool                m_loaded;       // Image loaded state
             unsigned char*      m_image;        // Image data
+            bool                m_ownsImage;    // Image data ownership
             uint32_t            m_width;        // Image width
             uint32_t            m_height;       // Image height
+            size_t              m_stride;       // Image rows stride
+            uint32_t            m_mipLevels;    // Image mip levels count
+            PNGDecoder*         m_decoder;      // Progressive decoder
+
+            unsigned char*      m_destination;  // Caller destination image
+            size_t              m_destSize;     // Destination size
+            size_t              m_destStride;   // Destination rows stride
     };
 
 
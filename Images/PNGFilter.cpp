@@ -0,0 +1,830 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/PNGFilter.cpp : PNG scanline filters                            //
+////////////////////////////////////////////////////////////////////////////////
+#include "PNGFilter.h"
+
+#if defined(WOS_X86)
+    #include <immintrin.h>
+#endif
+#if defined(WOS_NEON)
+    #include <arm_neon.h>
+#endif
+#if defined(WOS_WASMSIMD)
+    #include <wasm_simd128.h>
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  PNG filter byte shift shuffle table                                       //
+//  16 bytes loaded at (16-n) shift a vector up by n bytes (zero filled)      //
+////////////////////////////////////////////////////////////////////////////////
+alignas(16) static const unsigned char PNGFilterShiftTable[32] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//  Set PNG filter Sub carry shuffle                                          //
+//  Broadcasts the last complete pixel of a step bytes block                  //
+//  return : Block step (5 pixels for 3 bytes pixels, 16 bytes otherwise)     //
+////////////////////////////////////////////////////////////////////////////////
+inline size_t PNGFilterSubCarry(unsigned char carry[16], uint32_t bpp)
+{
+    size_t step = (bpp == 3) ? 15 : 16;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        carry[i] = static_cast<unsigned char>((step-bpp) + (i % bpp));
+    }
+    return step;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load PNG pixel (3 or 4 bytes) into a 32 bits value                        //
+//  return : Pixel bytes (zero extended)                                      //
+////////////////////////////////////////////////////////////////////////////////
+inline uint32_t PNGFilterLoadPixel(const unsigned char* data, uint32_t bpp)
+{
+    // Compose 3 bytes pixels in registers (no stack round trip)
+    uint32_t pixel = 0;
+    if (bpp == 4) { memcpy(&pixel, data, 4); return pixel; }
+    uint16_t low = 0;
+    memcpy(&low, data, 2);
+    return (static_cast<uint32_t>(low) |
+        (static_cast<uint32_t>(data[2]) << 16));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Store PNG pixel (3 or 4 bytes) from a 32 bits value                       //
+////////////////////////////////////////////////////////////////////////////////
+inline void PNGFilterStorePixel(unsigned char* data, uint32_t pixel,
+    uint32_t bpp)
+{
+    if (bpp == 4) { memcpy(data, &pixel, 4); return; }
+    uint16_t low = static_cast<uint16_t>(pixel);
+    memcpy(data, &low, 2);
+    data[2] = static_cast<unsigned char>(pixel >> 16);
+}
+
+
+#if defined(WOS_X86)
+////////////////////////////////////////////////////////////////////////////////
+//  Check if the CPU supports SSSE3 unfilter kernels                          //
+//  return : True if SSSE3 is supported                                       //
+////////////////////////////////////////////////////////////////////////////////
+static bool PNGFilterSSSE3Supported()
+{
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Sub scanline with SSSE3 (in-register prefix sums)                //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("ssse3")))
+static size_t PNGUnfilterSubSSSE3(unsigned char* row, size_t size,
+    uint32_t bpp)
+{
+    alignas(16) unsigned char carryShuffle[16];
+    size_t step = PNGFilterSubCarry(carryShuffle, bpp);
+    const __m128i carryMask = _mm_load_si128((const __m128i*)carryShuffle);
+    __m128i carry = _mm_setzero_si128();
+
+    size_t i = 0;
+    __m128i next = _mm_setzero_si128();
+    if (size >= 16) { next = _mm_loadu_si128((const __m128i*)row); }
+    for (; (i+16) <= size; i += step)
+    {
+        // Load the next block before the store overlaps it
+        __m128i x = next;
+        if ((i+step+16) <= size)
+        {
+            next = _mm_loadu_si128((const __m128i*)&row[i+step]);
+        }
+        for (uint32_t shift = bpp; shift < step; shift <<= 1)
+        {
+            x = _mm_add_epi8(x, _mm_shuffle_epi8(x, _mm_loadu_si128(
+                (const __m128i*)&PNGFilterShiftTable[16-shift]
+            )));
+        }
+        x = _mm_add_epi8(x, carry);
+        carry = _mm_shuffle_epi8(x, carryMask);
+
+        // Keep the next block first byte filtered (3 bytes pixels)
+        unsigned char last = row[i+15];
+        _mm_storeu_si128((__m128i*)&row[i], x);
+        if (step < 16) { row[i+15] = last; }
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Up scanline with SSSE3                                           //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("ssse3")))
+static size_t PNGUnfilterUpSSSE3(unsigned char* row,
+    const unsigned char* prev, size_t size)
+{
+    size_t i = 0;
+    for (; (i+32) <= size; i += 32)
+    {
+        __m128i x1 = _mm_loadu_si128((const __m128i*)&row[i]);
+        __m128i x2 = _mm_loadu_si128((const __m128i*)&row[i+16]);
+        __m128i b1 = _mm_loadu_si128((const __m128i*)&prev[i]);
+        __m128i b2 = _mm_loadu_si128((const __m128i*)&prev[i+16]);
+        _mm_storeu_si128((__m128i*)&row[i], _mm_add_epi8(x1, b1));
+        _mm_storeu_si128((__m128i*)&row[i+16], _mm_add_epi8(x2, b2));
+    }
+    for (; (i+16) <= size; i += 16)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)&row[i]);
+        __m128i b = _mm_loadu_si128((const __m128i*)&prev[i]);
+        _mm_storeu_si128((__m128i*)&row[i], _mm_add_epi8(x, b));
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Average scanline with SSSE3 (3 and 4 bytes pixels)               //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("ssse3")))
+static size_t PNGUnfilterAverageSSSE3(unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    const __m128i ones = _mm_set1_epi8(1);
+    __m128i a = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; (i+bpp) <= size; i += bpp)
+    {
+        __m128i b = _mm_cvtsi32_si128((int)PNGFilterLoadPixel(&prev[i], bpp));
+        __m128i x = _mm_cvtsi32_si128((int)PNGFilterLoadPixel(&row[i], bpp));
+
+        // Rounded down average : avg(a, b) - ((a ^ b) & 1)
+        __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b),
+            _mm_and_si128(_mm_xor_si128(a, b), ones)
+        );
+        a = _mm_add_epi8(x, avg);
+        PNGFilterStorePixel(&row[i], (uint32_t)_mm_cvtsi128_si32(a), bpp);
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Paeth scanline with SSSE3 (3 and 4 bytes pixels)                 //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("ssse3")))
+static size_t PNGUnfilterPaethSSSE3(unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a = _mm_setzero_si128();
+    __m128i c = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; (i+bpp) <= size; i += bpp)
+    {
+        __m128i b = _mm_unpacklo_epi8(
+            _mm_cvtsi32_si128((int)PNGFilterLoadPixel(&prev[i], bpp)), zero
+        );
+        __m128i x = _mm_cvtsi32_si128((int)PNGFilterLoadPixel(&row[i], bpp));
+
+        // Distances to the initial estimate a + b - c
+        __m128i p = _mm_sub_epi16(b, c);
+        __m128i q = _mm_sub_epi16(a, c);
+        __m128i pa = _mm_abs_epi16(p);
+        __m128i pb = _mm_abs_epi16(q);
+        __m128i pc = _mm_abs_epi16(_mm_add_epi16(p, q));
+        __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+
+        // Select a, then b, then c in case of ties
+        __m128i mask = _mm_cmpeq_epi16(smallest, pb);
+        __m128i nearest = _mm_or_si128(
+            _mm_and_si128(mask, b), _mm_andnot_si128(mask, c)
+        );
+        mask = _mm_cmpeq_epi16(smallest, pa);
+        nearest = _mm_or_si128(
+            _mm_and_si128(mask, a), _mm_andnot_si128(mask, nearest)
+        );
+
+        x = _mm_add_epi8(x, _mm_packus_epi16(nearest, nearest));
+        PNGFilterStorePixel(&row[i], (uint32_t)_mm_cvtsi128_si32(x), bpp);
+        a = _mm_unpacklo_epi8(x, zero);
+        c = b;
+    }
+    return i;
+}
+#endif // WOS_X86
+
+#if defined(WOS_NEON)
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Sub scanline with NEON (in-register prefix sums)                 //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+static size_t PNGUnfilterSubNEON(unsigned char* row, size_t size,
+    uint32_t bpp)
+{
+    #if defined(__aarch64__)
+        unsigned char carryShuffle[16];
+        size_t step = PNGFilterSubCarry(carryShuffle, bpp);
+        const uint8x16_t carryMask = vld1q_u8(carryShuffle);
+        uint8x16_t carry = vdupq_n_u8(0);
+
+        size_t i = 0;
+        uint8x16_t next = vdupq_n_u8(0);
+        if (size >= 16) { next = vld1q_u8(row); }
+        for (; (i+16) <= size; i += step)
+        {
+            // Load the next block before the store overlaps it
+            uint8x16_t x = next;
+            if ((i+step+16) <= size) { next = vld1q_u8(&row[i+step]); }
+            for (uint32_t shift = bpp; shift < step; shift <<= 1)
+            {
+                x = vaddq_u8(x, vqtbl1q_u8(
+                    x, vld1q_u8(&PNGFilterShiftTable[16-shift])
+                ));
+            }
+            x = vaddq_u8(x, carry);
+            carry = vqtbl1q_u8(x, carryMask);
+
+            // Keep the next block first byte filtered (3 bytes pixels)
+            unsigned char last = row[i+15];
+            vst1q_u8(&row[i], x);
+            if (step < 16) { row[i+15] = last; }
+        }
+        return i;
+    #else
+        // Table lookups are limited to 8 bytes on 32 bits ARM
+        (void)row;
+        (void)size;
+        (void)bpp;
+        return 0;
+    #endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Up scanline with NEON                                            //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+static size_t PNGUnfilterUpNEON(unsigned char* row,
+    const unsigned char* prev, size_t size)
+{
+    size_t i = 0;
+    for (; (i+16) <= size; i += 16)
+    {
+        vst1q_u8(&row[i], vaddq_u8(vld1q_u8(&row[i]), vld1q_u8(&prev[i])));
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Average scanline with NEON (3 and 4 bytes pixels)                //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+static size_t PNGUnfilterAverageNEON(unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    uint8x8_t a = vdup_n_u8(0);
+
+    size_t i = 0;
+    for (; (i+bpp) <= size; i += bpp)
+    {
+        uint8x8_t b = vreinterpret_u8_u32(
+            vdup_n_u32(PNGFilterLoadPixel(&prev[i], bpp))
+        );
+        uint8x8_t x = vreinterpret_u8_u32(
+            vdup_n_u32(PNGFilterLoadPixel(&row[i], bpp))
+        );
+
+        // Halving add is the rounded down average
+        a = vadd_u8(x, vhadd_u8(a, b));
+        PNGFilterStorePixel(&row[i],
+            vget_lane_u32(vreinterpret_u32_u8(a), 0), bpp
+        );
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Paeth scanline with NEON (3 and 4 bytes pixels)                  //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+static size_t PNGUnfilterPaethNEON(unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    int16x8_t a = vdupq_n_s16(0);
+    int16x8_t c = vdupq_n_s16(0);
+
+    size_t i = 0;
+    for (; (i+bpp) <= size; i += bpp)
+    {
+        int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(
+            vdup_n_u32(PNGFilterLoadPixel(&prev[i], bpp))
+        )));
+        uint8x8_t x = vreinterpret_u8_u32(
+            vdup_n_u32(PNGFilterLoadPixel(&row[i], bpp))
+        );
+
+        // Distances to the initial estimate a + b - c
+        int16x8_t p = vsubq_s16(b, c);
+        int16x8_t q = vsubq_s16(a, c);
+        int16x8_t pa = vabsq_s16(p);
+        int16x8_t pb = vabsq_s16(q);
+        int16x8_t pc = vabsq_s16(vaddq_s16(p, q));
+        int16x8_t smallest = vminq_s16(pc, vminq_s16(pa, pb));
+
+        // Select a, then b, then c in case of ties
+        int16x8_t nearest = vbslq_s16(vceqq_s16(smallest, pb), b, c);
+        nearest = vbslq_s16(vceqq_s16(smallest, pa), a, nearest);
+
+        x = vadd_u8(x, vmovn_u16(vreinterpretq_u16_s16(nearest)));
+        PNGFilterStorePixel(&row[i],
+            vget_lane_u32(vreinterpret_u32_u8(x), 0), bpp
+        );
+        a = vreinterpretq_s16_u16(vmovl_u8(x));
+        c = b;
+    }
+    return i;
+}
+#endif // WOS_NEON
+
+#if defined(WOS_WASMSIMD)
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Sub scanline with WebAssembly simd128 (prefix sums)              //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+static size_t PNGUnfilterSubWasmSIMD(unsigned char* row, size_t size,
+    uint32_t bpp)
+{
+    unsigned char carryShuffle[16];
+    size_t step = PNGFilterSubCarry(carryShuffle, bpp);
+    const v128_t carryMask = wasm_v128_load(carryShuffle);
+    v128_t carry = wasm_i8x16_splat(0);
+
+    size_t i = 0;
+    v128_t next = wasm_i8x16_splat(0);
+    if (size >= 16) { next = wasm_v128_load(row); }
+    for (; (i+16) <= size; i += step)
+    {
+        // Load the next block before the store overlaps it
+        v128_t x = next;
+        if ((i+step+16) <= size) { next = wasm_v128_load(&row[i+step]); }
+        for (uint32_t shift = bpp; shift < step; shift <<= 1)
+        {
+            x = wasm_i8x16_add(x, wasm_i8x16_swizzle(
+                x, wasm_v128_load(&PNGFilterShiftTable[16-shift])
+            ));
+        }
+        x = wasm_i8x16_add(x, carry);
+        carry = wasm_i8x16_swizzle(x, carryMask);
+
+        // Keep the next block first byte filtered (3 bytes pixels)
+        unsigned char last = row[i+15];
+        wasm_v128_store(&row[i], x);
+        if (step < 16) { row[i+15] = last; }
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Up scanline with WebAssembly simd128                             //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+static size_t PNGUnfilterUpWasmSIMD(unsigned char* row,
+    const unsigned char* prev, size_t size)
+{
+    size_t i = 0;
+    for (; (i+16) <= size; i += 16)
+    {
+        wasm_v128_store(&row[i], wasm_i8x16_add(
+            wasm_v128_load(&row[i]), wasm_v128_load(&prev[i])
+        ));
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Average scanline with WebAssembly simd128 (3 and 4 bpp)          //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+static size_t PNGUnfilterAverageWasmSIMD(unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    const v128_t ones = wasm_i8x16_splat(1);
+    v128_t a = wasm_i8x16_splat(0);
+
+    size_t i = 0;
+    for (; (i+bpp) <= size; i += bpp)
+    {
+        v128_t b = wasm_i32x4_make(
+            (int32_t)PNGFilterLoadPixel(&prev[i], bpp), 0, 0, 0
+        );
+        v128_t x = wasm_i32x4_make(
+            (int32_t)PNGFilterLoadPixel(&row[i], bpp), 0, 0, 0
+        );
+
+        // Rounded down average : avgr(a, b) - ((a ^ b) & 1)
+        v128_t avg = wasm_i8x16_sub(wasm_u8x16_avgr(a, b),
+            wasm_v128_and(wasm_v128_xor(a, b), ones)
+        );
+        a = wasm_i8x16_add(x, avg);
+        PNGFilterStorePixel(&row[i],
+            (uint32_t)wasm_i32x4_extract_lane(a, 0), bpp
+        );
+    }
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Paeth scanline with WebAssembly simd128 (3 and 4 bpp)            //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+static size_t PNGUnfilterPaethWasmSIMD(unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    v128_t a = wasm_i16x8_splat(0);
+    v128_t c = wasm_i16x8_splat(0);
+
+    size_t i = 0;
+    for (; (i+bpp) <= size; i += bpp)
+    {
+        v128_t b = wasm_u16x8_extend_low_u8x16(wasm_i32x4_make(
+            (int32_t)PNGFilterLoadPixel(&prev[i], bpp), 0, 0, 0
+        ));
+        v128_t x = wasm_i32x4_make(
+            (int32_t)PNGFilterLoadPixel(&row[i], bpp), 0, 0, 0
+        );
+
+        // Distances to the initial estimate a + b - c
+        v128_t p = wasm_i16x8_sub(b, c);
+        v128_t q = wasm_i16x8_sub(a, c);
+        v128_t pa = wasm_i16x8_abs(p);
+        v128_t pb = wasm_i16x8_abs(q);
+        v128_t pc = wasm_i16x8_abs(wasm_i16x8_add(p, q));
+        v128_t smallest = wasm_i16x8_min(pc, wasm_i16x8_min(pa, pb));
+
+        // Select a, then b, then c in case of ties
+        v128_t nearest = wasm_v128_bitselect(
+            b, c, wasm_i16x8_eq(smallest, pb)
+        );
+        nearest = wasm_v128_bitselect(
+            a, nearest, wasm_i16x8_eq(smallest, pa)
+        );
+
+        x = wasm_i8x16_add(x, wasm_u8x16_narrow_i16x8(nearest, nearest));
+        PNGFilterStorePixel(&row[i],
+            (uint32_t)wasm_i32x4_extract_lane(x, 0), bpp
+        );
+        a = wasm_u16x8_extend_low_u8x16(x);
+        c = b;
+    }
+    return i;
+}
+#endif // WOS_WASMSIMD
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Sub scanline with the available SIMD kernel                      //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+inline size_t PNGUnfilterSubSIMD(unsigned char* row, size_t size,
+    uint32_t bpp)
+{
+    #if defined(WOS_X86)
+        if (PNGFilterSSSE3Supported())
+        {
+            return PNGUnfilterSubSSSE3(row, size, bpp);
+        }
+    #elif defined(WOS_NEON)
+        return PNGUnfilterSubNEON(row, size, bpp);
+    #elif defined(WOS_WASMSIMD)
+        return PNGUnfilterSubWasmSIMD(row, size, bpp);
+    #endif
+    (void)row;
+    (void)size;
+    (void)bpp;
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Up scanline with the available SIMD kernel                       //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+inline size_t PNGUnfilterUpSIMD(unsigned char* row,
+    const unsigned char* prev, size_t size)
+{
+    #if defined(WOS_X86)
+        if (PNGFilterSSSE3Supported())
+        {
+            return PNGUnfilterUpSSSE3(row, prev, size);
+        }
+    #elif defined(WOS_NEON)
+        return PNGUnfilterUpNEON(row, prev, size);
+    #elif defined(WOS_WASMSIMD)
+        return PNGUnfilterUpWasmSIMD(row, prev, size);
+    #endif
+    (void)row;
+    (void)prev;
+    (void)size;
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Average scanline with the available SIMD kernel                  //
+//  Single byte and two bytes pixels stay on the scalar path : the serial     //
+//  left dependency leaves no parallelism to extract within a pixel           //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+inline size_t PNGUnfilterAverageSIMD(unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    if (bpp >= 3)
+    {
+        #if defined(WOS_X86)
+            if (PNGFilterSSSE3Supported())
+            {
+                return PNGUnfilterAverageSSSE3(row, prev, size, bpp);
+            }
+        #elif defined(WOS_NEON)
+            return PNGUnfilterAverageNEON(row, prev, size, bpp);
+        #elif defined(WOS_WASMSIMD)
+            return PNGUnfilterAverageWasmSIMD(row, prev, size, bpp);
+        #endif
+    }
+    (void)row;
+    (void)prev;
+    (void)size;
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter Paeth scanline with the available SIMD kernel                    //
+//  Single byte and two bytes pixels stay on the scalar path                  //
+//  return : Number of bytes unfiltered                                       //
+////////////////////////////////////////////////////////////////////////////////
+inline size_t PNGUnfilterPaethSIMD(unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    if (bpp >= 3)
+    {
+        #if defined(WOS_X86)
+            if (PNGFilterSSSE3Supported())
+            {
+                return PNGUnfilterPaethSSSE3(row, prev, size, bpp);
+            }
+        #elif defined(WOS_NEON)
+            return PNGUnfilterPaethNEON(row, prev, size, bpp);
+        #elif defined(WOS_WASMSIMD)
+            return PNGUnfilterPaethWasmSIMD(row, prev, size, bpp);
+        #endif
+    }
+    (void)row;
+    (void)prev;
+    (void)size;
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter PNG scanline from the start byte with the scalar path            //
+//  return : True if the scanline is successfully unfiltered                  //
+////////////////////////////////////////////////////////////////////////////////
+static bool PNGUnfilterRowFrom(unsigned char filter, unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp, size_t start)
+{
+    switch (filter)
+    {
+        case PNGFILE_FILTER_NONE:
+            // No filter
+            return true;
+
+        case PNGFILE_FILTER_SUB:
+            // Sub filter
+            for (size_t i = ((start > bpp) ? start : bpp); i < size; ++i)
+            {
+                row[i] += row[i-bpp];
+            }
+            return true;
+
+        case PNGFILE_FILTER_UP:
+            // Up filter
+            for (size_t i = start; i < size; ++i)
+            {
+                row[i] += prev[i];
+            }
+            return true;
+
+        case PNGFILE_FILTER_AVERAGE:
+            // Average filter
+            for (size_t i = start; i < bpp; ++i)
+            {
+                row[i] += (prev[i] >> 1);
+            }
+            for (size_t i = ((start > bpp) ? start : bpp); i < size; ++i)
+            {
+                row[i] += (unsigned char)(
+                    ((uint32_t)row[i-bpp] + (uint32_t)prev[i]) >> 1
+                );
+            }
+            return true;
+
+        case PNGFILE_FILTER_PAETH:
+            // Paeth filter
+            for (size_t i = start; i < bpp; ++i)
+            {
+                row[i] += prev[i];
+            }
+            for (size_t i = ((start > bpp) ? start : bpp); i < size; ++i)
+            {
+                row[i] += PNGPaethPredictor(row[i-bpp], prev[i], prev[i-bpp]);
+            }
+            return true;
+
+        default:
+            // Invalid filter type
+            return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter PNG scanline in place                                            //
+//  return : True if the scanline is successfully unfiltered                  //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGUnfilterRow(unsigned char filter, unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    // Check scanline
+    if (!row || !prev || (bpp <= 0) || (bpp > PNGFilterMaxSIMDPixelSize) ||
+        (bpp > size))
+    {
+        // Fall back to the scalar path
+        return PNGUnfilterRowScalar(filter, row, prev, size, bpp);
+    }
+
+    // SIMD kernels unfilter the scanline head, scalar code the remainder
+    size_t start = 0;
+    switch (filter)
+    {
+        case PNGFILE_FILTER_SUB:
+            start = PNGUnfilterSubSIMD(row, size, bpp);
+            break;
+        case PNGFILE_FILTER_UP:
+            start = PNGUnfilterUpSIMD(row, prev, size);
+            break;
+        case PNGFILE_FILTER_AVERAGE:
+            start = PNGUnfilterAverageSIMD(row, prev, size, bpp);
+            break;
+        case PNGFILE_FILTER_PAETH:
+            start = PNGUnfilterPaethSIMD(row, prev, size, bpp);
+            break;
+        default:
+            break;
+    }
+    return PNGUnfilterRowFrom(filter, row, prev, size, bpp, start);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter PNG scanline in place with the scalar reference path             //
+//  return : True if the scanline is successfully unfiltered                  //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGUnfilterRowScalar(unsigned char filter, unsigned char* row,
+    const unsigned char* prev, size_t size, uint32_t bpp)
+{
+    // Check scanline
+    if (!row || !prev || (bpp <= 0) || (bpp > size))
+    {
+        // Invalid scanline
+        return false;
+    }
+    return PNGUnfilterRowFrom(filter, row, prev, size, bpp, 0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Filter PNG scanline                                                       //
+//  return : True if the scanline is successfully filtered                    //
+////////////////////////////////////////////////////////////////////////////////
+bool PNGFilterRow(unsigned char filter, unsigned char* out,
+    const unsigned char* row, const unsigned char* prev,
+    size_t size, uint32_t bpp)
+{
+    // Check scanline
+    if (!out || !row || !prev || (bpp <= 0) || (bpp > size))
+    {
+        // Invalid scanline
+        return false;
+    }
+
+    switch (filter)
+    {
+        case PNGFILE_FILTER_NONE:
+            // No filter
+            memcpy(out, row, size);
+            return true;
+
+        case PNGFILE_FILTER_SUB:
+            // Sub filter
+            memcpy(out, row, bpp);
+            for (size_t i = bpp; i < size; ++i)
+            {
+                out[i] = (unsigned char)(row[i] - row[i-bpp]);
+            }
+            return true;
+
+        case PNGFILE_FILTER_UP:
+            // Up filter
+            for (size_t i = 0; i < size; ++i)
+            {
+                out[i] = (unsigned char)(row[i] - prev[i]);
+            }
+            return true;
+
+        case PNGFILE_FILTER_AVERAGE:
+            // Average filter
+            for (size_t i = 0; i < bpp; ++i)
+            {
+                out[i] = (unsigned char)(row[i] - (prev[i] >> 1));
+            }
+            for (size_t i = bpp; i < size; ++i)
+            {
+                out[i] = (unsigned char)(row[i] - (unsigned char)(
+                    ((uint32_t)row[i-bpp] + (uint32_t)prev[i]) >> 1
+                ));
+            }
+            return true;
+
+        case PNGFILE_FILTER_PAETH:
+            // Paeth filter
+            for (size_t i = 0; i < bpp; ++i)
+            {
+                out[i] = (unsigned char)(row[i] - prev[i]);
+            }
+            for (size_t i = bpp; i < size; ++i)
+            {
+                out[i] = (unsigned char)(row[i] -
+                    PNGPaethPredictor(row[i-bpp], prev[i], prev[i-bpp]));
+            }
+            return true;
+
+        default:
+            // Invalid filter type
+            return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compute PNG filtered scanline cost                                        //
+//  return : Sum of the absolute values of the bytes read as signed           //
+////////////////////////////////////////////////////////////////////////////////
+uint64_t PNGFilterRowCost(const unsigned char* row, size_t size)
+{
+    uint64_t cost = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        int value = (int)(signed char)row[i];
+        cost += (uint64_t)((value < 0) ? -value : value);
+    }
+    return cost;
+}
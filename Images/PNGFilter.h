@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Images/PNGFilter.h : PNG scanline filters                              //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_IMAGES_PNGFILTER_HEADER
+#define WOS_IMAGES_PNGFILTER_HEADER
+
+    #include "../System/System.h"
+    #include "PNGFile.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  PNGFilter settings                                                    //
+    ////////////////////////////////////////////////////////////////////////////
+    const uint32_t PNGFilterMaxSIMDPixelSize = 4;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Paeth predictor                                                       //
+    //  return : Left, up or up-left byte, whichever is closest to the        //
+    //           initial estimate left + up - upleft                          //
+    ////////////////////////////////////////////////////////////////////////////
+    inline unsigned char PNGPaethPredictor(
+        unsigned char left, unsigned char up, unsigned char upLeft)
+    {
+        int pa = (int)up - (int)upLeft;
+        int pb = (int)left - (int)upLeft;
+        int pc = pa + pb;
+        pa = (pa < 0) ? -pa : pa;
+        pb = (pb < 0) ? -pb : pb;
+        pc = (pc < 0) ? -pc : pc;
+        if ((pa <= pb) && (pa <= pc)) { return left; }
+        if (pb <= pc) { return up; }
+        return upLeft;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Unfilter PNG scanline in place                                        //
+    //  prev is the unfiltered previous scanline (zeros for the first one)    //
+    //  bpp is the number of bytes per complete pixel (at least 1)            //
+    //  SSSE3, NEON or simd128 kernels are used for pixels up to 4 bytes      //
+    //  return : True if the scanline is successfully unfiltered              //
+    ////////////////////////////////////////////////////////////////////////////
+    bool PNGUnfilterRow(unsigned char filter, unsigned char* row,
+        const unsigned char* prev, size_t size, uint32_t bpp);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Unfilter PNG scanline in place with the scalar reference path         //
+    //  return : True if the scanline is successfully unfiltered              //
+    ////////////////////////////////////////////////////////////////////////////
+    bool PNGUnfilterRowScalar(unsigned char filter, unsigned char* row,
+        const unsigned char* prev, size_t size, uint32_t bpp);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Filter PNG scanline                                                   //
+    //  row and prev are unfiltered scanlines (zeros for the first one)       //
+    //  out receives the filtered scanline (without the filter type byte)     //
+    //  return : True if the scanline is successfully filtered                //
+    ////////////////////////////////////////////////////////////////////////////
+    bool PNGFilterRow(unsigned char filter, unsigned char* out,
+        const unsigned char* row, const unsigned char* prev,
+        size_t size, uint32_t bpp);
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compute PNG filtered scanline cost                                    //
+    //  return : Sum of the absolute values of the bytes read as signed       //
+    ////////////////////////////////////////////////////////////////////////////
+    uint64_t PNGFilterRowCost(const unsigned char* row, size_t size);
+
+
+#endif // WOS_IMAGES_PNGFILTER_HEADER
@@ -49,7 +49,9 @@
 Texture::Texture() :
 m_handle(0),
 m_width(0),
-m_height(0)
+m_height(0),
+m_mipLevels(0),
+m_format(TEXTUREFORMAT_RGBA8)
 {
 
 }
@@ -69,7 +71,8 @@ Texture::~Texture()
 ////////////////////////////////////////////////////////////////////////////////
 bool Texture::createTexture(uint32_t width, uint32_t height,
     const unsigned char* data,
-    bool mipmaps, bool smooth, TextureRepeatMode repeat)
+    bool mipmaps, bool smooth, TextureRepeatMode repeat, uint32_t dataLevels,
+    TextureFormat format)
 {
     // Check texture handle
     if (m_handle)
@@ -102,10 +105,12 @@ bool Texture::createTexture(uint32_t width, uint32_t height,
         mipLevels = (Math::log2(((width > height) ? width : height)) + 1);
     }
     if (mipLevels <= 1) { mipLevels = 1; }
+    if (dataLevels > mipLevels) { dataLevels = mipLevels; }
+    if (dataLevels <= 1) { dataLevels = 1; }
 
     // Upload texture to graphics memory
-    if (!GResources.textures.uploadTexture(
-        m_handle, width, height, mipLevels, data, smooth, repeat))
+    if (!GResources.textures.uploadTexture(m_handle, width, height,
+        mipLevels, dataLevels, data, format, smooth, repeat))
     {
         // Could not upload texture to graphics memory
         return false;
@@ -114,11 +119,104 @@ bool Texture::createTexture(uint32_t width, uint32_t height,
     // Set texture size
     m_width = width;
     m_height = height;
+    m_mipLevels = mipLevels;
+    m_format = format;
+
+    // Texture successfully created
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Create compressed texture from KTX2 file mip levels                       //
+//  return : True if texture is successfully created                          //
+////////////////////////////////////////////////////////////////////////////////
+bool Texture::createTexture(const KTXFile& ktxfile, uint32_t first,
+    bool mipmaps, bool smooth, TextureRepeatMode repeat)
+{
+    // Check texture handle
+    if (m_handle)
+    {
+        // Destroy current texture
+        destroyTexture();
+    }
+
+    // Check texture file
+    if (!ktxfile.isValid() || (first >= ktxfile.getLevels()))
+    {
+        // Invalid texture file
+        return false;
+    }
+
+    // Check texture size
+    uint32_t width = ImageDownscaledSize(ktxfile.getWidth(), first);
+    uint32_t height = ImageDownscaledSize(ktxfile.getHeight(), first);
+    if ((width <= 0) || (width > TextureMaxWidth) ||
+        (height <= 0) || (height > TextureMaxHeight))
+    {
+        // Invalid texture size
+        SysMessage::box() << "[0x300C] Invalid texture size :\n";
+        SysMessage::box() << width << "x" << height << "px";
+        return false;
+    }
+
+    // Set mip levels (compressed mip levels can not be generated)
+    uint32_t mipLevels = 1;
+    if (mipmaps)
+    {
+        mipLevels = (Math::log2(((width > height) ? width : height)) + 1);
+        if ((ktxfile.getLevels() - first) < mipLevels)
+        {
+            // Incomplete texture mip chain
+            return false;
+        }
+    }
+    if (mipLevels <= 1) { mipLevels = 1; }
+
+    // Upload compressed texture to graphics memory
+    if (!GResources.textures.uploadCompressedTexture(
+        m_handle, ktxfile, first, mipLevels, smooth, repeat))
+    {
+        // Could not upload compressed texture to graphics memory
+        return false;
+    }
+
+    // Set texture size
+    m_width = width;
+    m_height = height;
+    m_mipLevels = mipLevels;
+    m_format = TEXTUREFORMAT_COMPRESSED;
 
     // Texture successfully created
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//  Update texture data (same size as the created texture)                    //
+//  return : True if texture is successfully updated                          //
+////////////////////////////////////////////////////////////////////////////////
+bool Texture::updateTexture(const unsigned char* data, uint32_t dataLevels)
+{
+    // Check texture handle and data (compressed textures are immutable)
+    if (!m_handle || !data || (m_format == TEXTUREFORMAT_COMPRESSED))
+    {
+        // Invalid texture or texture data
+        return false;
+    }
+
+    // Update texture in graphics memory
+    if (dataLevels > m_mipLevels) { dataLevels = m_mipLevels; }
+    if (dataLevels <= 1) { dataLevels = 1; }
+    if (!GResources.textures.updateTexture(m_handle,
+        m_width, m_height, m_mipLevels, dataLevels, data, m_format))
+    {
+        // Could not update texture in graphics memory
+        return false;
+    }
+
+    // Texture successfully updated
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Destroy texture                                                           //
 ////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +230,8 @@ void Texture::destroyTexture()
         GSysWindow.releaseThread();
     }
     m_handle = 0;
+    m_format = TEXTUREFORMAT_RGBA8;
+    m_mipLevels = 0;
     m_height = 0;
     m_width = 0;
 }
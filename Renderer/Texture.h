@@ -48,6 +48,7 @@
     #include "../System/SysMessage.h"
     #include "../System/SysWindow.h"
     #include "../Math/Math.h"
+    #include "../Images/KTXFile.h"
 
     #include <cstdint>
 
@@ -62,6 +63,16 @@
         TEXTUREMODE_MIRROR = 2
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  TextureFormat enumeration                                             //
+    ////////////////////////////////////////////////////////////////////////////
+    enum TextureFormat
+    {
+        TEXTUREFORMAT_RGBA8 = 0,
+        TEXTUREFORMAT_RGB565 = 1,
+        TEXTUREFORMAT_COMPRESSED = 2
+    };
+
 
     ////////////////////////////////////////////////////////////////////////////
     //  Texture class definition                                              //
@@ -82,13 +93,34 @@
 
             ////////////////////////////////////////////////////////////////////
             //  Create texture                                                //
+            //  data can hold dataLevels precomputed packed mip levels,       //
+            //  missing mip levels are generated by the graphics driver       //
             //  return : True if texture is successfully created              //
             ////////////////////////////////////////////////////////////////////
             bool createTexture(uint32_t width, uint32_t height,
                 const unsigned char* data,
+                bool mipmaps = false, bool smooth = true,
+                TextureRepeatMode repeat = TEXTUREMODE_CLAMP,
+                uint32_t dataLevels = 1,
+                TextureFormat format = TEXTUREFORMAT_RGBA8);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Create compressed texture from KTX2 file mip levels           //
+            //  Mip levels are uploaded from the first level, mipmapped       //
+            //  textures need every next level of the file                    //
+            //  return : True if texture is successfully created              //
+            ////////////////////////////////////////////////////////////////////
+            bool createTexture(const KTXFile& ktxfile, uint32_t first = 0,
                 bool mipmaps = false, bool smooth = true,
                 TextureRepeatMode repeat = TEXTUREMODE_CLAMP);
 
+            ////////////////////////////////////////////////////////////////////
+            //  Update texture data (same size as the created texture)        //
+            //  return : True if texture is successfully updated              //
+            ////////////////////////////////////////////////////////////////////
+            bool updateTexture(const unsigned char* data,
+                uint32_t dataLevels = 1);
+
             ////////////////////////////////////////////////////////////////////
             //  Destroy texture                                               //
             ////////////////////////////////////////////////////////////////////
@@ -129,6 +161,8 @@
             unsigned int        m_handle;           // Texture handle
             uint32_t            m_width;            // Texture width
             uint32_t            m_height;           // Texture height
+            uint32_t            m_mipLevels;        // Texture mip levels
+            TextureFormat       m_format;           // Texture data format
     };
 
 
@@ -0,0 +1,392 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Resources/AssetBundle.cpp : Packed assets bundle management            //
+////////////////////////////////////////////////////////////////////////////////
+#include "AssetBundle.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetBundle global instance                                               //
+////////////////////////////////////////////////////////////////////////////////
+AssetBundle GAssetBundle = AssetBundle();
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetBundle default constructor                                           //
+////////////////////////////////////////////////////////////////////////////////
+AssetBundle::AssetBundle() :
+m_fetch(),
+m_mutex(),
+m_opened(false),
+m_valid(false),
+m_entries(0),
+m_assets(0),
+m_count(0),
+m_verified(false),
+m_inflated(0)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetBundle destructor                                                    //
+////////////////////////////////////////////////////////////////////////////////
+AssetBundle::~AssetBundle()
+{
+    destroyBundle();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Start asynchronous bundle fetch (returns immediately)                     //
+//  return : True if the bundle fetch is started                              //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetBundle::start(const std::string& path)
+{
+    // Reset bundle
+    destroyBundle();
+
+    // Fetch bundle
+    return m_fetch.start(path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Wait for the bundle fetch and open the bundle                             //
+//  return : True if the bundle is available                                  //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetBundle::wait()
+{
+    m_mutex.lock();
+    if (!m_opened)
+    {
+        // First waiter opens the fetched bundle
+        if (m_fetch.wait() == SYSFETCH_STATE_LOADED)
+        {
+            m_valid = open(m_fetch.getData(), m_fetch.getSize());
+        }
+        m_opened = true;
+    }
+    bool valid = m_valid;
+    m_mutex.unlock();
+    return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Open bundle from memory (data must outlive the bundle)                    //
+//  return : True if the bundle is valid                                      //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetBundle::open(const unsigned char* data, size_t size, bool verify)
+{
+    // Reset bundle index
+    resetBundle();
+
+    // Read bundle index
+    if (!readIndex(data, size))
+    {
+        // Invalid bundle index
+        resetBundle();
+        return false;
+    }
+
+    // Read bundle assets
+    if (!readAssets(data, verify))
+    {
+        // Invalid bundle assets
+        resetBundle();
+        return false;
+    }
+
+    // Bundle is valid
+    m_verified = verify;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get asset view                                                            //
+//  return : True if the asset is in the bundle                               //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetBundle::getAsset(const char* name, AssetBundleView& view) const
+{
+    view.data = 0;
+    view.size = 0;
+    view.contentHash = 0;
+    view.verified = false;
+
+    // Search asset name hash in the sorted index
+    uint64_t hash = AssetBundleHash(name);
+    uint32_t first = 0;
+    uint32_t last = m_count;
+    while (first < last)
+    {
+        uint32_t middle = first + ((last-first) >> 1);
+        if (m_entries[middle].hash < hash) { first = middle+1; }
+        else { last = middle; }
+    }
+    if ((first >= m_count) || (m_entries[first].hash != hash))
+    {
+        // Asset is not in the bundle
+        return false;
+    }
+
+    // Asset view
+    view.data = m_assets[first];
+    view.size = m_entries[first].rawSize;
+    view.contentHash = m_entries[first].contentHash;
+    view.verified = m_verified;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Destroy bundle (invalidates every view)                                   //
+////////////////////////////////////////////////////////////////////////////////
+void AssetBundle::destroyBundle()
+{
+    m_mutex.lock();
+    resetBundle();
+    m_fetch.destroyFetch();
+    m_opened = false;
+    m_valid = false;
+    m_mutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read bundle index                                                         //
+//  return : True if the bundle index is valid                                //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetBundle::readIndex(const unsigned char* data, size_t size)
+{
+    // Check bundle header
+    if (!data || (size < AssetBundleHeaderSize))
+    {
+        // Invalid bundle size
+        return false;
+    }
+    if ((data[0] != 'W') || (data[1] != 'P') ||
+        (data[2] != 'A') || (data[3] != 'K'))
+    {
+        // Invalid bundle header
+        return false;
+    }
+    if (data[4] != AssetBundleMajorVersion)
+    {
+        // Unsupported bundle version
+        return false;
+    }
+
+    // Check bundle index
+    uint32_t count = 0;
+    uint32_t indexCRC = 0;
+    memcpy(&count, &data[8], sizeof(uint32_t));
+    memcpy(&indexCRC, &data[12], sizeof(uint32_t));
+    if (count > AssetBundleMaxEntries)
+    {
+        // Invalid bundle entries count
+        return false;
+    }
+    size_t indexSize = (count*AssetBundleEntrySize);
+    size_t indexEnd = (AssetBundleHeaderSize + indexSize);
+    if (indexEnd > size)
+    {
+        // Invalid bundle index size
+        return false;
+    }
+    if (SysCRC32(&data[AssetBundleHeaderSize], indexSize) != indexCRC)
+    {
+        // Invalid bundle index CRC
+        return false;
+    }
+    if (count <= 0)
+    {
+        // Empty bundle
+        return true;
+    }
+
+    // Allocate bundle index
+    m_entries = new (std::nothrow) AssetBundleEntry[count];
+    m_assets = new (std::nothrow) const unsigned char*[count];
+    if (!m_entries || !m_assets)
+    {
+        // Could not allocate bundle index
+        return false;
+    }
+
+    // Read bundle index entries
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const unsigned char* entryData =
+            &data[AssetBundleHeaderSize + i*AssetBundleEntrySize];
+        AssetBundleEntry& entry = m_entries[i];
+        memcpy(&entry.hash, &entryData[0], sizeof(uint64_t));
+        memcpy(&entry.offset, &entryData[8], sizeof(uint32_t));
+        memcpy(&entry.size, &entryData[12], sizeof(uint32_t));
+        memcpy(&entry.rawSize, &entryData[16], sizeof(uint32_t));
+        memcpy(&entry.crc, &entryData[20], sizeof(uint32_t));
+        memcpy(&entry.compression, &entryData[24], sizeof(uint32_t));
+        memcpy(&entry.contentHash, &entryData[32], sizeof(uint64_t));
+        m_assets[i] = 0;
+
+        // Entries are sorted by unique name hash
+        if ((i > 0) && (entry.hash <= m_entries[i-1].hash))
+        {
+            // Invalid bundle index order
+            return false;
+        }
+
+        // Check entry data range
+        if ((entry.offset < indexEnd) || (entry.offset > size) ||
+            (entry.size > (size - entry.offset)))
+        {
+            // Invalid entry data range
+            return false;
+        }
+
+        // Check entry compression
+        if (entry.compression == ASSETBUNDLE_COMPRESSION_NONE)
+        {
+            if (entry.size != entry.rawSize)
+            {
+                // Invalid stored entry size
+                return false;
+            }
+        }
+        else if (entry.compression != ASSETBUNDLE_COMPRESSION_ZLIB)
+        {
+            // Unsupported entry compression
+            return false;
+        }
+    }
+    m_count = count;
+
+    // Bundle index is valid
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Inflate compressed assets and check assets CRC32                          //
+//  return : True if every asset is valid                                     //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetBundle::readAssets(const unsigned char* data, bool verify)
+{
+    // Compute inflated assets size
+    size_t inflatedSize = 0;
+    for (uint32_t i = 0; i < m_count; ++i)
+    {
+        if (m_entries[i].compression != ASSETBUNDLE_COMPRESSION_ZLIB)
+        {
+            continue;
+        }
+        size_t rawSize = ((static_cast<size_t>(m_entries[i].rawSize) +
+            (AssetBundleAlignment-1)) & ~(AssetBundleAlignment-1));
+        if ((rawSize < m_entries[i].rawSize) ||
+            (rawSize > (SIZE_MAX - inflatedSize)))
+        {
+            // Invalid inflated assets size
+            return false;
+        }
+        inflatedSize += rawSize;
+    }
+
+    // Allocate inflated assets and decode context
+    ZLibDeflateContext* context = 0;
+    if (inflatedSize > 0)
+    {
+        m_inflated = new (std::nothrow) unsigned char[inflatedSize];
+        context = new (std::nothrow) ZLibDeflateContext;
+        if (!m_inflated || !context)
+        {
+            // Could not allocate inflated assets
+            if (context) { delete context; }
+            return false;
+        }
+        ZLibInitDecodeContext(*context);
+    }
+
+    // Read assets
+    bool valid = true;
+    size_t inflatedOffset = 0;
+    for (uint32_t i = 0; valid && (i < m_count); ++i)
+    {
+        const AssetBundleEntry& entry = m_entries[i];
+        if (entry.compression == ASSETBUNDLE_COMPRESSION_ZLIB)
+        {
+            // Inflate compressed asset
+            unsigned char* asset = &m_inflated[inflatedOffset];
+            size_t inRead = 0;
+            size_t outWritten = 0;
+            valid = ZLibDeflateDecompressExact(*context,
+                &data[entry.offset], entry.size, &inRead,
+                asset, entry.rawSize, &outWritten
+            );
+            m_assets[i] = asset;
+            inflatedOffset += ((static_cast<size_t>(entry.rawSize) +
+                (AssetBundleAlignment-1)) & ~(AssetBundleAlignment-1));
+        }
+        else
+        {
+            // Stored asset is viewed in place
+            m_assets[i] = &data[entry.offset];
+        }
+
+        // Check asset CRC32
+        if (valid && verify &&
+            (SysCRC32(m_assets[i], entry.rawSize) != entry.crc))
+        {
+            valid = false;
+        }
+    }
+    if (context) { delete context; }
+    return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reset bundle index and inflated assets                                    //
+////////////////////////////////////////////////////////////////////////////////
+void AssetBundle::resetBundle()
+{
+    if (m_inflated) { delete[] m_inflated; }
+    if (m_assets) { delete[] m_assets; }
+    if (m_entries) { delete[] m_entries; }
+    m_inflated = 0;
+    m_assets = 0;
+    m_entries = 0;
+    m_count = 0;
+    m_verified = false;
+}
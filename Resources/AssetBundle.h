@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Resources/AssetBundle.h : Packed assets bundle management              //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_RESOURCES_ASSETBUNDLE_HEADER
+#define WOS_RESOURCES_ASSETBUNDLE_HEADER
+
+    #include "../System/System.h"
+    #include "../System/SysMutex.h"
+    #include "../System/SysFetch.h"
+    #include "../System/SysCRC.h"
+    #include "../Compress/ZLib.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <string>
+    #include <new>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetBundle settings                                                  //
+    ////////////////////////////////////////////////////////////////////////////
+    const char AssetBundleDefaultPath[] = "assets.wpak";
+    const uint8_t AssetBundleMajorVersion = 2;
+    const uint8_t AssetBundleMinorVersion = 0;
+    const size_t AssetBundleHeaderSize = 16;
+    const size_t AssetBundleEntrySize = 40;
+    const size_t AssetBundleAlignment = 16;
+    const uint32_t AssetBundleMaxEntries = 65536;
+    const uint64_t AssetBundleHashBasis = 0xCBF29CE484222325ull;
+    const uint64_t AssetBundleHashPrime = 0x00000100000001B3ull;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetBundleCompression enumeration                                    //
+    ////////////////////////////////////////////////////////////////////////////
+    enum AssetBundleCompression
+    {
+        ASSETBUNDLE_COMPRESSION_NONE = 0,
+        ASSETBUNDLE_COMPRESSION_ZLIB = 1
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetBundleEntry structure                                            //
+    //  Index entry, stored as 40 bytes (little endian) :                     //
+    //  hash (8), offset (4), size (4), rawSize (4), crc (4),                 //
+    //  compression (4), reserved (4), contentHash (8)                        //
+    ////////////////////////////////////////////////////////////////////////////
+    struct AssetBundleEntry
+    {
+        uint64_t hash;                  // Asset name hash
+        uint32_t offset;                // Stored data offset in the bundle
+        uint32_t size;                  // Stored data size
+        uint32_t rawSize;               // Uncompressed data size
+        uint32_t crc;                   // Uncompressed data CRC32
+        uint32_t compression;           // Stored data compression
+        uint64_t contentHash;           // Uncompressed data hash
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetBundleView structure                                             //
+    //  Read only view into the bundle memory, valid until it is destroyed    //
+    ////////////////////////////////////////////////////////////////////////////
+    struct AssetBundleView
+    {
+        const unsigned char* data;      // Asset data
+        size_t size;                    // Asset data size
+        uint64_t contentHash;           // Asset data content hash
+        bool verified;                  // Asset CRC32 checked on open
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compute asset name hash (64 bits FNV-1a of the asset path)            //
+    //  return : Asset name hash                                              //
+    ////////////////////////////////////////////////////////////////////////////
+    inline uint64_t AssetBundleHash(const char* name)
+    {
+        uint64_t hash = AssetBundleHashBasis;
+        for (; name && *name; ++name)
+        {
+            hash ^= static_cast<unsigned char>(*name);
+            hash *= AssetBundleHashPrime;
+        }
+        return hash;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Compute asset content hash (64 bits FNV-1a of the asset data)         //
+    //  Computed by the bundler, identifies the asset content for caching     //
+    //  return : Asset content hash                                           //
+    ////////////////////////////////////////////////////////////////////////////
+    inline uint64_t AssetBundleContentHash(const unsigned char* data,
+        size_t size)
+    {
+        uint64_t hash = AssetBundleHashBasis;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= AssetBundleHashPrime;
+        }
+        return hash;
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetBundle class definition                                          //
+    //  Bundle layout : header (16 bytes : "WPAK", major, minor, reserved,    //
+    //  entries count, index CRC32), index entries sorted by name hash, then  //
+    //  the assets data (each aligned on 16 bytes)                            //
+    //  Stored assets are viewed in place in the fetched bundle, compressed   //
+    //  assets are inflated once when the bundle is opened                    //
+    ////////////////////////////////////////////////////////////////////////////
+    class AssetBundle
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  AssetBundle default constructor                               //
+            ////////////////////////////////////////////////////////////////////
+            AssetBundle();
+
+            ////////////////////////////////////////////////////////////////////
+            //  AssetBundle destructor                                        //
+            ////////////////////////////////////////////////////////////////////
+            ~AssetBundle();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Start asynchronous bundle fetch (returns immediately)         //
+            //  return : True if the bundle fetch is started                  //
+            ////////////////////////////////////////////////////////////////////
+            bool start(const std::string& path = AssetBundleDefaultPath);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wait for the bundle fetch and open the bundle                 //
+            //  return : True if the bundle is available                      //
+            ////////////////////////////////////////////////////////////////////
+            bool wait();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Open bundle from memory (data must outlive the bundle)        //
+            //  verify checks every asset CRC32                               //
+            //  return : True if the bundle is valid                          //
+            ////////////////////////////////////////////////////////////////////
+            bool open(const unsigned char* data, size_t size,
+                bool verify = true);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get asset view                                                //
+            //  return : True if the asset is in the bundle                   //
+            ////////////////////////////////////////////////////////////////////
+            bool getAsset(const char* name, AssetBundleView& view) const;
+
+            ////////////////////////////////////////////////////////////////////
+            //  Destroy bundle (invalidates every view)                       //
+            ////////////////////////////////////////////////////////////////////
+            void destroyBundle();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get bundle assets count                                       //
+            //  return : Number of assets in the bundle                       //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getAssetsCount() const
+            {
+                return m_count;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get bundle index entry                                        //
+            //  return : Index entry (sorted by name hash)                    //
+            ////////////////////////////////////////////////////////////////////
+            inline const AssetBundleEntry& getEntry(uint32_t index) const
+            {
+                return m_entries[index];
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  AssetBundle private copy constructor : Not copyable           //
+            ////////////////////////////////////////////////////////////////////
+            AssetBundle(const AssetBundle&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  AssetBundle private copy operator : Not copyable              //
+            ////////////////////////////////////////////////////////////////////
+            AssetBundle& operator=(const AssetBundle&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Read bundle index                                             //
+            //  return : True if the bundle index is valid                    //
+            ////////////////////////////////////////////////////////////////////
+            bool readIndex(const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Inflate compressed assets and check assets CRC32              //
+            //  return : True if every asset is valid                         //
+            ////////////////////////////////////////////////////////////////////
+            bool readAssets(const unsigned char* data, bool verify);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Reset bundle index and inflated assets                        //
+            ////////////////////////////////////////////////////////////////////
+            void resetBundle();
+
+
+        private:
+            SysFetch                m_fetch;        // Bundle fetch
+            SysMutex                m_mutex;        // Bundle open mutex
+            bool                    m_opened;       // Bundle open attempted
+            bool                    m_valid;        // Bundle validity
+
+            AssetBundleEntry*       m_entries;      // Bundle index entries
+            const unsigned char**   m_assets;       // Assets data
+            uint32_t                m_count;        // Bundle entries count
+            bool                    m_verified;     // Assets CRC32 checked
+            unsigned char*          m_inflated;     // Inflated assets
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetBundle global instance                                           //
+    ////////////////////////////////////////////////////////////////////////////
+    extern AssetBundle GAssetBundle;
+
+
+#endif // WOS_RESOURCES_ASSETBUNDLE_HEADER
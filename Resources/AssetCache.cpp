@@ -0,0 +1,930 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Resources/AssetCache.cpp : Persistent assets cache                     //
+////////////////////////////////////////////////////////////////////////////////
+#include "AssetCache.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCache global instance                                                //
+////////////////////////////////////////////////////////////////////////////////
+AssetCache GAssetCache = AssetCache();
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Write asset cache value header                                            //
+////////////////////////////////////////////////////////////////////////////////
+void AssetCacheWriteHeader(unsigned char* value, uint64_t key,
+    const unsigned char* payload, size_t size)
+{
+    uint16_t version = AssetCacheVersion;
+    uint16_t reserved = 0;
+    uint32_t payloadSize = static_cast<uint32_t>(size);
+    uint32_t payloadCRC = SysCRC32(payload, size);
+    value[0] = 'W';
+    value[1] = 'C';
+    value[2] = 'A';
+    value[3] = 'C';
+    memcpy(&value[4], &version, sizeof(uint16_t));
+    memcpy(&value[6], &reserved, sizeof(uint16_t));
+    memcpy(&value[8], &key, sizeof(uint64_t));
+    memcpy(&value[16], &payloadSize, sizeof(uint32_t));
+    memcpy(&value[20], &payloadCRC, sizeof(uint32_t));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check asset cache value header and payload CRC32                          //
+//  return : True if the value is valid                                       //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCacheCheckValue(const unsigned char* value, size_t size,
+    uint64_t key)
+{
+    // Check value header
+    if (!value || (size < AssetCacheHeaderSize))
+    {
+        // Invalid value size
+        return false;
+    }
+    if ((value[0] != 'W') || (value[1] != 'C') ||
+        (value[2] != 'A') || (value[3] != 'C'))
+    {
+        // Invalid value header
+        return false;
+    }
+    uint16_t version = 0;
+    uint64_t valueKey = 0;
+    uint32_t payloadSize = 0;
+    uint32_t payloadCRC = 0;
+    memcpy(&version, &value[4], sizeof(uint16_t));
+    memcpy(&valueKey, &value[8], sizeof(uint64_t));
+    memcpy(&payloadSize, &value[16], sizeof(uint32_t));
+    memcpy(&payloadCRC, &value[20], sizeof(uint32_t));
+    if ((version != AssetCacheVersion) || (valueKey != key) ||
+        (payloadSize != (size - AssetCacheHeaderSize)))
+    {
+        // Invalid value version, key or size
+        return false;
+    }
+
+    // Check value payload
+    if (SysCRC32(&value[AssetCacheHeaderSize], payloadSize) != payloadCRC)
+    {
+        // Invalid value payload CRC
+        return false;
+    }
+
+    // Value is valid
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCacheStore default constructor                                       //
+////////////////////////////////////////////////////////////////////////////////
+AssetCacheStore::AssetCacheStore() :
+m_name()
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCacheStore virtual destructor                                        //
+////////////////////////////////////////////////////////////////////////////////
+AssetCacheStore::~AssetCacheStore()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get stored value path                                                     //
+//  return : Value path (store name and hexadecimal key)                      //
+////////////////////////////////////////////////////////////////////////////////
+std::string AssetCacheStore::getPath(uint64_t key) const
+{
+    const char digits[] = "0123456789abcdef";
+    char name[17] = {0};
+    for (int i = 0; i < 16; ++i)
+    {
+        name[i] = digits[(key >> ((15-i)*4)) & 0xF];
+    }
+    return (m_name + "/" + name + ".bin");
+}
+
+
+#if defined(WOS_EMSCRIPTEN)
+////////////////////////////////////////////////////////////////////////////////
+//  Complete asset cache request and wake up the caller                       //
+////////////////////////////////////////////////////////////////////////////////
+void AssetCacheRequestComplete(AssetCacheRequest* request, bool success)
+{
+    request->mutex.lock();
+    request->success = success;
+    request->done = true;
+    request->condition.notifyAll();
+    request->mutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Asset cache request success callback function                             //
+////////////////////////////////////////////////////////////////////////////////
+void OnAssetCacheRequestSuccess(emscripten_fetch_t* fetch)
+{
+    // Get request
+    AssetCacheRequest* request = (AssetCacheRequest*)fetch->userData;
+    if (!request) { emscripten_fetch_close(fetch); return; }
+
+    // Copy loaded value
+    bool success = true;
+    if (strcmp(request->method, "GET") == 0)
+    {
+        success = false;
+        if (fetch->data && (fetch->numBytes > 0))
+        {
+            size_t size = static_cast<size_t>(fetch->numBytes);
+            request->data = new (std::nothrow) unsigned char[size];
+            if (request->data)
+            {
+                memcpy(request->data, fetch->data, size);
+                request->size = size;
+                success = true;
+            }
+        }
+    }
+    emscripten_fetch_close(fetch);
+    AssetCacheRequestComplete(request, success);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Asset cache request error callback function                               //
+////////////////////////////////////////////////////////////////////////////////
+void OnAssetCacheRequestError(emscripten_fetch_t* fetch)
+{
+    AssetCacheRequest* request = (AssetCacheRequest*)fetch->userData;
+    emscripten_fetch_close(fetch);
+    if (request) { AssetCacheRequestComplete(request, false); }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Asset cache request start function (called on the main thread)            //
+////////////////////////////////////////////////////////////////////////////////
+void OnAssetCacheRequestStart(void* arg)
+{
+    // Get request
+    AssetCacheRequest* request = (AssetCacheRequest*)arg;
+    if (!request) { return; }
+
+    // Run IndexedDB request (loads never fall back to a download)
+    emscripten_fetch_attr_t attributes;
+    emscripten_fetch_attr_init(&attributes);
+    strcpy(attributes.requestMethod, request->method);
+    attributes.attributes = EMSCRIPTEN_FETCH_PERSIST_FILE;
+    if (strcmp(request->method, "GET") == 0)
+    {
+        attributes.attributes |=
+            (EMSCRIPTEN_FETCH_LOAD_TO_MEMORY | EMSCRIPTEN_FETCH_NO_DOWNLOAD);
+    }
+    else
+    {
+        attributes.attributes |= EMSCRIPTEN_FETCH_REPLACE;
+    }
+    attributes.requestData = (const char*)request->input;
+    attributes.requestDataSize = request->inputSize;
+    attributes.userData = arg;
+    attributes.onsuccess = OnAssetCacheRequestSuccess;
+    attributes.onerror = OnAssetCacheRequestError;
+    if (!emscripten_fetch(&attributes, request->path.c_str()))
+    {
+        // Could not start request
+        AssetCacheRequestComplete(request, false);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCacheIDBStore default constructor                                    //
+////////////////////////////////////////////////////////////////////////////////
+AssetCacheIDBStore::AssetCacheIDBStore() :
+AssetCacheStore()
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCacheIDBStore virtual destructor                                     //
+////////////////////////////////////////////////////////////////////////////////
+AssetCacheIDBStore::~AssetCacheIDBStore()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Open store                                                                //
+//  return : True if the store is ready                                       //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCacheIDBStore::open(const char* name)
+{
+    // IndexedDB database is opened by emscripten fetch at startup,
+    // requests fail if it is not available
+    m_name = name;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load stored value (allocated, to be deleted by the caller)                //
+//  return : True if the value is loaded                                      //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCacheIDBStore::load(uint64_t key, unsigned char*& data,
+    size_t& size)
+{
+    AssetCacheRequest request;
+    request.method = "GET";
+    request.path = getPath(key);
+    request.input = 0;
+    request.inputSize = 0;
+    if (!run(request))
+    {
+        // Could not load value
+        if (request.data) { delete[] request.data; }
+        return false;
+    }
+    data = request.data;
+    size = request.size;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Save value (replaces the previous value)                                  //
+//  return : True if the value is saved                                       //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCacheIDBStore::save(uint64_t key, const unsigned char* data,
+    size_t size)
+{
+    AssetCacheRequest request;
+    request.method = "EM_IDB_STORE";
+    request.path = getPath(key);
+    request.input = data;
+    request.inputSize = size;
+    return run(request);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove stored value                                                       //
+////////////////////////////////////////////////////////////////////////////////
+void AssetCacheIDBStore::remove(uint64_t key)
+{
+    AssetCacheRequest request;
+    request.method = "EM_IDB_DELETE";
+    request.path = getPath(key);
+    request.input = 0;
+    request.inputSize = 0;
+    run(request);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Run IndexedDB request on the main thread and wait for it                  //
+//  return : True if the request succeeded                                    //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCacheIDBStore::run(AssetCacheRequest& request)
+{
+    // IndexedDB callbacks run on the main thread
+    request.data = 0;
+    request.size = 0;
+    request.done = false;
+    request.success = false;
+    if (emscripten_is_main_runtime_thread())
+    {
+        // Main thread can not wait for its own callbacks
+        return false;
+    }
+    emscripten_async_run_in_main_runtime_thread(
+        EM_FUNC_SIG_VI, (void*)OnAssetCacheRequestStart, (void*)&request
+    );
+
+    // Wait for the request completion
+    request.mutex.lock();
+    while (!request.done)
+    {
+        request.condition.wait(request.mutex);
+    }
+    bool success = request.success;
+    request.mutex.unlock();
+    return success;
+}
+
+#else
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCacheFileStore default constructor                                   //
+////////////////////////////////////////////////////////////////////////////////
+AssetCacheFileStore::AssetCacheFileStore() :
+AssetCacheStore()
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCacheFileStore virtual destructor                                    //
+////////////////////////////////////////////////////////////////////////////////
+AssetCacheFileStore::~AssetCacheFileStore()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Open store (creates the store directory)                                  //
+//  return : True if the store is ready                                       //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCacheFileStore::open(const char* name)
+{
+    m_name = name;
+    std::error_code error;
+    std::filesystem::create_directories(m_name, error);
+    return std::filesystem::is_directory(m_name, error);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load stored value (allocated, to be deleted by the caller)                //
+//  return : True if the value is loaded                                      //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCacheFileStore::load(uint64_t key, unsigned char*& data,
+    size_t& size)
+{
+    // Open value file
+    std::ifstream file;
+    file.open(getPath(key).c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        // Could not open value file
+        return false;
+    }
+
+    // Get value file size
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (fileSize <= 0)
+    {
+        // Invalid value file size
+        return false;
+    }
+
+    // Read value file
+    unsigned char* value =
+        new (std::nothrow) unsigned char[static_cast<size_t>(fileSize)];
+    if (!value)
+    {
+        // Could not allocate value
+        return false;
+    }
+    file.read((char*)value, fileSize);
+    if (file.gcount() != fileSize)
+    {
+        // Could not read value file
+        delete[] value;
+        return false;
+    }
+    data = value;
+    size = static_cast<size_t>(fileSize);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Save value (written aside, then renamed over the previous)                //
+//  return : True if the value is saved                                       //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCacheFileStore::save(uint64_t key, const unsigned char* data,
+    size_t size)
+{
+    // Write temporary value file
+    std::string path = getPath(key);
+    std::string tempPath = path + ".tmp";
+    std::ofstream file;
+    file.open(tempPath.c_str(), std::ios::out | std::ios::binary);
+    if (!file.is_open())
+    {
+        // Could not create value file
+        return false;
+    }
+    file.write((const char*)data, size);
+    file.close();
+    std::error_code error;
+    if (file.fail())
+    {
+        // Could not write value file
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    // Replace value file
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        // Could not replace value file
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove stored value                                                       //
+////////////////////////////////////////////////////////////////////////////////
+void AssetCacheFileStore::remove(uint64_t key)
+{
+    std::error_code error;
+    std::filesystem::remove(getPath(key), error);
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCache default constructor                                            //
+////////////////////////////////////////////////////////////////////////////////
+AssetCache::AssetCache() :
+m_mutex(),
+m_flushMutex(),
+m_store(0),
+m_opened(false),
+m_valid(false),
+m_modified(false),
+m_entries(0),
+m_count(0),
+m_pending(0),
+m_stamp(0),
+m_size(0),
+m_capacity(AssetCacheDefaultCapacity)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetCache destructor                                                     //
+////////////////////////////////////////////////////////////////////////////////
+AssetCache::~AssetCache()
+{
+    destroyCache();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Init assets cache (the store is opened on first use)                      //
+//  return : True if the assets cache is ready                                //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCache::init(uint64_t capacity, AssetCacheStore* store)
+{
+    // Reset assets cache
+    destroyCache();
+
+    // Create platform store
+    if (!store)
+    {
+    #if defined(WOS_EMSCRIPTEN)
+        store = new (std::nothrow) AssetCacheIDBStore();
+    #else
+        store = new (std::nothrow) AssetCacheFileStore();
+    #endif
+        if (!store)
+        {
+            // Could not create assets cache store
+            return false;
+        }
+    }
+
+    // Assets cache is ready
+    m_mutex.lock();
+    m_store = store;
+    m_capacity = capacity;
+    m_mutex.unlock();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load cached payload (allocated, to be deleted by the caller)              //
+//  return : True if the payload is cached and valid                          //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCache::load(uint64_t key, unsigned char*& data, size_t& size)
+{
+    data = 0;
+    size = 0;
+    if (key == AssetCacheManifestKey) { return false; }
+
+    // Find cache entry and mark it as used
+    m_mutex.lock();
+    uint32_t index = 0;
+    if (!open() || ((index = find(key)) >= m_count) ||
+        (m_entries[index].key != key))
+    {
+        // Payload is not cached
+        m_mutex.unlock();
+        return false;
+    }
+    m_entries[index].stamp = ++m_stamp;
+    m_modified = true;
+    AssetCacheStore* store = m_store;
+    m_mutex.unlock();
+
+    // Load and check stored value (outside of the cache lock)
+    unsigned char* value = 0;
+    size_t valueSize = 0;
+    if (!store->load(key, value, valueSize) ||
+        !AssetCacheCheckValue(value, valueSize, key))
+    {
+        // Stale or corrupted value
+        if (value) { delete[] value; }
+        m_mutex.lock();
+        index = find(key);
+        if ((index < m_count) && (m_entries[index].key == key))
+        {
+            removeEntry(index);
+        }
+        m_mutex.unlock();
+        store->remove(key);
+        return false;
+    }
+
+    // Move payload in front of the value
+    size = (valueSize - AssetCacheHeaderSize);
+    memmove(value, &value[AssetCacheHeaderSize], size);
+    data = value;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Save payload, evicting least recently used payloads                       //
+//  return : True if the payload is cached                                    //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCache::save(uint64_t key, const unsigned char* data, size_t size)
+{
+    // Check payload
+    if ((key == AssetCacheManifestKey) || !data ||
+        (size > (0xFFFFFFFF - AssetCacheHeaderSize)))
+    {
+        // Invalid payload
+        return false;
+    }
+    uint64_t valueSize = (size + AssetCacheHeaderSize);
+
+    m_mutex.lock();
+    if (!open() || (valueSize > m_capacity))
+    {
+        // Payload can not be cached
+        m_mutex.unlock();
+        return false;
+    }
+
+    // Unlink previous payload (its stored value is replaced)
+    uint32_t index = find(key);
+    if ((index < m_count) && (m_entries[index].key == key))
+    {
+        removeEntry(index);
+    }
+
+    // Unlink least recently used payloads, the pending saves are reserved
+    uint64_t* evicted = 0;
+    uint32_t evictedCount = 0;
+    while ((m_count > 0) && (((m_count + m_pending) >= AssetCacheMaxEntries) ||
+        ((m_size + valueSize) > m_capacity)))
+    {
+        if (!evicted)
+        {
+            evicted = new (std::nothrow) uint64_t[m_count];
+            if (!evicted) { break; }
+        }
+        uint32_t oldest = 0;
+        for (uint32_t i = 1; i < m_count; ++i)
+        {
+            if (m_entries[i].stamp < m_entries[oldest].stamp) { oldest = i; }
+        }
+        evicted[evictedCount++] = m_entries[oldest].key;
+        removeEntry(oldest);
+    }
+    bool reserved = (((m_count + m_pending) < AssetCacheMaxEntries) &&
+        ((m_size + valueSize) <= m_capacity));
+    if (reserved)
+    {
+        ++m_pending;
+        m_size += valueSize;
+    }
+    AssetCacheStore* store = m_store;
+    m_mutex.unlock();
+
+    // Remove evicted values (outside of the cache lock)
+    // A key saved again while its eviction is in progress loses its value,
+    // and its entry is then removed by the next load
+    for (uint32_t i = 0; i < evictedCount; ++i)
+    {
+        store->remove(evicted[i]);
+    }
+    if (evicted) { delete[] evicted; }
+    if (!reserved)
+    {
+        // Payload can not be cached
+        return false;
+    }
+
+    // Write and save value (outside of the cache lock)
+    bool saved = false;
+    unsigned char* value = new (std::nothrow) unsigned char[valueSize];
+    if (value)
+    {
+        AssetCacheWriteHeader(value, key, data, size);
+        memcpy(&value[AssetCacheHeaderSize], data, size);
+        saved = store->save(key, value, valueSize);
+        delete[] value;
+    }
+
+    m_mutex.lock();
+    --m_pending;
+    m_size -= valueSize;
+    if (!saved)
+    {
+        // Could not save value
+        m_mutex.unlock();
+        store->remove(key);
+        return false;
+    }
+
+    // Insert cache entry (or replace the entry of a concurrent save)
+    index = find(key);
+    if ((index < m_count) && (m_entries[index].key == key))
+    {
+        m_size -= m_entries[index].size;
+    }
+    else
+    {
+        memmove(&m_entries[index+1], &m_entries[index],
+            sizeof(AssetCacheEntry)*(m_count-index)
+        );
+        ++m_count;
+    }
+    m_entries[index].key = key;
+    m_entries[index].size = static_cast<uint32_t>(valueSize);
+    m_entries[index].stamp = ++m_stamp;
+    m_size += valueSize;
+    m_modified = true;
+    m_mutex.unlock();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Save cache manifest if it was modified                                    //
+//  return : True if the manifest is up to date                               //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCache::flush()
+{
+    // Manifests are written in order of their snapshots
+    m_flushMutex.lock();
+    m_mutex.lock();
+    if (!m_valid || !m_modified)
+    {
+        // Manifest is up to date
+        bool flushed = m_valid;
+        m_mutex.unlock();
+        m_flushMutex.unlock();
+        return flushed;
+    }
+
+    // Allocate manifest value
+    size_t size =
+        (AssetCacheManifestHeaderSize + m_count*AssetCacheEntrySize);
+    unsigned char* value =
+        new (std::nothrow) unsigned char[AssetCacheHeaderSize + size];
+    if (!value)
+    {
+        // Could not allocate manifest
+        m_mutex.unlock();
+        m_flushMutex.unlock();
+        return false;
+    }
+
+    // Write manifest entries
+    unsigned char* manifest = &value[AssetCacheHeaderSize];
+    memcpy(&manifest[0], &m_count, sizeof(uint32_t));
+    memcpy(&manifest[4], &m_stamp, sizeof(uint32_t));
+    for (uint32_t i = 0; i < m_count; ++i)
+    {
+        unsigned char* entryData =
+            &manifest[AssetCacheManifestHeaderSize + i*AssetCacheEntrySize];
+        memcpy(&entryData[0], &m_entries[i].key, sizeof(uint64_t));
+        memcpy(&entryData[8], &m_entries[i].size, sizeof(uint32_t));
+        memcpy(&entryData[12], &m_entries[i].stamp, sizeof(uint32_t));
+    }
+    m_modified = false;
+    AssetCacheStore* store = m_store;
+    m_mutex.unlock();
+
+    // Save manifest (outside of the cache lock)
+    AssetCacheWriteHeader(value, AssetCacheManifestKey, manifest, size);
+    bool flushed = store->save(
+        AssetCacheManifestKey, value, AssetCacheHeaderSize + size
+    );
+    delete[] value;
+    if (!flushed)
+    {
+        // Manifest is saved again on the next flush
+        m_mutex.lock();
+        m_modified = true;
+        m_mutex.unlock();
+    }
+    m_flushMutex.unlock();
+    return flushed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Destroy assets cache (flushes the manifest)                               //
+////////////////////////////////////////////////////////////////////////////////
+void AssetCache::destroyCache()
+{
+    flush();
+    m_mutex.lock();
+    if (m_entries) { delete[] m_entries; }
+    if (m_store) { delete m_store; }
+    m_entries = 0;
+    m_store = 0;
+    m_count = 0;
+    m_pending = 0;
+    m_stamp = 0;
+    m_size = 0;
+    m_modified = false;
+    m_valid = false;
+    m_opened = false;
+    m_mutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Open store and read manifest (first use, cache mutex held)                //
+//  return : True if the store is available                                   //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCache::open()
+{
+    if (m_opened) { return m_valid; }
+    m_opened = true;
+
+    // Open store
+    if (!m_store || !m_store->open(AssetCacheDefaultName))
+    {
+        // Could not open store
+        return false;
+    }
+
+    // Allocate cache entries
+    m_entries = new (std::nothrow) AssetCacheEntry[AssetCacheMaxEntries];
+    if (!m_entries)
+    {
+        // Could not allocate cache entries
+        return false;
+    }
+
+    // Read manifest (values left without a manifest are replaced as their
+    // keys are saved again)
+    if (!readManifest())
+    {
+        m_count = 0;
+        m_stamp = 0;
+        m_size = 0;
+    }
+
+    // Evict least recently used payloads above the cache capacity
+    m_valid = true;
+    while ((m_count > 0) && (m_size > m_capacity))
+    {
+        uint32_t oldest = 0;
+        for (uint32_t i = 1; i < m_count; ++i)
+        {
+            if (m_entries[i].stamp < m_entries[oldest].stamp) { oldest = i; }
+        }
+        m_store->remove(m_entries[oldest].key);
+        removeEntry(oldest);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Read cache manifest (cache mutex held)                                    //
+//  return : True if the manifest is valid                                    //
+////////////////////////////////////////////////////////////////////////////////
+bool AssetCache::readManifest()
+{
+    // Load manifest
+    unsigned char* value = 0;
+    size_t valueSize = 0;
+    if (!m_store->load(AssetCacheManifestKey, value, valueSize) ||
+        !AssetCacheCheckValue(value, valueSize, AssetCacheManifestKey) ||
+        (valueSize < (AssetCacheHeaderSize + AssetCacheManifestHeaderSize)))
+    {
+        // Invalid manifest
+        if (value) { delete[] value; }
+        return false;
+    }
+
+    // Check manifest entries count
+    const unsigned char* manifest = &value[AssetCacheHeaderSize];
+    uint32_t count = 0;
+    memcpy(&count, &manifest[0], sizeof(uint32_t));
+    memcpy(&m_stamp, &manifest[4], sizeof(uint32_t));
+    if ((count > AssetCacheMaxEntries) ||
+        (valueSize != (AssetCacheHeaderSize +
+        AssetCacheManifestHeaderSize + count*AssetCacheEntrySize)))
+    {
+        // Invalid manifest entries count
+        delete[] value;
+        return false;
+    }
+
+    // Read manifest entries
+    m_size = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const unsigned char* entryData =
+            &manifest[AssetCacheManifestHeaderSize + i*AssetCacheEntrySize];
+        AssetCacheEntry& entry = m_entries[i];
+        memcpy(&entry.key, &entryData[0], sizeof(uint64_t));
+        memcpy(&entry.size, &entryData[8], sizeof(uint32_t));
+        memcpy(&entry.stamp, &entryData[12], sizeof(uint32_t));
+
+        // Entries are sorted by unique key
+        if ((entry.key == AssetCacheManifestKey) ||
+            ((i > 0) && (entry.key <= m_entries[i-1].key)))
+        {
+            // Invalid manifest order
+            delete[] value;
+            return false;
+        }
+        m_size += entry.size;
+    }
+    m_count = count;
+    delete[] value;
+
+    // Manifest is valid
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Find entry index (first entry with key greater or equal)                  //
+//  return : Entry index in the sorted entries                                //
+////////////////////////////////////////////////////////////////////////////////
+uint32_t AssetCache::find(uint64_t key) const
+{
+    uint32_t first = 0;
+    uint32_t last = m_count;
+    while (first < last)
+    {
+        uint32_t middle = first + ((last-first) >> 1);
+        if (m_entries[middle].key < key) { first = middle+1; }
+        else { last = middle; }
+    }
+    return first;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove entry (cache mutex held)                                           //
+////////////////////////////////////////////////////////////////////////////////
+void AssetCache::removeEntry(uint32_t index)
+{
+    m_size -= m_entries[index].size;
+    memmove(&m_entries[index], &m_entries[index+1],
+        sizeof(AssetCacheEntry)*(m_count-index-1)
+    );
+    --m_count;
+    m_modified = true;
+}
@@ -0,0 +1,442 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Resources/AssetCache.h : Persistent assets cache                       //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_RESOURCES_ASSETCACHE_HEADER
+#define WOS_RESOURCES_ASSETCACHE_HEADER
+
+    #include "../System/System.h"
+    #include "../System/SysMutex.h"
+    #include "../System/SysCondition.h"
+    #include "../System/SysCRC.h"
+
+    #if defined(WOS_EMSCRIPTEN)
+        #include <emscripten/fetch.h>
+        #include <emscripten/threading.h>
+    #else
+        #include <filesystem>
+        #include <fstream>
+        #include <cstdio>
+    #endif
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <string>
+    #include <new>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetCache settings                                                   //
+    ////////////////////////////////////////////////////////////////////////////
+    const char AssetCacheDefaultName[] = "wos_cache";
+    const uint64_t AssetCacheDefaultCapacity = 268435456;
+    const uint32_t AssetCacheMaxEntries = 4096;
+    const uint16_t AssetCacheVersion = 1;
+    const size_t AssetCacheHeaderSize = 24;
+    const size_t AssetCacheEntrySize = 16;
+    const size_t AssetCacheManifestHeaderSize = 8;
+    const uint64_t AssetCacheManifestKey = 0;
+    const uint64_t AssetCacheHashBasis = 0xCBF29CE484222325ull;
+    const uint64_t AssetCacheHashPrime = 0x00000100000001B3ull;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetCacheEntry structure                                             //
+    //  Manifest entry, stored as 16 bytes (little endian) :                  //
+    //  key (8), size (4), stamp (4)                                          //
+    ////////////////////////////////////////////////////////////////////////////
+    struct AssetCacheEntry
+    {
+        uint64_t key;                   // Asset content key
+        uint32_t size;                  // Stored payload size
+        uint32_t stamp;                 // Last use stamp (LRU)
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Hash 64 bits value into asset cache key (64 bits FNV-1a)              //
+    //  return : Updated asset cache key                                      //
+    ////////////////////////////////////////////////////////////////////////////
+    inline uint64_t AssetCacheHash(uint64_t hash, uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            hash ^= ((value >> (i*8)) & 0xFF);
+            hash *= AssetCacheHashPrime;
+        }
+        return hash;
+    }
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetCacheStore class definition                                      //
+    //  Persistent key/value storage backing the assets cache                 //
+    //  Stores are called from the loader threads only (never from the main   //
+    //  thread), concurrent loads must be supported                           //
+    ////////////////////////////////////////////////////////////////////////////
+    class AssetCacheStore
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCacheStore default constructor                           //
+            ////////////////////////////////////////////////////////////////////
+            AssetCacheStore();
+
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCacheStore virtual destructor                            //
+            ////////////////////////////////////////////////////////////////////
+            virtual ~AssetCacheStore();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Open store                                                    //
+            //  return : True if the store is ready                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool open(const char* name) = 0;
+
+            ////////////////////////////////////////////////////////////////////
+            //  Load stored value (allocated, to be deleted by the caller)    //
+            //  return : True if the value is loaded                          //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool load(uint64_t key, unsigned char*& data,
+                size_t& size) = 0;
+
+            ////////////////////////////////////////////////////////////////////
+            //  Save value (replaces the previous value)                      //
+            //  return : True if the value is saved                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool save(uint64_t key, const unsigned char* data,
+                size_t size) = 0;
+
+            ////////////////////////////////////////////////////////////////////
+            //  Remove stored value                                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual void remove(uint64_t key) = 0;
+
+
+        protected:
+            ////////////////////////////////////////////////////////////////////
+            //  Get stored value path                                         //
+            //  return : Value path (store name and hexadecimal key)          //
+            ////////////////////////////////////////////////////////////////////
+            std::string getPath(uint64_t key) const;
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCacheStore private copy constructor : Not copyable       //
+            ////////////////////////////////////////////////////////////////////
+            AssetCacheStore(const AssetCacheStore&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCacheStore private copy operator : Not copyable          //
+            ////////////////////////////////////////////////////////////////////
+            AssetCacheStore& operator=(const AssetCacheStore&) = delete;
+
+
+        protected:
+            std::string             m_name;         // Store name
+    };
+
+
+    #if defined(WOS_EMSCRIPTEN)
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetCacheRequest structure                                           //
+    //  IndexedDB request run on the main thread, waited by the caller        //
+    ////////////////////////////////////////////////////////////////////////////
+    struct AssetCacheRequest
+    {
+        SysMutex mutex;                 // Request mutex
+        SysCondition condition;         // Request completion condition
+        const char* method;             // Request method
+        std::string path;               // Stored value path
+        const unsigned char* input;     // Stored value (EM_IDB_STORE)
+        size_t inputSize;               // Stored value size
+        unsigned char* data;            // Loaded value (GET)
+        size_t size;                    // Loaded value size
+        bool done;                      // Request completion
+        bool success;                   // Request success
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetCacheIDBStore class definition                                   //
+    //  Browser store, values are kept in IndexedDB by emscripten fetch       //
+    ////////////////////////////////////////////////////////////////////////////
+    class AssetCacheIDBStore : public AssetCacheStore
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCacheIDBStore default constructor                        //
+            ////////////////////////////////////////////////////////////////////
+            AssetCacheIDBStore();
+
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCacheIDBStore virtual destructor                         //
+            ////////////////////////////////////////////////////////////////////
+            virtual ~AssetCacheIDBStore();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Open store                                                    //
+            //  return : True if the store is ready                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool open(const char* name);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Load stored value (allocated, to be deleted by the caller)    //
+            //  return : True if the value is loaded                          //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool load(uint64_t key, unsigned char*& data,
+                size_t& size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Save value (replaces the previous value)                      //
+            //  return : True if the value is saved                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool save(uint64_t key, const unsigned char* data,
+                size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Remove stored value                                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual void remove(uint64_t key);
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  Run IndexedDB request on the main thread and wait for it      //
+            //  return : True if the request succeeded                        //
+            ////////////////////////////////////////////////////////////////////
+            bool run(AssetCacheRequest& request);
+    };
+
+    #else
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetCacheFileStore class definition                                  //
+    //  Native store, values are kept in files of the store directory         //
+    ////////////////////////////////////////////////////////////////////////////
+    class AssetCacheFileStore : public AssetCacheStore
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCacheFileStore default constructor                       //
+            ////////////////////////////////////////////////////////////////////
+            AssetCacheFileStore();
+
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCacheFileStore virtual destructor                        //
+            ////////////////////////////////////////////////////////////////////
+            virtual ~AssetCacheFileStore();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Open store (creates the store directory)                      //
+            //  return : True if the store is ready                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool open(const char* name);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Load stored value (allocated, to be deleted by the caller)    //
+            //  return : True if the value is loaded                          //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool load(uint64_t key, unsigned char*& data,
+                size_t& size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Save value (written aside, then renamed over the previous)    //
+            //  return : True if the value is saved                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual bool save(uint64_t key, const unsigned char* data,
+                size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Remove stored value                                           //
+            ////////////////////////////////////////////////////////////////////
+            virtual void remove(uint64_t key);
+    };
+    #endif
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetCache class definition                                           //
+    //  Content addressed cache of decoded assets, persisted across launches  //
+    //  Keys are hashed from the source content (bundle 64 bits content hash  //
+    //  and size) and the decode parameters                                   //
+    //  Each value holds a 24 bytes header : "WCAC", version, reserved,       //
+    //  key (8), payload size, payload CRC32, checked on every load           //
+    //  The manifest (key 0) tracks the values sizes and last use stamps,     //
+    //  least recently used values are evicted above the cache capacity       //
+    //  Store requests are sent out of the cache lock (except on first use),  //
+    //  so that IndexedDB requests do not serialize the loader jobs           //
+    ////////////////////////////////////////////////////////////////////////////
+    class AssetCache
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCache default constructor                                //
+            ////////////////////////////////////////////////////////////////////
+            AssetCache();
+
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCache destructor                                         //
+            ////////////////////////////////////////////////////////////////////
+            ~AssetCache();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Init assets cache (the store is opened on first use)          //
+            //  store (optional) replaces the platform store, and is owned    //
+            //  by the cache once init succeeded                              //
+            //  return : True if the assets cache is ready                    //
+            ////////////////////////////////////////////////////////////////////
+            bool init(uint64_t capacity = AssetCacheDefaultCapacity,
+                AssetCacheStore* store = 0);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Load cached payload (allocated, to be deleted by the caller)  //
+            //  return : True if the payload is cached and valid              //
+            ////////////////////////////////////////////////////////////////////
+            bool load(uint64_t key, unsigned char*& data, size_t& size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Save payload, evicting least recently used payloads           //
+            //  return : True if the payload is cached                        //
+            ////////////////////////////////////////////////////////////////////
+            bool save(uint64_t key, const unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Save cache manifest if it was modified                        //
+            //  return : True if the manifest is up to date                   //
+            ////////////////////////////////////////////////////////////////////
+            bool flush();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Destroy assets cache (flushes the manifest)                   //
+            ////////////////////////////////////////////////////////////////////
+            void destroyCache();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get cached payloads count                                     //
+            //  return : Number of cached payloads                            //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getCount()
+            {
+                m_mutex.lock();
+                uint32_t count = m_count;
+                m_mutex.unlock();
+                return count;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get cached payloads size                                      //
+            //  return : Stored size of the cached payloads in bytes          //
+            ////////////////////////////////////////////////////////////////////
+            inline uint64_t getSize()
+            {
+                m_mutex.lock();
+                uint64_t size = m_size;
+                m_mutex.unlock();
+                return size;
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCache private copy constructor : Not copyable            //
+            ////////////////////////////////////////////////////////////////////
+            AssetCache(const AssetCache&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  AssetCache private copy operator : Not copyable               //
+            ////////////////////////////////////////////////////////////////////
+            AssetCache& operator=(const AssetCache&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Open store and read manifest (first use, cache mutex held)    //
+            //  return : True if the store is available                       //
+            ////////////////////////////////////////////////////////////////////
+            bool open();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Read cache manifest (cache mutex held)                        //
+            //  return : True if the manifest is valid                        //
+            ////////////////////////////////////////////////////////////////////
+            bool readManifest();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Find entry index (first entry with key greater or equal)      //
+            //  return : Entry index in the sorted entries                    //
+            ////////////////////////////////////////////////////////////////////
+            uint32_t find(uint64_t key) const;
+
+            ////////////////////////////////////////////////////////////////////
+            //  Remove entry (cache mutex held)                               //
+            //  The stored value is removed by the caller, out of the lock    //
+            ////////////////////////////////////////////////////////////////////
+            void removeEntry(uint32_t index);
+
+
+        private:
+            SysMutex                m_mutex;        // Cache mutex
+            SysMutex                m_flushMutex;   // Manifest write mutex
+            AssetCacheStore*        m_store;        // Cache store
+            bool                    m_opened;       // Store open attempted
+            bool                    m_valid;        // Store availability
+            bool                    m_modified;     // Manifest modified
+
+            AssetCacheEntry*        m_entries;      // Entries sorted by key
+            uint32_t                m_count;        // Entries count
+            uint32_t                m_pending;      // Saves in progress
+            uint32_t                m_stamp;        // Last use stamp
+            uint64_t                m_size;         // Stored values size
+            uint64_t                m_capacity;     // Stored values capacity
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  AssetCache global instance                                            //
+    ////////////////////////////////////////////////////////////////////////////
+    extern AssetCache GAssetCache;
+
+
+#endif // WOS_RESOURCES_ASSETCACHE_HEADER
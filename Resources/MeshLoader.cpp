@@ -43,49 +43,131 @@
 
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Mesh loaded callback function                                             //
+//  Parse mesh job VMSH data                                                  //
+//  return : True if the mesh is successfully parsed                          //
 ////////////////////////////////////////////////////////////////////////////////
-void OnMeshLoaded(void* arg, void* buffer, int size)
+bool MeshParseVMSH(MeshLoaderJob& job)
 {
-    // Get callback data
-    MeshCallbackData* callbackData = (MeshCallbackData*)arg;
-    if (!callbackData) { return; }
-
-    // Allocate data memory for copy
-    callbackData->mutex.lock();
-    callbackData->data = new (std::nothrow) unsigned char[size];
-    if (!callbackData->data)
+    // Get bundled or downloaded mesh data
+    if (!job.data)
     {
-        // Could not allocate data memory
-        callbackData->data = 0;
-        callbackData->size = 0;
-        callbackData->state = MESHLOADER_CALLBACK_ERROR;
-        callbackData->mutex.unlock();
-        return;
+        if ((job.fetch.getState() != SYSFETCH_STATE_LOADED) ||
+            !job.fetch.getData())
+        {
+            // Could not download mesh
+            return false;
+        }
+        job.data = job.fetch.getData();
+        job.size = job.fetch.getSize();
     }
 
-    // Copy downloaded data into memory
-    memcpy(callbackData->data, buffer, size);
-    callbackData->size = size;
-    callbackData->state = MESHLOADER_CALLBACK_LOADED;
-    callbackData->mutex.unlock();
+    // Init vertices and indices count
+    uint32_t verticesCount = 0;
+    uint32_t indicesCount = 0;
+    const unsigned char* data = job.data;
+    const unsigned char* end = data+job.size;
+
+    // Read VMSH header
+    char header[4] = {0};
+    char majorVersion = 0;
+    char minorVersion = 0;
+    if (data > (end - sizeof(char)*6)) { return false; }
+    memcpy(header, data, sizeof(char)*4);
+    data += sizeof(char)*4;
+    memcpy(&majorVersion, data, sizeof(char));
+    data += sizeof(char);
+    memcpy(&minorVersion, data, sizeof(char));
+    data += sizeof(char);
+
+    // Check VMSH header
+    if ((header[0] != 'V') || (header[1] != 'M') ||
+        (header[2] != 'S') || (header[3] != 'H'))
+    {
+        // Invalid VMSH header
+        return false;
+    }
+
+    // Check VMSH version
+    if ((majorVersion != 1) || (minorVersion != 0))
+    {
+        // Invalid VMSH header
+        return false;
+    }
+
+    // Read VMSH file type
+    char type = 0;
+    if (data > (end - sizeof(char))) { return false; }
+    memcpy(&type, data, sizeof(char));
+    data += sizeof(char);
+    if (type != 0)
+    {
+        // Invalid VMSH type
+        return false;
+    }
+
+    // Read vertices and indices count
+    if (data > (end - sizeof(uint32_t)*2)) { return false; }
+    memcpy(&verticesCount, data, sizeof(uint32_t));
+    data += sizeof(uint32_t);
+    memcpy(&indicesCount, data, sizeof(uint32_t));
+    data += sizeof(uint32_t);
+    if ((verticesCount <= 0) || (indicesCount <= 0))
+    {
+        // Invalid vertices or indices count
+        return false;
+    }
+
+    // Check vertices count
+    if (verticesCount >= MeshLoaderMaxVerticesCount)
+    {
+        // Invalid vertices count
+        return false;
+    }
+
+    // Check indices count
+    if (indicesCount >= MeshLoaderMaxIndicesCount)
+    {
+        // Invalid indices count
+        return false;
+    }
+
+    // Allocate mesh vertices and indices
+    job.vertices = new (std::nothrow) float[verticesCount];
+    job.indices = new (std::nothrow) uint32_t[indicesCount];
+    if (!job.vertices || !job.indices)
+    {
+        // Could not allocate mesh vertices and indices
+        return false;
+    }
+
+    // Read vertices
+    if (data > (end - sizeof(float)*verticesCount)) { return false; }
+    memcpy((char*)job.vertices, data, sizeof(float)*verticesCount);
+    data += sizeof(float)*verticesCount;
+
+    // Read 16bits indices into 32bits indices
+    if (data > (end - sizeof(uint16_t)*indicesCount)) { return false; }
+    for (uint32_t i = 0; i < indicesCount; ++i)
+    {
+        uint16_t index = 0;
+        memcpy(&index, data, sizeof(uint16_t));
+        data += sizeof(uint16_t);
+        job.indices[i] = index;
+    }
+
+    // Mesh successfully parsed
+    job.verticesCount = verticesCount;
+    job.indicesCount = indicesCount;
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Mesh error callback function                                              //
+//  Mesh parse job function                                                   //
 ////////////////////////////////////////////////////////////////////////////////
-void OnMeshError(void* arg)
+void MeshParseJob(void* userData)
 {
-    // Get callback data
-    MeshCallbackData* callbackData = (MeshCallbackData*)arg;
-    if (!callbackData) { return; }
-
-    // Set callback data error
-    callbackData->mutex.lock();
-    callbackData->data = 0;
-    callbackData->size = 0;
-    callbackData->state = MESHLOADER_CALLBACK_ERROR;
-    callbackData->mutex.unlock();
+    MeshLoaderJob* job = (MeshLoaderJob*)userData;
+    if (job) { job->loaded = MeshParseVMSH(*job); }
 }
 
 
@@ -95,10 +177,7 @@ void OnMeshError(void* arg)
 MeshLoader::MeshLoader() :
 m_state(MESHLOADER_STATE_NONE),
 m_stateMutex(),
-m_meshes(0),
-m_vertices(0),
-m_indices16(0),
-m_indices(0)
+m_meshes(0)
 {
 
 }
@@ -108,12 +187,6 @@ m_indices(0)
 ////////////////////////////////////////////////////////////////////////////////
 MeshLoader::~MeshLoader()
 {
-    if (m_indices) { delete[] m_indices; }
-    m_indices = 0;
-    if (m_indices16) { delete[] m_indices16; }
-    m_indices16 = 0;
-    if (m_vertices) { delete[] m_vertices; }
-    m_vertices = 0;
     if (m_meshes) { delete[] m_meshes; }
     m_meshes = 0;
     m_state = MESHLOADER_STATE_NONE;
@@ -237,30 +310,6 @@ bool MeshLoader::init()
         return false;
     }
 
-    // Allocate mesh vertices
-    m_vertices = new (std::nothrow) float[MeshLoaderMaxVerticesCount];
-    if (!m_vertices)
-    {
-        // Could not allocate mesh vertices
-        return false;
-    }
-
-    // Allocate mesh 16bits indices
-    m_indices16 = new (std::nothrow) uint16_t[MeshLoaderMaxIndicesCount];
-    if (!m_indices16)
-    {
-        // Could not allocate mesh 16bits indices
-        return false;
-    }
-
-    // Allocate mesh indices
-    m_indices = new (std::nothrow) uint32_t[MeshLoaderMaxIndicesCount];
-    if (!m_indices)
-    {
-        // Could not allocate mesh indices
-        return false;
-    }
-
     // Mesh loader ready
     return true;
 }
@@ -325,14 +374,6 @@ MeshLoaderState MeshLoader::getState()
 ////////////////////////////////////////////////////////////////////////////////
 void MeshLoader::destroyMeshLoader()
 {
-    // Delete indices and vertices
-    if (m_indices) { delete[] m_indices; }
-    m_indices = 0;
-    if (m_indices16) { delete[] m_indices16; }
-    m_indices16 = 0;
-    if (m_vertices) { delete[] m_vertices; }
-    m_vertices = 0;
-
     // Destroy meshes vertex buffers
     for (int i = 0; i < MESHES_ASSETSCOUNT; ++i)
     {
@@ -344,43 +385,20 @@ void MeshLoader::destroyMeshLoader()
 
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Load mesh asynchronously and wait for callback                            //
+//  Load mesh asynchronously                                                  //
 //  return : True if mesh is loaded, false otherwise                          //
 ////////////////////////////////////////////////////////////////////////////////
 bool MeshLoader::loadMeshAsync(VertexBuffer& vertexBuffer, const char* path)
 {
-    // Reset callback data
-    MeshCallbackData callbackData;
-    callbackData.mutex.lock();
-    callbackData.state = MESHLOADER_CALLBACK_NONE;
-    callbackData.data = 0;
-    callbackData.size = 0;
-    callbackData.mutex.unlock();
-
-    // Download mesh asynchronously
-    emscripten_async_wget_data(
-        path, (void*)&callbackData, OnMeshLoaded, OnMeshError
-    );
-    MeshCallbackState state = MESHLOADER_CALLBACK_NONE;
-
-    // Wait for the mesh to be downloaded
-    while (state == MESHLOADER_CALLBACK_NONE)
-    {
-        callbackData.mutex.lock();
-        state = callbackData.state;
-        callbackData.mutex.unlock();
-        SysSleep(MeshLoaderWaitAsyncSleepTime);
-    }
-    if ((state == MESHLOADER_CALLBACK_ERROR) || (!callbackData.data))
-    {
-        // Could not download mesh
-        return false;
-    }
+    // Setup mesh job
+    MeshLoaderJob job;
+    job.vertexBuffer = &vertexBuffer;
+    job.path = path;
 
-    // Load mesh from data buffer
-    if (!loadVMSH(vertexBuffer, callbackData.data, callbackData.size))
+    // Load mesh
+    if (!loadMeshesJobs(&job, 1))
     {
-        // Could not load VMSH
+        // Could not load mesh
         return false;
     }
 
@@ -534,106 +552,51 @@ bool MeshLoader::loadMeshes()
 
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Load mesh from VMSH data buffer                                           //
-//  return : True if the mesh is successfully loaded                          //
+//  Load meshes with the job scheduler                                        //
+//  return : True if every mesh is successfully loaded                        //
 ////////////////////////////////////////////////////////////////////////////////
-bool MeshLoader::loadVMSH(VertexBuffer& vertexBuffer,
-    unsigned char* data, int size)
+bool MeshLoader::loadMeshesJobs(MeshLoaderJob* jobs, uint32_t count)
 {
-    // Init vertices and indices count
-    uint32_t verticesCount = 0;
-    uint32_t indicesCount = 0;
-    unsigned char* end = data+size;
-
-    // Read VMSH header
-    char header[4] = {0};
-    char majorVersion = 0;
-    char minorVersion = 0;
-    if (data > (end - sizeof(char)*6)) { return false; }
-    memcpy(header, data, sizeof(char)*4);
-    data += sizeof(char)*4;
-    memcpy(&majorVersion, data, sizeof(char));
-    data += sizeof(char);
-    memcpy(&minorVersion, data, sizeof(char));
-    data += sizeof(char);
-
-    // Check VMSH header
-    if ((header[0] != 'V') || (header[1] != 'M') ||
-        (header[2] != 'S') || (header[3] != 'H'))
+    // Start downloads of the meshes missing from the bundle, parse jobs
+    // run as soon as each mesh data are available
+    bool bundled = GAssetBundle.wait();
+    for (uint32_t i = 0; i < count; ++i)
     {
-        // Invalid VMSH header
-        return false;
+        MeshLoaderJob& job = jobs[i];
+        job.vertices = 0;
+        job.indices = 0;
+        job.verticesCount = 0;
+        job.indicesCount = 0;
+        job.loaded = false;
+        AssetBundleView view;
+        if (!bundled || !GAssetBundle.getAsset(job.path, view))
+        {
+            view.data = 0;
+            view.size = 0;
+            job.fetch.start(job.path, &job.fetched);
+        }
+        job.data = view.data;
+        job.size = view.size;
+        GSysJobs.submit(MeshParseJob, &job, &job.ready, &job.fetched);
     }
 
-    // Check VMSH version
-    if ((majorVersion != 1) || (minorVersion != 0))
+    // Upload meshes on this thread (owner of the GL context)
+    bool loaded = true;
+    for (uint32_t i = 0; i < count; ++i)
     {
-        // Invalid VMSH header
-        return false;
+        MeshLoaderJob& job = jobs[i];
+        GSysJobs.wait(job.ready);
+        if (!job.loaded || !job.vertexBuffer->createBuffer(
+            job.vertices, job.indices, job.verticesCount, job.indicesCount,
+            VERTEX_INPUTS_STATICMESH))
+        {
+            // Could not load mesh
+            loaded = false;
+        }
+        if (job.indices) { delete[] job.indices; }
+        job.indices = 0;
+        if (job.vertices) { delete[] job.vertices; }
+        job.vertices = 0;
     }
-
-    // Read VMSH file type
-    char type = 0;
-    if (data > (end - sizeof(char))) { return false; }
-    memcpy(&type, data, sizeof(char));
-    data += sizeof(char);
-    if (type != 0)
-    {
-        // Invalid VMSH type
-        return false;
-    }
-
-    // Read vertices and indices count
-    if (data > (end - sizeof(uint32_t)*2)) { return false; }
-    memcpy(&verticesCount, data, sizeof(uint32_t));
-    data += sizeof(uint32_t);
-    memcpy(&indicesCount, data, sizeof(uint32_t));
-    data += sizeof(uint32_t);
-    if ((verticesCount <= 0) || (indicesCount <= 0))
-    {
-        // Invalid vertices or indices count
-        return false;
-    }
-
-    // Check vertices count
-    if (verticesCount >= MeshLoaderMaxVerticesCount)
-    {
-        // Invalid vertices count
-        return false;
-    }
-
-    // Check indices count
-    if (indicesCount >= MeshLoaderMaxIndicesCount)
-    {
-        // Invalid indices count
-        return false;
-    }
-
-    // Read vertices
-    if (data > (end - sizeof(float)*verticesCount)) { return false; }
-    memcpy((char*)m_vertices, data, sizeof(float)*verticesCount);
-    data += sizeof(float)*verticesCount;
-
-    // Read indices
-    if (data > (end - sizeof(uint16_t)*indicesCount)) { return false; }
-    memcpy((char*)m_indices16, data, sizeof(uint16_t)*indicesCount);
-    data += sizeof(uint16_t)*indicesCount;
-
-    // Convert 16bits indices into 32bits indices
-    for (uint32_t i = 0; i < indicesCount; ++i)
-    {
-        m_indices[i] = m_indices16[i];
-    }
-
-    // Create vertex buffer
-    if (!vertexBuffer.createBuffer(
-        m_vertices, m_indices, verticesCount, indicesCount,
-        VERTEX_INPUTS_STATICMESH))
-    {
-        // Could not create vertex buffer
-        return false;
-    }
-
-    // Mesh successfully loaded
-    return true;
+    return loaded;
 }
@@ -45,11 +45,15 @@
     #include "../System/System.h"
     #include "../System/SysThread.h"
     #include "../System/SysMutex.h"
+    #include "../System/SysFetch.h"
+    #include "../System/SysJobs.h"
     #include "../System/SysWindow.h"
     #include "../System/SysSettings.h"
 
     #include "../Renderer/VertexBuffer.h"
 
+    #include "AssetBundle.h"
+
     #include <fstream>
     #include <cstdint>
     #include <cstring>
@@ -67,7 +71,6 @@
     //  MeshLoader settings                                                   //
     ////////////////////////////////////////////////////////////////////////////
     const double MeshLoaderIdleSleepTime = 0.01;
-    const double MeshLoaderWaitAsyncSleepTime = 0.002;
     const double MeshLoaderErrorSleepTime = 0.1;
     const uint32_t MeshLoaderMaxVerticesCount = 1048576;
     const uint32_t MeshLoaderMaxIndicesCount = 262144;
@@ -88,6 +91,30 @@
     };
 
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  MeshLoaderJob structure                                               //
+    //  Download and VMSH parse jobs of one mesh, chained by their counters,  //
+    //  the upload is left to the mesh loader thread                          //
+    ////////////////////////////////////////////////////////////////////////////
+    struct MeshLoaderJob
+    {
+        VertexBuffer* vertexBuffer;     // Loaded vertex buffer
+        const char* path;               // Mesh path
+
+        const unsigned char* data;      // Bundled data (0 to download)
+        size_t size;                    // Bundled data size
+        SysFetch fetch;                 // Mesh download
+        SysJobCounter fetched;          // Download completion
+        SysJobCounter ready;            // Parse job completion
+
+        float* vertices;                // Parsed vertices
+        uint32_t* indices;              // Parsed indices
+        uint32_t verticesCount;         // Parsed vertices count
+        uint32_t indicesCount;          // Parsed indices count
+        bool loaded;                    // Mesh load state
+    };
+
+
     ////////////////////////////////////////////////////////////////////////////
     //  MeshLoaderState enumeration                                           //
     ////////////////////////////////////////////////////////////////////////////
@@ -105,28 +132,6 @@
     };
 
 
-    ////////////////////////////////////////////////////////////////////////////
-    //  MeshCallbackState enumeration                                         //
-    ////////////////////////////////////////////////////////////////////////////
-    enum MeshCallbackState
-    {
-        MESHLOADER_CALLBACK_NONE = 0,
-        MESHLOADER_CALLBACK_LOADED = 1,
-        MESHLOADER_CALLBACK_ERROR = 2
-    };
-
-    ////////////////////////////////////////////////////////////////////////////
-    //  MeshCallbackData structure                                            //
-    ////////////////////////////////////////////////////////////////////////////
-    struct MeshCallbackData
-    {
-        SysMutex mutex;
-        MeshCallbackState state;
-        unsigned char* data;
-        int size;
-    };
-
-
     ////////////////////////////////////////////////////////////////////////////
     //  MeshLoader class definition                                           //
     ////////////////////////////////////////////////////////////////////////////
@@ -190,7 +195,7 @@
 
 
             ////////////////////////////////////////////////////////////////////
-            //  Load mesh asynchronously and wait for callback                //
+            //  Load mesh asynchronously                                      //
             //  return : True if mesh is loaded, false otherwise              //
             ////////////////////////////////////////////////////////////////////
             bool loadMeshAsync(VertexBuffer& vertexBuffer, const char* path);
@@ -233,11 +238,11 @@
 
 
             ////////////////////////////////////////////////////////////////////
-            //  Load mesh from VMSH data buffer                               //
-            //  return : True if the mesh is successfully loaded              //
+            //  Load meshes with the job scheduler                            //
+            //  Meshes are uploaded in order, as soon as each one is ready    //
+            //  return : True if every mesh is successfully loaded            //
             ////////////////////////////////////////////////////////////////////
-            bool loadVMSH(VertexBuffer& vertexBuffer,
-                unsigned char* data, int size);
+            bool loadMeshesJobs(MeshLoaderJob* jobs, uint32_t count);
 
 
         private:
@@ -257,10 +262,6 @@
             SysMutex                m_stateMutex;       // State mutex
 
             VertexBuffer*           m_meshes;           // Meshes
-
-            float*                  m_vertices;         // Mesh vertices
-            uint16_t*               m_indices16;        // Mesh 16bits indices
-            uint32_t*               m_indices;          // Mesh indices
     };
 
 
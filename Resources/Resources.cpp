@@ -73,6 +73,16 @@ Resources::~Resources()
 ////////////////////////////////////////////////////////////////////////////////
 bool Resources::init()
 {
+    // Start job scheduler workers (jobs are still run by the waiting
+    // loader threads if the workers could not be started)
+    GSysJobs.init();
+
+    // Fetch assets bundle (assets missing from it are fetched one by one)
+    GAssetBundle.start();
+
+    // Init assets cache (assets are decoded on each load without it)
+    GAssetCache.init();
+
     // Start texture loader thread
     textures.start();
 
@@ -187,4 +197,13 @@ void Resources::destroyResources()
 
     // Destroy texture loader
     textures.destroyTextureLoader();
+
+    // Destroy assets cache
+    GAssetCache.destroyCache();
+
+    // Destroy assets bundle
+    GAssetBundle.destroyBundle();
+
+    // Stop job scheduler workers
+    GSysJobs.destroyJobs();
 }
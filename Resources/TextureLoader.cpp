@@ -43,49 +43,318 @@
 
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Texture loaded callback function                                          //
+//  Calling thread texture decoder                                            //
+//  Each worker keeps its decoder scratch buffers across the decode jobs      //
 ////////////////////////////////////////////////////////////////////////////////
-void OnTextureLoaded(void* arg, void* buffer, int size)
+thread_local PNGFile TextureThreadDecoder;
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load decoded texture from the assets cache                                //
+//  Cached payload : mip chain, then width, height and mip levels             //
+//  return : True if the texture is loaded from the cache                     //
+////////////////////////////////////////////////////////////////////////////////
+bool TextureLoadCached(TextureLoaderJob& job)
+{
+    // Load cached payload
+    unsigned char* data = 0;
+    size_t size = 0;
+    if (!GAssetCache.load(job.key, data, size))
+    {
+        // Texture is not cached
+        return false;
+    }
+
+    // Check cached texture info
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipLevels = 0;
+    if (size >= TextureCacheInfoSize)
+    {
+        size -= TextureCacheInfoSize;
+        memcpy(&width, &data[size], sizeof(uint32_t));
+        memcpy(&height, &data[size+4], sizeof(uint32_t));
+        memcpy(&mipLevels, &data[size+8], sizeof(uint32_t));
+    }
+    if ((width <= 0) || (width > TextureMaxWidth) ||
+        (height <= 0) || (height > TextureMaxHeight) ||
+        (mipLevels <= 0) || (mipLevels > ImageMipLevels(width, height)) ||
+        (size != ImageMipChainSize(width, height, mipLevels)))
+    {
+        // Invalid cached texture
+        delete[] data;
+        return false;
+    }
+
+    // Texture is loaded from the cache
+    job.image = data;
+    job.width = width;
+    job.height = height;
+    job.mipLevels = mipLevels;
+    job.cached = true;
+    job.loaded = true;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Save decoded texture into the assets cache                                //
+////////////////////////////////////////////////////////////////////////////////
+void TextureSaveCached(TextureLoaderJob& job)
+{
+    // Append texture info after the mip chain
+    size_t size = ImageMipChainSize(job.width, job.height, job.mipLevels);
+    memcpy(&job.image[size], &job.width, sizeof(uint32_t));
+    memcpy(&job.image[size+4], &job.height, sizeof(uint32_t));
+    memcpy(&job.image[size+8], &job.mipLevels, sizeof(uint32_t));
+
+    // Texture is decoded again on the next load if it could not be saved
+    GAssetCache.save(job.key, job.image, size + TextureCacheInfoSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check compressed texture path                                             //
+//  return : True if the texture path ends with the KTX2 extension            //
+////////////////////////////////////////////////////////////////////////////////
+bool TextureCompressedPath(const char* path)
+{
+    size_t extension = (sizeof(TextureCompressedExtension)-1);
+    size_t length = (path ? strlen(path) : 0);
+    return ((length > extension) &&
+        (strcmp(&path[length-extension], TextureCompressedExtension) == 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Resolve compressed texture variant path                                   //
+//  Variants supported by the graphics driver are selected first, then the    //
+//  variants that can be transcoded, bundled variants are preferred           //
+////////////////////////////////////////////////////////////////////////////////
+void TextureResolveVariant(TextureLoaderJob& job, bool bundled)
+{
+    std::string base(job.path,
+        strlen(job.path) - (sizeof(TextureCompressedExtension)-1)
+    );
+    std::string fallback;
+    for (uint32_t pass = 0; pass < 2; ++pass)
+    {
+        for (uint32_t i = 0; i < TextureCompressedVariantsCount; ++i)
+        {
+            const TextureCompressedVariant& variant =
+                TextureCompressedVariants[i];
+            if ((pass == 0) && !(variant.formats & job.formats)) { continue; }
+            if ((pass == 1) && !variant.transcodable) { continue; }
+
+            // Select bundled variant (or first variant to download)
+            AssetBundleView view;
+            job.source = base + variant.suffix;
+            if (!bundled || GAssetBundle.getAsset(job.source.c_str(), view))
+            {
+                return;
+            }
+            if (fallback.empty()) { fallback = job.source; }
+        }
+    }
+    job.source = fallback;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Decode compressed texture                                                 //
+//  Mip levels are kept compressed if the graphics driver supports their      //
+//  block format, or transcoded (opaque textures are transcoded to RGB565)    //
+////////////////////////////////////////////////////////////////////////////////
+void TextureDecodeCompressed(TextureLoaderJob& job)
+{
+    // Open texture file (mip levels are viewed in the texture data)
+    KTXFile& ktxfile = job.ktxfile;
+    if (!ktxfile.open(job.data, job.size))
+    {
+        // Invalid compressed texture
+        return;
+    }
+
+    // Mipmapped textures skip the first levels of complete mip chains,
+    // according to the texture quality setting
+    uint32_t levels = ktxfile.getLevels();
+    bool complete = (levels >=
+        ImageMipLevels(ktxfile.getWidth(), ktxfile.getHeight()));
+    uint32_t first = 0;
+    if (job.mipmaps && complete)
+    {
+        first = ((job.downscale < levels) ? job.downscale : (levels-1));
+    }
+    job.downscale = first;
+    job.width = ImageDownscaledSize(ktxfile.getWidth(), first);
+    job.height = ImageDownscaledSize(ktxfile.getHeight(), first);
+    job.mipLevels = (job.mipmaps ? (levels - first) : 1);
+
+    // Keep compressed mip levels if their format is supported, compressed
+    // mip levels can not be generated, and S3TC levels must be multiple of
+    // 4 in size (except for 1 or 2 pixels sizes of the next levels)
+    BlockFormat format = ktxfile.getFormat();
+    bool compressed = ((job.formats & (1 << format)) &&
+        (!job.mipmaps || complete));
+    bool s3tc = ((format == BLOCKFORMAT_BC1) ||
+        (format == BLOCKFORMAT_BC1A) || (format == BLOCKFORMAT_BC3));
+    for (uint32_t i = 0; compressed && s3tc && (i < job.mipLevels); ++i)
+    {
+        uint32_t width = ImageDownscaledSize(job.width, i);
+        uint32_t height = ImageDownscaledSize(job.height, i);
+        if ((((width % 4) != 0) && ((i == 0) || (width > 2))) ||
+            (((height % 4) != 0) && ((i == 0) || (height > 2))))
+        {
+            compressed = false;
+        }
+    }
+    if (compressed)
+    {
+        // Compressed texture is ready for upload
+        job.compressed = true;
+        job.loaded = true;
+        return;
+    }
+
+    // Allocate transcoded mip chain
+    if (!BlockFormatTranscodable(format))
+    {
+        // Unsupported compressed texture format
+        return;
+    }
+    BlockTarget target = BLOCKTARGET_RGB565;
+    job.format = TEXTUREFORMAT_RGB565;
+    if (BlockFormatAlpha(format))
+    {
+        target = BLOCKTARGET_RGBA8;
+        job.format = TEXTUREFORMAT_RGBA8;
+    }
+    job.image = new (std::nothrow) unsigned char[
+        ktxfile.getTranscodedSize(target, first, job.mipLevels)
+    ];
+    if (!job.image)
+    {
+        // Could not allocate transcoded mip chain
+        return;
+    }
+
+    // Transcode mip levels
+    if (!ktxfile.transcode(job.image, target, first, job.mipLevels))
+    {
+        // Could not transcode texture
+        return;
+    }
+
+    // Texture is transcoded
+    job.loaded = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Texture decode job function                                               //
+////////////////////////////////////////////////////////////////////////////////
+void TextureDecodeJob(void* userData)
 {
-    // Get callback data
-    TextureCallbackData* callbackData = (TextureCallbackData*)arg;
-    if (!callbackData) { return; }
-
-    // Allocate data memory for copy
-    callbackData->mutex.lock();
-    callbackData->data = new (std::nothrow) unsigned char[size];
-    if (!callbackData->data)
-    {
-        // Could not allocate data memory
-        callbackData->data = 0;
-        callbackData->size = 0;
-        callbackData->state = TEXTURELOADER_CALLBACK_ERROR;
-        callbackData->mutex.unlock();
+    // Get texture job
+    TextureLoaderJob* job = (TextureLoaderJob*)userData;
+    if (!job) { return; }
+
+    // Load decoded texture from the assets cache
+    if (job->key && TextureLoadCached(*job)) { return; }
+
+    // Get bundled or downloaded texture data
+    if (!job->data)
+    {
+        if (job->fetch.getState() != SYSFETCH_STATE_LOADED)
+        {
+            // Could not download texture
+            return;
+        }
+        job->data = job->fetch.getData();
+        job->size = job->fetch.getSize();
+    }
+
+    // Compressed texture
+    if (KTXFile::probe(job->data, job->size))
+    {
+        TextureDecodeCompressed(*job);
+        return;
+    }
+
+    // Check texture header
+    PNGFileInfo info;
+    if (!PNGFile::probe(job->data, job->size, info) ||
+        (info.width > TextureMaxWidth) || (info.height > TextureMaxHeight))
+    {
+        // Invalid texture
+        return;
+    }
+
+    // Allocate texture mip chain (interlaced textures are not downscaled)
+    uint32_t shift = (info.interlace == 0) ? job->downscale : 0;
+    if (shift > ImageDownscalerMaxShift) { shift = ImageDownscalerMaxShift; }
+    job->width = ImageDownscaledSize(info.width, shift);
+    job->height = ImageDownscaledSize(info.height, shift);
+    job->mipLevels = 1;
+    if (job->mipmaps)
+    {
+        job->mipLevels = ImageMipLevels(job->width, job->height);
+    }
+    job->image = new (std::nothrow) unsigned char[
+        ImageMipChainSize(job->width, job->height, job->mipLevels) +
+        TextureCacheInfoSize
+    ];
+    if (!job->image)
+    {
+        // Could not allocate texture mip chain
         return;
     }
 
-    // Copy downloaded data into memory
-    memcpy(callbackData->data, buffer, size);
-    callbackData->size = size;
-    callbackData->state = TEXTURELOADER_CALLBACK_LOADED;
-    callbackData->mutex.unlock();
+    // Decode texture into the mip chain base level
+    PNGFileLoadOptions options = PNGFileDefaultLoadOptions;
+    options.downscale = shift;
+    options.filter = IMAGEDOWNSCALER_FILTER_KAISER;
+    if (job->verified)
+    {
+        // Bundled data are already checked by the bundle CRC32
+        options.verify = PNGFILE_VERIFY_SKIP;
+        options.manifestValidated = true;
+    }
+    PNGFile& pngfile = TextureThreadDecoder;
+    pngfile.setDestination(job->image,
+        static_cast<size_t>(job->width)*job->height*4
+    );
+    if (!pngfile.loadImage(job->data, job->size, options) ||
+        (pngfile.getWidth() != job->width) ||
+        (pngfile.getHeight() != job->height))
+    {
+        // Could not decode texture
+        return;
+    }
+
+    // Texture is decoded
+    job->loaded = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Texture error callback function                                           //
+//  Texture mipmaps job function                                              //
+//  Decoded textures are then saved into the assets cache                     //
+//  Compressed textures hold their mip levels                                 //
 ////////////////////////////////////////////////////////////////////////////////
-void OnTextureError(void* arg)
+void TextureMipmapsJob(void* userData)
 {
-    // Get callback data
-    TextureCallbackData* callbackData = (TextureCallbackData*)arg;
-    if (!callbackData) { return; }
-
-    // Set callback data error
-    callbackData->mutex.lock();
-    callbackData->data = 0;
-    callbackData->size = 0;
-    callbackData->state = TEXTURELOADER_CALLBACK_ERROR;
-    callbackData->mutex.unlock();
+    // Get texture job
+    TextureLoaderJob* job = (TextureLoaderJob*)userData;
+    if (!job || !job->loaded || job->cached) { return; }
+    if (job->ktxfile.isValid()) { return; }
+
+    // Filter texture mip chain from the base level
+    if ((job->mipLevels > 1) && !ImageGenerateMipmaps(
+        job->image, job->width, job->height, job->mipLevels,
+        IMAGEDOWNSCALER_FILTER_KAISER, PNGFileDefaultLoadOptions.gammaCorrect))
+    {
+        // Could not generate texture mipmaps
+        job->loaded = false;
+        return;
+    }
+
+    // Save decoded texture into the assets cache
+    if (job->key) { TextureSaveCached(*job); }
 }
 
 
@@ -96,7 +365,10 @@ TextureLoader::TextureLoader() :
 m_state(TEXTURELOADER_STATE_NONE),
 m_stateMutex(),
 m_texturesGUI(0),
-m_texturesHigh(0)
+m_texturesHigh(0),
+m_pngFile(),
+m_decodeBlock(0),
+m_blockFormats(0)
 {
 
 }
@@ -235,6 +507,26 @@ bool TextureLoader::init()
         return false;
     }
 
+    // Allocate texture decode block (reused by every texture)
+    m_decodeBlock = new (std::nothrow) unsigned char[PNGFileReadBlockSize];
+    if (!m_decodeBlock)
+    {
+        // Could not allocate texture decode block
+        return false;
+    }
+
+    // Enable compressed texture formats supported by the graphics driver
+    m_blockFormats = 0;
+    GSysWindow.setThread();
+    for (uint32_t i = 0; i < TextureCompressedVariantsCount; ++i)
+    {
+        if (GSysWindow.enableExtension(TextureCompressedVariants[i].extension))
+        {
+            m_blockFormats |= TextureCompressedVariants[i].formats;
+        }
+    }
+    GSysWindow.releaseThread();
+
     // Texture loader ready
     return true;
 }
@@ -299,6 +591,11 @@ TextureLoaderState TextureLoader::getState()
 ////////////////////////////////////////////////////////////////////////////////
 void TextureLoader::destroyTextureLoader()
 {
+    // Destroy pooled PNG decoders and decode block
+    m_pngFile.destroyImage();
+    if (m_decodeBlock) { delete[] m_decodeBlock; }
+    m_decodeBlock = 0;
+
     // Destroy high textures
     for (int i = 0; i < TEXTURE_ASSETSCOUNT; ++i)
     {
@@ -318,58 +615,116 @@ void TextureLoader::destroyTextureLoader()
 
 
 ////////////////////////////////////////////////////////////////////////////////
-//  Load texture asynchronously and wait for callback                         //
+//  Load texture asynchronously                                               //
 //  return : True if texture is loaded, false otherwise                       //
 ////////////////////////////////////////////////////////////////////////////////
 bool TextureLoader::loadTextureAsync(Texture& texture, const char* path,
     bool mipmaps, bool smooth, TextureRepeatMode repeat)
 {
-    // Reset callback data
-    TextureCallbackData callbackData;
-    callbackData.mutex.lock();
-    callbackData.state = TEXTURELOADER_CALLBACK_NONE;
-    callbackData.data = 0;
-    callbackData.size = 0;
-    callbackData.mutex.unlock();
+    // Check texture decode block
+    unsigned char* block = m_decodeBlock;
+    if (!block)
+    {
+        // Texture loader is not initialized
+        return false;
+    }
+
+    // Bundled textures are already complete (no preview), and compressed
+    // textures are not progressive
+    AssetBundleView view;
+    if (TextureCompressedPath(path) ||
+        (GAssetBundle.wait() && GAssetBundle.getAsset(path, view)))
+    {
+        TextureLoaderJob job;
+        job.texture = &texture;
+        job.path = path;
+        job.mipmaps = mipmaps;
+        job.smooth = smooth;
+        job.repeat = repeat;
+        return loadTexturesJobs(&job, 1);
+    }
 
     // Download texture asynchronously
-    emscripten_async_wget_data(
-        path, (void*)&callbackData, OnTextureLoaded, OnTextureError
-    );
-    TextureCallbackState state = TEXTURELOADER_CALLBACK_NONE;
+    SysFetch fetch;
+    if (!fetch.start(path))
+    {
+        // Could not start texture download
+        return false;
+    }
 
-    // Wait for the texture to be downloaded
-    while (state == TEXTURELOADER_CALLBACK_NONE)
+    // Mipmapped textures are downscaled to the texture quality setting,
+    // and their mip chain is filtered on the loader thread
+    PNGFileLoadOptions options = PNGFileDefaultLoadOptions;
+    if (mipmaps)
     {
-        callbackData.mutex.lock();
-        state = callbackData.state;
-        callbackData.mutex.unlock();
-        SysSleep(TextureLoaderWaitAsyncSleepTime);
+        options.downscale = GSysSettings.getTextureQualityMode();
+        options.filter = IMAGEDOWNSCALER_FILTER_KAISER;
+        options.mipmaps = true;
     }
-    if ((state == TEXTURELOADER_CALLBACK_ERROR) || (!callbackData.data))
+
+    // Start PNG decode stream (pooled decoder and image buffers)
+    PNGFile& pngfile = m_pngFile;
+    bool decoded = pngfile.startStream(options);
+    size_t decodedSize = 0;
+    uint32_t previewPasses = 0;
+
+    // Decode the texture as it is downloaded (woken up on each block)
+    size_t blockSize = 0;
+    while ((blockSize = fetch.read(
+        decodedSize, block, PNGFileReadBlockSize)) > 0)
     {
-        // Could not download texture
-        return false;
+        // Decode downloaded block
+        decodedSize += blockSize;
+        if (!decoded) { continue; }
+        decoded = pngfile.feedStream(block, blockSize);
+
+        // Upload interlaced texture preview after each completed pass
+        uint32_t passes = pngfile.getStreamPasses();
+        if (decoded && (passes >= TextureLoaderPreviewPass) &&
+            (passes > previewPasses) && (passes < PNGFileAdam7Passes))
+        {
+            if (previewPasses <= 0)
+            {
+                decoded = texture.createTexture(
+                    pngfile.getWidth(), pngfile.getHeight(),
+                    pngfile.getStreamImage(), mipmaps, smooth, repeat
+                );
+            }
+            else
+            {
+                decoded = texture.updateTexture(pngfile.getStreamImage());
+            }
+            previewPasses = passes;
+        }
     }
 
-    // Load texture from PNG buffer
-    PNGFile pngfile;
-    if (!pngfile.loadImage(callbackData.data, callbackData.size))
+    if ((fetch.wait() != SYSFETCH_STATE_LOADED) || !decoded ||
+        !pngfile.finishStream())
     {
-        // Could not load PNG buffer
-        if (callbackData.data) { delete[] callbackData.data; }
+        // Could not download or decode texture
+        if (previewPasses > 0) { texture.destroyTexture(); }
         return false;
     }
-    if (!texture.createTexture(
-        pngfile.getWidth(), pngfile.getHeight(), pngfile.getImage(),
-        mipmaps, smooth, repeat))
+
+    // Refine preview texture or create texture
+    if (previewPasses > 0)
+    {
+        decoded = texture.updateTexture(
+            pngfile.getImage(), pngfile.getMipLevels()
+        );
+    }
+    else
+    {
+        decoded = texture.createTexture(
+            pngfile.getWidth(), pngfile.getHeight(), pngfile.getImage(),
+            mipmaps, smooth, repeat, pngfile.getMipLevels()
+        );
+    }
+    if (!decoded)
     {
         // Could not create texture
-        if (callbackData.data) { delete[] callbackData.data; }
         return false;
     }
-    pngfile.destroyImage();
-    if (callbackData.data) { delete[] callbackData.data; }
 
     // Texture is successfully loaded
     return true;
@@ -377,11 +732,13 @@ bool TextureLoader::loadTextureAsync(Texture& texture, const char* path,
 
 ////////////////////////////////////////////////////////////////////////////////
 //  Upload texture to graphics memory                                         //
+//  data holds dataLevels packed mip levels                                   //
 //  return : True if texture is successfully uploaded                         //
 ////////////////////////////////////////////////////////////////////////////////
 bool TextureLoader::uploadTexture(unsigned int& handle,
-    uint32_t width, uint32_t height, uint32_t mipLevels,
-    const unsigned char* data, bool smooth, TextureRepeatMode repeat)
+    uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t dataLevels,
+    const unsigned char* data, TextureFormat format,
+    bool smooth, TextureRepeatMode repeat)
 {
     // Set current thread as current context
     GSysWindow.setThread();
@@ -391,18 +748,120 @@ bool TextureLoader::uploadTexture(unsigned int& handle,
     if (!handle)
     {
         // Unable to create texture
+        GSysWindow.releaseThread();
         SysMessage::box() << "[0x300D] Unable to create texture\n";
         SysMessage::box() << "Please update your graphics drivers";
         return false;
     }
 
-    // Upload texture data
+    // Upload texture data and precomputed mip levels
+    // RGB565 rows are 2 bytes aligned (RGBA8 offsets halved)
+    GLenum glFormat = GL_RGBA;
+    GLenum glType = GL_UNSIGNED_BYTE;
+    size_t pixelShift = 0;
+    if (format == TEXTUREFORMAT_RGB565)
+    {
+        glFormat = GL_RGB;
+        glType = GL_UNSIGNED_SHORT_5_6_5;
+        pixelShift = 1;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    }
     glBindTexture(GL_TEXTURE_2D, handle);
-    glTexImage2D(
-        GL_TEXTURE_2D, 0, GL_RGBA, width, height,
-        0, GL_RGBA, GL_UNSIGNED_BYTE, data
-    );
+    for (uint32_t i = 0; i < dataLevels; ++i)
+    {
+        glTexImage2D(
+            GL_TEXTURE_2D, i, glFormat,
+            ImageDownscaledSize(width, i), ImageDownscaledSize(height, i),
+            0, glFormat, glType,
+            &data[ImageMipChainSize(width, height, i) >> pixelShift]
+        );
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Set texture sampling parameters
+    setTextureParameters(smooth, repeat);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Generate texture mipmaps
+    if (!generateTextureMipmaps(handle, width, height, mipLevels, dataLevels))
+    {
+        // Could not generate texture mipmaps
+        GSysWindow.releaseThread();
+        return false;
+    }
+
+    // Texture successfully uploaded
+    GSysWindow.releaseThread();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Upload compressed texture to graphics memory                              //
+//  return : True if texture is successfully uploaded                         //
+////////////////////////////////////////////////////////////////////////////////
+bool TextureLoader::uploadCompressedTexture(unsigned int& handle,
+    const KTXFile& ktxfile, uint32_t first, uint32_t mipLevels,
+    bool smooth, TextureRepeatMode repeat)
+{
+    // Check compressed mip levels
+    if ((first >= ktxfile.getLevels()) ||
+        (mipLevels > (ktxfile.getLevels() - first)) ||
+        !(m_blockFormats & (1 << ktxfile.getFormat())))
+    {
+        // Unsupported compressed texture
+        return false;
+    }
+
+    // Set current thread as current context
+    GSysWindow.setThread();
+
+    // Create texture
+    glGenTextures(1, &handle);
+    if (!handle)
+    {
+        // Unable to create texture
+        GSysWindow.releaseThread();
+        SysMessage::box() << "[0x300D] Unable to create texture\n";
+        SysMessage::box() << "Please update your graphics drivers";
+        return false;
+    }
+
+    // Upload compressed mip levels
+    uint32_t width = ImageDownscaledSize(ktxfile.getWidth(), first);
+    uint32_t height = ImageDownscaledSize(ktxfile.getHeight(), first);
+    glBindTexture(GL_TEXTURE_2D, handle);
+    for (uint32_t i = 0; i < mipLevels; ++i)
+    {
+        glCompressedTexImage2D(
+            GL_TEXTURE_2D, i, TextureCompressedFormats[ktxfile.getFormat()],
+            ImageDownscaledSize(width, i), ImageDownscaledSize(height, i),
+            0, static_cast<GLsizei>(ktxfile.getLevelSize(first+i)),
+            ktxfile.getLevelData(first+i)
+        );
+    }
+
+    // Set texture sampling parameters
+    setTextureParameters(smooth, repeat);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Set texture mipmaps filtering (every mip level is uploaded)
+    if (!generateTextureMipmaps(handle, width, height, mipLevels, mipLevels))
+    {
+        // Could not set texture mipmaps
+        GSysWindow.releaseThread();
+        return false;
+    }
+
+    // Texture successfully uploaded
+    GSysWindow.releaseThread();
+    return true;
+}
 
+////////////////////////////////////////////////////////////////////////////////
+//  Set bound texture sampling parameters                                     //
+////////////////////////////////////////////////////////////////////////////////
+void TextureLoader::setTextureParameters(bool smooth, TextureRepeatMode repeat)
+{
     // Repeat mode
     if (repeat == TEXTUREMODE_REPEAT)
     {
@@ -453,26 +912,64 @@ bool TextureLoader::uploadTexture(unsigned int& handle,
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Update texture data in graphics memory                                    //
+//  data holds dataLevels packed mip levels                                   //
+//  return : True if texture is successfully updated                          //
+////////////////////////////////////////////////////////////////////////////////
+bool TextureLoader::updateTexture(unsigned int& handle,
+    uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t dataLevels,
+    const unsigned char* data, TextureFormat format)
+{
+    // Set current thread as current context
+    GSysWindow.setThread();
+
+    // Update texture data and precomputed mip levels
+    GLenum glFormat = GL_RGBA;
+    GLenum glType = GL_UNSIGNED_BYTE;
+    size_t pixelShift = 0;
+    if (format == TEXTUREFORMAT_RGB565)
+    {
+        glFormat = GL_RGB;
+        glType = GL_UNSIGNED_SHORT_5_6_5;
+        pixelShift = 1;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    }
+    glBindTexture(GL_TEXTURE_2D, handle);
+    for (uint32_t i = 0; i < dataLevels; ++i)
+    {
+        glTexSubImage2D(
+            GL_TEXTURE_2D, i, 0, 0,
+            ImageDownscaledSize(width, i), ImageDownscaledSize(height, i),
+            glFormat, glType,
+            &data[ImageMipChainSize(width, height, i) >> pixelShift]
+        );
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    // Generate texture mipmaps
-    if (!generateTextureMipmaps(handle, width, height, mipLevels))
+    // Regenerate texture mipmaps
+    if (!generateTextureMipmaps(handle, width, height, mipLevels, dataLevels))
     {
         // Could not generate texture mipmaps
+        GSysWindow.releaseThread();
         return false;
     }
 
-    // Texture successfully uploaded
+    // Texture successfully updated
     GSysWindow.releaseThread();
     return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 //  Generate texture mipmaps                                                  //
+//  Only the mip levels missing from the data are generated                   //
 //  return : True if texture mipmaps are generated                            //
 ////////////////////////////////////////////////////////////////////////////////
 bool TextureLoader::generateTextureMipmaps(unsigned int& handle,
-    uint32_t width, uint32_t height, uint32_t mipLevels)
+    uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t dataLevels)
 {
     // Check texture size
     if ((width <= 0) || (width > TextureMaxWidth) ||
@@ -489,9 +986,12 @@ bool TextureLoader::generateTextureMipmaps(unsigned int& handle,
         return true;
     }
 
-    // Generate texture mipmaps
+    // Generate missing texture mipmaps
     glBindTexture(GL_TEXTURE_2D, handle);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    if (dataLevels < mipLevels)
+    {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     glTexParameteri(
         GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR
     );
@@ -509,71 +1009,121 @@ bool TextureLoader::generateTextureMipmaps(unsigned int& handle,
 ////////////////////////////////////////////////////////////////////////////////
 bool TextureLoader::loadEmbeddedTextures()
 {
-    // Load cursor texture
-    if (!loadTextureAsync(m_texturesGUI[TEXTURE_CURSOR],
-        "cursors/default.png",
-        false, false, TEXTUREMODE_CLAMP))
-    {
-        // Could not load cursor texture
-        return false;
-    }
-
-    // Load NS cursor texture
-    if (!loadTextureAsync(m_texturesGUI[TEXTURE_NSCURSOR],
-        "cursors/nsresize.png",
-        false, false, TEXTUREMODE_CLAMP))
-    {
-        // Could not load NS cursor texture
-        return false;
-    }
-
-    // Load EW cursor texture
-    if (!loadTextureAsync(m_texturesGUI[TEXTURE_EWCURSOR],
-        "cursors/ewresize.png",
-        false, false, TEXTUREMODE_CLAMP))
+    // Setup embedded textures jobs
+    TextureLoaderJob jobs[TEXTURE_GUICOUNT];
+    for (int i = 0; i < TEXTURE_GUICOUNT; ++i)
     {
-        // Could not load EW cursor texture
-        return false;
+        const TextureEmbeddedAsset& asset = TextureEmbeddedAssets[i];
+        jobs[i].texture = &m_texturesGUI[asset.texture];
+        jobs[i].path = asset.path;
+        jobs[i].mipmaps = asset.mipmaps;
+        jobs[i].smooth = asset.smooth;
+        jobs[i].repeat = asset.repeat;
     }
 
-    // Load NE-SW cursor texture
-    if (!loadTextureAsync(m_texturesGUI[TEXTURE_NESWCURSOR],
-        "cursors/neswresize.png",
-        false, false, TEXTUREMODE_CLAMP))
+    // Load embedded textures
+    if (!loadTexturesJobs(jobs, TEXTURE_GUICOUNT))
     {
-        // Could not load NE-SW cursor texture
+        // Could not load embedded textures
         return false;
     }
 
-    // Load NW-SE cursor texture
-    if (!loadTextureAsync(m_texturesGUI[TEXTURE_NWSECURSOR],
-        "cursors/nwseresize.png",
-        false, false, TEXTUREMODE_CLAMP))
-    {
-        // Could not load NW-SE cursor texture
-        return false;
-    }
+    // Embedded textures are successfully loaded
+    return true;
+}
 
-    // Load window texture
-    if (!loadTextureAsync(m_texturesGUI[TEXTURE_WINDOW],
-        "textures/window.png",
-        false, true, TEXTUREMODE_CLAMP))
+////////////////////////////////////////////////////////////////////////////////
+//  Load textures with the job scheduler                                      //
+//  return : True if every texture is successfully loaded                     //
+////////////////////////////////////////////////////////////////////////////////
+bool TextureLoader::loadTexturesJobs(TextureLoaderJob* jobs, uint32_t count)
+{
+    // Start downloads of the textures missing from the bundle, decode and
+    // mipmaps jobs run as soon as each texture data are available
+    // Mipmapped textures are downscaled to the texture quality setting
+    // Bundled textures are cached by content, decode and mipmaps jobs are
+    // skipped on the next loads (compressed textures are not cached)
+    bool bundled = GAssetBundle.wait();
+    uint32_t downscale = GSysSettings.getTextureQualityMode();
+    for (uint32_t i = 0; i < count; ++i)
     {
-        // Could not load pixel font texture
-        return false;
+        TextureLoaderJob& job = jobs[i];
+        job.downscale = job.mipmaps ? downscale : 0;
+        job.image = 0;
+        job.width = 0;
+        job.height = 0;
+        job.mipLevels = 1;
+        job.loaded = false;
+        job.key = 0;
+        job.cached = false;
+        job.ktxfile.destroyFile();
+        job.compressed = false;
+        job.format = TEXTUREFORMAT_RGBA8;
+        job.formats = m_blockFormats;
+        job.source = job.path;
+        bool compressed = TextureCompressedPath(job.path);
+        if (compressed) { TextureResolveVariant(job, bundled); }
+        AssetBundleView view;
+        if (bundled && GAssetBundle.getAsset(job.source.c_str(), view))
+        {
+            if (!compressed)
+            {
+                job.key = AssetCacheHash(
+                    AssetCacheHashBasis, TextureCacheFormat
+                );
+                job.key = AssetCacheHash(job.key, view.contentHash);
+                job.key = AssetCacheHash(job.key, view.size);
+                job.key = AssetCacheHash(job.key, job.downscale);
+                job.key = AssetCacheHash(job.key, job.mipmaps ? 1 : 0);
+            }
+        }
+        else
+        {
+            view.data = 0;
+            view.size = 0;
+            view.verified = false;
+            job.fetch.start(job.source.c_str(), &job.fetched);
+        }
+        job.data = view.data;
+        job.size = view.size;
+        job.verified = view.verified;
+        GSysJobs.submit(TextureDecodeJob, &job, &job.decoded, &job.fetched);
+        GSysJobs.submit(TextureMipmapsJob, &job, &job.ready, &job.decoded);
     }
 
-    // Load pixel font texture
-    if (!loadTextureAsync(m_texturesGUI[TEXTURE_PIXELFONT],
-        "fonts/wospxfont.png",
-        false, true, TEXTUREMODE_CLAMP))
+    // Upload textures on this thread (owner of the GL context)
+    bool loaded = true;
+    for (uint32_t i = 0; i < count; ++i)
     {
-        // Could not load pixel font texture
-        return false;
+        TextureLoaderJob& job = jobs[i];
+        GSysJobs.wait(job.ready);
+        bool created = false;
+        if (job.loaded && job.compressed)
+        {
+            created = job.texture->createTexture(job.ktxfile,
+                job.downscale, job.mipmaps, job.smooth, job.repeat
+            );
+        }
+        else if (job.loaded)
+        {
+            created = job.texture->createTexture(
+                job.width, job.height, job.image, job.mipmaps,
+                job.smooth, job.repeat, job.mipLevels, job.format
+            );
+        }
+        if (!created)
+        {
+            // Could not load texture
+            loaded = false;
+        }
+        if (job.image) { delete[] job.image; }
+        job.image = 0;
+        job.ktxfile.destroyFile();
     }
 
-    // Embedded textures are successfully loaded
-    return true;
+    // Save assets cache manifest
+    GAssetCache.flush();
+    return loaded;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,20 +42,30 @@
 #ifndef WOS_RESOURCES_TEXTURELOADER_HEADER
 #define WOS_RESOURCES_TEXTURELOADER_HEADER
 
-    #include <emscripten/html5.h>
     #include <GLES2/gl2.h>
 
     #include "../System/System.h"
     #include "../System/SysThread.h"
     #include "../System/SysMutex.h"
+    #include "../System/SysFetch.h"
+    #include "../System/SysJobs.h"
     #include "../System/SysWindow.h"
     #include "../System/SysSettings.h"
 
     #include "../Renderer/Texture.h"
 
+    #include "AssetBundle.h"
+    #include "AssetCache.h"
+
     #include "../Images/PNGFile.h"
+    #include "../Images/ImageDownscaler.h"
+    #include "../Images/BlockTranscoder.h"
+    #include "../Images/KTXFile.h"
 
+    #include <cstddef>
     #include <cstdint>
+    #include <cstring>
+    #include <string>
     #include <new>
 
 
@@ -72,8 +82,48 @@
         (TextureMaxWidth*TextureMaxHeight*TextureMaxLayers*4);
     const uint32_t CubeMapMaxSize = (CubeMapMaxWidth*CubeMapMaxHeight*4*6);
     const double TextureLoaderIdleSleepTime = 0.01;
-    const double TextureLoaderWaitAsyncSleepTime = 0.002;
     const double TextureLoaderErrorSleepTime = 0.1;
+    const uint32_t TextureLoaderPreviewPass = 3;
+    const uint64_t TextureCacheFormat = 1;
+    const size_t TextureCacheInfoSize = 12;
+    const char TextureCompressedExtension[] = ".ktx2";
+    const uint32_t TextureCompressedVariantsCount = 3;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Texture compressed GL formats (indexed by block format)               //
+    ////////////////////////////////////////////////////////////////////////////
+    const GLenum TextureCompressedFormats[BLOCKFORMAT_COUNT] =
+    {
+        0,
+        0x83F0, 0x83F1, 0x83F3,     // S3TC DXT1 RGB, DXT1 RGBA, DXT5
+        0x9274, 0x9276, 0x9278,     // ETC2 RGB8, RGB8 A1, RGBA8 EAC
+        0x93B0                      // ASTC 4x4 RGBA
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  TextureCompressedVariant structure                                    //
+    //  Compressed textures paths end with ".ktx2", and each variant file is  //
+    //  named after the path with the variant suffix instead of ".ktx2"       //
+    ////////////////////////////////////////////////////////////////////////////
+    struct TextureCompressedVariant
+    {
+        const char* suffix;
+        const char* extension;
+        uint32_t formats;
+        bool transcodable;
+    };
+    const TextureCompressedVariant TextureCompressedVariants[
+        TextureCompressedVariantsCount] = {
+        {".astc.ktx2", "WEBGL_compressed_texture_astc",
+            (1 << BLOCKFORMAT_ASTC4X4), false},
+        {".etc2.ktx2", "WEBGL_compressed_texture_etc",
+            ((1 << BLOCKFORMAT_ETC2) | (1 << BLOCKFORMAT_ETC2A1) |
+            (1 << BLOCKFORMAT_ETC2A8)), true},
+        {".bc.ktx2", "WEBGL_compressed_texture_s3tc",
+            ((1 << BLOCKFORMAT_BC1) | (1 << BLOCKFORMAT_BC1A) |
+            (1 << BLOCKFORMAT_BC3)), true}
+    };
 
 
     ////////////////////////////////////////////////////////////////////////////
@@ -92,6 +142,34 @@
         TEXTURE_GUICOUNT = 7
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  TextureEmbeddedAsset structure                                        //
+    ////////////////////////////////////////////////////////////////////////////
+    struct TextureEmbeddedAsset
+    {
+        TexturesGUI texture;
+        const char* path;
+        bool mipmaps;
+        bool smooth;
+        TextureRepeatMode repeat;
+    };
+    const TextureEmbeddedAsset TextureEmbeddedAssets[TEXTURE_GUICOUNT] = {
+        {TEXTURE_CURSOR, "cursors/default.png",
+            false, false, TEXTUREMODE_CLAMP},
+        {TEXTURE_NSCURSOR, "cursors/nsresize.png",
+            false, false, TEXTUREMODE_CLAMP},
+        {TEXTURE_EWCURSOR, "cursors/ewresize.png",
+            false, false, TEXTUREMODE_CLAMP},
+        {TEXTURE_NESWCURSOR, "cursors/neswresize.png",
+            false, false, TEXTUREMODE_CLAMP},
+        {TEXTURE_NWSECURSOR, "cursors/nwseresize.png",
+            false, false, TEXTUREMODE_CLAMP},
+        {TEXTURE_WINDOW, "textures/window.png",
+            false, true, TEXTUREMODE_CLAMP},
+        {TEXTURE_PIXELFONT, "fonts/wospxfont.png",
+            false, true, TEXTUREMODE_CLAMP}
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     //  TexturesAssets enumeration                                            //
     ////////////////////////////////////////////////////////////////////////////
@@ -137,24 +215,39 @@
 
 
     ////////////////////////////////////////////////////////////////////////////
-    //  TextureCallbackState enumeration                                      //
-    ////////////////////////////////////////////////////////////////////////////
-    enum TextureCallbackState
-    {
-        TEXTURELOADER_CALLBACK_NONE = 0,
-        TEXTURELOADER_CALLBACK_LOADED = 1,
-        TEXTURELOADER_CALLBACK_ERROR = 2
-    };
-
-    ////////////////////////////////////////////////////////////////////////////
-    //  TextureCallbackData structure                                         //
+    //  TextureLoaderJob structure                                            //
+    //  Download, decode and mipmaps jobs of one texture, chained by their    //
+    //  counters, the upload is left to the texture loader thread             //
     ////////////////////////////////////////////////////////////////////////////
-    struct TextureCallbackData
+    struct TextureLoaderJob
     {
-        SysMutex mutex;
-        TextureCallbackState state;
-        unsigned char* data;
-        int size;
+        Texture* texture;               // Loaded texture
+        const char* path;               // Texture path
+        bool mipmaps;                   // Texture mipmaps
+        bool smooth;                    // Texture smooth filtering
+        TextureRepeatMode repeat;       // Texture repeat mode
+        uint32_t downscale;             // Decode downscale shift
+
+        std::string source;             // Texture variant path
+        uint32_t formats;               // Supported compressed formats
+        const unsigned char* data;      // Bundled data (0 to download)
+        size_t size;                    // Bundled data size
+        bool verified;                  // Bundled data CRC32 checked
+        SysFetch fetch;                 // Texture download
+        SysJobCounter fetched;          // Download completion
+        SysJobCounter decoded;          // Decode job completion
+        SysJobCounter ready;            // Mipmaps job completion
+        uint64_t key;                   // Assets cache key (0 uncached)
+        bool cached;                    // Loaded from the assets cache
+
+        KTXFile ktxfile;                // Compressed texture file
+        bool compressed;                // Upload compressed mip levels
+        TextureFormat format;           // Decoded mip chain format
+        unsigned char* image;           // Decoded mip chain and cache info
+        uint32_t width;                 // Decoded width
+        uint32_t height;                // Decoded height
+        uint32_t mipLevels;             // Decoded mip levels
+        bool loaded;                    // Texture load state
     };
 
 
@@ -223,6 +316,15 @@
                 return m_texturesHigh[texture];
             }
 
+            ////////////////////////////////////////////////////////////////////
+            //  Get compressed formats supported by the graphics driver       //
+            //  return : Supported block formats mask (bit per block format)  //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getCompressedFormats() const
+            {
+                return m_blockFormats;
+            }
+
             ////////////////////////////////////////////////////////////////////
             //  Destroy texture loader                                        //
             ////////////////////////////////////////////////////////////////////
@@ -230,7 +332,12 @@
 
 
             ////////////////////////////////////////////////////////////////////
-            //  Load texture asynchronously and wait for callback             //
+            //  Load texture asynchronously                                   //
+            //  The texture is decoded as it is downloaded, interlaced PNG    //
+            //  textures are uploaded as a low resolution preview after the   //
+            //  first passes, and refined by each next pass                   //
+            //  Compressed textures (".ktx2") are loaded with the variant     //
+            //  supported by the graphics driver, or transcoded otherwise     //
             //  return : True if texture is loaded, false otherwise           //
             ////////////////////////////////////////////////////////////////////
             bool loadTextureAsync(Texture& texture, const char* path,
@@ -238,28 +345,63 @@
 
             ////////////////////////////////////////////////////////////////////
             //  Upload texture to graphics memory                             //
+            //  data holds dataLevels packed mip levels                       //
             //  return : True if texture is successfully uploaded             //
             ////////////////////////////////////////////////////////////////////
             bool uploadTexture(unsigned int& handle,
-                uint32_t width, uint32_t height, uint32_t mipLevels,
-                const unsigned char* data,
+                uint32_t width, uint32_t height,
+                uint32_t mipLevels, uint32_t dataLevels,
+                const unsigned char* data, TextureFormat format,
+                bool smooth, TextureRepeatMode repeat);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Upload compressed texture to graphics memory                  //
+            //  mipLevels compressed mip levels are uploaded from first level //
+            //  return : True if texture is successfully uploaded             //
+            ////////////////////////////////////////////////////////////////////
+            bool uploadCompressedTexture(unsigned int& handle,
+                const KTXFile& ktxfile, uint32_t first, uint32_t mipLevels,
                 bool smooth, TextureRepeatMode repeat);
 
+            ////////////////////////////////////////////////////////////////////
+            //  Update texture data in graphics memory                        //
+            //  data holds dataLevels packed mip levels                       //
+            //  return : True if texture is successfully updated              //
+            ////////////////////////////////////////////////////////////////////
+            bool updateTexture(unsigned int& handle,
+                uint32_t width, uint32_t height,
+                uint32_t mipLevels, uint32_t dataLevels,
+                const unsigned char* data, TextureFormat format);
+
             ////////////////////////////////////////////////////////////////////
             //  Generate texture mipmaps                                      //
+            //  Only the mip levels missing from the data are generated       //
             //  return : True if texture mipmaps are generated                //
             ////////////////////////////////////////////////////////////////////
             bool generateTextureMipmaps(unsigned int& handle,
-                uint32_t width, uint32_t height, uint32_t mipLevels);
+                uint32_t width, uint32_t height,
+                uint32_t mipLevels, uint32_t dataLevels);
 
 
         private:
+            ////////////////////////////////////////////////////////////////////
+            //  Set bound texture sampling parameters                         //
+            ////////////////////////////////////////////////////////////////////
+            void setTextureParameters(bool smooth, TextureRepeatMode repeat);
+
             ////////////////////////////////////////////////////////////////////
             //  Load embedded textures                                        //
             //  return : True if embedded textures are successfully loaded    //
             ////////////////////////////////////////////////////////////////////
             bool loadEmbeddedTextures();
 
+            ////////////////////////////////////////////////////////////////////
+            //  Load textures with the job scheduler                          //
+            //  Textures are uploaded in order, as soon as each one is ready  //
+            //  return : True if every texture is successfully loaded         //
+            ////////////////////////////////////////////////////////////////////
+            bool loadTexturesJobs(TextureLoaderJob* jobs, uint32_t count);
+
             ////////////////////////////////////////////////////////////////////
             //  Preload textures assets                                       //
             //  return : True if textures assets are preloaded                //
@@ -291,6 +433,10 @@
 
             Texture*                m_texturesGUI;      // GUI textures
             Texture*                m_texturesHigh;     // High textures
+
+            PNGFile                 m_pngFile;          // Pooled PNG decoder
+            unsigned char*          m_decodeBlock;      // Pooled decode block
+            uint32_t                m_blockFormats;     // Supported GPU formats
     };
 
 
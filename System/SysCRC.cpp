@@ -0,0 +1,465 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     System/SysCRC.cpp : System CRC management                              //
+////////////////////////////////////////////////////////////////////////////////
+#include "SysCRC.h"
+
+#if defined(WOS_X86)
+    #include <immintrin.h>
+#endif
+#if defined(WOS_NEON)
+    #include <arm_neon.h>
+#endif
+#if defined(WOS_ARMCRC32)
+    #include <arm_acle.h>
+#endif
+#if defined(WOS_WASMSIMD)
+    #include <wasm_simd128.h>
+#endif
+
+
+#if defined(WOS_X86)
+////////////////////////////////////////////////////////////////////////////////
+//  CRC32 carry-less multiply folding constants                               //
+////////////////////////////////////////////////////////////////////////////////
+alignas(16) static const uint64_t SysCRC32FoldK1K2[2] =
+    { 0x0154442BD4ull, 0x01C6E41596ull };
+alignas(16) static const uint64_t SysCRC32FoldK3K4[2] =
+    { 0x01751997D0ull, 0x00CCAA009Eull };
+alignas(16) static const uint64_t SysCRC32FoldK5K0[2] =
+    { 0x0163CD6124ull, 0x0000000000ull };
+alignas(16) static const uint64_t SysCRC32FoldPoly[2] =
+    { 0x01DB710641ull, 0x01F7011641ull };
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check if the CPU supports carry-less multiply CRC32 folding               //
+//  return : True if PCLMULQDQ and SSE4.1 are supported                       //
+////////////////////////////////////////////////////////////////////////////////
+static bool SysCRC32FoldSupported()
+{
+    static const bool supported = (
+        __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")
+    );
+    return supported;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Update CRC32 with carry-less multiply folding                             //
+//  size must be at least 64 bytes and a multiple of 16 bytes                 //
+//  return : Updated CRC32                                                    //
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t SysUpdateCRC32Fold(
+    uint32_t crc, const unsigned char* buffer, size_t size)
+{
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    __m128i y5, y6, y7, y8;
+
+    // Load first 64 bytes and xor initial CRC32
+    x1 = _mm_loadu_si128((const __m128i*)(buffer + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*)(buffer + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*)(buffer + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*)(buffer + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    x0 = _mm_load_si128((const __m128i*)SysCRC32FoldK1K2);
+    buffer += 64;
+    size -= 64;
+
+    // Fold 4x128 bits in parallel
+    while (size >= 64)
+    {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        y5 = _mm_loadu_si128((const __m128i*)(buffer + 0x00));
+        y6 = _mm_loadu_si128((const __m128i*)(buffer + 0x10));
+        y7 = _mm_loadu_si128((const __m128i*)(buffer + 0x20));
+        y8 = _mm_loadu_si128((const __m128i*)(buffer + 0x30));
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+        buffer += 64;
+        size -= 64;
+    }
+
+    // Fold 4x128 bits into 128 bits
+    x0 = _mm_load_si128((const __m128i*)SysCRC32FoldK3K4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // Fold remaining 128 bits blocks
+    while (size >= 16)
+    {
+        x2 = _mm_loadu_si128((const __m128i*)buffer);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        buffer += 16;
+        size -= 16;
+    }
+
+    // Fold 128 bits into 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+    x0 = _mm_loadl_epi64((const __m128i*)SysCRC32FoldK5K0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128((const __m128i*)SysCRC32FoldPoly);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+#endif // WOS_X86
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Update CRC32 with bytes from a buffer                                     //
+//  return : Updated CRC32                                                    //
+////////////////////////////////////////////////////////////////////////////////
+uint32_t SysUpdateCRC32(uint32_t crc, const unsigned char* buffer, size_t size)
+{
+    #if defined(WOS_X86)
+        // Carry-less multiply folding over 16 bytes blocks
+        if ((size >= SysCRC32FoldMinSize) && SysCRC32FoldSupported())
+        {
+            size_t foldSize = (size & ~((size_t)15));
+            crc = SysUpdateCRC32Fold(crc, buffer, foldSize);
+            buffer += foldSize;
+            size -= foldSize;
+        }
+    #elif defined(WOS_ARMCRC32)
+        // ARMv8 CRC32 instructions
+        while (size >= 8)
+        {
+            uint64_t word = 0;
+            memcpy(&word, buffer, 8);
+            crc = __crc32d(crc, word);
+            buffer += 8;
+            size -= 8;
+        }
+        while (size > 0)
+        {
+            crc = __crc32b(crc, *buffer++);
+            --size;
+        }
+        return crc;
+    #endif
+
+    // Slice-by-16 tables (WebAssembly and fallback path)
+    return SysUpdateCRC32Slices(crc, buffer, size);
+}
+
+
+#if defined(WOS_X86)
+////////////////////////////////////////////////////////////////////////////////
+//  Check if the CPU supports SSSE3 Adler32                                   //
+//  return : True if SSSE3 is supported                                       //
+////////////////////////////////////////////////////////////////////////////////
+static bool SysAdler32SSSE3Supported()
+{
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Update Adler32 with SSSE3 over 32 bytes blocks                            //
+//  return : Updated Adler32                                                  //
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("ssse3")))
+static uint32_t SysUpdateAdler32SSSE3(
+    uint32_t adler32, const unsigned char* buffer, size_t blocks)
+{
+    uint32_t s1 = (adler32 & 0x0000FFFF);
+    uint32_t s2 = (adler32 & 0xFFFF0000) >> 16;
+    const __m128i tap1 = _mm_setr_epi8(
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17
+    );
+    const __m128i tap2 = _mm_setr_epi8(
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
+    );
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    while (blocks > 0)
+    {
+        // Defer modulo until the sums could overflow
+        size_t n = (SysAdler32NMax / SysAdler32BlockSize);
+        if (n > blocks) { n = blocks; }
+        blocks -= n;
+
+        // Previous s1 sums are added 32 times per block
+        __m128i vps = _mm_set_epi32(0, 0, 0, (int)(s1*n));
+        __m128i vs1 = _mm_setzero_si128();
+        __m128i vs2 = _mm_set_epi32(0, 0, 0, (int)s2);
+        do
+        {
+            __m128i bytes1 = _mm_loadu_si128((const __m128i*)buffer);
+            __m128i bytes2 = _mm_loadu_si128((const __m128i*)(buffer+16));
+            vps = _mm_add_epi32(vps, vs1);
+
+            // Bytes sums and weighted sums
+            vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(bytes1, zero));
+            vs2 = _mm_add_epi32(vs2,
+                _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones)
+            );
+            vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(bytes2, zero));
+            vs2 = _mm_add_epi32(vs2,
+                _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones)
+            );
+            buffer += SysAdler32BlockSize;
+        } while (--n);
+        vs2 = _mm_add_epi32(vs2, _mm_slli_epi32(vps, 5));
+
+        // Horizontal sums
+        vs1 = _mm_add_epi32(vs1, _mm_shuffle_epi32(vs1, _MM_SHUFFLE(2,3,0,1)));
+        vs1 = _mm_add_epi32(vs1, _mm_shuffle_epi32(vs1, _MM_SHUFFLE(1,0,3,2)));
+        vs2 = _mm_add_epi32(vs2, _mm_shuffle_epi32(vs2, _MM_SHUFFLE(2,3,0,1)));
+        vs2 = _mm_add_epi32(vs2, _mm_shuffle_epi32(vs2, _MM_SHUFFLE(1,0,3,2)));
+        s1 += (uint32_t)_mm_cvtsi128_si32(vs1);
+        s2 = (uint32_t)_mm_cvtsi128_si32(vs2);
+        s1 %= SysAdler32Base;
+        s2 %= SysAdler32Base;
+    }
+    return ((s2 << 16) | s1);
+}
+#endif // WOS_X86
+
+#if defined(WOS_NEON)
+////////////////////////////////////////////////////////////////////////////////
+//  Update Adler32 with NEON over 32 bytes blocks                             //
+//  return : Updated Adler32                                                  //
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t SysUpdateAdler32NEON(
+    uint32_t adler32, const unsigned char* buffer, size_t blocks)
+{
+    uint32_t s1 = (adler32 & 0x0000FFFF);
+    uint32_t s2 = (adler32 & 0xFFFF0000) >> 16;
+    static const uint16_t taps[32] = {
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
+    };
+
+    while (blocks > 0)
+    {
+        // Defer modulo until the sums could overflow
+        size_t n = (SysAdler32NMax / SysAdler32BlockSize);
+        if (n > blocks) { n = blocks; }
+        blocks -= n;
+
+        // Previous s1 sums are added 32 times per block
+        uint32x4_t vs2 = vsetq_lane_u32((uint32_t)(s1*n), vdupq_n_u32(0), 0);
+        uint32x4_t vs1 = vdupq_n_u32(0);
+        uint16x8_t columns1 = vdupq_n_u16(0);
+        uint16x8_t columns2 = vdupq_n_u16(0);
+        uint16x8_t columns3 = vdupq_n_u16(0);
+        uint16x8_t columns4 = vdupq_n_u16(0);
+        do
+        {
+            uint8x16_t bytes1 = vld1q_u8(buffer);
+            uint8x16_t bytes2 = vld1q_u8(buffer+16);
+            vs2 = vaddq_u32(vs2, vs1);
+            vs1 = vpadalq_u16(vs1, vpadalq_u8(vpaddlq_u8(bytes1), bytes2));
+            columns1 = vaddw_u8(columns1, vget_low_u8(bytes1));
+            columns2 = vaddw_u8(columns2, vget_high_u8(bytes1));
+            columns3 = vaddw_u8(columns3, vget_low_u8(bytes2));
+            columns4 = vaddw_u8(columns4, vget_high_u8(bytes2));
+            buffer += SysAdler32BlockSize;
+        } while (--n);
+        vs2 = vshlq_n_u32(vs2, 5);
+
+        // Weighted column sums
+        vs2 = vmlal_u16(vs2, vget_low_u16(columns1), vld1_u16(&taps[0]));
+        vs2 = vmlal_u16(vs2, vget_high_u16(columns1), vld1_u16(&taps[4]));
+        vs2 = vmlal_u16(vs2, vget_low_u16(columns2), vld1_u16(&taps[8]));
+        vs2 = vmlal_u16(vs2, vget_high_u16(columns2), vld1_u16(&taps[12]));
+        vs2 = vmlal_u16(vs2, vget_low_u16(columns3), vld1_u16(&taps[16]));
+        vs2 = vmlal_u16(vs2, vget_high_u16(columns3), vld1_u16(&taps[20]));
+        vs2 = vmlal_u16(vs2, vget_low_u16(columns4), vld1_u16(&taps[24]));
+        vs2 = vmlal_u16(vs2, vget_high_u16(columns4), vld1_u16(&taps[28]));
+
+        // Horizontal sums
+        uint32x2_t sum1 = vpadd_u32(vget_low_u32(vs1), vget_high_u32(vs1));
+        uint32x2_t sum2 = vpadd_u32(vget_low_u32(vs2), vget_high_u32(vs2));
+        uint32x2_t sums = vpadd_u32(sum1, sum2);
+        s1 += vget_lane_u32(sums, 0);
+        s2 += vget_lane_u32(sums, 1);
+        s1 %= SysAdler32Base;
+        s2 %= SysAdler32Base;
+    }
+    return ((s2 << 16) | s1);
+}
+#endif // WOS_NEON
+
+#if defined(WOS_WASMSIMD)
+////////////////////////////////////////////////////////////////////////////////
+//  Update Adler32 with WebAssembly simd128 over 32 bytes blocks              //
+//  return : Updated Adler32                                                  //
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t SysUpdateAdler32WasmSIMD(
+    uint32_t adler32, const unsigned char* buffer, size_t blocks)
+{
+    uint32_t s1 = (adler32 & 0x0000FFFF);
+    uint32_t s2 = (adler32 & 0xFFFF0000) >> 16;
+    const v128_t tap1 = wasm_u16x8_make(32, 31, 30, 29, 28, 27, 26, 25);
+    const v128_t tap2 = wasm_u16x8_make(24, 23, 22, 21, 20, 19, 18, 17);
+    const v128_t tap3 = wasm_u16x8_make(16, 15, 14, 13, 12, 11, 10, 9);
+    const v128_t tap4 = wasm_u16x8_make(8, 7, 6, 5, 4, 3, 2, 1);
+
+    while (blocks > 0)
+    {
+        // Defer modulo until the sums could overflow
+        size_t n = (SysAdler32NMax / SysAdler32BlockSize);
+        if (n > blocks) { n = blocks; }
+        blocks -= n;
+
+        // Previous s1 sums are added 32 times per block
+        v128_t vps = wasm_i32x4_make((int32_t)(s1*n), 0, 0, 0);
+        v128_t vs1 = wasm_i32x4_splat(0);
+        v128_t columns1 = wasm_i16x8_splat(0);
+        v128_t columns2 = wasm_i16x8_splat(0);
+        v128_t columns3 = wasm_i16x8_splat(0);
+        v128_t columns4 = wasm_i16x8_splat(0);
+        do
+        {
+            v128_t bytes1 = wasm_v128_load(buffer);
+            v128_t bytes2 = wasm_v128_load(buffer+16);
+            vps = wasm_i32x4_add(vps, vs1);
+            vs1 = wasm_i32x4_add(vs1, wasm_u32x4_extadd_pairwise_u16x8(
+                wasm_i16x8_add(
+                    wasm_u16x8_extadd_pairwise_u8x16(bytes1),
+                    wasm_u16x8_extadd_pairwise_u8x16(bytes2)
+                )
+            ));
+            columns1 = wasm_i16x8_add(
+                columns1, wasm_u16x8_extend_low_u8x16(bytes1)
+            );
+            columns2 = wasm_i16x8_add(
+                columns2, wasm_u16x8_extend_high_u8x16(bytes1)
+            );
+            columns3 = wasm_i16x8_add(
+                columns3, wasm_u16x8_extend_low_u8x16(bytes2)
+            );
+            columns4 = wasm_i16x8_add(
+                columns4, wasm_u16x8_extend_high_u8x16(bytes2)
+            );
+            buffer += SysAdler32BlockSize;
+        } while (--n);
+        v128_t vs2 = wasm_i32x4_shl(vps, 5);
+
+        // Weighted column sums
+        vs2 = wasm_i32x4_add(vs2, wasm_u32x4_extmul_low_u16x8(columns1, tap1));
+        vs2 = wasm_i32x4_add(vs2, wasm_u32x4_extmul_high_u16x8(columns1, tap1));
+        vs2 = wasm_i32x4_add(vs2, wasm_u32x4_extmul_low_u16x8(columns2, tap2));
+        vs2 = wasm_i32x4_add(vs2, wasm_u32x4_extmul_high_u16x8(columns2, tap2));
+        vs2 = wasm_i32x4_add(vs2, wasm_u32x4_extmul_low_u16x8(columns3, tap3));
+        vs2 = wasm_i32x4_add(vs2, wasm_u32x4_extmul_high_u16x8(columns3, tap3));
+        vs2 = wasm_i32x4_add(vs2, wasm_u32x4_extmul_low_u16x8(columns4, tap4));
+        vs2 = wasm_i32x4_add(vs2, wasm_u32x4_extmul_high_u16x8(columns4, tap4));
+
+        // Horizontal sums
+        s1 += (uint32_t)wasm_i32x4_extract_lane(vs1, 0);
+        s1 += (uint32_t)wasm_i32x4_extract_lane(vs1, 1);
+        s1 += (uint32_t)wasm_i32x4_extract_lane(vs1, 2);
+        s1 += (uint32_t)wasm_i32x4_extract_lane(vs1, 3);
+        s2 += (uint32_t)wasm_i32x4_extract_lane(vs2, 0);
+        s2 += (uint32_t)wasm_i32x4_extract_lane(vs2, 1);
+        s2 += (uint32_t)wasm_i32x4_extract_lane(vs2, 2);
+        s2 += (uint32_t)wasm_i32x4_extract_lane(vs2, 3);
+        s1 %= SysAdler32Base;
+        s2 %= SysAdler32Base;
+    }
+    return ((s2 << 16) | s1);
+}
+#endif // WOS_WASMSIMD
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Update Adler32 with bytes from a buffer                                   //
+//  return : Updated Adler32                                                  //
+////////////////////////////////////////////////////////////////////////////////
+uint32_t SysUpdateAdler32(
+    uint32_t adler32, const unsigned char* buffer, size_t size)
+{
+    size_t blocks = (size / SysAdler32BlockSize);
+    if (blocks > 0)
+    {
+        #if defined(WOS_X86)
+            if (SysAdler32SSSE3Supported())
+            {
+                adler32 = SysUpdateAdler32SSSE3(adler32, buffer, blocks);
+                buffer += (blocks*SysAdler32BlockSize);
+                size -= (blocks*SysAdler32BlockSize);
+            }
+        #elif defined(WOS_NEON)
+            adler32 = SysUpdateAdler32NEON(adler32, buffer, blocks);
+            buffer += (blocks*SysAdler32BlockSize);
+            size -= (blocks*SysAdler32BlockSize);
+        #elif defined(WOS_WASMSIMD)
+            adler32 = SysUpdateAdler32WasmSIMD(adler32, buffer, blocks);
+            buffer += (blocks*SysAdler32BlockSize);
+            size -= (blocks*SysAdler32BlockSize);
+        #endif
+    }
+
+    // Remaining bytes (and scalar fallback path)
+    return SysUpdateAdler32Scalar(adler32, buffer, size);
+}
@@ -46,6 +46,7 @@
 
     #include <cstddef>
     #include <cstdint>
+    #include <cstring>
 
 
     ////////////////////////////////////////////////////////////////////////////
@@ -126,12 +127,106 @@
     const uint32_t SysCRC32Final = 0xFFFFFFFFu;
 
     ////////////////////////////////////////////////////////////////////////////
-    //  Update CRC32 with bytes from a buffer                                 //
+    //  CRC32 reversed polynomial                                             //
+    ////////////////////////////////////////////////////////////////////////////
+    const uint32_t SysCRC32Polynomial = 0xEDB88320u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  CRC32 minimum buffer size for the carry-less multiply folding path    //
+    ////////////////////////////////////////////////////////////////////////////
+    const size_t SysCRC32FoldMinSize = 64;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  CRC32 slice tables                                                    //
+    //  table[k][i] is the CRC32 of byte i followed by k zero bytes           //
+    ////////////////////////////////////////////////////////////////////////////
+    struct SysCRC32SliceTables
+    {
+        uint32_t table[16][256];
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Build CRC32 slice tables                                              //
+    //  return : Built CRC32 slice tables                                     //
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr SysCRC32SliceTables SysCRC32BuildSlices()
+    {
+        SysCRC32SliceTables slices = {};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            slices.table[0][i] = SysCRC32Table[i];
+        }
+        for (uint32_t k = 1; k < 16; ++k)
+        {
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t crc = slices.table[k-1][i];
+                slices.table[k][i] = (crc >> 8) ^ SysCRC32Table[crc & 0xFF];
+            }
+        }
+        return slices;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  CRC32 slice-by-16 tables                                              //
+    ////////////////////////////////////////////////////////////////////////////
+    inline constexpr SysCRC32SliceTables SysCRC32Slices =
+        SysCRC32BuildSlices();
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Update CRC32 with bytes from a buffer (slice-by-16 and slice-by-8)    //
     //  return : Updated CRC32                                                //
     ////////////////////////////////////////////////////////////////////////////
-    inline uint32_t SysUpdateCRC32(
-        uint32_t crc, unsigned char* buffer, size_t size)
+    inline uint32_t SysUpdateCRC32Slices(
+        uint32_t crc, const unsigned char* buffer, size_t size)
     {
+        const uint32_t (*table)[256] = SysCRC32Slices.table;
+
+        // Slice-by-16
+        while (size >= 16)
+        {
+            uint32_t words[4];
+            memcpy(words, buffer, 16);
+            words[0] ^= crc;
+            crc = table[15][words[0] & 0xFF] ^
+                table[14][(words[0] >> 8) & 0xFF] ^
+                table[13][(words[0] >> 16) & 0xFF] ^
+                table[12][words[0] >> 24] ^
+                table[11][words[1] & 0xFF] ^
+                table[10][(words[1] >> 8) & 0xFF] ^
+                table[9][(words[1] >> 16) & 0xFF] ^
+                table[8][words[1] >> 24] ^
+                table[7][words[2] & 0xFF] ^
+                table[6][(words[2] >> 8) & 0xFF] ^
+                table[5][(words[2] >> 16) & 0xFF] ^
+                table[4][words[2] >> 24] ^
+                table[3][words[3] & 0xFF] ^
+                table[2][(words[3] >> 8) & 0xFF] ^
+                table[1][(words[3] >> 16) & 0xFF] ^
+                table[0][words[3] >> 24];
+            buffer += 16;
+            size -= 16;
+        }
+
+        // Slice-by-8
+        if (size >= 8)
+        {
+            uint32_t words[2];
+            memcpy(words, buffer, 8);
+            words[0] ^= crc;
+            crc = table[7][words[0] & 0xFF] ^
+                table[6][(words[0] >> 8) & 0xFF] ^
+                table[5][(words[0] >> 16) & 0xFF] ^
+                table[4][words[0] >> 24] ^
+                table[3][words[1] & 0xFF] ^
+                table[2][(words[1] >> 8) & 0xFF] ^
+                table[1][(words[1] >> 16) & 0xFF] ^
+                table[0][words[1] >> 24];
+            buffer += 8;
+            size -= 8;
+        }
+
+        // Remaining bytes
         for (size_t i = 0; i < size; ++i)
         {
             crc = SysCRC32Table[(crc^buffer[i]) & 0xFF] ^ (crc >> 8);
@@ -139,15 +234,97 @@
         return crc;
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  Update CRC32 with bytes from a buffer                                 //
+    //  Uses carry-less multiply folding when the CPU supports it             //
+    //  return : Updated CRC32                                                //
+    ////////////////////////////////////////////////////////////////////////////
+    uint32_t SysUpdateCRC32(
+        uint32_t crc, const unsigned char* buffer, size_t size);
+
     ////////////////////////////////////////////////////////////////////////////
     //  Compute CRC32 with bytes from a buffer                                //
     //  return : Computed CRC32                                               //
     ////////////////////////////////////////////////////////////////////////////
-    inline uint32_t SysCRC32(unsigned char* buffer, size_t size)
+    inline uint32_t SysCRC32(const unsigned char* buffer, size_t size)
     {
         return (SysUpdateCRC32(SysCRC32Default, buffer, size) ^ SysCRC32Final);
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  Multiply two polynomials modulo the CRC32 polynomial                  //
+    //  return : Product of a and b modulo the CRC32 polynomial               //
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr uint32_t SysCRC32MultModP(uint32_t a, uint32_t b)
+    {
+        uint32_t m = 0x80000000u;
+        uint32_t p = 0;
+        while (m)
+        {
+            if (a & m)
+            {
+                p ^= b;
+                if ((a & (m-1)) == 0) { break; }
+            }
+            m >>= 1;
+            b = (b & 1) ? ((b >> 1) ^ SysCRC32Polynomial) : (b >> 1);
+        }
+        return p;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  CRC32 x^(2^n) modulo polynomial table                                 //
+    ////////////////////////////////////////////////////////////////////////////
+    struct SysCRC32PowerTable
+    {
+        uint32_t table[32];
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Build CRC32 x^(2^n) modulo polynomial table                           //
+    //  return : Built CRC32 power table                                      //
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr SysCRC32PowerTable SysCRC32BuildPowers()
+    {
+        SysCRC32PowerTable powers = {};
+        uint32_t p = 0x40000000u;
+        powers.table[0] = p;
+        for (uint32_t n = 1; n < 32; ++n)
+        {
+            p = SysCRC32MultModP(p, p);
+            powers.table[n] = p;
+        }
+        return powers;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  CRC32 x^(2^n) modulo polynomial powers                                //
+    ////////////////////////////////////////////////////////////////////////////
+    inline constexpr SysCRC32PowerTable SysCRC32Powers = SysCRC32BuildPowers();
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Combine CRC32 of two consecutive buffers                              //
+    //  return : CRC32 of the first buffer followed by the second buffer      //
+    ////////////////////////////////////////////////////////////////////////////
+    inline uint32_t SysCRC32Combine(uint32_t crc1, uint32_t crc2, size_t size2)
+    {
+        // Compute x^(8*size2) modulo the polynomial
+        uint32_t p = 0x80000000u;
+        uint32_t k = 3;
+        while (size2)
+        {
+            if (size2 & 1)
+            {
+                p = SysCRC32MultModP(SysCRC32Powers.table[k & 31], p);
+            }
+            size2 >>= 1;
+            ++k;
+        }
+
+        // Shift the first CRC32 over the second buffer
+        return (SysCRC32MultModP(p, crc1) ^ crc2);
+    }
+
 
     ////////////////////////////////////////////////////////////////////////////
     //  Adler32 default value                                                 //
@@ -155,30 +332,93 @@
     const uint32_t SysAdler32Default = 0x00000001u;
 
     ////////////////////////////////////////////////////////////////////////////
-    //  Update Adler32 with bytes from a buffer                               //
+    //  Adler32 max bytes count before the sums overflow : 5552               //
+    ////////////////////////////////////////////////////////////////////////////
+    const size_t SysAdler32NMax = 5552;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Adler32 modulo : 65521                                                //
+    ////////////////////////////////////////////////////////////////////////////
+    const uint32_t SysAdler32Base = 65521;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Adler32 SIMD block size                                               //
+    ////////////////////////////////////////////////////////////////////////////
+    const size_t SysAdler32BlockSize = 32;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  Update Adler32 with bytes from a buffer (scalar path)                 //
     //  return : Updated Adler32                                              //
     ////////////////////////////////////////////////////////////////////////////
-    inline uint32_t SysUpdateAdler32(
-        uint32_t adler32, unsigned char* buffer, size_t size)
+    inline uint32_t SysUpdateAdler32Scalar(
+        uint32_t adler32, const unsigned char* buffer, size_t size)
     {
         uint32_t a = (adler32 & 0x0000FFFF);
         uint32_t b = (adler32 & 0xFFFF0000) >> 16;
-        for (size_t i = 0; i < size; ++i)
+        while (size > 0)
         {
-            a = (a + buffer[i]) % 65521;
-            b = (a + b) % 65521;
+            // Defer modulo until the sums could overflow
+            size_t block = (size < SysAdler32NMax) ? size : SysAdler32NMax;
+            size -= block;
+            for (; block >= 16; block -= 16)
+            {
+                a += buffer[0]; b += a; a += buffer[1]; b += a;
+                a += buffer[2]; b += a; a += buffer[3]; b += a;
+                a += buffer[4]; b += a; a += buffer[5]; b += a;
+                a += buffer[6]; b += a; a += buffer[7]; b += a;
+                a += buffer[8]; b += a; a += buffer[9]; b += a;
+                a += buffer[10]; b += a; a += buffer[11]; b += a;
+                a += buffer[12]; b += a; a += buffer[13]; b += a;
+                a += buffer[14]; b += a; a += buffer[15]; b += a;
+                buffer += 16;
+            }
+            for (; block > 0; --block)
+            {
+                a += *buffer++;
+                b += a;
+            }
+            a %= SysAdler32Base;
+            b %= SysAdler32Base;
         }
         return ((b << 16) | a);
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  Update Adler32 with bytes from a buffer                               //
+    //  Uses SSSE3, NEON or WebAssembly simd128 when available                //
+    //  return : Updated Adler32                                              //
+    ////////////////////////////////////////////////////////////////////////////
+    uint32_t SysUpdateAdler32(
+        uint32_t adler32, const unsigned char* buffer, size_t size);
+
     ////////////////////////////////////////////////////////////////////////////
     //  Compute Adler32 with bytes from a buffer                              //
     //  return : Computed Adler32                                             //
     ////////////////////////////////////////////////////////////////////////////
-    inline uint32_t SysAdler32(unsigned char* buffer, size_t size)
+    inline uint32_t SysAdler32(const unsigned char* buffer, size_t size)
     {
         return SysUpdateAdler32(SysAdler32Default, buffer, size);
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  Combine Adler32 of two consecutive buffers                            //
+    //  return : Adler32 of the first buffer followed by the second buffer    //
+    ////////////////////////////////////////////////////////////////////////////
+    inline uint32_t SysAdler32Combine(
+        uint32_t adler1, uint32_t adler2, size_t size2)
+    {
+        uint32_t rem = (uint32_t)(size2 % SysAdler32Base);
+        uint32_t a = (adler1 & 0x0000FFFF);
+        uint32_t b = ((rem * a) % SysAdler32Base);
+        a += ((adler2 & 0x0000FFFF) + SysAdler32Base - 1);
+        b += (((adler1 >> 16) & 0x0000FFFF) +
+            ((adler2 >> 16) & 0x0000FFFF) + SysAdler32Base - rem);
+        if (a >= SysAdler32Base) { a -= SysAdler32Base; }
+        if (a >= SysAdler32Base) { a -= SysAdler32Base; }
+        if (b >= (SysAdler32Base << 1)) { b -= (SysAdler32Base << 1); }
+        if (b >= SysAdler32Base) { b -= SysAdler32Base; }
+        return ((b << 16) | a);
+    }
+
 
 #endif // WOS_SYSTEM_SYSCRC_HEADER
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     System/SysCondition.h : System condition variable                      //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_SYSTEM_SYSCONDITION_HEADER
+#define WOS_SYSTEM_SYSCONDITION_HEADER
+
+    #include "System.h"
+    #include "SysMutex.h"
+
+    #include <condition_variable>
+    #include <chrono>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysCondition class definition                                         //
+    //  The mutex must be locked by the calling thread when waiting, it is    //
+    //  released during the wait and locked again before returning            //
+    ////////////////////////////////////////////////////////////////////////////
+    class SysCondition
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  SysCondition default constructor                              //
+            ////////////////////////////////////////////////////////////////////
+            inline SysCondition() :
+            m_condition()
+            {
+
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysCondition destructor                                       //
+            ////////////////////////////////////////////////////////////////////
+            inline ~SysCondition()
+            {
+
+            }
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wait until the condition is notified                          //
+            ////////////////////////////////////////////////////////////////////
+            inline void wait(SysMutex& mutex)
+            {
+                m_condition.wait(mutex);
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wait until the condition is notified or seconds elapsed       //
+            //  return : True if the condition was notified before timeout    //
+            ////////////////////////////////////////////////////////////////////
+            inline bool waitFor(SysMutex& mutex, double seconds)
+            {
+                return (m_condition.wait_for(mutex,
+                    std::chrono::duration<double>(seconds)) ==
+                    std::cv_status::no_timeout
+                );
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wake up one waiting thread                                    //
+            ////////////////////////////////////////////////////////////////////
+            inline void notify()
+            {
+                m_condition.notify_one();
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wake up every waiting thread                                  //
+            ////////////////////////////////////////////////////////////////////
+            inline void notifyAll()
+            {
+                m_condition.notify_all();
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  SysCondition private copy constructor : Not copyable          //
+            ////////////////////////////////////////////////////////////////////
+            SysCondition(const SysCondition&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysCondition private copy operator : Not copyable             //
+            ////////////////////////////////////////////////////////////////////
+            SysCondition& operator=(const SysCondition&) = delete;
+
+
+        private:
+            std::condition_variable_any m_condition;    // System condition
+    };
+
+
+#endif // WOS_SYSTEM_SYSCONDITION_HEADER
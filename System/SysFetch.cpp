@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     System/SysFetch.cpp : System asynchronous fetch                        //
+////////////////////////////////////////////////////////////////////////////////
+#include "SysFetch.h"
+
+
+#if defined(WOS_EMSCRIPTEN)
+////////////////////////////////////////////////////////////////////////////////
+//  Fetch progress callback function                                          //
+////////////////////////////////////////////////////////////////////////////////
+void OnSysFetchProgress(emscripten_fetch_t* fetch)
+{
+    // Get fetch
+    SysFetch* sysFetch = (SysFetch*)fetch->userData;
+    if (!sysFetch || !fetch->data || (fetch->numBytes <= 0)) { return; }
+
+    // Append streamed data (failures are reported on completion)
+    sysFetch->appendData(fetch->data,
+        static_cast<size_t>(fetch->numBytes),
+        static_cast<size_t>(fetch->totalBytes)
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Fetch loaded callback function                                            //
+////////////////////////////////////////////////////////////////////////////////
+void OnSysFetchLoaded(emscripten_fetch_t* fetch)
+{
+    // Get fetch
+    SysFetch* sysFetch = (SysFetch*)fetch->userData;
+    if (!sysFetch) { emscripten_fetch_close(fetch); return; }
+
+    // Data were not streamed (no streaming support in the browser)
+    // Data are only appended on the main thread, size can be read here
+    if ((sysFetch->getSize() <= 0) && fetch->data && (fetch->numBytes > 0))
+    {
+        sysFetch->appendData(
+            fetch->data, static_cast<size_t>(fetch->numBytes), 0
+        );
+    }
+    emscripten_fetch_close(fetch);
+    sysFetch->complete(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Fetch error callback function                                             //
+////////////////////////////////////////////////////////////////////////////////
+void OnSysFetchError(emscripten_fetch_t* fetch)
+{
+    // Get fetch
+    SysFetch* sysFetch = (SysFetch*)fetch->userData;
+    emscripten_fetch_close(fetch);
+    if (sysFetch) { sysFetch->complete(false); }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Fetch start function (called on the main thread)                          //
+////////////////////////////////////////////////////////////////////////////////
+void OnSysFetchStart(void* arg)
+{
+    // Get fetch
+    SysFetch* sysFetch = (SysFetch*)arg;
+    if (!sysFetch) { return; }
+
+    // Stream fetch data
+    emscripten_fetch_attr_t attributes;
+    emscripten_fetch_attr_init(&attributes);
+    strcpy(attributes.requestMethod, "GET");
+    attributes.attributes =
+        (EMSCRIPTEN_FETCH_LOAD_TO_MEMORY | EMSCRIPTEN_FETCH_STREAM_DATA);
+    attributes.userData = arg;
+    attributes.onsuccess = OnSysFetchLoaded;
+    attributes.onprogress = OnSysFetchProgress;
+    attributes.onerror = OnSysFetchError;
+    if (!emscripten_fetch(&attributes, sysFetch->getPath()))
+    {
+        // Could not start fetch
+        sysFetch->complete(false);
+    }
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysFetch default constructor                                              //
+////////////////////////////////////////////////////////////////////////////////
+SysFetch::SysFetch() :
+m_mutex(),
+m_condition(),
+m_state(SYSFETCH_STATE_NONE),
+m_path(),
+m_data(0),
+m_size(0),
+m_capacity(0),
+m_failed(false),
+m_counter(0)
+#if !defined(WOS_EMSCRIPTEN)
+,m_thread(0)
+#endif
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysFetch destructor                                                       //
+////////////////////////////////////////////////////////////////////////////////
+SysFetch::~SysFetch()
+{
+    destroyFetch();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Start asynchronous fetch (returns immediately)                            //
+//  counter (optional) is incremented until the fetch completes               //
+//  return : True if the fetch is started                                     //
+////////////////////////////////////////////////////////////////////////////////
+bool SysFetch::start(const std::string& path, SysJobCounter* counter)
+{
+    // Wait for the previous fetch
+    destroyFetch();
+
+    // Reset fetch
+    if (counter) { counter->increment(); }
+    m_mutex.lock();
+    m_path = path;
+    m_failed = false;
+    m_counter = counter;
+    m_state = SYSFETCH_STATE_LOADING;
+    m_mutex.unlock();
+
+#if defined(WOS_EMSCRIPTEN)
+    // Fetch callbacks run on the main thread
+    emscripten_async_run_in_main_runtime_thread(
+        EM_FUNC_SIG_VI, (void*)OnSysFetchStart, (void*)this
+    );
+#else
+    // Read local file on a thread
+    m_thread = new (std::nothrow) std::thread(&SysFetch::readLocalFile, this);
+    if (!m_thread)
+    {
+        // Could not start local file thread
+        complete(false);
+        return false;
+    }
+#endif
+
+    // Fetch is started
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Wait for the fetch completion                                             //
+//  return : Fetch final state (LOADED or ERROR)                              //
+////////////////////////////////////////////////////////////////////////////////
+SysFetchState SysFetch::wait()
+{
+    m_mutex.lock();
+    while (m_state == SYSFETCH_STATE_LOADING)
+    {
+        m_condition.wait(m_mutex);
+    }
+    SysFetchState state = m_state;
+    m_mutex.unlock();
+    return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Wait for streamed data at offset and copy them                            //
+//  return : Number of bytes copied, 0 when the fetch is complete             //
+//           and no data remain after offset                                  //
+////////////////////////////////////////////////////////////////////////////////
+size_t SysFetch::read(size_t offset, unsigned char* data, size_t size)
+{
+    m_mutex.lock();
+    while ((m_state == SYSFETCH_STATE_LOADING) && (m_size <= offset))
+    {
+        m_condition.wait(m_mutex);
+    }
+    size_t copySize = 0;
+    if ((m_state != SYSFETCH_STATE_ERROR) && (m_size > offset))
+    {
+        copySize = (m_size - offset);
+        if (copySize > size) { copySize = size; }
+        memcpy(data, &m_data[offset], copySize);
+    }
+    m_mutex.unlock();
+    return copySize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get fetch current state                                                   //
+//  return : Fetch state                                                      //
+////////////////////////////////////////////////////////////////////////////////
+SysFetchState SysFetch::getState()
+{
+    m_mutex.lock();
+    SysFetchState state = m_state;
+    m_mutex.unlock();
+    return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Append received data (called by the fetch backend)                        //
+//  return : True if data are successfully appended                           //
+////////////////////////////////////////////////////////////////////////////////
+bool SysFetch::appendData(const char* data, size_t size, size_t totalSize)
+{
+    m_mutex.lock();
+
+    // Grow data memory
+    if ((m_size + size) > m_capacity)
+    {
+        size_t capacity = (m_capacity*2);
+        if (capacity < SysFetchBlockSize) { capacity = SysFetchBlockSize; }
+        if (capacity < totalSize) { capacity = totalSize; }
+        if (capacity < (m_size + size)) { capacity = (m_size + size); }
+        unsigned char* newData = new (std::nothrow) unsigned char[capacity];
+        if (!newData)
+        {
+            // Could not allocate data memory
+            m_failed = true;
+            m_mutex.unlock();
+            return false;
+        }
+        if (m_data)
+        {
+            memcpy(newData, m_data, m_size);
+            delete[] m_data;
+        }
+        m_data = newData;
+        m_capacity = capacity;
+    }
+
+    // Copy received data and wake up waiters
+    memcpy(&m_data[m_size], data, size);
+    m_size += size;
+    m_condition.notifyAll();
+    m_mutex.unlock();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Complete fetch and wake up waiters (called by the backend)                //
+////////////////////////////////////////////////////////////////////////////////
+void SysFetch::complete(bool loaded)
+{
+    SysJobCounter* counter = 0;
+    m_mutex.lock();
+    if (m_state == SYSFETCH_STATE_LOADING)
+    {
+        m_state = (loaded && !m_failed) ?
+            SYSFETCH_STATE_LOADED : SYSFETCH_STATE_ERROR;
+        counter = m_counter;
+        m_counter = 0;
+    }
+    m_condition.notifyAll();
+    m_mutex.unlock();
+
+    // Release the jobs waiting for the fetch (outside of the fetch lock)
+    if (counter) { counter->decrement(); }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Destroy fetch (waits for an eventual fetch in flight)                     //
+////////////////////////////////////////////////////////////////////////////////
+void SysFetch::destroyFetch()
+{
+    // Wait for the fetch in flight
+    wait();
+#if !defined(WOS_EMSCRIPTEN)
+    if (m_thread)
+    {
+        m_thread->join();
+        delete m_thread;
+    }
+    m_thread = 0;
+#endif
+
+    // Destroy fetched data
+    m_mutex.lock();
+    if (m_data) { delete[] m_data; }
+    m_failed = false;
+    m_counter = 0;
+    m_capacity = 0;
+    m_size = 0;
+    m_data = 0;
+    m_path.clear();
+    m_state = SYSFETCH_STATE_NONE;
+    m_mutex.unlock();
+}
+
+
+#if !defined(WOS_EMSCRIPTEN)
+////////////////////////////////////////////////////////////////////////////////
+//  Read local file (native stand-in thread)                                  //
+////////////////////////////////////////////////////////////////////////////////
+void SysFetch::readLocalFile()
+{
+    // Open local file
+    std::ifstream file;
+    file.open(m_path.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        // Could not open local file
+        complete(false);
+        return;
+    }
+
+    // Get local file size
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (fileSize < 0)
+    {
+        // Invalid local file size
+        complete(false);
+        return;
+    }
+
+    // Stream local file by blocks
+    char block[SysFetchBlockSize];
+    bool loaded = true;
+    while (loaded && file)
+    {
+        file.read(block, SysFetchBlockSize);
+        size_t blockSize = static_cast<size_t>(file.gcount());
+        if (blockSize <= 0) { break; }
+        loaded = appendData(block, blockSize, static_cast<size_t>(fileSize));
+    }
+    if (file.bad()) { loaded = false; }
+    complete(loaded);
+}
+#endif
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     System/SysFetch.h : System asynchronous fetch                          //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_SYSTEM_SYSFETCH_HEADER
+#define WOS_SYSTEM_SYSFETCH_HEADER
+
+    #include "System.h"
+    #include "SysMutex.h"
+    #include "SysCondition.h"
+    #include "SysJobs.h"
+
+    #if defined(WOS_EMSCRIPTEN)
+        #include <emscripten/fetch.h>
+        #include <emscripten/threading.h>
+    #else
+        #include <fstream>
+        #include <thread>
+    #endif
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <string>
+    #include <new>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysFetch settings                                                     //
+    ////////////////////////////////////////////////////////////////////////////
+    const size_t SysFetchBlockSize = 65536;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysFetchState enumeration                                             //
+    ////////////////////////////////////////////////////////////////////////////
+    enum SysFetchState
+    {
+        SYSFETCH_STATE_NONE = 0,
+        SYSFETCH_STATE_LOADING = 1,
+        SYSFETCH_STATE_LOADED = 2,
+        SYSFETCH_STATE_ERROR = 3
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysFetch class definition                                             //
+    //  One asynchronous download, any number of them can be in flight        //
+    //  Data are streamed into memory as they arrive, waiters are woken up    //
+    //  on each received block and on completion (no polling)                 //
+    //  Browser builds use emscripten fetch (started on the main thread),     //
+    //  native builds read the local file on a thread as a stand-in           //
+    //  A job counter can be released on completion, so that the jobs using   //
+    //  the data are run as soon as they arrive                               //
+    ////////////////////////////////////////////////////////////////////////////
+    class SysFetch
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  SysFetch default constructor                                  //
+            ////////////////////////////////////////////////////////////////////
+            SysFetch();
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysFetch destructor                                           //
+            ////////////////////////////////////////////////////////////////////
+            ~SysFetch();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Start asynchronous fetch (returns immediately)                //
+            //  counter (optional) is incremented until the fetch completes   //
+            //  return : True if the fetch is started                         //
+            ////////////////////////////////////////////////////////////////////
+            bool start(const std::string& path, SysJobCounter* counter = 0);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wait for the fetch completion                                 //
+            //  return : Fetch final state (LOADED or ERROR)                  //
+            ////////////////////////////////////////////////////////////////////
+            SysFetchState wait();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wait for streamed data at offset and copy them                //
+            //  return : Number of bytes copied, 0 when the fetch is complete //
+            //           and no data remain after offset                      //
+            ////////////////////////////////////////////////////////////////////
+            size_t read(size_t offset, unsigned char* data, size_t size);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get fetch current state                                       //
+            //  return : Fetch state                                          //
+            ////////////////////////////////////////////////////////////////////
+            SysFetchState getState();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Append received data (called by the fetch backend)            //
+            //  A failed append makes the fetch complete with ERROR           //
+            //  return : True if data are successfully appended               //
+            ////////////////////////////////////////////////////////////////////
+            bool appendData(const char* data, size_t size, size_t totalSize);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Complete fetch and wake up waiters (called by the backend)    //
+            ////////////////////////////////////////////////////////////////////
+            void complete(bool loaded);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Destroy fetch (waits for an eventual fetch in flight)         //
+            ////////////////////////////////////////////////////////////////////
+            void destroyFetch();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get fetch path                                                //
+            //  return : Fetched path                                         //
+            ////////////////////////////////////////////////////////////////////
+            inline const char* getPath() const
+            {
+                return m_path.c_str();
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get fetched data (once wait returned LOADED)                  //
+            //  return : Fetched data                                         //
+            ////////////////////////////////////////////////////////////////////
+            inline const unsigned char* getData() const
+            {
+                return m_data;
+            }
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get fetched data size (once wait returned LOADED)             //
+            //  return : Fetched data size in bytes                           //
+            ////////////////////////////////////////////////////////////////////
+            inline size_t getSize() const
+            {
+                return m_size;
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  SysFetch private copy constructor : Not copyable              //
+            ////////////////////////////////////////////////////////////////////
+            SysFetch(const SysFetch&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysFetch private copy operator : Not copyable                 //
+            ////////////////////////////////////////////////////////////////////
+            SysFetch& operator=(const SysFetch&) = delete;
+
+        #if !defined(WOS_EMSCRIPTEN)
+            ////////////////////////////////////////////////////////////////////
+            //  Read local file (native stand-in thread)                      //
+            ////////////////////////////////////////////////////////////////////
+            void readLocalFile();
+        #endif
+
+
+        private:
+            SysMutex                m_mutex;        // Fetch mutex
+            SysCondition            m_condition;    // Fetch data condition
+            SysFetchState           m_state;        // Fetch state
+            std::string             m_path;         // Fetched path
+            unsigned char*          m_data;         // Fetched data
+            size_t                  m_size;         // Fetched data size
+            size_t                  m_capacity;     // Fetched data capacity
+            bool                    m_failed;       // Data append failure
+            SysJobCounter*          m_counter;      // Completion job counter
+        #if !defined(WOS_EMSCRIPTEN)
+            std::thread*            m_thread;       // Local file thread
+        #endif
+    };
+
+
+#endif // WOS_SYSTEM_SYSFETCH_HEADER
@@ -0,0 +1,522 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     System/SysJobs.cpp : Work stealing job scheduler                       //
+////////////////////////////////////////////////////////////////////////////////
+#include "SysJobs.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobs global instance                                                   //
+////////////////////////////////////////////////////////////////////////////////
+SysJobs GSysJobs = SysJobs();
+
+////////////////////////////////////////////////////////////////////////////////
+//  Calling thread queue index (0 for the shared queue)                       //
+////////////////////////////////////////////////////////////////////////////////
+thread_local uint32_t SysJobsThreadQueue = 0;
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobCounter default constructor                                         //
+////////////////////////////////////////////////////////////////////////////////
+SysJobCounter::SysJobCounter() :
+m_mutex(),
+m_count(0),
+m_continued(0)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobCounter destructor                                                  //
+////////////////////////////////////////////////////////////////////////////////
+SysJobCounter::~SysJobCounter()
+{
+    m_continued = 0;
+    m_count = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Add pending jobs to the counter                                           //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobCounter::increment(uint32_t count)
+{
+    m_mutex.lock();
+    m_count += count;
+    m_mutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Remove one pending job from the counter                                   //
+//  Dependent jobs are submitted when the count reaches zero                  //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobCounter::decrement()
+{
+    SysJob continuations[SysJobCounterMaxContinuations];
+    uint32_t continued = 0;
+    bool done = false;
+
+    m_mutex.lock();
+    if (m_count > 0)
+    {
+        --m_count;
+        if (m_count <= 0)
+        {
+            // Release dependent jobs
+            for (uint32_t i = 0; i < m_continued; ++i)
+            {
+                continuations[i] = m_continuations[i];
+            }
+            continued = m_continued;
+            m_continued = 0;
+            done = true;
+        }
+    }
+    m_mutex.unlock();
+
+    // The counter can be destroyed by its waiters from here
+    if (done)
+    {
+        for (uint32_t i = 0; i < continued; ++i)
+        {
+            GSysJobs.push(continuations[i]);
+        }
+        GSysJobs.wake();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Add a job to submit when the count reaches zero                           //
+//  return : False if the count is zero or the continuations are full,        //
+//           the job must then be handled by the caller                       //
+////////////////////////////////////////////////////////////////////////////////
+bool SysJobCounter::addContinuation(const SysJob& job)
+{
+    bool added = false;
+    m_mutex.lock();
+    if ((m_count > 0) && (m_continued < SysJobCounterMaxContinuations))
+    {
+        m_continuations[m_continued++] = job;
+        added = true;
+    }
+    m_mutex.unlock();
+    return added;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get counter pending jobs count                                            //
+//  return : Pending jobs count                                               //
+////////////////////////////////////////////////////////////////////////////////
+uint32_t SysJobCounter::getCount()
+{
+    m_mutex.lock();
+    uint32_t count = m_count;
+    m_mutex.unlock();
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobQueue default constructor                                           //
+////////////////////////////////////////////////////////////////////////////////
+SysJobQueue::SysJobQueue() :
+m_mutex(),
+m_top(0),
+m_bottom(0)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobQueue destructor                                                    //
+////////////////////////////////////////////////////////////////////////////////
+SysJobQueue::~SysJobQueue()
+{
+    m_bottom = 0;
+    m_top = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Push job at the bottom of the queue                                       //
+//  return : False if the queue is full                                       //
+////////////////////////////////////////////////////////////////////////////////
+bool SysJobQueue::push(const SysJob& job)
+{
+    m_mutex.lock();
+    if ((m_bottom - m_top) >= SysJobsQueueSize)
+    {
+        // Job queue is full
+        m_mutex.unlock();
+        return false;
+    }
+    m_jobs[m_bottom & (SysJobsQueueSize-1)] = job;
+    ++m_bottom;
+    m_mutex.unlock();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Pop job from the bottom of the queue (owner thread)                       //
+//  return : True if a job was popped                                         //
+////////////////////////////////////////////////////////////////////////////////
+bool SysJobQueue::pop(SysJob& job)
+{
+    m_mutex.lock();
+    if (m_bottom == m_top)
+    {
+        // Job queue is empty
+        m_mutex.unlock();
+        return false;
+    }
+    --m_bottom;
+    job = m_jobs[m_bottom & (SysJobsQueueSize-1)];
+    m_mutex.unlock();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Steal job from the top of the queue (other threads)                       //
+//  return : True if a job was stolen                                         //
+////////////////////////////////////////////////////////////////////////////////
+bool SysJobQueue::steal(SysJob& job)
+{
+    m_mutex.lock();
+    if (m_bottom == m_top)
+    {
+        // Job queue is empty
+        m_mutex.unlock();
+        return false;
+    }
+    job = m_jobs[m_top & (SysJobsQueueSize-1)];
+    ++m_top;
+    m_mutex.unlock();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobsWorker default constructor                                         //
+////////////////////////////////////////////////////////////////////////////////
+SysJobsWorker::SysJobsWorker() :
+m_jobs(0),
+m_queue(0)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobsWorker virtual destructor                                          //
+////////////////////////////////////////////////////////////////////////////////
+SysJobsWorker::~SysJobsWorker()
+{
+    m_queue = 0;
+    m_jobs = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobsWorker thread process                                              //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobsWorker::process()
+{
+    if (!m_jobs)
+    {
+        // Worker without scheduler
+        SysSleep(SysThreadStandbySleepTime);
+        return;
+    }
+
+    // Run next job, or wait for new jobs
+    SysJobsThreadQueue = m_queue;
+    uint64_t epoch = m_jobs->getEpoch();
+    if (!m_jobs->runNext())
+    {
+        m_jobs->idle(epoch);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobs default constructor                                               //
+////////////////////////////////////////////////////////////////////////////////
+SysJobs::SysJobs() :
+m_shared(),
+m_queues(0),
+m_workers(0),
+m_workersCount(0),
+m_idleMutex(),
+m_idle(),
+m_epoch(0),
+m_quit(false)
+{
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  SysJobs destructor                                                        //
+////////////////////////////////////////////////////////////////////////////////
+SysJobs::~SysJobs()
+{
+    destroyJobs();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Init job scheduler workers                                                //
+//  return : True if the job scheduler is ready                               //
+////////////////////////////////////////////////////////////////////////////////
+bool SysJobs::init(uint32_t workersCount)
+{
+    // Stop current workers
+    destroyJobs();
+
+    // One worker per hardware thread (navigator.hardwareConcurrency)
+    if (workersCount <= 0)
+    {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workersCount = (hardwareThreads > 1) ? (hardwareThreads-1) : 0;
+    }
+    if (workersCount > SysJobsMaxWorkers)
+    {
+        workersCount = SysJobsMaxWorkers;
+    }
+    if (workersCount <= 0)
+    {
+        // Jobs are run by the waiting threads
+        return true;
+    }
+
+    // Allocate workers queues and threads
+    m_queues = new (std::nothrow) SysJobQueue[workersCount];
+    m_workers = new (std::nothrow) SysJobsWorker[workersCount];
+    if (!m_queues || !m_workers)
+    {
+        // Could not allocate workers
+        if (m_workers) { delete[] m_workers; }
+        if (m_queues) { delete[] m_queues; }
+        m_workers = 0;
+        m_queues = 0;
+        return false;
+    }
+    m_workersCount = workersCount;
+
+    // Start worker threads
+    for (uint32_t i = 0; i < workersCount; ++i)
+    {
+        m_workers[i].setQueue(this, i+1);
+        if (!m_workers[i].start())
+        {
+            // Could not start worker thread
+            destroyJobs();
+            return false;
+        }
+    }
+
+    // Job scheduler is ready
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Submit job                                                                //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobs::submit(SysJobFunction function, void* userData,
+    SysJobCounter* counter, SysJobCounter* dependency)
+{
+    SysJob job;
+    job.function = function;
+    job.userData = userData;
+    job.counter = counter;
+    if (counter) { counter->increment(); }
+
+    if (dependency)
+    {
+        // Defer job until its dependency is complete
+        if (dependency->addContinuation(job)) { return; }
+
+        // Dependency is complete, or its continuations are full
+        wait(*dependency);
+    }
+    push(job);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Push job into the calling thread queue                                    //
+//  The job runs immediately when the queue is full                           //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobs::push(const SysJob& job)
+{
+    uint32_t queue = SysJobsThreadQueue;
+    SysJobQueue& jobQueue = (queue > 0) ? m_queues[queue-1] : m_shared;
+    if (!jobQueue.push(job))
+    {
+        // Job queue is full
+        run(job);
+        return;
+    }
+    wake();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Run pending jobs until counter reaches zero                               //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobs::wait(SysJobCounter& counter)
+{
+    while (true)
+    {
+        uint64_t epoch = getEpoch();
+        if (counter.getCount() <= 0) { break; }
+        if (!runNext()) { idle(epoch); }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Run next pending job (own queue first, then steal)                        //
+//  return : True if a job was run                                            //
+////////////////////////////////////////////////////////////////////////////////
+bool SysJobs::runNext()
+{
+    // Newest job of the calling thread queue
+    SysJob job;
+    uint32_t queue = SysJobsThreadQueue;
+    SysJobQueue& jobQueue = (queue > 0) ? m_queues[queue-1] : m_shared;
+    if (jobQueue.pop(job))
+    {
+        run(job);
+        return true;
+    }
+
+    // Oldest job of the shared queue
+    if ((queue > 0) && m_shared.steal(job))
+    {
+        run(job);
+        return true;
+    }
+
+    // Oldest job of the other workers queues
+    for (uint32_t i = 0; i < m_workersCount; ++i)
+    {
+        uint32_t victim = ((queue+i) % m_workersCount);
+        if ((victim+1) == queue) { continue; }
+        if (m_queues[victim].steal(job))
+        {
+            run(job);
+            return true;
+        }
+    }
+
+    // No pending job
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get job scheduler wake up epoch                                           //
+//  return : Current epoch, to pass to idle                                   //
+////////////////////////////////////////////////////////////////////////////////
+uint64_t SysJobs::getEpoch()
+{
+    m_idleMutex.lock();
+    uint64_t epoch = m_epoch;
+    m_idleMutex.unlock();
+    return epoch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Wait for new jobs or completed counters since epoch                       //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobs::idle(uint64_t epoch)
+{
+    m_idleMutex.lock();
+    if (!m_quit && (m_epoch == epoch))
+    {
+        m_idle.waitFor(m_idleMutex, SysJobsIdleWaitTime);
+    }
+    m_idleMutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Wake up idle threads                                                      //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobs::wake()
+{
+    m_idleMutex.lock();
+    ++m_epoch;
+    m_idle.notifyAll();
+    m_idleMutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Destroy job scheduler (pending jobs are run first)                        //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobs::destroyJobs()
+{
+    // Stop worker threads
+    m_idleMutex.lock();
+    m_quit = true;
+    m_idle.notifyAll();
+    m_idleMutex.unlock();
+    for (uint32_t i = 0; i < m_workersCount; ++i)
+    {
+        m_workers[i].stop();
+    }
+    if (m_workers) { delete[] m_workers; }
+    m_workers = 0;
+
+    // Run the jobs left in the queues
+    while (runNext()) {}
+    m_workersCount = 0;
+    if (m_queues) { delete[] m_queues; }
+    m_queues = 0;
+
+    m_idleMutex.lock();
+    m_quit = false;
+    m_idleMutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Run job and release its counter                                           //
+////////////////////////////////////////////////////////////////////////////////
+void SysJobs::run(const SysJob& job)
+{
+    if (job.function) { job.function(job.userData); }
+    if (job.counter) { job.counter->decrement(); }
+}
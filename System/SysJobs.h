@@ -0,0 +1,383 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     System/SysJobs.h : Work stealing job scheduler                         //
+////////////////////////////////////////////////////////////////////////////////
+#ifndef WOS_SYSTEM_SYSJOBS_HEADER
+#define WOS_SYSTEM_SYSJOBS_HEADER
+
+    #include "System.h"
+    #include "SysThread.h"
+    #include "SysMutex.h"
+    #include "SysCondition.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <thread>
+    #include <new>
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysJobs settings                                                      //
+    ////////////////////////////////////////////////////////////////////////////
+    const uint32_t SysJobsMaxWorkers = 16;
+    const uint32_t SysJobsQueueSize = 1024;
+    const uint32_t SysJobCounterMaxContinuations = 16;
+    const double SysJobsIdleWaitTime = 0.01;
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysJob function                                                       //
+    ////////////////////////////////////////////////////////////////////////////
+    typedef void (*SysJobFunction)(void* userData);
+
+
+    class SysJobCounter;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysJob structure                                                      //
+    ////////////////////////////////////////////////////////////////////////////
+    struct SysJob
+    {
+        SysJobFunction function;        // Job function
+        void* userData;                 // Job function user data
+        SysJobCounter* counter;         // Job completion counter
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysJobCounter class definition                                        //
+    //  Counts the pending jobs of a group, the jobs depending on the group   //
+    //  are submitted when the count reaches zero                             //
+    //  A counter must outlive the jobs and the fetches it counts             //
+    ////////////////////////////////////////////////////////////////////////////
+    class SysJobCounter
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobCounter default constructor                             //
+            ////////////////////////////////////////////////////////////////////
+            SysJobCounter();
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobCounter destructor                                      //
+            ////////////////////////////////////////////////////////////////////
+            ~SysJobCounter();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Add pending jobs to the counter                               //
+            ////////////////////////////////////////////////////////////////////
+            void increment(uint32_t count = 1);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Remove one pending job from the counter                       //
+            //  Dependent jobs are submitted when the count reaches zero      //
+            ////////////////////////////////////////////////////////////////////
+            void decrement();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Add a job to submit when the count reaches zero               //
+            //  return : False if the count is zero or the continuations      //
+            //           are full, the job must then be handled by the caller //
+            ////////////////////////////////////////////////////////////////////
+            bool addContinuation(const SysJob& job);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get counter pending jobs count                                //
+            //  return : Pending jobs count                                   //
+            ////////////////////////////////////////////////////////////////////
+            uint32_t getCount();
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobCounter private copy constructor : Not copyable         //
+            ////////////////////////////////////////////////////////////////////
+            SysJobCounter(const SysJobCounter&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobCounter private copy operator : Not copyable            //
+            ////////////////////////////////////////////////////////////////////
+            SysJobCounter& operator=(const SysJobCounter&) = delete;
+
+
+        private:
+            SysMutex        m_mutex;        // Counter mutex
+            uint32_t        m_count;        // Pending jobs count
+            SysJob          m_continuations[SysJobCounterMaxContinuations];
+            uint32_t        m_continued;    // Dependent jobs count
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysJobQueue class definition                                          //
+    //  Owner thread pushes and pops at the bottom (last in first out),       //
+    //  other threads steal at the top (first in first out)                   //
+    ////////////////////////////////////////////////////////////////////////////
+    class SysJobQueue
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobQueue default constructor                               //
+            ////////////////////////////////////////////////////////////////////
+            SysJobQueue();
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobQueue destructor                                        //
+            ////////////////////////////////////////////////////////////////////
+            ~SysJobQueue();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Push job at the bottom of the queue                           //
+            //  return : False if the queue is full                           //
+            ////////////////////////////////////////////////////////////////////
+            bool push(const SysJob& job);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Pop job from the bottom of the queue (owner thread)           //
+            //  return : True if a job was popped                             //
+            ////////////////////////////////////////////////////////////////////
+            bool pop(SysJob& job);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Steal job from the top of the queue (other threads)           //
+            //  return : True if a job was stolen                             //
+            ////////////////////////////////////////////////////////////////////
+            bool steal(SysJob& job);
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobQueue private copy constructor : Not copyable           //
+            ////////////////////////////////////////////////////////////////////
+            SysJobQueue(const SysJobQueue&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobQueue private copy operator : Not copyable              //
+            ////////////////////////////////////////////////////////////////////
+            SysJobQueue& operator=(const SysJobQueue&) = delete;
+
+
+        private:
+            SysMutex        m_mutex;        // Queue mutex
+            SysJob          m_jobs[SysJobsQueueSize];
+            uint32_t        m_top;          // Queue top (steal side)
+            uint32_t        m_bottom;       // Queue bottom (owner side)
+    };
+
+
+    class SysJobs;
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysJobsWorker class definition                                        //
+    ////////////////////////////////////////////////////////////////////////////
+    class SysJobsWorker : public SysThread
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobsWorker default constructor                             //
+            ////////////////////////////////////////////////////////////////////
+            SysJobsWorker();
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobsWorker virtual destructor                              //
+            ////////////////////////////////////////////////////////////////////
+            virtual ~SysJobsWorker();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobsWorker thread process                                  //
+            ////////////////////////////////////////////////////////////////////
+            virtual void process();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Set SysJobsWorker scheduler and queue                         //
+            ////////////////////////////////////////////////////////////////////
+            inline void setQueue(SysJobs* jobs, uint32_t queue)
+            {
+                m_jobs = jobs;
+                m_queue = queue;
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobsWorker private copy constructor : Not copyable         //
+            ////////////////////////////////////////////////////////////////////
+            SysJobsWorker(const SysJobsWorker&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobsWorker private copy operator : Not copyable            //
+            ////////////////////////////////////////////////////////////////////
+            SysJobsWorker& operator=(const SysJobsWorker&) = delete;
+
+
+        private:
+            SysJobs*            m_jobs;         // Worker scheduler
+            uint32_t            m_queue;        // Worker queue index
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysJobs class definition                                              //
+    //  Each worker owns a job queue and steals from the others when it runs  //
+    //  dry, threads outside the pool submit into a shared queue              //
+    //  Waiting threads run pending jobs instead of sleeping, so the jobs     //
+    //  still complete without workers (single core)                          //
+    ////////////////////////////////////////////////////////////////////////////
+    class SysJobs
+    {
+        public:
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobs default constructor                                   //
+            ////////////////////////////////////////////////////////////////////
+            SysJobs();
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobs destructor                                            //
+            ////////////////////////////////////////////////////////////////////
+            ~SysJobs();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Init job scheduler workers                                    //
+            //  workersCount 0 starts one worker per hardware thread (the     //
+            //  main thread excepted), the count is capped to                 //
+            //  SysJobsMaxWorkers                                             //
+            //  return : True if the job scheduler is ready                   //
+            ////////////////////////////////////////////////////////////////////
+            bool init(uint32_t workersCount = 0);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Submit job                                                    //
+            //  counter (optional) is incremented until the job is complete   //
+            //  The job runs once dependency (optional) reaches zero          //
+            ////////////////////////////////////////////////////////////////////
+            void submit(SysJobFunction function, void* userData,
+                SysJobCounter* counter = 0, SysJobCounter* dependency = 0);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Push job into the calling thread queue                        //
+            //  The job runs immediately when the queue is full               //
+            ////////////////////////////////////////////////////////////////////
+            void push(const SysJob& job);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Run pending jobs until counter reaches zero                   //
+            ////////////////////////////////////////////////////////////////////
+            void wait(SysJobCounter& counter);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Run next pending job (own queue first, then steal)            //
+            //  return : True if a job was run                                //
+            ////////////////////////////////////////////////////////////////////
+            bool runNext();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get job scheduler wake up epoch                               //
+            //  return : Current epoch, to pass to idle                       //
+            ////////////////////////////////////////////////////////////////////
+            uint64_t getEpoch();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wait for new jobs or completed counters since epoch           //
+            ////////////////////////////////////////////////////////////////////
+            void idle(uint64_t epoch);
+
+            ////////////////////////////////////////////////////////////////////
+            //  Wake up idle threads                                          //
+            ////////////////////////////////////////////////////////////////////
+            void wake();
+
+            ////////////////////////////////////////////////////////////////////
+            //  Destroy job scheduler (pending jobs are run first)            //
+            ////////////////////////////////////////////////////////////////////
+            void destroyJobs();
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Get job scheduler workers count                               //
+            //  return : Number of worker threads                             //
+            ////////////////////////////////////////////////////////////////////
+            inline uint32_t getWorkersCount() const
+            {
+                return m_workersCount;
+            }
+
+
+        private:
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobs private copy constructor : Not copyable               //
+            ////////////////////////////////////////////////////////////////////
+            SysJobs(const SysJobs&) = delete;
+
+            ////////////////////////////////////////////////////////////////////
+            //  SysJobs private copy operator : Not copyable                  //
+            ////////////////////////////////////////////////////////////////////
+            SysJobs& operator=(const SysJobs&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////
+            //  Run job and release its counter                               //
+            ////////////////////////////////////////////////////////////////////
+            void run(const SysJob& job);
+
+
+        private:
+            SysJobQueue             m_shared;       // Shared submit queue
+            SysJobQueue*            m_queues;       // Workers queues
+            SysJobsWorker*          m_workers;      // Worker threads
+            uint32_t                m_workersCount; // Worker threads count
+
+            SysMutex                m_idleMutex;    // Idle threads mutex
+            SysCondition            m_idle;         // Idle threads condition
+            uint64_t                m_epoch;        // Wake up epoch
+            bool                    m_quit;         // Workers quit request
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    //  SysJobs global instance                                               //
+    ////////////////////////////////////////////////////////////////////////////
+    extern SysJobs GSysJobs;
+
+
+#endif // WOS_SYSTEM_SYSJOBS_HEADER
@@ -54,7 +54,8 @@ SysSettings GSysSettings = SysSettings();
 ////////////////////////////////////////////////////////////////////////////////
 SysSettings::SysSettings() :
 m_maxAnisotropicFiltering(ANISOTROPIC_FILTERING_NONE),
-m_anisotropicFiltering(ANISOTROPIC_FILTERING_NONE)
+m_anisotropicFiltering(ANISOTROPIC_FILTERING_NONE),
+m_textureQuality(TEXTURE_QUALITY_FULL)
 {
 
 }
@@ -64,6 +65,7 @@ m_anisotropicFiltering(ANISOTROPIC_FILTERING_NONE)
 ////////////////////////////////////////////////////////////////////////////////
 SysSettings::~SysSettings()
 {
+    m_textureQuality = TEXTURE_QUALITY_FULL;
     m_anisotropicFiltering = ANISOTROPIC_FILTERING_NONE;
     m_maxAnisotropicFiltering = ANISOTROPIC_FILTERING_NONE;
 }
@@ -78,6 +80,7 @@ bool SysSettings::loadSettings()
     // Temp set settings
     m_anisotropicFiltering = ANISOTROPIC_FILTERING_8X;
     //m_anisotropicFiltering = ANISOTROPIC_FILTERING_NONE;
+    m_textureQuality = TEXTURE_QUALITY_FULL;
 
     // System settings successfully loaded
     return true;
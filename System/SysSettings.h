@@ -59,6 +59,17 @@
         ANISOTROPIC_FILTERING_16X = 4
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  Texture quality mode enumeration (textures downscale at decode time)  //
+    ////////////////////////////////////////////////////////////////////////////
+    enum TextureQualityMode
+    {
+        TEXTURE_QUALITY_FULL = 0,
+        TEXTURE_QUALITY_HALF = 1,
+        TEXTURE_QUALITY_QUARTER = 2,
+        TEXTURE_QUALITY_EIGHTH = 3
+    };
+
 
     ////////////////////////////////////////////////////////////////////////////
     //  SysSettings class definition                                          //
@@ -98,6 +109,14 @@
                 m_anisotropicFiltering = anisotropicFiltering;
             }
 
+            ////////////////////////////////////////////////////////////////////
+            //  Set texture quality mode                                      //
+            ////////////////////////////////////////////////////////////////////
+            inline void setTextureQualityMode(TextureQualityMode textureQuality)
+            {
+                m_textureQuality = textureQuality;
+            }
+
 
             ////////////////////////////////////////////////////////////////////
             //  Get max anisotropic filtering mode                            //
@@ -116,6 +135,14 @@
                 return m_anisotropicFiltering;
             }
 
+            ////////////////////////////////////////////////////////////////////
+            //  Get texture quality mode                                      //
+            ////////////////////////////////////////////////////////////////////
+            inline TextureQualityMode getTextureQualityMode()
+            {
+                return m_textureQuality;
+            }
+
 
         private:
             ////////////////////////////////////////////////////////////////////
@@ -133,6 +160,7 @@
             AnisotropicFilteringMode    m_maxAnisotropicFiltering;
 
             AnisotropicFilteringMode    m_anisotropicFiltering;
+            TextureQualityMode          m_textureQuality;
     };
 
 
@@ -49,6 +49,15 @@
     #define WOS_DESKTOP
 
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  Platform configuration                                                //
+    //  WOS_EMSCRIPTEN : Browser build, without it native stand-ins are used  //
+    ////////////////////////////////////////////////////////////////////////////
+    #if defined(__EMSCRIPTEN__)
+        #define WOS_EMSCRIPTEN
+    #endif
+
+
     ////////////////////////////////////////////////////////////////////////////
     //  64bits or 32bits configuration                                        //
     ////////////////////////////////////////////////////////////////////////////
@@ -61,6 +70,27 @@
     #endif
 
 
+    ////////////////////////////////////////////////////////////////////////////
+    //  SIMD instruction sets configuration                                   //
+    //  WOS_X86 : x86 SSE/PCLMUL paths, selected at runtime                   //
+    //  WOS_NEON : ARM NEON paths (WOS_ARMCRC32 with CRC32 extension)         //
+    //  WOS_WASMSIMD : WebAssembly simd128 paths (-msimd128)                  //
+    ////////////////////////////////////////////////////////////////////////////
+    #if (defined(__x86_64__) || defined(__i386__)) && \
+        (defined(__GNUC__) || defined(__clang__))
+        #define WOS_X86
+    #endif
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define WOS_NEON
+        #if defined(__ARM_FEATURE_CRC32)
+            #define WOS_ARMCRC32
+        #endif
+    #endif
+    #if defined(__wasm_simd128__)
+        #define WOS_WASMSIMD
+    #endif
+
+
     ////////////////////////////////////////////////////////////////////////////
     //  Mouse pointer lock configuration                                      //
     //  0 : No pointer lock (OS absolute mouse position)                      //
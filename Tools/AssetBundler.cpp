@@ -0,0 +1,410 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Tools/AssetBundler.cpp : Packed assets bundle builder                  //
+////////////////////////////////////////////////////////////////////////////////
+#include "../Resources/AssetBundle.h"
+#include "../Compress/ZLib.h"
+#include "../System/SysCRC.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetBundler settings                                                     //
+//  Assets are stored compressed only when it saves at least 10%              //
+////////////////////////////////////////////////////////////////////////////////
+const double AssetBundlerMaxRatio = 0.9;
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetBundler asset structure                                              //
+////////////////////////////////////////////////////////////////////////////////
+struct AssetBundlerAsset
+{
+    std::string name;                   // Asset name (fetch path)
+    AssetBundleEntry entry;             // Asset index entry
+    std::vector<unsigned char> data;    // Asset stored data
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load file into memory                                                     //
+//  return : True if the file is successfully loaded                          //
+////////////////////////////////////////////////////////////////////////////////
+static bool AssetBundlerLoadFile(const std::string& path,
+    std::vector<unsigned char>& data)
+{
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        // Could not open file
+        return false;
+    }
+
+    data.clear();
+    unsigned char buffer[65536];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer+read);
+    }
+    bool loaded = (std::ferror(file) == 0);
+    std::fclose(file);
+    return loaded;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get asset name (relative path with forward slashes)                       //
+//  return : Asset name                                                       //
+////////////////////////////////////////////////////////////////////////////////
+static std::string AssetBundlerName(const std::filesystem::path& path)
+{
+    std::string name = path.lexically_normal().generic_string();
+    while (name.compare(0, 2, "./") == 0) { name.erase(0, 2); }
+    return name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Add file or directory (recursively) to the assets names                   //
+//  return : True if the path exists                                          //
+////////////////////////////////////////////////////////////////////////////////
+static bool AssetBundlerAddPath(const std::string& path,
+    std::vector<std::string>& names)
+{
+    std::error_code error;
+    if (std::filesystem::is_regular_file(path, error))
+    {
+        names.push_back(AssetBundlerName(path));
+        return true;
+    }
+    if (!std::filesystem::is_directory(path, error))
+    {
+        // Invalid path
+        return false;
+    }
+
+    for (std::filesystem::recursive_directory_iterator it(path, error), end;
+        !error && (it != end); it.increment(error))
+    {
+        if (it->is_regular_file(error))
+        {
+            names.push_back(AssetBundlerName(it->path()));
+        }
+    }
+    return !error;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Append little endian value to the bundle                                  //
+////////////////////////////////////////////////////////////////////////////////
+static void AssetBundlerWrite(std::vector<unsigned char>& bundle,
+    uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        bundle.push_back(static_cast<unsigned char>(value >> (i*8)));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load and compress asset                                                   //
+//  return : True if the asset is successfully loaded                         //
+////////////////////////////////////////////////////////////////////////////////
+static bool AssetBundlerLoadAsset(AssetBundlerAsset& asset,
+    bool store, ZLibDeflateLevel level)
+{
+    // Load asset file
+    if (!AssetBundlerLoadFile(asset.name, asset.data) ||
+        (asset.data.size() > UINT32_MAX))
+    {
+        std::printf("FAIL  %s : could not load file\n", asset.name.c_str());
+        return false;
+    }
+    asset.entry.hash = AssetBundleHash(asset.name.c_str());
+    asset.entry.offset = 0;
+    asset.entry.size = static_cast<uint32_t>(asset.data.size());
+    asset.entry.rawSize = static_cast<uint32_t>(asset.data.size());
+    asset.entry.crc = SysCRC32(asset.data.data(), asset.data.size());
+    asset.entry.contentHash = AssetBundleContentHash(
+        asset.data.data(), asset.data.size()
+    );
+    asset.entry.compression = ASSETBUNDLE_COMPRESSION_NONE;
+    if (store || asset.data.empty()) { return true; }
+
+    // Compress asset when it is worth it (PNG data are already deflated)
+    std::vector<unsigned char> compressed(
+        ZLibComputeDeflateCompressSize(asset.data.size())
+    );
+    size_t compressedSize = compressed.size();
+    if (!ZLibDeflateCompress(asset.data.data(), asset.data.size(),
+        compressed.data(), &compressedSize, level))
+    {
+        std::printf("FAIL  %s : could not compress\n", asset.name.c_str());
+        return false;
+    }
+    if (compressedSize < (asset.data.size()*AssetBundlerMaxRatio))
+    {
+        compressed.resize(compressedSize);
+        asset.data.swap(compressed);
+        asset.entry.size = static_cast<uint32_t>(compressedSize);
+        asset.entry.compression = ASSETBUNDLE_COMPRESSION_ZLIB;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Build assets bundle                                                       //
+//  return : True if the bundle is successfully written                       //
+////////////////////////////////////////////////////////////////////////////////
+static bool AssetBundlerBuild(const std::string& output,
+    std::vector<std::string>& names, bool store, ZLibDeflateLevel level)
+{
+    // Load assets (the bundle itself excepted)
+    std::string outputName = AssetBundlerName(output);
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    names.erase(std::remove(names.begin(), names.end(), outputName),
+        names.end()
+    );
+    if (names.empty() || (names.size() > AssetBundleMaxEntries))
+    {
+        std::printf("FAIL  invalid assets count : %zu\n", names.size());
+        return false;
+    }
+    std::vector<AssetBundlerAsset> assets(names.size());
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        assets[i].name = names[i];
+        if (!AssetBundlerLoadAsset(assets[i], store, level)) { return false; }
+    }
+
+    // Sort index by name hash and reject collisions
+    std::sort(assets.begin(), assets.end(),
+        [](const AssetBundlerAsset& a, const AssetBundlerAsset& b)
+        { return (a.entry.hash < b.entry.hash); }
+    );
+    for (size_t i = 1; i < assets.size(); ++i)
+    {
+        if (assets[i].entry.hash == assets[i-1].entry.hash)
+        {
+            std::printf("FAIL  name hash collision : %s %s\n",
+                assets[i-1].name.c_str(), assets[i].name.c_str()
+            );
+            return false;
+        }
+    }
+
+    // Layout assets data after the index
+    uint64_t offset = (AssetBundleHeaderSize +
+        assets.size()*AssetBundleEntrySize);
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        offset = ((offset + (AssetBundleAlignment-1)) &
+            ~static_cast<uint64_t>(AssetBundleAlignment-1));
+        if ((offset + assets[i].data.size()) > UINT32_MAX)
+        {
+            std::printf("FAIL  bundle is larger than 4GB\n");
+            return false;
+        }
+        assets[i].entry.offset = static_cast<uint32_t>(offset);
+        offset += assets[i].data.size();
+    }
+
+    // Write index
+    std::vector<unsigned char> index;
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        const AssetBundleEntry& entry = assets[i].entry;
+        AssetBundlerWrite(index, entry.hash, 8);
+        AssetBundlerWrite(index, entry.offset, 4);
+        AssetBundlerWrite(index, entry.size, 4);
+        AssetBundlerWrite(index, entry.rawSize, 4);
+        AssetBundlerWrite(index, entry.crc, 4);
+        AssetBundlerWrite(index, entry.compression, 4);
+        AssetBundlerWrite(index, 0, 4);
+        AssetBundlerWrite(index, entry.contentHash, 8);
+    }
+
+    // Write header, index and assets data
+    std::vector<unsigned char> bundle;
+    bundle.push_back('W');
+    bundle.push_back('P');
+    bundle.push_back('A');
+    bundle.push_back('K');
+    bundle.push_back(AssetBundleMajorVersion);
+    bundle.push_back(AssetBundleMinorVersion);
+    AssetBundlerWrite(bundle, 0, 2);
+    AssetBundlerWrite(bundle, assets.size(), 4);
+    AssetBundlerWrite(bundle, SysCRC32(index.data(), index.size()), 4);
+    bundle.insert(bundle.end(), index.begin(), index.end());
+    size_t rawSize = 0;
+    for (size_t i = 0; i < assets.size(); ++i)
+    {
+        bundle.resize(assets[i].entry.offset, 0);
+        bundle.insert(bundle.end(),
+            assets[i].data.begin(), assets[i].data.end()
+        );
+        rawSize += assets[i].entry.rawSize;
+        std::printf("  %-40s %10u %10u %s\n", assets[i].name.c_str(),
+            assets[i].entry.rawSize, assets[i].entry.size,
+            (assets[i].entry.compression == ASSETBUNDLE_COMPRESSION_ZLIB) ?
+            "zlib" : "stored"
+        );
+    }
+
+    // Save bundle
+    FILE* file = std::fopen(output.c_str(), "wb");
+    if (!file)
+    {
+        std::printf("FAIL  could not create %s\n", output.c_str());
+        return false;
+    }
+    bool written = (std::fwrite(bundle.data(), 1, bundle.size(), file) ==
+        bundle.size());
+    if (std::fclose(file) != 0) { written = false; }
+    if (!written)
+    {
+        std::printf("FAIL  could not write %s\n", output.c_str());
+        return false;
+    }
+    std::printf("Bundle : %s, %zu assets, %zu bytes (%zu bytes raw)\n",
+        output.c_str(), assets.size(), bundle.size(), rawSize
+    );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check assets bundle                                                       //
+//  return : True if the bundle and its listed assets are valid               //
+////////////////////////////////////////////////////////////////////////////////
+static bool AssetBundlerCheck(const std::string& path,
+    const std::vector<std::string>& names)
+{
+    // Open bundle (index, inflate and CRC32 checks)
+    std::vector<unsigned char> data;
+    AssetBundle bundle;
+    if (!AssetBundlerLoadFile(path, data) ||
+        !bundle.open(data.data(), data.size()))
+    {
+        std::printf("FAIL  %s : invalid bundle\n", path.c_str());
+        return false;
+    }
+
+    // Compare listed assets and their content hash with their files
+    bool valid = true;
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        std::vector<unsigned char> file;
+        AssetBundleView view;
+        if (!AssetBundlerLoadFile(names[i], file) ||
+            !bundle.getAsset(names[i].c_str(), view) ||
+            (view.size != file.size()) || (view.size > 0 &&
+            (std::memcmp(view.data, file.data(), view.size) != 0)) ||
+            (view.contentHash !=
+            AssetBundleContentHash(file.data(), file.size())))
+        {
+            std::printf("FAIL  %s : asset mismatch\n", names[i].c_str());
+            valid = false;
+        }
+    }
+    std::printf("Bundle : %s, %u assets, %zu checked\n", path.c_str(),
+        bundle.getAssetsCount(), names.size()
+    );
+    return valid;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  AssetBundler main                                                         //
+//  Build : AssetBundler [-store] [-level 0-4] bundle.wpak paths...           //
+//  Check : AssetBundler -check bundle.wpak paths...                          //
+//  Paths are files or directories, relative to the web root                  //
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    bool check = false;
+    bool store = false;
+    ZLibDeflateLevel level = ZLIB_DEFLATE_LEVEL_SMALLEST;
+    std::string output;
+    std::vector<std::string> names;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-check") == 0) { check = true; }
+        else if (std::strcmp(argv[i], "-store") == 0) { store = true; }
+        else if ((std::strcmp(argv[i], "-level") == 0) && ((i+1) < argc))
+        {
+            int value = std::atoi(argv[++i]);
+            if ((value < 0) || (value >= ZLIB_DEFLATE_LEVEL_COUNT))
+            {
+                std::printf("FAIL  invalid level : %d\n", value);
+                return 1;
+            }
+            level = static_cast<ZLibDeflateLevel>(value);
+        }
+        else if (output.empty()) { output = argv[i]; }
+        else if (!AssetBundlerAddPath(argv[i], names))
+        {
+            std::printf("FAIL  %s : no such file or directory\n", argv[i]);
+            return 1;
+        }
+    }
+    if (output.empty())
+    {
+        std::printf("Usage : AssetBundler [-store] [-level 0-4] "
+            "bundle.wpak paths...\n"
+            "        AssetBundler -check bundle.wpak paths...\n"
+        );
+        return 1;
+    }
+
+    if (check)
+    {
+        return AssetBundlerCheck(output, names) ? 0 : 1;
+    }
+    return AssetBundlerBuild(output, names, store, level) ? 0 : 1;
+}
@@ -0,0 +1,545 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Tools/KTXBench.cpp : KTX2 transcoder benchmark and conformance tool    //
+////////////////////////////////////////////////////////////////////////////////
+#include "../Images/KTXFile.h"
+#include "../Images/BlockTranscoder.h"
+#include "../Images/ImageDownscaler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  KTXBench settings                                                         //
+////////////////////////////////////////////////////////////////////////////////
+const double KTXBenchMinTime = 0.1;
+const uint32_t KTXBenchMinRuns = 3;
+const uint32_t KTXBenchWidth = 1024;
+const uint32_t KTXBenchHeight = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+//  KTXBench synthetic formats                                                //
+////////////////////////////////////////////////////////////////////////////////
+struct KTXBenchFormat
+{
+    const char* name;           // Format name
+    BlockFormat format;         // Block format
+    uint32_t vkFormat;          // KTX2 Vulkan format
+};
+static const KTXBenchFormat KTXBenchFormats[BLOCKFORMAT_COUNT-1] = {
+    {"BC1", BLOCKFORMAT_BC1, KTXFileVkFormatBC1},
+    {"BC1A", BLOCKFORMAT_BC1A, KTXFileVkFormatBC1A},
+    {"BC3", BLOCKFORMAT_BC3, KTXFileVkFormatBC3},
+    {"ETC2", BLOCKFORMAT_ETC2, KTXFileVkFormatETC2},
+    {"ETC2A1", BLOCKFORMAT_ETC2A1, KTXFileVkFormatETC2A1},
+    {"ETC2A8", BLOCKFORMAT_ETC2A8, KTXFileVkFormatETC2A8},
+    {"ASTC4x4", BLOCKFORMAT_ASTC4X4, KTXFileVkFormatASTC4x4}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//  KTXBench known answer blocks                                              //
+//  Expected pixels follow the BCn and ETC2 specifications, interpolated BCn  //
+//  colors are rounded down                                                   //
+////////////////////////////////////////////////////////////////////////////////
+struct KTXBenchBlock
+{
+    const char* name;           // Block mode name
+    BlockFormat format;         // Block format
+    unsigned char data[16];     // Block data
+    unsigned char rgba[64];     // Expected 4x4 RGBA pixels
+};
+static const KTXBenchBlock KTXBenchBlocks[] = {
+    {"BC1 4 colors", BLOCKFORMAT_BC1,
+        {0x00, 0xFC, 0x1F, 0x04, 0x6C, 0xB1, 0xC6, 0x1B,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {255, 130,   0, 255,  85, 130, 170, 255,
+         170, 130,  85, 255,   0, 130, 255, 255,
+           0, 130, 255, 255, 255, 130,   0, 255,
+          85, 130, 170, 255, 170, 130,  85, 255,
+         170, 130,  85, 255,   0, 130, 255, 255,
+         255, 130,   0, 255,  85, 130, 170, 255,
+          85, 130, 170, 255, 170, 130,  85, 255,
+           0, 130, 255, 255, 255, 130,   0, 255}},
+    {"BC1 3 colors", BLOCKFORMAT_BC1,
+        {0x45, 0x29, 0xE0, 0xFF, 0xE4, 0x39, 0x4E, 0x93,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        { 41,  40,  41, 255, 255, 255,   0, 255,
+         148, 147,  20, 255,   0,   0,   0, 255,
+         255, 255,   0, 255, 148, 147,  20, 255,
+           0,   0,   0, 255,  41,  40,  41, 255,
+         148, 147,  20, 255,   0,   0,   0, 255,
+          41,  40,  41, 255, 255, 255,   0, 255,
+           0,   0,   0, 255,  41,  40,  41, 255,
+         255, 255,   0, 255, 148, 147,  20, 255}},
+    {"BC1A 3 colors", BLOCKFORMAT_BC1A,
+        {0x45, 0x29, 0xE0, 0xFF, 0xE4, 0x39, 0x4E, 0x93,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        { 41,  40,  41, 255, 255, 255,   0, 255,
+         148, 147,  20, 255,   0,   0,   0,   0,
+         255, 255,   0, 255, 148, 147,  20, 255,
+           0,   0,   0,   0,  41,  40,  41, 255,
+         148, 147,  20, 255,   0,   0,   0,   0,
+          41,  40,  41, 255, 255, 255,   0, 255,
+           0,   0,   0,   0,  41,  40,  41, 255,
+         255, 255,   0, 255, 148, 147,  20, 255}},
+    {"BC3 8 alphas", BLOCKFORMAT_BC3,
+        {0xF0, 0x10, 0xA8, 0xCE, 0x78, 0xA8, 0xCE, 0x78,
+        0x45, 0x29, 0xE0, 0xFF, 0xB1, 0xB1, 0xB1, 0xB1},
+        {255, 255,   0, 240,  41,  40,  41, 112,
+         183, 183,  13, 208, 112, 111,  27,  48,
+         255, 255,   0, 144,  41,  40,  41,  16,
+         183, 183,  13,  80, 112, 111,  27, 176,
+         255, 255,   0, 240,  41,  40,  41, 112,
+         183, 183,  13, 208, 112, 111,  27,  48,
+         255, 255,   0, 144,  41,  40,  41,  16,
+         183, 183,  13,  80, 112, 111,  27, 176}},
+    {"BC3 6 alphas", BLOCKFORMAT_BC3,
+        {0x1E, 0xC8, 0xE1, 0x55, 0xCC, 0xE1, 0x55, 0xCC,
+        0x45, 0x29, 0xE0, 0xFF, 0xB1, 0xB1, 0xB1, 0xB1},
+        {255, 255,   0, 200,  41,  40,  41, 132,
+         183, 183,  13, 255, 112, 111,  27,  64,
+         255, 255,   0, 166,  41,  40,  41,  30,
+         183, 183,  13,  98, 112, 111,  27,   0,
+         255, 255,   0, 200,  41,  40,  41, 132,
+         183, 183,  13, 255, 112, 111,  27,  64,
+         255, 255,   0, 166,  41,  40,  41,  30,
+         183, 183,  13,  98, 112, 111,  27,   0}},
+    {"ETC2 individual", BLOCKFORMAT_ETC2,
+        {0xC3, 0x5E, 0x91, 0x39, 0x63, 0x9C, 0x5A, 0x5A,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {209,  90, 158, 255, 187,  68, 136, 255,
+         199,  80, 148, 255, 221, 102, 170, 255,
+         221, 102, 170, 255, 209,  90, 158, 255,
+         187,  68, 136, 255, 199,  80, 148, 255,
+          18, 205,   0, 255, 157, 255, 123, 255,
+          84, 255,  50, 255,   0, 132,   0, 255,
+           0, 132,   0, 255,  18, 205,   0, 255,
+         157, 255, 123, 255,  84, 255,  50, 255}},
+    {"ETC2 differential", BLOCKFORMAT_ETC2,
+        {0xA5, 0x4B, 0xDE, 0x76, 0x55, 0xAA, 0xF0, 0xF0,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {178,  87, 235, 255, 207, 116, 255, 255,
+         116,  75, 182, 255,  60,  19, 126, 255,
+         152,  61, 209, 255, 123,  32, 180, 255,
+         164, 123, 230, 255, 220, 179, 255, 255,
+         178,  87, 235, 255, 207, 116, 255, 255,
+         116,  75, 182, 255,  60,  19, 126, 255,
+         152,  61, 209, 255, 123,  32, 180, 255,
+         164, 123, 230, 255, 220, 179, 255, 255}},
+    {"ETC2 T mode", BLOCKFORMAT_ETC2,
+        {0x15, 0x4B, 0x72, 0xDB, 0xA5, 0x5A, 0xF0, 0xF0,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {153,  68, 187, 255,  87,   2, 189, 255,
+         119,  34, 221, 255, 151,  66, 253, 255,
+         119,  34, 221, 255, 151,  66, 253, 255,
+         153,  68, 187, 255,  87,   2, 189, 255,
+         153,  68, 187, 255,  87,   2, 189, 255,
+         119,  34, 221, 255, 151,  66, 253, 255,
+         119,  34, 221, 255, 151,  66, 253, 255,
+         153,  68, 187, 255,  87,   2, 189, 255}},
+    {"ETC2 H mode", BLOCKFORMAT_ETC2,
+        {0x4A, 0xF9, 0x1E, 0x36, 0x63, 0x9C, 0xA5, 0xA5,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {121,  53, 138, 255,  83, 236, 134, 255,
+          19, 172,  70, 255, 185, 117, 202, 255,
+         185, 117, 202, 255, 121,  53, 138, 255,
+          83, 236, 134, 255,  19, 172,  70, 255,
+          19, 172,  70, 255, 185, 117, 202, 255,
+         121,  53, 138, 255,  83, 236, 134, 255,
+          83, 236, 134, 255,  19, 172,  70, 255,
+         185, 117, 202, 255, 121,  53, 138, 255}},
+    {"ETC2 planar", BLOCKFORMAT_ETC2,
+        {0x51, 0x48, 0xFB, 0x96, 0xF1, 0xF8, 0x01, 0x61,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        {162, 201, 125, 255, 132, 211, 158, 255,
+         101, 221, 190, 255,  71, 231, 223, 255,
+         122, 153, 127, 255,  91, 163, 160, 255,
+          61, 173, 192, 255,  30, 183, 225, 255,
+          81, 106, 130, 255,  51, 116, 162, 255,
+          20, 126, 195, 255,   0, 136, 227, 255,
+          41,  58, 132, 255,  10,  68, 164, 255,
+           0,  78, 197, 255,   0,  88, 229, 255}},
+    {"ETC2A1 punchthrough", BLOCKFORMAT_ETC2A1,
+        {0x62, 0xCF, 0x21, 0x89, 0x93, 0x6C, 0x5A, 0x5A,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+        { 99, 206,  33, 255, 159, 255,  93, 255,
+           0,   0,   0,   0,  39, 146,   0, 255,
+         159, 255,  93, 255,   0,   0,   0,   0,
+          39, 146,   0, 255,  99, 206,  33, 255,
+           0,   0,   0,   0,  86, 169,  12, 255,
+         115, 198,  41, 255, 144, 227,  70, 255,
+          86, 169,  12, 255, 115, 198,  41, 255,
+         144, 227,  70, 255,   0,   0,   0,   0}},
+    {"ETC2A8 EAC alpha", BLOCKFORMAT_ETC2A8,
+        {0x78, 0xBD, 0x5E, 0x1C, 0xC5, 0x5E, 0x1C, 0xC5,
+        0xA5, 0x4B, 0xDE, 0x76, 0x55, 0xAA, 0xF0, 0xF0},
+        {178,  87, 235,  87, 207, 116, 255, 142,
+         116,  75, 182,  87,  60,  19, 126, 142,
+         152,  61, 209, 219, 123,  32, 180,  10,
+         164, 123, 230, 219, 220, 179, 255,  10,
+         178,  87, 235, 120, 207, 116, 255, 109,
+         116,  75, 182, 120,  60,  19, 126, 109,
+         152,  61, 209,  98, 123,  32, 180, 131,
+         164, 123, 230,  98, 220, 179, 255, 131}}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get current time in seconds                                               //
+//  return : Current steady clock time in seconds                             //
+////////////////////////////////////////////////////////////////////////////////
+static double KTXBenchTime()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get block format name                                                     //
+//  return : Block format name                                                //
+////////////////////////////////////////////////////////////////////////////////
+static const char* KTXBenchFormatName(BlockFormat format)
+{
+    for (uint32_t i = 0; i < (BLOCKFORMAT_COUNT-1); ++i)
+    {
+        if (KTXBenchFormats[i].format == format)
+        {
+            return KTXBenchFormats[i].name;
+        }
+    }
+    return "None";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Build synthetic KTX2 file with random blocks and a full mip chain         //
+////////////////////////////////////////////////////////////////////////////////
+static void KTXBenchBuild(std::vector<unsigned char>& file,
+    const KTXBenchFormat& format, uint32_t width, uint32_t height,
+    uint32_t seed)
+{
+    // Write header and levels index
+    uint32_t levels = ImageMipLevels(width, height);
+    size_t offset = (KTXFileHeaderSize + levels*KTXFileLevelIndexSize);
+    file.assign(offset, 0);
+    std::memcpy(&file[0], KTXFileIdentifier, sizeof(KTXFileIdentifier));
+    uint32_t header[9] = {
+        format.vkFormat, 1, width, height, 0, 0, 1, levels, 0
+    };
+    std::memcpy(&file[12], header, sizeof(header));
+    for (uint32_t i = 0; i < levels; ++i)
+    {
+        uint64_t size = BlockImageSize(format.format,
+            ImageDownscaledSize(width, i), ImageDownscaledSize(height, i)
+        );
+        uint64_t level[3] = {file.size(), size, size};
+        std::memcpy(&file[KTXFileHeaderSize + i*KTXFileLevelIndexSize],
+            level, sizeof(level)
+        );
+        file.resize(file.size() + size);
+    }
+
+    // Fill levels with random blocks
+    std::srand(seed);
+    for (size_t i = offset; i < file.size(); ++i)
+    {
+        file[i] = static_cast<unsigned char>(std::rand());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check KTX2 file transcoding                                               //
+//  return : Number of check failures                                         //
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t KTXBenchCheck(const std::vector<unsigned char>& file,
+    const KTXFile& ktxfile)
+{
+    // Truncated files must be rejected
+    uint32_t failures = 0;
+    KTXFile truncated;
+    if (truncated.open(&file[0], file.size()-1))
+    {
+        std::printf("FAIL  %s truncated file accepted\n",
+            KTXBenchFormatName(ktxfile.getFormat())
+        );
+        ++failures;
+    }
+    if (!BlockFormatTranscodable(ktxfile.getFormat())) { return failures; }
+
+    // RGB565 target must match the RGBA8 target
+    uint32_t levels = ktxfile.getLevels();
+    std::vector<unsigned char> rgba(
+        ktxfile.getTranscodedSize(BLOCKTARGET_RGBA8, 0, levels)
+    );
+    std::vector<unsigned char> rgb(
+        ktxfile.getTranscodedSize(BLOCKTARGET_RGB565, 0, levels)
+    );
+    if (!ktxfile.transcode(&rgba[0], BLOCKTARGET_RGBA8, 0, levels) ||
+        !ktxfile.transcode(&rgb[0], BLOCKTARGET_RGB565, 0, levels))
+    {
+        std::printf("FAIL  %s transcode\n",
+            KTXBenchFormatName(ktxfile.getFormat())
+        );
+        return (failures + 1);
+    }
+    for (size_t i = 0; i < (rgb.size()/2); ++i)
+    {
+        uint16_t color = static_cast<uint16_t>(
+            (((rgba[i*4]*31 + 127) / 255) << 11) |
+            (((rgba[i*4+1]*63 + 127) / 255) << 5) |
+            ((rgba[i*4+2]*31 + 127) / 255)
+        );
+        if (std::memcmp(&rgb[i*2], &color, sizeof(uint16_t)) != 0)
+        {
+            std::printf("FAIL  %s RGB565 pixel %zu\n",
+                KTXBenchFormatName(ktxfile.getFormat()), i
+            );
+            return (failures + 1);
+        }
+    }
+
+    // Opaque formats must be transcoded opaque
+    if (!BlockFormatAlpha(ktxfile.getFormat()))
+    {
+        for (size_t i = 0; i < (rgba.size()/4); ++i)
+        {
+            if (rgba[i*4+3] != 255)
+            {
+                std::printf("FAIL  %s alpha pixel %zu\n",
+                    KTXBenchFormatName(ktxfile.getFormat()), i
+                );
+                return (failures + 1);
+            }
+        }
+    }
+    return failures;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check known answer blocks of every transcodable format and mode           //
+//  return : Number of check failures                                         //
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t KTXBenchKnownAnswers()
+{
+    uint32_t failures = 0;
+    uint32_t count = (sizeof(KTXBenchBlocks) / sizeof(KTXBenchBlock));
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // Transcode block to both targets
+        const KTXBenchBlock& block = KTXBenchBlocks[i];
+        unsigned char rgba[64] = {0};
+        uint16_t rgb[16] = {0};
+        if (!BlockTranscode(block.format, block.data, 4, 4,
+            rgba, BLOCKTARGET_RGBA8) ||
+            !BlockTranscode(block.format, block.data, 4, 4,
+            reinterpret_cast<unsigned char*>(rgb), BLOCKTARGET_RGB565))
+        {
+            std::printf("FAIL  %s transcode\n", block.name);
+            ++failures;
+            continue;
+        }
+
+        // Compare with the expected pixels
+        for (uint32_t j = 0; j < 16; ++j)
+        {
+            const unsigned char* expected = &block.rgba[j*4];
+            uint16_t color = static_cast<uint16_t>(
+                (((expected[0]*31 + 127) / 255) << 11) |
+                (((expected[1]*63 + 127) / 255) << 5) |
+                ((expected[2]*31 + 127) / 255)
+            );
+            if ((std::memcmp(&rgba[j*4], expected, 4) != 0) ||
+                (rgb[j] != color))
+            {
+                std::printf("FAIL  %s pixel %u : %u %u %u %u "
+                    "expected %u %u %u %u\n", block.name, j,
+                    rgba[j*4], rgba[j*4+1], rgba[j*4+2], rgba[j*4+3],
+                    expected[0], expected[1], expected[2], expected[3]
+                );
+                ++failures;
+                break;
+            }
+        }
+    }
+    return failures;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Time KTX2 file transcoding                                                //
+//  return : Average time in seconds to transcode the mip chain               //
+////////////////////////////////////////////////////////////////////////////////
+static double KTXBenchRun(const KTXFile& ktxfile, BlockTarget target)
+{
+    uint32_t levels = ktxfile.getLevels();
+    std::vector<unsigned char> out(
+        ktxfile.getTranscodedSize(target, 0, levels)
+    );
+    double total = 0.0;
+    uint32_t runs = 0;
+    while ((runs < KTXBenchMinRuns) || (total < KTXBenchMinTime))
+    {
+        double start = KTXBenchTime();
+        ktxfile.transcode(&out[0], target, 0, levels);
+        total += (KTXBenchTime() - start);
+        ++runs;
+    }
+    return (total / runs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Report KTX2 file memory and transcoding throughput                        //
+//  return : Number of check failures                                         //
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t KTXBenchReport(const std::string& name,
+    const std::vector<unsigned char>& file)
+{
+    // Open KTX2 file
+    KTXFile ktxfile;
+    if (file.empty() || !ktxfile.open(&file[0], file.size()))
+    {
+        std::printf("FAIL  %s invalid KTX2 file\n", name.c_str());
+        return 1;
+    }
+    uint32_t failures = KTXBenchCheck(file, ktxfile);
+
+    // Graphics memory of the compressed and transcoded mip chains
+    uint32_t levels = ktxfile.getLevels();
+    size_t compressed = 0;
+    for (uint32_t i = 0; i < levels; ++i)
+    {
+        compressed += ktxfile.getLevelSize(i);
+    }
+    size_t rgba = ImageMipChainSize(
+        ktxfile.getWidth(), ktxfile.getHeight(), levels
+    );
+    double pixels = (static_cast<double>(rgba/4) / 1000000.0);
+
+    // Transcoding throughput (ASTC is only uploaded compressed)
+    double rgbaTime = 0.0;
+    double rgbTime = 0.0;
+    if (BlockFormatTranscodable(ktxfile.getFormat()))
+    {
+        rgbaTime = KTXBenchRun(ktxfile, BLOCKTARGET_RGBA8);
+        rgbTime = KTXBenchRun(ktxfile, BLOCKTARGET_RGB565);
+    }
+    std::printf("%-20s %-8s %5ux%-5u %7.2f %7.2f %8.2fx %10.1f %10.1f\n",
+        name.c_str(), KTXBenchFormatName(ktxfile.getFormat()),
+        ktxfile.getWidth(), ktxfile.getHeight(),
+        (compressed / 1048576.0), (rgba / 1048576.0),
+        (static_cast<double>(rgba) / compressed),
+        (rgbaTime > 0.0) ? (pixels / rgbaTime) : 0.0,
+        (rgbTime > 0.0) ? (pixels / rgbTime) : 0.0
+    );
+    return failures;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  KTXBench program entry point                                              //
+//  Usage : KTXBench [file.ktx2 ...]                                          //
+//  Synthetic files of every block format are used without arguments          //
+//  return : 0 if every file is successfully checked, 1 otherwise             //
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    // Check known answer blocks
+    uint32_t failures = KTXBenchKnownAnswers();
+    std::printf("%-20s %-8s %11s %7s %7s %9s %10s %10s\n",
+        "File", "Format", "Size", "GPU MB", "RGBA MB", "Saving",
+        "RGBA MP/s", "565 MP/s"
+    );
+
+    if (argc > 1)
+    {
+        // Check KTX2 files
+        for (int i = 1; i < argc; ++i)
+        {
+            std::ifstream stream(argv[i], std::ios::binary);
+            std::vector<unsigned char> file(
+                (std::istreambuf_iterator<char>(stream)),
+                std::istreambuf_iterator<char>()
+            );
+            failures += KTXBenchReport(argv[i], file);
+        }
+    }
+    else
+    {
+        // Check synthetic KTX2 files (random blocks)
+        for (uint32_t i = 0; i < (BLOCKFORMAT_COUNT-1); ++i)
+        {
+            std::vector<unsigned char> file;
+            KTXBenchBuild(file, KTXBenchFormats[i],
+                KTXBenchWidth, KTXBenchHeight, i+1
+            );
+            failures += KTXBenchReport(
+                std::string("synthetic ") + KTXBenchFormats[i].name, file
+            );
+
+            // Odd sizes (partial blocks)
+            KTXBenchBuild(file, KTXBenchFormats[i], 37, 19, i+1);
+            KTXFile ktxfile;
+            if (!ktxfile.open(&file[0], file.size()))
+            {
+                std::printf("FAIL  %s odd size\n", KTXBenchFormats[i].name);
+                ++failures;
+                continue;
+            }
+            failures += KTXBenchCheck(file, ktxfile);
+        }
+    }
+
+    // Conformance summary
+    if (failures > 0)
+    {
+        std::printf("\n%u conformance failures\n", failures);
+        return 1;
+    }
+    std::printf("\nAll files are successfully transcoded\n");
+    return 0;
+}
@@ -0,0 +1,287 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Tools/PNGFilterBench.cpp : PNG unfilter benchmark and conformance tool //
+////////////////////////////////////////////////////////////////////////////////
+#include "../Images/PNGFilter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  PNGFilterBench settings                                                   //
+////////////////////////////////////////////////////////////////////////////////
+const double PNGFilterBenchMinTime = 0.1;
+const uint32_t PNGFilterBenchMinRuns = 3;
+const uint32_t PNGFilterBenchWidth = 4096;
+const uint32_t PNGFilterBenchHeight = 64;
+const uint32_t PNGFilterBenchMaxCheckWidth = 80;
+
+////////////////////////////////////////////////////////////////////////////////
+//  PNGFilterBench filter names                                               //
+////////////////////////////////////////////////////////////////////////////////
+static const char* PNGFilterBenchNames[5] = {
+    "None", "Sub", "Up", "Average", "Paeth"
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get current time in seconds                                               //
+//  return : Current steady clock time in seconds                             //
+////////////////////////////////////////////////////////////////////////////////
+static double PNGFilterBenchTime()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compute throughput in MB/s                                                //
+//  return : Computed throughput in MB/s                                      //
+////////////////////////////////////////////////////////////////////////////////
+static double PNGFilterBenchThroughput(size_t size, double time)
+{
+    if (time <= 0.0) { return 0.0; }
+    return ((static_cast<double>(size) / 1000000.0) / time);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Generate photographic-like image (smooth gradients with noise)            //
+////////////////////////////////////////////////////////////////////////////////
+static void PNGFilterBenchImage(std::vector<unsigned char>& image,
+    size_t stride, uint32_t height, uint32_t seed)
+{
+    image.resize(stride*height);
+    std::srand(seed);
+    for (uint32_t j = 0; j < height; ++j)
+    {
+        for (size_t i = 0; i < stride; ++i)
+        {
+            image[j*stride+i] = static_cast<unsigned char>(
+                (i*3) + (j*5) + (std::rand() & 7)
+            );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Filter image scanlines with a single filter type                          //
+////////////////////////////////////////////////////////////////////////////////
+static void PNGFilterBenchFilter(const std::vector<unsigned char>& image,
+    std::vector<unsigned char>& filtered, size_t stride, uint32_t height,
+    uint32_t bpp, unsigned char filter)
+{
+    filtered.resize(stride*height);
+    std::vector<unsigned char> zero(stride, 0);
+    for (uint32_t j = 0; j < height; ++j)
+    {
+        const unsigned char* row = &image[j*stride];
+        const unsigned char* prev = (j > 0) ? &image[(j-1)*stride] : &zero[0];
+        for (size_t i = 0; i < stride; ++i)
+        {
+            unsigned char a = (i >= bpp) ? row[i-bpp] : 0;
+            unsigned char b = prev[i];
+            unsigned char c = (i >= bpp) ? prev[i-bpp] : 0;
+            unsigned char predictor = 0;
+            switch (filter)
+            {
+                case PNGFILE_FILTER_SUB: predictor = a; break;
+                case PNGFILE_FILTER_UP: predictor = b; break;
+                case PNGFILE_FILTER_AVERAGE:
+                    predictor = static_cast<unsigned char>((a+b) >> 1);
+                    break;
+                case PNGFILE_FILTER_PAETH:
+                    predictor = PNGPaethPredictor(a, b, c);
+                    break;
+                default: break;
+            }
+            filtered[j*stride+i] = static_cast<unsigned char>(
+                row[i] - predictor
+            );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Unfilter image scanlines in place                                         //
+//  return : True if every scanline is successfully unfiltered                //
+////////////////////////////////////////////////////////////////////////////////
+static bool PNGFilterBenchUnfilter(std::vector<unsigned char>& data,
+    const std::vector<unsigned char>& zero, size_t stride, uint32_t height,
+    uint32_t bpp, unsigned char filter, bool simd)
+{
+    for (uint32_t j = 0; j < height; ++j)
+    {
+        unsigned char* row = &data[j*stride];
+        const unsigned char* prev = (j > 0) ? (row-stride) : &zero[0];
+        bool unfiltered = simd ?
+            PNGUnfilterRow(filter, row, prev, stride, bpp) :
+            PNGUnfilterRowScalar(filter, row, prev, stride, bpp);
+        if (!unfiltered) { return false; }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Check SIMD and scalar unfilter against the source image                   //
+//  return : Number of mismatching widths                                     //
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t PNGFilterBenchCheck(uint32_t bpp, unsigned char filter)
+{
+    uint32_t failures = 0;
+    for (uint32_t width = 1; width <= PNGFilterBenchMaxCheckWidth; ++width)
+    {
+        size_t stride = (width*bpp);
+        uint32_t height = 4;
+        std::vector<unsigned char> image;
+        std::vector<unsigned char> filtered;
+        std::vector<unsigned char> zero(stride, 0);
+        PNGFilterBenchImage(image, stride, height, width);
+        for (size_t i = 0; i < image.size(); i += 7)
+        {
+            // Add sharp edges to exercise every predictor choice
+            image[i] = static_cast<unsigned char>(std::rand());
+        }
+        PNGFilterBenchFilter(image, filtered, stride, height, bpp, filter);
+
+        std::vector<unsigned char> scalar = filtered;
+        std::vector<unsigned char> simd = filtered;
+        if (!PNGFilterBenchUnfilter(
+                scalar, zero, stride, height, bpp, filter, false) ||
+            !PNGFilterBenchUnfilter(
+                simd, zero, stride, height, bpp, filter, true) ||
+            (scalar != image) || (simd != image))
+        {
+            std::printf("FAIL  %s bpp %u width %u\n",
+                PNGFilterBenchNames[filter], bpp, width
+            );
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Time image unfilter                                                       //
+//  return : Average time in seconds to unfilter the image                    //
+////////////////////////////////////////////////////////////////////////////////
+static double PNGFilterBenchRun(const std::vector<unsigned char>& filtered,
+    size_t stride, uint32_t height, uint32_t bpp, unsigned char filter,
+    bool simd)
+{
+    std::vector<unsigned char> data(filtered.size());
+    std::vector<unsigned char> zero(stride, 0);
+    double total = 0.0;
+    uint32_t runs = 0;
+    while ((runs < PNGFilterBenchMinRuns) || (total < PNGFilterBenchMinTime))
+    {
+        std::memcpy(&data[0], &filtered[0], filtered.size());
+        double start = PNGFilterBenchTime();
+        PNGFilterBenchUnfilter(data, zero, stride, height, bpp, filter, simd);
+        total += (PNGFilterBenchTime() - start);
+        ++runs;
+    }
+    return (total / runs);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  PNGFilterBench program entry point                                        //
+//  Usage : PNGFilterBench                                                    //
+//  return : 0 if every kernel matches the scalar path, 1 otherwise           //
+////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    uint32_t failures = 0;
+    std::printf("Image : %u x %u pixels per bpp\n\n",
+        PNGFilterBenchWidth, PNGFilterBenchHeight
+    );
+    std::printf("%-8s %4s %14s %14s %9s\n",
+        "Filter", "Bpp", "Scalar MB/s", "SIMD MB/s", "Speedup"
+    );
+
+    for (unsigned char filter = PNGFILE_FILTER_SUB;
+        filter <= PNGFILE_FILTER_PAETH; ++filter)
+    {
+        for (uint32_t bpp = 1; bpp <= PNGFilterMaxSIMDPixelSize; ++bpp)
+        {
+            // Conformance on small odd widths (SIMD heads and scalar tails)
+            failures += PNGFilterBenchCheck(bpp, filter);
+
+            // Throughput on a large image
+            size_t stride = (PNGFilterBenchWidth*bpp);
+            std::vector<unsigned char> image;
+            std::vector<unsigned char> filtered;
+            PNGFilterBenchImage(image, stride, PNGFilterBenchHeight, bpp);
+            PNGFilterBenchFilter(image, filtered,
+                stride, PNGFilterBenchHeight, bpp, filter
+            );
+            double scalarTime = PNGFilterBenchRun(filtered,
+                stride, PNGFilterBenchHeight, bpp, filter, false
+            );
+            double simdTime = PNGFilterBenchRun(filtered,
+                stride, PNGFilterBenchHeight, bpp, filter, true
+            );
+
+            size_t size = filtered.size();
+            std::printf("%-8s %4u %14.1f %14.1f %8.2fx\n",
+                PNGFilterBenchNames[filter], bpp,
+                PNGFilterBenchThroughput(size, scalarTime),
+                PNGFilterBenchThroughput(size, simdTime),
+                (simdTime > 0.0) ? (scalarTime / simdTime) : 0.0
+            );
+        }
+    }
+
+    // Conformance summary
+    if (failures > 0)
+    {
+        std::printf("\n%u conformance failures\n", failures);
+        return 1;
+    }
+    std::printf("\nAll kernels match the scalar unfilter path\n");
+    return 0;
+}
@@ -0,0 +1,712 @@
+////////////////////////////////////////////////////////////////////////////////
+//   _______                               ________________________________   //
+//   \\ .   \                     ________/ . . . . . . . . . . . . . .   /   //
+//    \\ .   \     ____       ___/ . . . . .   __________________________/    //
+//     \\ .   \   //   \   __/. . .  _________/   /    // .  _________/       //
+//      \\ .   \_//     \_//     ___/.  _____    /    // .  /_____            //
+//       \\ .   \/   _   \/    _/// .  /    \\   |    \\  .       \           //
+//        \\ .      /\\       /  || .  |    ||   |     \\______    \          //
+//         \\ .    /  \\     /   || .  \____//   |  _________//    /          //
+//          \\ .  /    \\   /    //  .           / // . . . .     /           //
+//           \\__/      \\_/    //______________/ //_____________/            //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+//   This is free and unencumbered software released into the public domain.  //
+//                                                                            //
+//   Anyone is free to copy, modify, publish, use, compile, sell, or          //
+//   distribute this software, either in source code form or as a compiled    //
+//   binary, for any purpose, commercial or non-commercial, and by any        //
+//   means.                                                                   //
+//                                                                            //
+//   In jurisdictions that recognize copyright laws, the author or authors    //
+//   of this software dedicate any and all copyright interest in the          //
+//   software to the public domain. We make this dedication for the benefit   //
+//   of the public at large and to the detriment of our heirs and             //
+//   successors. We intend this dedication to be an overt act of              //
+//   relinquishment in perpetuity of all present and future rights to this    //
+//   software under copyright law.                                            //
+//                                                                            //
+//   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,          //
+//   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF       //
+//   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   //
+//   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR        //
+//   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,    //
+//   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR    //
+//   OTHER DEALINGS IN THE SOFTWARE.                                          //
+//                                                                            //
+//   For more information, please refer to <https://unlicense.org>            //
+////////////////////////////////////////////////////////////////////////////////
+//    WOS : Web Operating System                                              //
+//     Tools/ZLibBench.cpp : ZLib benchmark and conformance tool              //
+////////////////////////////////////////////////////////////////////////////////
+#include "../Compress/ZLib.h"
+#include "../Compress/ZLibInflater.h"
+#include "../System/SysCRC.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef WOS_ZLIBBENCH_SYSTEM_ZLIB
+    #include <zlib.h>
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  ZLibBench settings                                                        //
+////////////////////////////////////////////////////////////////////////////////
+const double ZLibBenchMinTime = 0.1;
+const uint32_t ZLibBenchMinRuns = 3;
+const size_t ZLibBenchSyntheticSize = 1048576;
+const size_t ZLibBenchAllocHeader = 16;
+
+////////////////////////////////////////////////////////////////////////////////
+//  ZLibBench corpus entry structure                                          //
+////////////////////////////////////////////////////////////////////////////////
+struct ZLibBenchEntry
+{
+    std::string name;                       // Entry name
+    std::vector<unsigned char> data;        // Reference uncompressed data
+    std::vector<unsigned char> source;      // Source ZLib stream (PNG IDAT)
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//  ZLibBench level results structure                                         //
+////////////////////////////////////////////////////////////////////////////////
+struct ZLibBenchResults
+{
+    size_t inSize;          // Total uncompressed size
+    size_t outSize;         // Total compressed size
+    double compressTime;    // Total compression time
+    double decompressTime;  // Total decompression time
+    size_t compressPeak;    // Peak heap memory while compressing
+    size_t decompressPeak;  // Peak heap memory while decompressing
+    uint32_t failures;      // Round-trip failures
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Heap memory accounting                                                    //
+////////////////////////////////////////////////////////////////////////////////
+static size_t ZLibBenchHeapCurrent = 0;
+static size_t ZLibBenchHeapPeak = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+//  Allocate accounted heap memory                                            //
+//  return : Allocated memory pointer, or null on failure                     //
+////////////////////////////////////////////////////////////////////////////////
+static void* ZLibBenchAlloc(size_t size)
+{
+    unsigned char* block = static_cast<unsigned char*>(
+        std::malloc(size + ZLibBenchAllocHeader)
+    );
+    if (!block) { return 0; }
+
+    std::memcpy(block, &size, sizeof(size_t));
+    ZLibBenchHeapCurrent += size;
+    if (ZLibBenchHeapCurrent > ZLibBenchHeapPeak)
+    {
+        ZLibBenchHeapPeak = ZLibBenchHeapCurrent;
+    }
+    return (block + ZLibBenchAllocHeader);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Free accounted heap memory                                                //
+////////////////////////////////////////////////////////////////////////////////
+static void ZLibBenchFree(void* ptr)
+{
+    if (!ptr) { return; }
+
+    unsigned char* block =
+        static_cast<unsigned char*>(ptr) - ZLibBenchAllocHeader;
+    size_t size = 0;
+    std::memcpy(&size, block, sizeof(size_t));
+    ZLibBenchHeapCurrent -= size;
+    std::free(block);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reset heap memory peak to the current heap usage                          //
+////////////////////////////////////////////////////////////////////////////////
+static void ZLibBenchResetPeak()
+{
+    ZLibBenchHeapPeak = ZLibBenchHeapCurrent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Global allocation operators (heap memory accounting)                      //
+////////////////////////////////////////////////////////////////////////////////
+void* operator new(size_t size)
+{
+    void* ptr = ZLibBenchAlloc(size);
+    if (!ptr) { std::abort(); }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    void* ptr = ZLibBenchAlloc(size);
+    if (!ptr) { std::abort(); }
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return ZLibBenchAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return ZLibBenchAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    ZLibBenchFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    ZLibBenchFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    ZLibBenchFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    ZLibBenchFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    ZLibBenchFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    ZLibBenchFree(ptr);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  Get current time in seconds                                               //
+//  return : Current steady clock time in seconds                             //
+////////////////////////////////////////////////////////////////////////////////
+static double ZLibBenchTime()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load file into memory                                                     //
+//  return : True if the file is successfully loaded                          //
+////////////////////////////////////////////////////////////////////////////////
+static bool ZLibBenchLoadFile(const std::string& path,
+    std::vector<unsigned char>& data)
+{
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        // Could not open file
+        return false;
+    }
+
+    data.clear();
+    unsigned char buffer[65536];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer+read);
+    }
+    std::fclose(file);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Extract PNG IDAT chunks into a single ZLib stream                         //
+//  return : True if the PNG IDAT stream is successfully extracted            //
+////////////////////////////////////////////////////////////////////////////////
+static bool ZLibBenchExtractIDAT(const std::vector<unsigned char>& png,
+    std::vector<unsigned char>& stream)
+{
+    static const unsigned char signature[8] = {
+        0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+    if ((png.size() < 8) || (std::memcmp(png.data(), signature, 8) != 0))
+    {
+        // Invalid PNG signature
+        return false;
+    }
+
+    stream.clear();
+    size_t index = 8;
+    while ((index + 12) <= png.size())
+    {
+        uint32_t length = (
+            (static_cast<uint32_t>(png[index]) << 24) |
+            (static_cast<uint32_t>(png[index+1]) << 16) |
+            (static_cast<uint32_t>(png[index+2]) << 8) |
+            static_cast<uint32_t>(png[index+3])
+        );
+        const unsigned char* type = &png[index+4];
+        if ((index + 12 + length) > png.size())
+        {
+            // Truncated PNG chunk
+            return false;
+        }
+
+        if (std::memcmp(type, "IDAT", 4) == 0)
+        {
+            stream.insert(stream.end(),
+                png.begin()+index+8, png.begin()+index+8+length
+            );
+        }
+        else if (std::memcmp(type, "IEND", 4) == 0)
+        {
+            break;
+        }
+        index += (12 + length);
+    }
+
+    return (stream.size() > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Reference inflate with the streaming inflater                             //
+//  return : True if the stream is successfully inflated                      //
+////////////////////////////////////////////////////////////////////////////////
+static bool ZLibBenchReferenceInflate(const std::vector<unsigned char>& in,
+    std::vector<unsigned char>& out)
+{
+    ZLibInflater inflater;
+    if (!inflater.init())
+    {
+        // Could not init inflater
+        return false;
+    }
+
+    out.clear();
+    unsigned char buffer[16384];
+    size_t inIndex = 0;
+    while (!inflater.isDone())
+    {
+        size_t inRead = 0;
+        if (!inflater.feed(
+            in.data()+inIndex, in.size()-inIndex, &inRead))
+        {
+            // Invalid stream
+            return false;
+        }
+        inIndex += inRead;
+
+        size_t drained = 0;
+        while ((drained = inflater.drain(buffer, sizeof(buffer))) > 0)
+        {
+            out.insert(out.end(), buffer, buffer+drained);
+        }
+
+        if ((inRead == 0) && !inflater.isDone())
+        {
+            // Truncated stream
+            return false;
+        }
+    }
+
+    return inflater.finish();
+}
+
+#ifdef WOS_ZLIBBENCH_SYSTEM_ZLIB
+////////////////////////////////////////////////////////////////////////////////
+//  Check stream against system zlib inflate output                           //
+//  return : True if system zlib output matches the reference data            //
+////////////////////////////////////////////////////////////////////////////////
+static bool ZLibBenchSystemCheck(const unsigned char* in, size_t inSize,
+    const std::vector<unsigned char>& data)
+{
+    std::vector<unsigned char> out(data.size()+1);
+    uLongf outSize = static_cast<uLongf>(out.size());
+    if (uncompress(out.data(), &outSize, in, static_cast<uLong>(inSize)) !=
+        Z_OK)
+    {
+        // System zlib rejected the stream
+        return false;
+    }
+    return ((outSize == data.size()) &&
+        (std::memcmp(out.data(), data.data(), data.size()) == 0));
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//  Load PNG corpus directory                                                 //
+//  return : Number of PNG streams loaded                                     //
+////////////////////////////////////////////////////////////////////////////////
+static uint32_t ZLibBenchLoadDirectory(const std::string& root,
+    const char* directory, std::vector<ZLibBenchEntry>& corpus,
+    uint32_t& failures)
+{
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::path(root) / directory;
+    std::vector<std::string> files;
+    for (std::filesystem::directory_iterator it(path, error), end;
+        !error && (it != end); it.increment(error))
+    {
+        if (it->path().extension() == ".png")
+        {
+            files.push_back(it->path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    uint32_t loaded = 0;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        std::vector<unsigned char> png;
+        ZLibBenchEntry entry;
+        entry.name = std::string(directory) + "/" +
+            std::filesystem::path(files[i]).filename().string();
+
+        if (!ZLibBenchLoadFile(files[i], png) ||
+            !ZLibBenchExtractIDAT(png, entry.source))
+        {
+            std::printf("FAIL  %s : could not extract IDAT\n",
+                entry.name.c_str()
+            );
+            ++failures;
+            continue;
+        }
+
+        // Reference inflate output
+        if (!ZLibBenchReferenceInflate(entry.source, entry.data))
+        {
+            std::printf("FAIL  %s : reference inflate\n", entry.name.c_str());
+            ++failures;
+            continue;
+        }
+
+        // One-shot inflate of the foreign stream against reference
+        std::vector<unsigned char> out(entry.data.size());
+        size_t outSize = out.size();
+        if (!ZLibDeflateDecompress(entry.source.data(), entry.source.size(),
+            out.data(), &outSize) || (outSize != entry.data.size()) ||
+            (std::memcmp(out.data(), entry.data.data(), outSize) != 0))
+        {
+            std::printf("FAIL  %s : source inflate mismatch\n",
+                entry.name.c_str()
+            );
+            ++failures;
+            continue;
+        }
+
+        #ifdef WOS_ZLIBBENCH_SYSTEM_ZLIB
+            if (!ZLibBenchSystemCheck(entry.source.data(),
+                entry.source.size(), entry.data))
+            {
+                std::printf("FAIL  %s : system zlib reference mismatch\n",
+                    entry.name.c_str()
+                );
+                ++failures;
+                continue;
+            }
+        #endif
+
+        corpus.push_back(entry);
+        ++loaded;
+    }
+    return loaded;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Add synthetic corpus entries                                              //
+////////////////////////////////////////////////////////////////////////////////
+static void ZLibBenchAddSynthetic(std::vector<ZLibBenchEntry>& corpus)
+{
+    static const char* words[16] = {
+        "window ", "texture ", "sprite ", "render ", "the ", "of ", "and ",
+        "shader ", "buffer ", "mouse ", "cursor ", "font ", "a ", "to ",
+        "vertex ", "\n"
+    };
+    uint32_t seed = 0x12345678;
+    ZLibBenchEntry entry;
+
+    // Zeros
+    entry.name = "synthetic/zeros";
+    entry.data.assign(ZLibBenchSyntheticSize, 0);
+    corpus.push_back(entry);
+
+    // Random bytes
+    entry.name = "synthetic/random";
+    entry.data.resize(ZLibBenchSyntheticSize);
+    for (size_t i = 0; i < entry.data.size(); ++i)
+    {
+        seed = (seed*1664525 + 1013904223);
+        entry.data[i] = static_cast<unsigned char>(seed >> 24);
+    }
+    corpus.push_back(entry);
+
+    // Text
+    entry.name = "synthetic/text";
+    entry.data.clear();
+    while (entry.data.size() < ZLibBenchSyntheticSize)
+    {
+        seed = (seed*1664525 + 1013904223);
+        const char* word = words[(seed >> 24) & 15];
+        entry.data.insert(entry.data.end(), word, word+std::strlen(word));
+    }
+    entry.data.resize(ZLibBenchSyntheticSize);
+    corpus.push_back(entry);
+
+    // RGBA gradient image rows (PNG filter none)
+    entry.name = "synthetic/gradient";
+    entry.data.clear();
+    for (uint32_t j = 0; j < 512; ++j)
+    {
+        entry.data.push_back(0);
+        for (uint32_t i = 0; i < 512; ++i)
+        {
+            seed = (seed*1664525 + 1013904223);
+            entry.data.push_back(static_cast<unsigned char>(i >> 1));
+            entry.data.push_back(static_cast<unsigned char>(j >> 1));
+            entry.data.push_back(static_cast<unsigned char>(
+                ((i+j) >> 2) + ((seed >> 30) & 1)
+            ));
+            entry.data.push_back(255);
+        }
+    }
+    corpus.push_back(entry);
+
+    // Small input
+    entry.name = "synthetic/small";
+    entry.data.assign(words[1], words[1]+std::strlen(words[1]));
+    corpus.push_back(entry);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Benchmark corpus entry at a given level                                   //
+//  return : True if the entry round-trips against the reference output       //
+////////////////////////////////////////////////////////////////////////////////
+static bool ZLibBenchEntryLevel(ZLibBenchEntry& entry,
+    ZLibDeflateLevel level, ZLibBenchResults& results)
+{
+    std::vector<unsigned char> compressed(
+        ZLibComputeDeflateCompressSize(entry.data.size())
+    );
+    std::vector<unsigned char> decompressed(entry.data.size()+1);
+    size_t compressedSize = 0;
+    size_t decompressedSize = 0;
+
+    // Compression
+    double bestTime = 0.0;
+    double totalTime = 0.0;
+    size_t peak = 0;
+    for (uint32_t run = 0;
+        (run < ZLibBenchMinRuns) || (totalTime < ZLibBenchMinTime); ++run)
+    {
+        compressedSize = compressed.size();
+        ZLibBenchResetPeak();
+        size_t base = ZLibBenchHeapCurrent;
+        double start = ZLibBenchTime();
+        if (!ZLibDeflateCompress(entry.data.data(), entry.data.size(),
+            compressed.data(), &compressedSize, level))
+        {
+            std::printf("FAIL  %s : level %u compress\n",
+                entry.name.c_str(), static_cast<unsigned int>(level)
+            );
+            return false;
+        }
+        double elapsed = ZLibBenchTime() - start;
+        if ((run == 0) || (elapsed < bestTime)) { bestTime = elapsed; }
+        if ((ZLibBenchHeapPeak-base) > peak) { peak = ZLibBenchHeapPeak-base; }
+        totalTime += elapsed;
+    }
+    results.compressTime += bestTime;
+    if (peak > results.compressPeak) { results.compressPeak = peak; }
+
+    // Decompression
+    bestTime = 0.0;
+    totalTime = 0.0;
+    peak = 0;
+    for (uint32_t run = 0;
+        (run < ZLibBenchMinRuns) || (totalTime < ZLibBenchMinTime); ++run)
+    {
+        decompressedSize = entry.data.size();
+        ZLibBenchResetPeak();
+        size_t base = ZLibBenchHeapCurrent;
+        double start = ZLibBenchTime();
+        if (!ZLibDeflateDecompress(compressed.data(), compressedSize,
+            decompressed.data(), &decompressedSize))
+        {
+            std::printf("FAIL  %s : level %u decompress\n",
+                entry.name.c_str(), static_cast<unsigned int>(level)
+            );
+            return false;
+        }
+        double elapsed = ZLibBenchTime() - start;
+        if ((run == 0) || (elapsed < bestTime)) { bestTime = elapsed; }
+        if ((ZLibBenchHeapPeak-base) > peak) { peak = ZLibBenchHeapPeak-base; }
+        totalTime += elapsed;
+    }
+    results.decompressTime += bestTime;
+    if (peak > results.decompressPeak) { results.decompressPeak = peak; }
+    results.inSize += entry.data.size();
+    results.outSize += compressedSize;
+
+    // Round-trip check against reference output
+    if ((decompressedSize != entry.data.size()) ||
+        (std::memcmp(decompressed.data(), entry.data.data(),
+        decompressedSize) != 0))
+    {
+        std::printf("FAIL  %s : level %u round-trip mismatch\n",
+            entry.name.c_str(), static_cast<unsigned int>(level)
+        );
+        return false;
+    }
+
+    // Streaming inflater check against reference output
+    std::vector<unsigned char> streamed;
+    std::vector<unsigned char> stream(
+        compressed.begin(), compressed.begin()+compressedSize
+    );
+    if (!ZLibBenchReferenceInflate(stream, streamed) ||
+        (streamed != entry.data))
+    {
+        std::printf("FAIL  %s : level %u reference inflate mismatch\n",
+            entry.name.c_str(), static_cast<unsigned int>(level)
+        );
+        return false;
+    }
+
+    #ifdef WOS_ZLIBBENCH_SYSTEM_ZLIB
+        if (!ZLibBenchSystemCheck(compressed.data(), compressedSize,
+            entry.data))
+        {
+            std::printf("FAIL  %s : level %u system zlib mismatch\n",
+                entry.name.c_str(), static_cast<unsigned int>(level)
+            );
+            return false;
+        }
+    #endif
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//  Compute throughput in MB/s                                                //
+//  return : Computed throughput in MB/s                                      //
+////////////////////////////////////////////////////////////////////////////////
+static double ZLibBenchThroughput(size_t size, double time)
+{
+    if (time <= 0.0) { return 0.0; }
+    return ((static_cast<double>(size) / 1000000.0) / time);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//  ZLibBench program entry point                                             //
+//  Usage : ZLibBench [repository root] [-v]                                  //
+//  return : 0 if every stream round-trips, 1 otherwise                       //
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::string root = ".";
+    bool verbose = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-v") == 0) { verbose = true; }
+        else { root = argv[i]; }
+    }
+
+    // Load corpus
+    std::vector<ZLibBenchEntry> corpus;
+    uint32_t failures = 0;
+    uint32_t pngCount = 0;
+    pngCount += ZLibBenchLoadDirectory(root, "textures", corpus, failures);
+    pngCount += ZLibBenchLoadDirectory(root, "cursors", corpus, failures);
+    pngCount += ZLibBenchLoadDirectory(root, "fonts", corpus, failures);
+    ZLibBenchAddSynthetic(corpus);
+    if (pngCount == 0)
+    {
+        std::printf("FAIL  no PNG stream found under %s\n", root.c_str());
+        ++failures;
+    }
+
+    size_t corpusSize = 0;
+    for (size_t i = 0; i < corpus.size(); ++i)
+    {
+        corpusSize += corpus[i].data.size();
+    }
+    std::printf("Corpus : %u PNG IDAT streams, %u synthetic, %zu bytes\n\n",
+        pngCount, static_cast<unsigned int>(corpus.size()-pngCount),
+        corpusSize
+    );
+
+    // Benchmark every level
+    std::printf("%-6s %12s %12s %8s %12s %12s %12s %12s\n",
+        "Level", "Input", "Output", "Ratio", "Comp MB/s", "Decomp MB/s",
+        "Comp peak", "Decomp peak"
+    );
+    for (uint32_t level = 0; level < ZLIB_DEFLATE_LEVEL_COUNT; ++level)
+    {
+        ZLibBenchResults results;
+        std::memset(&results, 0, sizeof(results));
+
+        for (size_t i = 0; i < corpus.size(); ++i)
+        {
+            size_t outSize = results.outSize;
+            double compressTime = results.compressTime;
+            double decompressTime = results.decompressTime;
+            if (!ZLibBenchEntryLevel(corpus[i],
+                static_cast<ZLibDeflateLevel>(level), results))
+            {
+                ++results.failures;
+                continue;
+            }
+
+            if (verbose)
+            {
+                size_t size = corpus[i].data.size();
+                std::printf("  %-30s %10zu %10zu %8.3f %10.1f %10.1f\n",
+                    corpus[i].name.c_str(), size, results.outSize-outSize,
+                    (size > 0) ? (static_cast<double>(
+                        results.outSize-outSize) / size) : 0.0,
+                    ZLibBenchThroughput(size,
+                        results.compressTime-compressTime),
+                    ZLibBenchThroughput(size,
+                        results.decompressTime-decompressTime)
+                );
+            }
+        }
+
+        std::printf("%-6u %12zu %12zu %8.3f %12.1f %12.1f %12zu %12zu\n",
+            level, results.inSize, results.outSize,
+            (results.inSize > 0) ? (static_cast<double>(results.outSize) /
+                results.inSize) : 0.0,
+            ZLibBenchThroughput(results.inSize, results.compressTime),
+            ZLibBenchThroughput(results.inSize, results.decompressTime),
+            results.compressPeak, results.decompressPeak
+        );
+        failures += results.failures;
+    }
+
+    // Conformance summary
+    if (failures > 0)
+    {
+        std::printf("\n%u conformance failures\n", failures);
+        return 1;
+    }
+    std::printf("\nAll streams round-trip against reference inflate output\n");
+    return 0;
+}
@@ -0,0 +1,35 @@
+:: Build WOS native tools (run from the Tools directory)
+:: Add -DWOS_ZLIBBENCH_SYSTEM_ZLIB and -lz to also check against system zlib
+
+:: Build ZLibBench
+@CALL g++ -std=c++17 -O3 -W -Wall -pthread ^
+    -o ZLibBench.exe ^
+    ZLibBench.cpp ^
+    ../Compress/ZLib.cpp ^
+    ../Compress/ZLibInflater.cpp ^
+    ../System/SysCRC.cpp
+
+:: Build PNGFilterBench
+@CALL g++ -std=c++17 -O3 -W -Wall -pthread ^
+    -o PNGFilterBench.exe ^
+    PNGFilterBench.cpp ^
+    ../Images/PNGFilter.cpp
+
+:: Build AssetBundler
+@CALL g++ -std=c++17 -O3 -W -Wall -pthread ^
+    -o AssetBundler.exe ^
+    AssetBundler.cpp ^
+    ../Resources/AssetBundle.cpp ^
+    ../System/SysThread.cpp ^
+    ../System/SysJobs.cpp ^
+    ../System/SysFetch.cpp ^
+    ../Compress/ZLib.cpp ^
+    ../Compress/ZLibInflater.cpp ^
+    ../System/SysCRC.cpp
+
+:: Build KTXBench
+@CALL g++ -std=c++17 -O3 -W -Wall -pthread ^
+    -o KTXBench.exe ^
+    KTXBench.cpp ^
+    ../Images/KTXFile.cpp ^
+    ../Images/BlockTranscoder.cpp
@@ -2,21 +2,35 @@
 @CALL D:\emsdk\emsdk activate latest
 
 :: Build WOS
+:: Pthread pool : hardwareConcurrency-1 jobs workers, texture and mesh
+:: loaders, and 3 ZLib deflate workers (ZLIB_DEFLATE_MAX_THREADS-1)
 @CALL emcc -std=c++17 -O3 -fno-exceptions -fno-rtti -fomit-frame-pointer ^
     -ffunction-sections -fno-trapping-math -fno-math-errno -fno-signed-zeros ^
-    -W -Wall -pthread -lGL -s WASM=1 -s USE_PTHREADS=1 -s MAX_WEBGL_VERSION=2 ^
+    -W -Wall -pthread -msimd128 -lGL -s WASM=1 -s USE_PTHREADS=1 ^
+    -s MAX_WEBGL_VERSION=2 ^
     -s OFFSCREENCANVAS_SUPPORT=1 -s OFFSCREEN_FRAMEBUFFER=1 ^
     -s DYNAMIC_EXECUTION=0 ^
+    -s PTHREAD_POOL_SIZE=navigator.hardwareConcurrency+4 ^
+    -s FETCH=1 -s FETCH_STREAMING=1 ^
     -o wos.js ^
     System/SysMessage.cpp ^
     System/SysCPU.cpp ^
+    System/SysCRC.cpp ^
     System/SysClock.cpp ^
     System/SysThread.cpp ^
+    System/SysJobs.cpp ^
+    System/SysFetch.cpp ^
     System/SysWindow.cpp ^
     System/SysMouse.cpp ^
     System/SysSettings.cpp ^
     Compress/ZLib.cpp ^
+    Compress/ZLibInflater.cpp ^
     Images/PNGFile.cpp ^
+    Images/PNGFilter.cpp ^
+    Images/PNGDecoder.cpp ^
+    Images/ImageDownscaler.cpp ^
+    Images/BlockTranscoder.cpp ^
+    Images/KTXFile.cpp ^
     Renderer/Renderer.cpp ^
     Renderer/Shader.cpp ^
     Renderer/VertexBuffer.cpp ^
@@ -36,11 +50,17 @@
     Renderer/GUI/GUIPxText.cpp ^
     Renderer/GUI/GUIWindow.cpp ^
     Resources/Resources.cpp ^
+    Resources/AssetBundle.cpp ^
+    Resources/AssetCache.cpp ^
     Resources/TextureLoader.cpp ^
     Resources/MeshLoader.cpp ^
     Game/Game.cpp ^
     Wos.cpp ^
     main.cpp
 
+:: Pack assets bundle (assets are fetched one by one without it)
+@IF EXIST Tools\AssetBundler.exe @CALL Tools\AssetBundler.exe ^
+    assets.wpak cursors fonts textures models
+
 :: System pause
 PAUSE